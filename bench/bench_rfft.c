@@ -0,0 +1,96 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "kaldi-native-fbank/rfft.h"
+
+constexpr int32_t KNF_BENCH_FRAMES = 64;
+constexpr int32_t KNF_BENCH_ROUNDS = 2000;
+
+static double knf_bench_now(void) {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+// Nanoseconds per frame for power spectra of KNF_BENCH_FRAMES frames of n
+// samples whose first `live` samples are random, one frame at a time or all
+// of them through knf_rfft_compute_batch.
+static double knf_bench_power(knf_rfft *fft, int32_t live, bool batch) {
+  const int32_t n = fft->n;
+  const size_t total = (size_t)KNF_BENCH_FRAMES * (size_t)n;
+  float *input = (float *)calloc(total, sizeof(float));
+  float *frames = (float *)calloc(total, sizeof(float));
+  if (input == nullptr || frames == nullptr) {
+    free(input);
+    free(frames);
+    return -1.0;
+  }
+  for (size_t i = 0; i < total; ++i) {
+    if ((int32_t)(i % (size_t)n) < live) {
+      input[i] = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+    }
+  }
+
+  double best = -1.0;
+  for (int32_t round = 0; round < KNF_BENCH_ROUNDS; ++round) {
+    memcpy(frames, input, total * sizeof(float));
+    double start = knf_bench_now();
+    bool ok = true;
+    if (batch) {
+      ok = knf_rfft_compute_batch(fft, frames, KNF_BENCH_FRAMES, n);
+    } else {
+      for (int32_t f = 0; f < KNF_BENCH_FRAMES && ok; ++f) {
+        ok = knf_rfft_compute_power(fft, frames + (size_t)f * n, false);
+      }
+    }
+    double elapsed = knf_bench_now() - start;
+    if (!ok) {
+      best = -1.0;
+      break;
+    }
+    if (best < 0.0 || elapsed < best) best = elapsed;
+  }
+  free(input);
+  free(frames);
+  return best * 1e9 / KNF_BENCH_FRAMES;
+}
+
+int main() {
+  // Kaldi's default 25 ms window at 16 kHz and 8 kHz, padded to a power of
+  // two.
+  const int32_t configs[][2] = {{512, 400}, {256, 200}};
+  srand(1);
+  printf("%6s %8s %8s %12s %12s %8s\n", "n", "nonzero", "mode", "full ns",
+         "pruned ns", "speedup");
+  for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); ++i) {
+    const int32_t n = configs[i][0];
+    const int32_t live = configs[i][1];
+    knf_rfft *full = knf_rfft_create(n, false);
+    knf_rfft *pruned = knf_rfft_create_pruned(n, live);
+    if (full == nullptr || pruned == nullptr) {
+      fprintf(stderr, "Failed to create FFT plans for n=%d\n", n);
+      knf_rfft_destroy(full);
+      knf_rfft_destroy(pruned);
+      return 1;
+    }
+    for (int mode = 0; mode < 2; ++mode) {
+      double t_full = knf_bench_power(full, live, mode == 1);
+      double t_pruned = knf_bench_power(pruned, live, mode == 1);
+      if (t_full < 0.0 || t_pruned < 0.0) {
+        fprintf(stderr, "FFT failed for n=%d\n", n);
+        knf_rfft_destroy(full);
+        knf_rfft_destroy(pruned);
+        return 1;
+      }
+      printf("%6d %8d %8s %12.1f %12.1f %7.2fx\n", n, live,
+             mode == 1 ? "batch" : "power", t_full, t_pruned,
+             t_full / t_pruned);
+    }
+    knf_rfft_destroy(full);
+    knf_rfft_destroy(pruned);
+  }
+  return 0;
+}
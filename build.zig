@@ -23,6 +23,8 @@ const core_sources = [_][]const u8{
     "src/whisper-feature.c",
     "src/stft.c",
     "src/istft.c",
+    "src/sliding-dft.c",
+    "src/resampler.c",
 };
 
 const test_sources = [_]struct { name: []const u8, path: []const u8 }{
@@ -35,6 +37,9 @@ const test_sources = [_]struct { name: []const u8, path: []const u8 }{
     .{ .name = "test_online", .path = "tests/test_online.c" },
     .{ .name = "test_feature_demo", .path = "tests/test_feature_demo.c" },
     .{ .name = "test_whisper", .path = "tests/test_whisper.c" },
+    .{ .name = "test_sliding_dft", .path = "tests/test_sliding_dft.c" },
+    .{ .name = "test_kaldi_math", .path = "tests/test_kaldi_math.c" },
+    .{ .name = "test_resampler", .path = "tests/test_resampler.c" },
 };
 
 const example_sources =
@@ -46,6 +51,10 @@ const example_sources =
         },
     };
 
+const bench_sources = [_]struct { name: []const u8, path: []const u8 }{
+    .{ .name = "bench_rfft", .path = "bench/bench_rfft.c" },
+};
+
 pub fn build(b: *std.Build) void {
     const target = b.standardTargetOptions(.{});
     const optimize = b.standardOptimizeOption(.{});
@@ -106,6 +115,84 @@ pub fn build(b: *std.Build) void {
         run_step.dependOn(&run.step);
     }
 
+    const bench_step = b.step("bench", "Run C benchmarks");
+    for (bench_sources) |bench| {
+        const bench_module = b.createModule(.{
+            .target = target,
+            .optimize = optimize,
+            .link_libc = true,
+            .sanitize_c = sanitize,
+        });
+        bench_module.addIncludePath(.{ .src_path = .{ .owner = b, .sub_path = "src" } });
+        bench_module.addIncludePath(.{ .src_path = .{ .owner = b, .sub_path = "include" } });
+        bench_module.addCSourceFiles(.{
+            .files = &[_][]const u8{bench.path},
+            .flags = &c_flags,
+        });
+
+        const exe = b.addExecutable(.{
+            .name = bench.name,
+            .root_module = bench_module,
+        });
+        exe.linkLibrary(lib);
+        linkCoreDeps(exe, target);
+
+        const run = b.addRunArtifact(exe);
+        bench_step.dependOn(&run.step);
+    }
+
+    // Regenerates src/pocketfft-codelet-tables.h and src/pocketfft-codelets.h;
+    // the generator compiles pocketfft.c itself, without the codelets.
+    const gen_module = b.createModule(.{
+        .target = b.graph.host,
+        .optimize = .Debug,
+        .link_libc = true,
+    });
+    gen_module.addIncludePath(.{ .src_path = .{ .owner = b, .sub_path = "src" } });
+    gen_module.addIncludePath(.{ .src_path = .{ .owner = b, .sub_path = "include" } });
+    gen_module.addCSourceFiles(.{
+        .files = &[_][]const u8{"tools/gen_fft_codelets.c"},
+        .flags = &c_flags,
+    });
+    const gen_codelets = b.addExecutable(.{
+        .name = "gen_fft_codelets",
+        .root_module = gen_module,
+    });
+    linkCoreDeps(gen_codelets, b.graph.host);
+    const run_gen_codelets = b.addRunArtifact(gen_codelets);
+    run_gen_codelets.addArg(b.pathFromRoot("src"));
+    const codelets_step = b.step("codelets", "Regenerate the FFT codelets in src/");
+    codelets_step.dependOn(&run_gen_codelets.step);
+
+    // Regenerates src/feature-window-tables.h and src/mel-tables.h from the
+    // window and mel code, built without the tables it is about to replace.
+    const tables_module = b.createModule(.{
+        .target = b.graph.host,
+        .optimize = .Debug,
+        .link_libc = true,
+    });
+    tables_module.addIncludePath(.{ .src_path = .{ .owner = b, .sub_path = "src" } });
+    tables_module.addIncludePath(.{ .src_path = .{ .owner = b, .sub_path = "include" } });
+    tables_module.addCSourceFiles(.{
+        .files = &[_][]const u8{
+            "tools/gen_feature_tables.c",
+            "src/log.c",
+            "src/kaldi-math.c",
+            "src/feature-window.c",
+            "src/mel-computations.c",
+        },
+        .flags = &(c_flags ++ [_][]const u8{"-DKNF_NO_EMBEDDED_TABLES"}),
+    });
+    const gen_tables = b.addExecutable(.{
+        .name = "gen_feature_tables",
+        .root_module = tables_module,
+    });
+    linkCoreDeps(gen_tables, b.graph.host);
+    const run_gen_tables = b.addRunArtifact(gen_tables);
+    run_gen_tables.addArg(b.pathFromRoot("src"));
+    const tables_step = b.step("tables", "Regenerate the window and mel tables in src/");
+    tables_step.dependOn(&run_gen_tables.step);
+
     const test_step = b.step("test", "Run C test executables");
     for (test_sources) |t| {
         const test_module = b.createModule(.{
@@ -6,6 +6,7 @@
 #include "kaldi-native-fbank/feature-window.h"
 #include "kaldi-native-fbank/mel-computations.h"
 #include "kaldi-native-fbank/rfft.h"
+#include "kaldi-native-fbank/sliding-dft.h"
 
 typedef struct {
   knf_frame_opts frame_opts;
@@ -16,12 +17,20 @@ typedef struct {
   float energy_floor;
   bool use_log_fbank;
   bool use_power;
+  // Take logs with knf_log_floor_fast instead of logf; see kaldi-math.h for
+  // its error bound.
+  bool fast_log;
+  // Spectrum engine of the online extractor; see sliding-dft.h.
+  knf_spectrum_engine spectrum_engine;
 } knf_fbank_opts;
 
 typedef struct {
   knf_fbank_opts opts;
+  knf_frame_geometry geometry;
   knf_rfft *rfft;
+  void *rfft_scratch;  // knf_rfft_scratch_size(rfft) bytes
   knf_mel_banks *mel_banks;
+  knf_mel_warped warped;  // banks for the last warp other than 1
   float log_energy_floor;
 } knf_fbank_computer;
 
@@ -32,5 +41,30 @@ void knf_fbank_computer_destroy(knf_fbank_computer *c);
 const knf_frame_opts *knf_fbank_frame_opts(const knf_fbank_computer *c);
 int32_t knf_fbank_dim(const knf_fbank_computer *c);
 bool knf_fbank_need_raw_log_energy(const knf_fbank_computer *c);
+// A vtln_warp other than 1 uses mel banks warped by it, shared with other
+// computers through knf_mel_banks_acquire. A warp no banks can be built for
+// gives a zero feature.
 void knf_fbank_compute(knf_fbank_computer *c, float signal_raw_log_energy,
                        float vtln_warp, float *signal_frame, float *feature);
+// Same, from a power spectrum computed elsewhere, e.g. by knf_sliding_dft:
+// spectrum[k] for the bins of the mel banks, warped by vtln_warp, as
+// |X_k|^2 or |X_k| as use_power says. signal_frame is only read for the
+// energy.
+void knf_fbank_compute_spectrum(knf_fbank_computer *c,
+                                float signal_raw_log_energy, float vtln_warp,
+                                const float *signal_frame,
+                                const float *spectrum, float *feature);
+// knf_fbank_compute for every row of frames, e.g. from knf_extract_windows,
+// with frames->log_energies as the raw log energies; row i's feature goes to
+// features + i * knf_fbank_dim(c). The rows and frames->log_energies are
+// overwritten. The mel banks run over all rows at once with
+// knf_mel_compute_batch.
+void knf_fbank_compute_batch(knf_fbank_computer *c, float vtln_warp,
+                             knf_frame_matrix *frames, float *features);
+// Same for num_warps warps at once, e.g. for a VTLN search: the power
+// spectrum of each row is computed once and every warp's banks run over it.
+// Row i at warp k goes to features + (k * frames->rows + i) * dim. The rows
+// and frames->log_energies are overwritten.
+void knf_fbank_compute_warps(knf_fbank_computer *c, const float *vtln_warps,
+                             int32_t num_warps, knf_frame_matrix *frames,
+                             float *features);
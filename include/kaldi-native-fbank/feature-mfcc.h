@@ -6,6 +6,7 @@
 #include "kaldi-native-fbank/feature-window.h"
 #include "kaldi-native-fbank/mel-computations.h"
 #include "kaldi-native-fbank/rfft.h"
+#include "kaldi-native-fbank/sliding-dft.h"
 
 typedef struct {
   knf_frame_opts frame_opts;
@@ -16,12 +17,20 @@ typedef struct {
   bool raw_energy;
   bool htk_compat;
   float energy_floor;
+  // Take logs with knf_log_floor_fast instead of logf; see kaldi-math.h for
+  // its error bound.
+  bool fast_log;
+  // Spectrum engine of the online extractor; see sliding-dft.h.
+  knf_spectrum_engine spectrum_engine;
 } knf_mfcc_opts;
 
 typedef struct {
   knf_mfcc_opts opts;
+  knf_frame_geometry geometry;
   knf_rfft *rfft;
+  void *rfft_scratch;  // knf_rfft_scratch_size(rfft) bytes
   knf_mel_banks *mel_banks;
+  knf_mel_warped warped;  // banks for the last warp other than 1
   float *mel_energies;
   float *dct_matrix;
   float *lifter_coeffs;
@@ -35,5 +44,21 @@ void knf_mfcc_computer_destroy(knf_mfcc_computer *c);
 const knf_frame_opts *knf_mfcc_frame_opts(const knf_mfcc_computer *c);
 int32_t knf_mfcc_dim(const knf_mfcc_computer *c);
 bool knf_mfcc_need_raw_log_energy(const knf_mfcc_computer *c);
+// vtln_warp is applied as in knf_fbank_compute.
 void knf_mfcc_compute(knf_mfcc_computer *c, float signal_raw_log_energy,
                       float vtln_warp, float *signal_frame, float *feature);
+// Same, from a power spectrum computed elsewhere, e.g. by knf_sliding_dft:
+// spectrum[k] for the bins of the mel banks, warped by vtln_warp, |X_k|^2.
+// signal_frame is only read for the energy.
+void knf_mfcc_compute_spectrum(knf_mfcc_computer *c,
+                               float signal_raw_log_energy, float vtln_warp,
+                               const float *signal_frame,
+                               const float *spectrum, float *feature);
+// Features of every row of frames, e.g. from knf_extract_windows, at
+// num_warps warps, with frames->log_energies as the raw log energies: the
+// power spectrum of each row is computed once and every warp's banks run
+// over it. Row i at warp k goes to features + (k * frames->rows + i) * dim.
+// The rows are overwritten.
+void knf_mfcc_compute_warps(knf_mfcc_computer *c, const float *vtln_warps,
+                            int32_t num_warps, knf_frame_matrix *frames,
+                            float *features);
@@ -11,6 +11,7 @@ typedef struct {
 
 typedef struct {
   knf_raw_audio_opts opts;
+  knf_frame_geometry geometry;
 } knf_raw_audio_computer;
 
 void knf_raw_audio_opts_default(knf_raw_audio_opts *opts);
@@ -1,6 +1,7 @@
 // Feature window utilities rewritten for C23.
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
 typedef struct {
@@ -8,6 +9,10 @@ typedef struct {
   float frame_shift_ms;
   float frame_length_ms;
   float dither;
+  // Key of the dither generator. Streams with the same seed, such as the
+  // default 0, get the same noise; give each stream its own seed if that
+  // matters.
+  uint64_t dither_seed;
   float preemph_coeff;
   bool remove_dc_offset;
   char window_type[16]; // povey, hamming, hann, sine, rectangular, blackman
@@ -17,16 +22,75 @@ typedef struct {
 } knf_frame_opts;
 
 typedef struct {
-  float *data;
+  const float *data;
   int32_t size;
+  bool embedded;  // data is a built-in table, not freed by knf_free_window
 } knf_window;
 
+// Sample types the extractors read natively. Integers are brought to the
+// 16-bit range Kaldi features expect: int16 as is, int32 divided by 65536,
+// G.711 mu-law and A-law bytes decoded to their 16-bit linear values.
+typedef enum {
+  KNF_SAMPLE_FLOAT32 = 0,
+  KNF_SAMPLE_INT16 = 1,
+  KNF_SAMPLE_INT32 = 2,
+  KNF_SAMPLE_FLOAT64 = 3,
+  KNF_SAMPLE_MULAW = 4,
+  KNF_SAMPLE_ALAW = 5,
+} knf_sample_format;
+
+size_t knf_sample_size(knf_sample_format format);
+// out[i] = sample offset + i of src, for 0 <= i < n.
+void knf_convert_samples(const void *src, knf_sample_format format,
+                         int64_t offset, int32_t n, float *out);
+
+// Channel argument that averages all channels of interleaved input.
+enum { KNF_CHANNEL_DOWNMIX = -1 };
+
+// Same for one channel of src interleaving channels channels, or their mean
+// for KNF_CHANNEL_DOWNMIX; offset and n count samples per channel.
+void knf_convert_channel(const void *src, knf_sample_format format,
+                         int32_t channels, int32_t channel, int64_t offset,
+                         int32_t n, float *out);
+
+// Frame layout derived once from knf_frame_opts, so that per-frame code reads
+// integers instead of redoing the float math and option checks.
+typedef struct {
+  int32_t shift;
+  int32_t size;
+  int32_t padded;  // size, or the next power of two
+  bool snip_edges;
+  bool remove_dc_offset;
+  float dither;
+  // Channel c of frame i, out of channels, is dithered with the
+  // knf_random_state blocks from (i * channels + c) * ((size + 3) / 4) on, so
+  // the noise depends only on seed, frame and channel. Single-channel and
+  // downmixed frames count as channel 0 of 1.
+  uint64_t dither_seed;
+  float preemph_coeff;
+  const float *window;  // size coefficients, or nullptr for none; not owned
+} knf_frame_geometry;
+
+// Consecutive processed frames, one per row, for the batched FFT and mel
+// stages. Rows start every stride floats, a multiple of 16, so each row is
+// 64-byte aligned; the floats from cols on are zero.
+typedef struct {
+  float *data;          // rows * stride floats
+  float *log_energies;  // rows raw log energies, before windowing
+  int32_t rows;
+  int32_t cols;  // the padded frame size
+  int32_t stride;
+  int32_t capacity;  // rows data and log_energies have room for
+} knf_frame_matrix;
+
 int32_t knf_round_up_power_of_two(int32_t n);
 void knf_frame_opts_default(knf_frame_opts *opts);
 int32_t knf_window_shift(const knf_frame_opts *opts);
 int32_t knf_window_size(const knf_frame_opts *opts);
 int32_t knf_padded_window_size(const knf_frame_opts *opts);
 
+// The windows of the standard configurations (src/feature-window-tables.h)
+// are bound to built-in tables, without computing or allocating anything.
 [[nodiscard]] bool knf_make_window(const char *window_type, int32_t window_size,
                                    float blackman_coeff, knf_window *out);
 [[nodiscard]] bool knf_make_window_from_opts(const knf_frame_opts *opts,
@@ -43,7 +107,61 @@ int32_t knf_num_frames(int64_t num_samples, const knf_frame_opts *opts,
                                       const knf_window *window_function,
                                       float *window,
                                       float *log_energy_pre_window);
-void knf_process_window(const knf_frame_opts *opts,
+// Processes frame frame_index in place; the index picks its dither noise.
+bool knf_process_window_at(const knf_frame_opts *opts,
+                           const knf_window *window_function,
+                           int32_t frame_index, float *window,
+                           float *log_energy_pre_window);
+// Same without a frame index, so it fails, leaving window alone, if the
+// options ask for dither.
+bool knf_process_window(const knf_frame_opts *opts,
                         const knf_window *window_function, float *window,
                         float *log_energy_pre_window);
+// Fails unless the frame size is positive and window, if given, holds exactly
+// size coefficients. A shift that is not positive yields no frames.
+[[nodiscard]] bool knf_frame_geometry_init(const knf_frame_opts *opts,
+                                           const knf_window *window,
+                                           knf_frame_geometry *out);
+// Same as the functions above, for a validated geometry.
+int64_t knf_frame_geometry_first_sample(const knf_frame_geometry *g,
+                                        int32_t frame);
+int32_t knf_frame_geometry_num_frames(const knf_frame_geometry *g,
+                                      int64_t num_samples, bool flush);
+[[nodiscard]] bool knf_frame_geometry_extract(const knf_frame_geometry *g,
+                                              int64_t sample_offset,
+                                              const float *wave,
+                                              int32_t wave_size,
+                                              int32_t frame_index,
+                                              float *window,
+                                              float *log_energy_pre_window);
+// Same, reading wave in its own format; the conversion happens in the same
+// pass as the copy.
+[[nodiscard]] bool knf_frame_geometry_extract_typed(
+    const knf_frame_geometry *g, int64_t sample_offset, const void *wave,
+    knf_sample_format format, int32_t wave_size, int32_t frame_index,
+    float *window, float *log_energy_pre_window);
+// Same for one channel of interleaved wave (see knf_convert_channel);
+// sample_offset and wave_size count samples per channel.
+[[nodiscard]] bool knf_frame_geometry_extract_channel(
+    const knf_frame_geometry *g, int64_t sample_offset, const void *wave,
+    knf_sample_format format, int32_t channels, int32_t channel,
+    int32_t wave_size, int32_t frame_index, float *window,
+    float *log_energy_pre_window);
+// Extracts frames first_frame .. first_frame + count - 1 of wave, interleaving
+// channels channels, into out, which must be zero-initialized or come from an
+// earlier call; it only reallocates to grow. Row f * channels + c holds frame
+// first_frame + f of channel c, or with downmix row f holds the frame of the
+// channels' mean. Fails, leaving out->rows at 0, if any frame is not
+// available.
+[[nodiscard]] bool knf_extract_windows(const knf_frame_geometry *g,
+                                       int64_t sample_offset,
+                                       const void *wave,
+                                       knf_sample_format format,
+                                       int32_t channels, bool downmix,
+                                       int32_t wave_size, int32_t first_frame,
+                                       int32_t count, knf_frame_matrix *out);
+void knf_frame_matrix_free(knf_frame_matrix *m);
+void knf_frame_geometry_process(const knf_frame_geometry *g,
+                                int32_t frame_index, float *window,
+                                float *log_energy_pre_window);
 float knf_inner_product(const float *a, const float *b, int32_t n);
@@ -9,13 +9,35 @@ constexpr double KNF_SQRT2 = 1.41421356237309504880;
 constexpr float KNF_PI_F = 3.14159265358979323846f;
 constexpr float KNF_TWO_PI_F = 6.28318530717958647692f;
 constexpr float KNF_SQRT2_F = 1.41421356237309504880f;
+constexpr float KNF_FAST_LOG_MAX_REL_ERROR = 2.384185791015625e-7f;  // 2^-22
 
+// Counter-based generator (Philox4x32-10): block c of four 32-bit values is a
+// pure function of the key and c, so a stream can be produced in any order,
+// by any number of threads, with the same result, and no state is shared
+// between streams.
 typedef struct {
-  unsigned seed;
+  uint32_t key[2];
+  uint64_t counter;  // next block
 } knf_random_state;
 
+// Seeds from rand(), as before; knf_random_state_seed is reproducible.
 void knf_random_state_init(knf_random_state *state);
+void knf_random_state_seed(knf_random_state *state, uint64_t seed);
+// The four values of block counter, without touching the state.
+void knf_rand_block(const knf_random_state *state, uint64_t counter,
+                    uint32_t out[4]);
+// Single values take one block each; nullptr state falls back to rand().
 int knf_rand(knf_random_state *state);
 float knf_rand_uniform(knf_random_state *state);
 float knf_rand_gauss(knf_random_state *state);
+// n values from the next (n + 3) / 4 blocks: uniform in (0, 1), or standard
+// normal, which takes one more block when n is odd. Vectorized across blocks.
+void knf_rand_uniform_block(knf_random_state *state, float *out, int32_t n);
+void knf_rand_gauss_block(knf_random_state *state, float *out, int32_t n);
 void knf_sqrt_inplace(float *in_out, int32_t n);
+// in_out[i] = log(max(in_out[i], floor)) for finite in_out[i] and a positive
+// normal floor. The fast variant vectorizes: it reduces the exponent with
+// integer operations and evaluates a polynomial instead of calling logf. Its
+// error is at most KNF_FAST_LOG_MAX_REL_ERROR * |log(x)|.
+void knf_log_floor(float *in_out, int32_t n, float floor);
+void knf_log_floor_fast(float *in_out, int32_t n, float floor);
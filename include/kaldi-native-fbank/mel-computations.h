@@ -19,16 +19,79 @@ typedef struct {
   bool debug_mel;
 } knf_mel_opts;
 
+// Each triangular filter is stored as its band of nonzero weights only:
+// filter r covers FFT bins first_bin[r] .. first_bin[r] + length[r] - 1 with
+// weights[start[r] ..], so the filters take O(taps) instead of
+// O(num_bins * num_fft_bins) floats and multiply-adds.
 typedef struct {
   int32_t num_bins;
   int32_t num_fft_bins;  // equals padded_window/2
-  float *weights;        // flattened [num_bins][num_fft_bins]
+  float *weights;        // the bands back to back
+  int32_t *first_bin;    // [num_bins]
+  int32_t *length;       // [num_bins]
+  int32_t *start;        // [num_bins], into weights
+  // Every filter is zero outside FFT bins [bin_begin, bin_end); callers only
+  // need the power spectrum over that range.
+  int32_t bin_begin;
+  int32_t bin_end;
+  // The banks and their arrays are a built-in read-only table (see
+  // src/mel-tables.h); knf_mel_banks_destroy leaves them alone.
+  bool embedded;
 } knf_mel_banks;
 
+// Banks a computer keeps for the warp of its last frames, so that a run of
+// frames at one warp acquires them once. Zero-initialize; give them back with
+// knf_mel_warped_release.
+typedef struct {
+  knf_mel_banks *banks;  // from knf_mel_banks_acquire, or nullptr
+  float warp;
+} knf_mel_warped;
+
 void knf_mel_opts_default(knf_mel_opts *opts);
+// Owning pointer, or nullptr. Unwarped banks of the standard configurations
+// are bound to built-in tables without computing or allocating anything.
 [[nodiscard]] knf_mel_banks *knf_mel_banks_create(
     const knf_mel_opts *opts, const knf_frame_opts *frame_opts,
-    float vtln_warp);  // Owning pointer, or nullptr.
+    float vtln_warp);
 void knf_mel_banks_destroy(knf_mel_banks *banks);
+// Shared banks for vtln_warp rounded to three decimals, from a process-wide
+// cache that keeps the most recently used warpings of every configuration,
+// so switching between a few warps does not rebuild them. Each successful
+// call needs one knf_mel_banks_release; the banks must not be modified.
+[[nodiscard]] knf_mel_banks *knf_mel_banks_acquire(
+    const knf_mel_opts *opts, const knf_frame_opts *frame_opts,
+    float vtln_warp);
+void knf_mel_banks_release(knf_mel_banks *banks);
+// Frees the cached banks nobody holds.
+void knf_mel_clear_cache(void);
+// unwarped for a vtln_warp of 1, else the banks w holds for vtln_warp, which
+// replace the ones it held if the warp changed; nullptr if they cannot be
+// built.
+const knf_mel_banks *knf_mel_warped_get(knf_mel_warped *w,
+                                        const knf_mel_banks *unwarped,
+                                        const knf_mel_opts *opts,
+                                        const knf_frame_opts *frame_opts,
+                                        float vtln_warp);
+void knf_mel_warped_release(knf_mel_warped *w);
+// Banks for each of num_warps warps into banks, unwarped for a warp of 1 and
+// acquired otherwise, and the FFT bins [bin_begin, bin_end) they read between
+// them; false, holding none, if some cannot be built. Give them back with
+// knf_mel_warps_release.
+[[nodiscard]] bool knf_mel_warps_acquire(
+    knf_mel_banks *unwarped, const knf_mel_opts *opts,
+    const knf_frame_opts *frame_opts, const float *vtln_warps,
+    int32_t num_warps, knf_mel_banks **banks, int32_t *bin_begin,
+    int32_t *bin_end);
+void knf_mel_warps_release(const knf_mel_banks *unwarped,
+                           knf_mel_banks **banks, int32_t num_warps);
+// Reads fft_energies[bin_begin .. bin_end - 1] only.
 void knf_mel_compute(const knf_mel_banks *banks, const float *fft_energies,
                      float *mel_energies_out);
+// knf_mel_compute for count spectra, spectrum i at fft_energies + i * stride
+// and its output at mel_energies_out + i * out_stride. Frames are processed a
+// few at a time against each filter, so every weight loaded is used for all
+// of them; results equal knf_mel_compute's up to rounding.
+void knf_mel_compute_batch(const knf_mel_banks *banks,
+                           const float *fft_energies, int32_t count,
+                           int32_t stride, float *mel_energies_out,
+                           int32_t out_stride);
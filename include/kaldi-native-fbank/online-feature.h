@@ -7,6 +7,8 @@
 #include "kaldi-native-fbank/feature-mfcc.h"
 #include "kaldi-native-fbank/feature-raw-audio-samples.h"
 #include "kaldi-native-fbank/feature-window.h"
+#include "kaldi-native-fbank/resampler.h"
+#include "kaldi-native-fbank/sliding-dft.h"
 #include "kaldi-native-fbank/whisper-feature.h"
 
 typedef enum {
@@ -18,6 +20,12 @@ typedef enum {
 
 typedef void (*knf_compute_fn)(void *computer, float raw_log_energy,
                                float vtln_warp, float *window, float *feature);
+typedef void (*knf_compute_spectrum_fn)(void *computer, float raw_log_energy,
+                                        float vtln_warp, const float *window,
+                                        const float *spectrum, float *feature);
+typedef void (*knf_compute_batch_fn)(void *computer, float vtln_warp,
+                                     knf_frame_matrix *frames,
+                                     float *features);
 typedef const knf_frame_opts *(*knf_frame_fn)(const void *computer);
 typedef int32_t (*knf_dim_fn)(const void *computer);
 typedef bool (*knf_need_raw_energy_fn)(const void *computer);
@@ -26,12 +34,35 @@ typedef struct {
   knf_online_kind kind;
   void *computer;
   knf_compute_fn compute;
+  // Computers with a batched path (fbank, whisper) take all pending frames in
+  // one call when the sliding DFT is not in use; nullptr otherwise.
+  knf_compute_batch_fn compute_batch;
+  float *batch_features;  // [rows][dim] output of compute_batch
+  int32_t batch_features_cap;
   knf_frame_fn frame_opts;
   knf_dim_fn dim;
   knf_need_raw_energy_fn need_raw_energy;
+  // Fbank and MFCC switch to a sliding DFT when the options allow it and it
+  // beats an FFT per frame; nullptr otherwise. Frames that are not entirely
+  // in the waveform buffer, e.g. reflected at the edges, still use the FFT.
+  knf_sliding_dft *sliding;
+  knf_compute_spectrum_fn compute_spectrum;
+  float *spectrum;
+  float *sliding_frame;  // a frame converted to float for the sliding DFT
+
+  // Set by knf_online_set_input_rate; input goes through it into waveform.
+  knf_resampler *resampler;
 
   knf_window window_fn;
-  float *waveform;
+  knf_frame_geometry geometry;  // of the computer's options and window_fn
+  knf_frame_matrix frames;      // reused for the frames of each call
+  // Samples are kept in the format they were accepted in and converted while
+  // frames are extracted. Mixing formats converts the buffer to float32.
+  // Multi-channel input stays interleaved; sizes count samples per channel.
+  void *waveform;
+  knf_sample_format format;
+  int32_t num_channels;
+  bool downmix;  // one feature of the channels' mean instead of one each
   int32_t waveform_size;
   int32_t waveform_cap;
   int64_t waveform_offset;
@@ -52,9 +83,25 @@ typedef struct {
                                              knf_online_feature *out);
 
 void knf_online_feature_destroy(knf_online_feature *f);
+// Accepts input at sampling_rate instead of the frame options' rate from now
+// on, resampling it as it arrives. Must be called before any input.
+[[nodiscard]] bool knf_online_set_input_rate(knf_online_feature *f,
+                                             float sampling_rate);
+// Accepts num_channels interleaved channels from now on. Each frame then has
+// num_channels features of dim floats one after the other, channel 0 first, or
+// a single one of their mean with downmix. Must be called before any input,
+// and cannot be combined with resampling.
+[[nodiscard]] bool knf_online_set_channels(knf_online_feature *f,
+                                           int32_t num_channels, bool downmix);
+// n counts samples per channel.
 [[nodiscard]] bool knf_online_accept_waveform(knf_online_feature *f,
                                               float sampling_rate,
                                               const float *waveform, int32_t n);
+[[nodiscard]] bool knf_online_accept_waveform_typed(knf_online_feature *f,
+                                                    float sampling_rate,
+                                                    const void *waveform,
+                                                    knf_sample_format format,
+                                                    int32_t n);
 [[nodiscard]] bool knf_online_input_finished(knf_online_feature *f);
 int32_t knf_online_num_frames_ready(const knf_online_feature *f);
 const float *knf_online_get_frame(const knf_online_feature *f, int32_t frame);
@@ -0,0 +1,43 @@
+// Streaming polyphase resampler in C23.
+#pragma once
+
+#include <stdint.h>
+
+#include "kaldi-native-fbank/feature-window.h"
+
+// Rational resampling from in_rate to out_rate Hz by up / down, with a
+// Hann-windowed sinc low-pass at 0.99 of the lower Nyquist frequency. The
+// filter is precomputed for each of the up phases, its taps padded to a
+// multiple of 8 so every output is a plain dot product. Samples before the
+// start of the stream and, when flushing, after its end count as zeros.
+typedef struct {
+  int32_t in_rate;
+  int32_t out_rate;
+  int32_t up;
+  int32_t down;
+  int32_t half;     // taps each side of an output; 2 * half are nonzero
+  int32_t taps;     // stride of filters, 2 * half rounded up to 8
+  float *filters;   // [up][taps]
+  float *buffer;    // input samples from buffer_start on
+  int32_t buffer_size;
+  int32_t buffer_cap;
+  int64_t buffer_start;
+  int64_t num_in;   // samples accepted so far
+  int64_t num_out;  // samples produced so far
+  bool flushed;
+} knf_resampler;
+
+// Rates must be positive integers.
+[[nodiscard]] bool knf_resampler_create(int32_t in_rate, int32_t out_rate,
+                                        knf_resampler *out);
+void knf_resampler_destroy(knf_resampler *r);
+// Upper bound on the samples the next knf_resampler_process with n inputs
+// writes, flushing or not; -1 if it does not fit in int32_t.
+int32_t knf_resampler_max_output(const knf_resampler *r, int32_t n);
+// Accepts n samples of input (which may be nullptr if n is 0) and writes the
+// outputs they complete to out, their count to num_out. With flush the
+// stream ends and the remaining outputs are written too.
+[[nodiscard]] bool knf_resampler_process(knf_resampler *r, const void *input,
+                                         knf_sample_format format, int32_t n,
+                                         bool flush, float *out,
+                                         int32_t *num_out);
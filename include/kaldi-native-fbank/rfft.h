@@ -5,16 +5,127 @@
 
 #include <stdint.h>
 
+// Arithmetic used by the transform. Float runs pocketfft's single-precision
+// engine directly on the caller's buffer; double widens every frame into a
+// scratch buffer and is kept as the high-accuracy reference.
+typedef enum {
+  KNF_RFFT_FLOAT = 0,
+  KNF_RFFT_DOUBLE = 1,
+} knf_rfft_precision;
+
+// Instruction set behind the float transform's radix passes; values match
+// pocketfft_isa. Plans pick the widest one the CPU supports whose vector width
+// divides n, and fall back to the portable scalar passes otherwise.
+typedef enum {
+  KNF_FFT_ISA_AUTO = -1,
+  KNF_FFT_ISA_SCALAR = 0,
+  KNF_FFT_ISA_SSE2 = 1,
+  KNF_FFT_ISA_AVX2 = 2,
+  KNF_FFT_ISA_AVX512 = 3,
+  KNF_FFT_ISA_NEON = 4,
+} knf_fft_isa;
+
 typedef struct {
   int32_t n;
   bool inverse;
   float scale;
+  knf_rfft_precision precision;
+  knf_fft_isa isa;  // KNF_FFT_ISA_SCALAR for KNF_RFFT_DOUBLE
+  int32_t nonzero;  // forward input from here on is taken as zero; n if none
+  bool codelet;     // single transforms run a size-specialized codelet
   void *plan;
-  float *work;  // size n
 } knf_rfft;
 
+// Same as knf_rfft_create_with_precision(n, inverse, KNF_RFFT_FLOAT).
 [[nodiscard]] knf_rfft *knf_rfft_create(int32_t n,
                                         bool inverse);  // Owning pointer, or
                                                         // nullptr.
+// Lengths with a large prime factor need Bluestein's algorithm, which only
+// exists in double precision; such plans silently use KNF_RFFT_DOUBLE.
+[[nodiscard]] knf_rfft *knf_rfft_create_with_precision(
+    int32_t n, bool inverse,
+    knf_rfft_precision precision);  // Owning pointer, or nullptr.
+// Forward float plan for frames zero-padded from nonzero samples up to n,
+// e.g. a 400-sample window in a 512-point FFT. The transforms never read
+// in_out[nonzero .. n-1], so callers need not clear it, and the first FFT
+// stage skips the work the zero tail would feed. Requires 0 < nonzero <= n.
+[[nodiscard]] knf_rfft *knf_rfft_create_pruned(
+    int32_t n, int32_t nonzero);  // Owning pointer, or nullptr.
 void knf_rfft_destroy(knf_rfft *fft);
-[[nodiscard]] bool knf_rfft_compute(knf_rfft *fft, float *in_out);
+// Widest instruction set this build and CPU can run.
+knf_fft_isa knf_fft_best_isa(void);
+bool knf_fft_isa_supported(knf_fft_isa isa);
+// Caps the instruction set of plans created afterwards, e.g. to compare the
+// kernels against each other in tests; KNF_FFT_ISA_AUTO restores detection.
+// Returns false, and changes nothing, if the CPU cannot run isa.
+bool knf_rfft_force_isa(knf_fft_isa isa);
+// Float plans of n = 256, 320, 400 and 512 run codelets: FFT passes
+// specialized for that size, with constant twiddle tables. Other sizes use the
+// generic passes. Disabling codelets affects plans created afterwards and
+// gives the same results, e.g. to check the codelets in tests: bit-identical
+// unless the compiler contracts multiply-adds (-ffp-contract), and otherwise
+// within rounding.
+void knf_rfft_enable_codelets(bool enabled);
+// A plan never changes after creation: the compute functions only read it, so
+// any number of threads may share one plan per size. Each call needs scratch
+// memory, which the *_with_scratch variants take from the caller, e.g. one
+// buffer per thread, and the others allocate per call. Scratch must hold
+// knf_rfft_scratch_size(fft) bytes (knf_rfft_batch_scratch_size(fft) for
+// batches) and be aligned for double, as malloc'ed memory is.
+size_t knf_rfft_scratch_size(const knf_rfft *fft);
+size_t knf_rfft_batch_scratch_size(const knf_rfft *fft);
+// How knf_rfft_create picks a float plan's variant: its instruction set,
+// codelets on or off, and the order of its radix passes.
+typedef enum {
+  // The widest instruction set with codelets, unless wisdom says otherwise.
+  KNF_RFFT_ESTIMATE = 0,
+  // Times every variant the first time a transform is planned, which takes a
+  // few milliseconds, and records the fastest as wisdom.
+  KNF_RFFT_MEASURE = 1,
+} knf_rfft_planning;
+// Affects plans created afterwards; KNF_RFFT_ESTIMATE is the default.
+void knf_rfft_set_planning(knf_rfft_planning planning);
+// Wisdom holds the fastest variant per (n, nonzero, direction) for the whole
+// process. Exporting writes it to a text file that later processes import at
+// startup instead of measuring again; entries for instruction sets the CPU
+// lacks are ignored. Plans follow the wisdom only while no ISA is forced and
+// codelets are enabled. Import returns false if the file cannot be read or is
+// malformed.
+bool knf_rfft_export_wisdom(const char *path);
+bool knf_rfft_import_wisdom(const char *path);
+void knf_rfft_forget_wisdom(void);
+// Plans are cached: creating one like a live or recently destroyed plan shares
+// its tables instead of building them again, so e.g. knf_stft_compute only
+// plans its size once. Frees the cached plans no knf_rfft refers to.
+void knf_rfft_clear_plan_cache(void);
+// Forward output and inverse input use Kaldi's packed layout:
+// [Re X0, Re X(n/2), Re X1, Im X1, ..., Re X(n/2-1), Im X(n/2-1)].
+[[nodiscard]] bool knf_rfft_compute(const knf_rfft *fft, float *in_out);
+[[nodiscard]] bool knf_rfft_compute_with_scratch(const knf_rfft *fft,
+                                                 float *in_out, void *scratch);
+// Forward transform that writes the power spectrum |X_k|^2 (or |X_k| when
+// magnitude is true), k = 0 .. n/2, to in_out[0 .. n/2]. The spectrum comes
+// straight out of the final FFT stage; no packed complex output is produced.
+// Fails on inverse plans.
+[[nodiscard]] bool knf_rfft_compute_power(const knf_rfft *fft, float *in_out,
+                                          bool magnitude);
+// Same, but only bins begin <= k < end (0 <= begin < end <= n/2 + 1) are
+// computed and stored to in_out[begin .. end-1]; the rest of in_out is left
+// unspecified. Feature computers pass the passband of their mel banks.
+[[nodiscard]] bool knf_rfft_compute_power_range(const knf_rfft *fft,
+                                                float *in_out, bool magnitude,
+                                                int32_t begin, int32_t end);
+[[nodiscard]] bool knf_rfft_compute_power_range_with_scratch(
+    const knf_rfft *fft, float *in_out, bool magnitude, int32_t begin,
+    int32_t end, void *scratch);
+// Transforms count frames in place, frame i starting at frames + i * stride
+// (stride >= n). Same-size frames are interleaved so that every SIMD lane
+// transforms a different frame, which beats calling knf_rfft_compute in a
+// loop whenever several frames are pending at once.
+[[nodiscard]] bool knf_rfft_compute_batch(const knf_rfft *fft, float *frames,
+                                          int32_t count, int32_t stride);
+[[nodiscard]] bool knf_rfft_compute_batch_with_scratch(const knf_rfft *fft,
+                                                       float *frames,
+                                                       int32_t count,
+                                                       int32_t stride,
+                                                       void *scratch);
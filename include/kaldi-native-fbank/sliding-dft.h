@@ -0,0 +1,74 @@
+// Sliding-DFT spectrum engine in C23.
+#pragma once
+
+#include <stdint.h>
+
+#include "kaldi-native-fbank/feature-window.h"
+#include "kaldi-native-fbank/rfft.h"
+
+// Spectrum engine of the online fbank and MFCC extractors. AUTO takes the
+// sliding DFT where knf_sliding_dft_cheaper predicts a win; its cost model is
+// a rough fit, so callers who measured otherwise can force either engine.
+// SLIDING fails extractor creation unless knf_sliding_dft_supported holds.
+typedef enum {
+  KNF_SPECTRUM_AUTO = 0,
+  KNF_SPECTRUM_FFT = 1,
+  KNF_SPECTRUM_SLIDING = 2,
+} knf_spectrum_engine;
+
+// Spectrum of consecutive frames updated from the previous frame: every
+// window that is a sum of cosines (rectangular, hanning, hann, hamming,
+// blackman) turns the windowed DFT into a few unwindowed DFTs at shifted
+// frequencies, and those slide by one sample in O(1) per bin. Costs
+// O(shift * bins) per frame against O(n log n) for an FFT, so it only pays off
+// for very small frame shifts. Every few thousand samples, and whenever frames
+// are not consecutive, the state is recomputed from scratch with FFTs to bound
+// the drift.
+typedef struct {
+  int32_t size;    // window size
+  int32_t padded;  // FFT size the bins refer to
+  int32_t shift;
+  int32_t bin_begin;
+  int32_t bin_end;
+  int32_t num_terms;    // cosines in the window, 1 to 3
+  double coeffs[3];     // window = sum_m coeffs[m] cos(2 pi m t / period)
+  double period;
+  bool remove_dc_offset;
+  bool magnitude;
+  // Trackers, [2 * num_terms - 1][bins]: the DFT at bin k shifted by
+  // 0, +1/period, -1/period, +2/period, ... cycles per sample.
+  double *re, *im;
+  double *step_re, *step_im;  // exp(2 pi i f)
+  double *tail_re, *tail_im;  // exp(-2 pi i f size)
+  double *window_re, *window_im;  // DFT of the window, for the DC offset
+  double sum;                     // of the frame's samples
+  float *frame;                   // raw samples of the last frame
+  int64_t frame_start;            // of the last frame; -1 before the first
+  int64_t slid;                   // samples slid since the last anchor
+  knf_rfft *fft;                  // double precision, for anchoring
+  float *buffer;                  // padded floats
+} knf_sliding_dft;
+
+// Whether the frame options allow sliding at all: no dither, no
+// pre-emphasis, and a cosine-sum window.
+bool knf_sliding_dft_supported(const knf_frame_opts *opts);
+// Whether sliding is supported and expected to beat the FFT for bins
+// [bin_begin, bin_end).
+bool knf_sliding_dft_cheaper(const knf_frame_opts *opts, int32_t bin_begin,
+                             int32_t bin_end);
+// Writes |X_k|^2 (|X_k| if magnitude) of the processed, windowed frame for
+// bin_begin <= k < bin_end, as knf_rfft_compute_power_range would.
+[[nodiscard]] bool knf_sliding_dft_create(const knf_frame_opts *opts,
+                                          int32_t bin_begin, int32_t bin_end,
+                                          bool magnitude,
+                                          knf_sliding_dft *out);
+void knf_sliding_dft_destroy(knf_sliding_dft *s);
+// Forgets the last frame, so the next one is anchored.
+void knf_sliding_dft_reset(knf_sliding_dft *s);
+// frame holds the size raw samples (before any processing) starting at sample
+// frame_start of the stream; spectrum receives bins [bin_begin, bin_end) at
+// their own indices.
+[[nodiscard]] bool knf_sliding_dft_compute(knf_sliding_dft *s,
+                                           int64_t frame_start,
+                                           const float *frame,
+                                           float *spectrum);
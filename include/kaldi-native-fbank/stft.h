@@ -27,4 +27,10 @@ void knf_stft_config_default(knf_stft_config *cfg);
 [[nodiscard]] bool knf_stft_compute(const knf_stft_config *cfg,
                                     const float *data, int32_t n,
                                     knf_stft_result *out);
+// Same, for samples in any knf_sample_format; they are converted while being
+// padded.
+[[nodiscard]] bool knf_stft_compute_typed(const knf_stft_config *cfg,
+                                          const void *samples,
+                                          knf_sample_format format, int32_t n,
+                                          knf_stft_result *out);
 void knf_stft_result_free(knf_stft_result *res);
@@ -14,8 +14,10 @@ typedef struct {
 
 typedef struct {
   knf_whisper_opts opts;
+  knf_frame_geometry geometry;
   knf_mel_banks *mel_banks;
   knf_rfft *rfft;
+  void *rfft_scratch;  // knf_rfft_scratch_size(rfft) bytes
 } knf_whisper_computer;
 
 void knf_whisper_opts_default(knf_whisper_opts *opts);
@@ -27,3 +29,7 @@ int32_t knf_whisper_dim(const knf_whisper_computer *c);
 bool knf_whisper_need_raw_log_energy(const knf_whisper_computer *c);
 void knf_whisper_compute(knf_whisper_computer *c, float signal_raw_log_energy,
                          float vtln_warp, float *signal_frame, float *feature);
+// knf_whisper_compute for every row of frames, row i's feature going to
+// features + i * knf_whisper_dim(c); the rows are overwritten.
+void knf_whisper_compute_batch(knf_whisper_computer *c, float vtln_warp,
+                               knf_frame_matrix *frames, float *features);
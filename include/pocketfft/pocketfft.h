@@ -33,3 +33,89 @@ void destroy_rfft_plan(rfft_plan plan);
 [[nodiscard]] int rfft_backward(rfft_plan plan, double c[], double fct);
 [[nodiscard]] int rfft_forward(rfft_plan plan, double c[], double fct);
 [[nodiscard]] size_t rfft_length(rfft_plan plan);
+
+/* Instruction sets the single-precision real FFT can dispatch to. */
+typedef enum {
+  POCKETFFT_ISA_SCALAR = 0,
+  POCKETFFT_ISA_SSE2 = 1,
+  POCKETFFT_ISA_AVX2 = 2,
+  POCKETFFT_ISA_AVX512 = 3,
+  POCKETFFT_ISA_NEON = 4,
+} pocketfft_isa;
+/* Widest instruction set supported by both this build and the running CPU. */
+pocketfft_isa pocketfft_best_isa(void);
+/* Order of the radix passes. The default puts a factor 2 first, then the 4s,
+ * then the odd factors in ascending order; the others permute the even and
+ * the odd factors among themselves, which gives the same transform with
+ * different memory access patterns. */
+typedef enum {
+  POCKETFFT_ORDER_DEFAULT = 0,
+  POCKETFFT_ORDER_REVERSED = 1,
+  POCKETFFT_ORDER_TWO_LAST = 2, /* the leading 2 moved behind the 4s */
+} pocketfft_order;
+
+struct rfftf_plan_i;
+typedef struct rfftf_plan_i *rfftf_plan;
+/* Single-precision packed real FFT; same data layout as rfft_forward and
+ * rfft_backward. Returns an owning plan, or nullptr if the length has a prime
+ * factor large enough to need Bluestein's algorithm, which only exists in
+ * double precision. Caller must release with destroy_rfftf_plan.
+ * make_rfftf_plan picks the widest kernel the CPU supports whose vector width
+ * divides the length; make_rfftf_plan_isa never picks one wider than isa
+ * (POCKETFFT_ISA_SCALAR forces the portable passes). */
+[[nodiscard]] rfftf_plan make_rfftf_plan(size_t length);
+[[nodiscard]] rfftf_plan make_rfftf_plan_isa(size_t length,
+                                             pocketfft_isa isa);
+/* Forward plan for input that is known to be zero from c[nonzero] on, such
+ * as a zero-padded frame: the forward transforms never read that tail, and
+ * the first radix-2/4 pass skips the butterflies it would feed. Backward
+ * transforms are unaffected. */
+[[nodiscard]] rfftf_plan make_rfftf_plan_pruned(size_t length, size_t nonzero,
+                                                pocketfft_isa isa);
+/* Same with the passes in the given order. Only the default order has
+ * codelets. */
+[[nodiscard]] rfftf_plan make_rfftf_plan_order(size_t length, size_t nonzero,
+                                               pocketfft_isa isa,
+                                               pocketfft_order order);
+/* Instruction set the plan actually runs on. */
+[[nodiscard]] pocketfft_isa rfftf_isa(rfftf_plan plan);
+/* Plans of the lengths 256, 320, 400 and 512 run codelets: pass sequences
+ * specialized at compile time, with constant twiddle tables. Disabling them
+ * selects the generic passes, which produce bit-identical results unless
+ * the compiler contracts multiply-adds, and results within rounding if so.
+ * rfftf_codelet tells whether single transforms of plan run a codelet. */
+void rfftf_set_codelets(rfftf_plan plan, bool enabled);
+[[nodiscard]] bool rfftf_codelet(rfftf_plan plan);
+void destroy_rfftf_plan(rfftf_plan plan);
+/* The transforms below only read the plan, so threads may share one, and work
+ * in scratch: rfftf_scratch_size(plan) floats for single transforms,
+ * rfftf_batch_scratch_size(plan) for batches. A null scratch is allocated and
+ * freed per call instead. */
+[[nodiscard]] size_t rfftf_scratch_size(rfftf_plan plan);
+[[nodiscard]] size_t rfftf_batch_scratch_size(rfftf_plan plan);
+[[nodiscard]] int rfftf_backward(rfftf_plan plan, float c[], float fct,
+                                 float scratch[]);
+[[nodiscard]] int rfftf_forward(rfftf_plan plan, float c[], float fct,
+                                float scratch[]);
+[[nodiscard]] size_t rfftf_length(rfftf_plan plan);
+/* Forward transform of an even length that leaves |X_k|^2 (|X_k| if magnitude
+ * is true) for k = 0 .. length/2 in c[0 .. length/2] instead of the packed
+ * coefficients, computed straight from the final pass. */
+[[nodiscard]] int rfftf_forward_power(rfftf_plan plan, float c[], float fct,
+                                      bool magnitude, float scratch[]);
+/* Same, but only bins begin <= k < end are computed and stored, to
+ * c[begin .. end - 1]; the rest of c is left unspecified. */
+[[nodiscard]] int rfftf_forward_power_range(rfftf_plan plan, float c[],
+                                            float fct, bool magnitude,
+                                            size_t begin, size_t end,
+                                            float scratch[]);
+/* Transforms count frames of rfftf_length(plan) floats, frame i starting at
+ * c + i * stride (stride >= length). Frames are interleaved so that every
+ * vector lane handles a different frame; frames left over after the last full
+ * vector are transformed one at a time. */
+[[nodiscard]] int rfftf_backward_batch(rfftf_plan plan, float c[],
+                                       size_t count, size_t stride, float fct,
+                                       float scratch[]);
+[[nodiscard]] int rfftf_forward_batch(rfftf_plan plan, float c[], size_t count,
+                                      size_t stride, float fct,
+                                      float scratch[]);
@@ -1,10 +1,10 @@
 // Fbank computation in C23.
 
 #include <math.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "kaldi-native-fbank/feature-fbank.h"
-#include "kaldi-native-fbank/feature-functions.h"
 #include "kaldi-native-fbank/kaldi-math.h"
 
 void knf_fbank_opts_default(knf_fbank_opts *opts) {
@@ -16,6 +16,8 @@ void knf_fbank_opts_default(knf_fbank_opts *opts) {
   opts->energy_floor = 0.0f;
   opts->use_log_fbank = true;
   opts->use_power = true;
+  opts->fast_log = false;
+  opts->spectrum_engine = KNF_SPECTRUM_AUTO;
 }
 
 [[nodiscard]] bool knf_fbank_computer_create(const knf_fbank_opts *opts,
@@ -31,13 +33,17 @@ void knf_fbank_opts_default(knf_fbank_opts *opts) {
   } else {
     out->log_energy_floor = -1e10f;
   }
-  int32_t n_fft = knf_padded_window_size(&opts->frame_opts);
-  out->rfft = knf_rfft_create(n_fft, false);
+  if (!knf_frame_geometry_init(&opts->frame_opts, nullptr, &out->geometry)) {
+    return false;
+  }
+  // Frames are zero-padded from the window size up to n_fft.
+  out->rfft = knf_rfft_create_pruned(out->geometry.padded, out->geometry.size);
   if (!out->rfft) return false;
+  out->rfft_scratch = malloc(knf_rfft_scratch_size(out->rfft));
   out->mel_banks =
       knf_mel_banks_create(&opts->mel_opts, &opts->frame_opts, 1.0f);
-  if (!out->mel_banks) {
-    knf_rfft_destroy(out->rfft);
+  if (!out->rfft_scratch || !out->mel_banks) {
+    knf_fbank_computer_destroy(out);
     return false;
   }
   return true;
@@ -46,7 +52,9 @@ void knf_fbank_opts_default(knf_fbank_opts *opts) {
 void knf_fbank_computer_destroy(knf_fbank_computer *c) {
   if (!c) return;
   knf_rfft_destroy(c->rfft);
+  free(c->rfft_scratch);
   knf_mel_banks_destroy(c->mel_banks);
+  knf_mel_warped_release(&c->warped);
 }
 
 const knf_frame_opts *knf_fbank_frame_opts(const knf_fbank_computer *c) {
@@ -70,54 +78,182 @@ bool knf_fbank_need_raw_log_energy(const knf_fbank_computer *c) {
   return c->opts.use_energy && c->opts.raw_energy;
 }
 
+// In-place log of n energies floored at 1e-20.
+static void knf_fbank_log(const knf_fbank_computer *c, float *x, int32_t n) {
+  if (c->opts.fast_log) {
+    knf_log_floor_fast(x, n, 1e-20f);
+  } else {
+    knf_log_floor(x, n, 1e-20f);
+  }
+}
+
+// Log energy of the processed frame unless the caller passed the raw one.
+static float knf_fbank_log_energy(const knf_fbank_computer *c,
+                                  float signal_raw_log_energy,
+                                  const float *signal_frame) {
+  const knf_fbank_opts *opts = &c->opts;
+  if (opts->use_energy && !opts->raw_energy) {
+    float energy =
+        knf_inner_product(signal_frame, signal_frame, c->geometry.padded);
+    knf_fbank_log(c, &energy, 1);
+    return energy;
+  }
+  return signal_raw_log_energy;
+}
+
+static int32_t knf_fbank_mel_offset(const knf_fbank_computer *c) {
+  return (c->opts.use_energy && !c->opts.htk_compat) ? 1 : 0;
+}
+
+static int32_t knf_fbank_energy_index(const knf_fbank_computer *c) {
+  return c->opts.htk_compat ? c->opts.mel_opts.num_bins : 0;
+}
+
+// Log of the mel energies already in feature, and the energy coefficient.
+static void knf_fbank_post(const knf_fbank_computer *c, float log_energy,
+                           float *feature) {
+  const knf_fbank_opts *opts = &c->opts;
+  float *mel_out = feature + knf_fbank_mel_offset(c);
+  if (opts->use_log_fbank) {
+    knf_fbank_log(c, mel_out, opts->mel_opts.num_bins);
+  }
+
+  if (opts->use_energy) {
+    if (opts->energy_floor > 0.0f && log_energy < c->log_energy_floor) {
+      log_energy = c->log_energy_floor;
+    }
+    feature[knf_fbank_energy_index(c)] = log_energy;
+  }
+}
+
+// Mel filtering of the spectrum, log, and the energy coefficient.
+static void knf_fbank_finish(const knf_fbank_computer *c,
+                             const knf_mel_banks *banks, float log_energy,
+                             const float *spectrum, float *feature) {
+  knf_mel_compute(banks, spectrum, feature + knf_fbank_mel_offset(c));
+  knf_fbank_post(c, log_energy, feature);
+}
+
 void knf_fbank_compute(knf_fbank_computer *c, float signal_raw_log_energy,
-                       [[maybe_unused]] float vtln_warp, float *signal_frame,
-                       float *feature) {
+                       float vtln_warp, float *signal_frame, float *feature) {
   if (c == nullptr || signal_frame == nullptr || feature == nullptr ||
       c->rfft == nullptr || c->mel_banks == nullptr) {
     return;
   }
 
   const knf_fbank_opts *opts = &c->opts;
-  int32_t padded = knf_padded_window_size(&opts->frame_opts);
   int32_t feature_dim = knf_fbank_dim(c);
-  if (padded <= 0 || feature_dim <= 0) {
-    return;
-  }
 
-  if (opts->use_energy && !opts->raw_energy) {
-    float energy = knf_inner_product(signal_frame, signal_frame, padded);
-    if (energy < 1e-20f) energy = 1e-20f;
-    signal_raw_log_energy = logf(energy);
+  float log_energy =
+      knf_fbank_log_energy(c, signal_raw_log_energy, signal_frame);
+  const knf_mel_banks *banks =
+      knf_mel_warped_get(&c->warped, c->mel_banks, &c->opts.mel_opts,
+                         &c->opts.frame_opts, vtln_warp);
+  // Only the bins some mel filter reads are computed.
+  if (banks == nullptr ||
+      !knf_rfft_compute_power_range_with_scratch(
+          c->rfft, signal_frame, !opts->use_power, banks->bin_begin,
+          banks->bin_end, c->rfft_scratch)) {
+    memset(feature, 0, sizeof(float) * (size_t)feature_dim);
+    return;
   }
+  knf_fbank_finish(c, banks, log_energy, signal_frame, feature);
+}
 
-  if (!knf_rfft_compute(c->rfft, signal_frame)) {
-    memset(feature, 0, sizeof(float) * (size_t)feature_dim);
+void knf_fbank_compute_spectrum(knf_fbank_computer *c,
+                                float signal_raw_log_energy, float vtln_warp,
+                                const float *signal_frame,
+                                const float *spectrum, float *feature) {
+  if (c == nullptr || signal_frame == nullptr || spectrum == nullptr ||
+      feature == nullptr || c->mel_banks == nullptr) {
     return;
   }
-  knf_compute_power_spectrum(signal_frame, padded);
-  if (!opts->use_power) {
-    knf_sqrt_inplace(signal_frame, padded / 2 + 1);
+  const knf_mel_banks *banks =
+      knf_mel_warped_get(&c->warped, c->mel_banks, &c->opts.mel_opts,
+                         &c->opts.frame_opts, vtln_warp);
+  if (banks == nullptr) {
+    memset(feature, 0, sizeof(float) * (size_t)knf_fbank_dim(c));
+    return;
   }
+  knf_fbank_finish(
+      c, banks, knf_fbank_log_energy(c, signal_raw_log_energy, signal_frame),
+      spectrum, feature);
+}
 
-  int32_t mel_offset = (opts->use_energy && !opts->htk_compat) ? 1 : 0;
-  float *mel_out = feature + mel_offset;
-  knf_mel_compute(c->mel_banks, signal_frame, mel_out);
-
-  if (opts->use_log_fbank) {
-    for (int32_t i = 0; i < opts->mel_opts.num_bins; ++i) {
-      float v = mel_out[i];
-      if (v < 1e-20f) v = 1e-20f;
-      mel_out[i] = logf(v);
+// Features of the frames for each of num_warps banks, which read FFT bins
+// [bin_begin, bin_end) between them; false if a transform fails.
+static bool knf_fbank_compute_banks(const knf_fbank_computer *c,
+                                    knf_mel_banks *const *banks,
+                                    int32_t num_warps, int32_t bin_begin,
+                                    int32_t bin_end, knf_frame_matrix *frames,
+                                    float *features) {
+  const knf_fbank_opts *opts = &c->opts;
+  int32_t dim = knf_fbank_dim(c);
+  size_t block = (size_t)dim * (size_t)frames->rows;
+  for (int32_t i = 0; i < frames->rows; ++i) {
+    float *row = frames->data + (size_t)i * (size_t)frames->stride;
+    frames->log_energies[i] =
+        knf_fbank_log_energy(c, frames->log_energies[i], row);
+    if (!knf_rfft_compute_power_range_with_scratch(
+            c->rfft, row, !opts->use_power, bin_begin, bin_end,
+            c->rfft_scratch)) {
+      return false;
     }
   }
-
-  if (opts->use_energy) {
-    if (opts->energy_floor > 0.0f &&
-        signal_raw_log_energy < c->log_energy_floor) {
-      signal_raw_log_energy = c->log_energy_floor;
+  for (int32_t k = 0; k < num_warps; ++k) {
+    float *out = features + (size_t)k * block;
+    knf_mel_compute_batch(banks[k], frames->data, frames->rows,
+                          frames->stride, out + knf_fbank_mel_offset(c), dim);
+    for (int32_t i = 0; i < frames->rows; ++i) {
+      knf_fbank_post(c, frames->log_energies[i], out + (size_t)i * dim);
     }
-    int32_t energy_index = opts->htk_compat ? opts->mel_opts.num_bins : 0;
-    feature[energy_index] = signal_raw_log_energy;
+  }
+  return true;
+}
+
+// A single warp goes through the computer's held banks, so batches at one
+// warp neither allocate nor touch the shared cache.
+void knf_fbank_compute_batch(knf_fbank_computer *c, float vtln_warp,
+                             knf_frame_matrix *frames, float *features) {
+  if (c == nullptr || frames == nullptr || frames->data == nullptr ||
+      features == nullptr || c->rfft == nullptr || c->mel_banks == nullptr) {
+    return;
+  }
+  knf_mel_banks *banks = (knf_mel_banks *)knf_mel_warped_get(
+      &c->warped, c->mel_banks, &c->opts.mel_opts, &c->opts.frame_opts,
+      vtln_warp);
+  if (banks == nullptr ||
+      !knf_fbank_compute_banks(c, &banks, 1, banks->bin_begin, banks->bin_end,
+                               frames, features)) {
+    memset(features, 0,
+           sizeof(float) * (size_t)knf_fbank_dim(c) * (size_t)frames->rows);
+  }
+}
+
+void knf_fbank_compute_warps(knf_fbank_computer *c, const float *vtln_warps,
+                             int32_t num_warps, knf_frame_matrix *frames,
+                             float *features) {
+  if (c == nullptr || vtln_warps == nullptr || num_warps <= 0 ||
+      frames == nullptr || frames->data == nullptr || features == nullptr ||
+      c->rfft == nullptr || c->mel_banks == nullptr) {
+    return;
+  }
+  size_t block = (size_t)knf_fbank_dim(c) * (size_t)frames->rows;
+  auto banks = (knf_mel_banks **)calloc((size_t)num_warps,
+                                        sizeof(knf_mel_banks *));
+  int32_t bin_begin = 0;
+  int32_t bin_end = 0;
+  bool ok = banks != nullptr &&
+            knf_mel_warps_acquire(c->mel_banks, &c->opts.mel_opts,
+                                  &c->opts.frame_opts, vtln_warps, num_warps,
+                                  banks, &bin_begin, &bin_end);
+  if (ok) {
+    ok = knf_fbank_compute_banks(c, banks, num_warps, bin_begin, bin_end,
+                                 frames, features);
+    knf_mel_warps_release(c->mel_banks, banks, num_warps);
+  }
+  free(banks);
+  if (!ok) {
+    memset(features, 0, sizeof(float) * block * (size_t)num_warps);
   }
 }
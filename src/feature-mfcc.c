@@ -4,7 +4,6 @@
 #include <stdlib.h>
 #include <string.h>
 
-#include "kaldi-native-fbank/feature-functions.h"
 #include "kaldi-native-fbank/feature-mfcc.h"
 #include "kaldi-native-fbank/kaldi-math.h"
 
@@ -43,6 +42,8 @@ void knf_mfcc_opts_default(knf_mfcc_opts *opts) {
   opts->raw_energy = true;
   opts->htk_compat = false;
   opts->energy_floor = 0.0f;
+  opts->fast_log = false;
+  opts->spectrum_engine = KNF_SPECTRUM_AUTO;
 }
 
 [[nodiscard]] bool knf_mfcc_computer_create(const knf_mfcc_opts *opts,
@@ -54,13 +55,17 @@ void knf_mfcc_opts_default(knf_mfcc_opts *opts) {
 
   memset(out, 0, sizeof(*out));
   out->opts = *opts;
-  int32_t n_fft = knf_padded_window_size(&opts->frame_opts);
-  out->rfft = knf_rfft_create(n_fft, false);
+  if (!knf_frame_geometry_init(&opts->frame_opts, nullptr, &out->geometry)) {
+    return false;
+  }
+  // Frames are zero-padded from the window size up to n_fft.
+  out->rfft = knf_rfft_create_pruned(out->geometry.padded, out->geometry.size);
   if (!out->rfft) return false;
+  out->rfft_scratch = malloc(knf_rfft_scratch_size(out->rfft));
   out->mel_banks =
       knf_mel_banks_create(&opts->mel_opts, &opts->frame_opts, 1.0f);
-  if (!out->mel_banks) {
-    knf_rfft_destroy(out->rfft);
+  if (!out->rfft_scratch || !out->mel_banks) {
+    knf_mfcc_computer_destroy(out);
     return false;
   }
   out->mel_energies =
@@ -98,8 +103,11 @@ void knf_mfcc_computer_destroy(knf_mfcc_computer *c) {
   if (!c) return;
   knf_rfft_destroy(c->rfft);
   c->rfft = nullptr;
+  free(c->rfft_scratch);
+  c->rfft_scratch = nullptr;
   knf_mel_banks_destroy(c->mel_banks);
   c->mel_banks = nullptr;
+  knf_mel_warped_release(&c->warped);
   free(c->mel_energies);
   c->mel_energies = nullptr;
   free(c->dct_matrix);
@@ -129,38 +137,36 @@ bool knf_mfcc_need_raw_log_energy(const knf_mfcc_computer *c) {
   return c->opts.use_energy && c->opts.raw_energy;
 }
 
-void knf_mfcc_compute(knf_mfcc_computer *c, float signal_raw_log_energy,
-                      [[maybe_unused]] float vtln_warp, float *signal_frame,
-                      float *feature) {
-  if (c == nullptr || signal_frame == nullptr || feature == nullptr ||
-      c->rfft == nullptr || c->mel_banks == nullptr ||
-      c->mel_energies == nullptr || c->dct_matrix == nullptr) {
-    return;
+// In-place log of n energies floored at 1e-20.
+static void knf_mfcc_log(const knf_mfcc_computer *c, float *x, int32_t n) {
+  if (c->opts.fast_log) {
+    knf_log_floor_fast(x, n, 1e-20f);
+  } else {
+    knf_log_floor(x, n, 1e-20f);
   }
+}
 
+// Log energy of the processed frame unless the caller passed the raw one.
+static float knf_mfcc_log_energy(const knf_mfcc_computer *c,
+                                 float signal_raw_log_energy,
+                                 const float *signal_frame) {
   const knf_mfcc_opts *opts = &c->opts;
-  int32_t padded = knf_padded_window_size(&opts->frame_opts);
-  int32_t dim = knf_mfcc_dim(c);
-  if (padded <= 0 || dim <= 0) {
-    return;
-  }
   if (opts->use_energy && !opts->raw_energy) {
-    float energy = knf_inner_product(signal_frame, signal_frame, padded);
-    if (energy < 1e-20f) energy = 1e-20f;
-    signal_raw_log_energy = logf(energy);
+    float energy =
+        knf_inner_product(signal_frame, signal_frame, c->geometry.padded);
+    knf_mfcc_log(c, &energy, 1);
+    return energy;
   }
+  return signal_raw_log_energy;
+}
 
-  if (!knf_rfft_compute(c->rfft, signal_frame)) {
-    memset(feature, 0, sizeof(float) * (size_t)dim);
-    return;
-  }
-  knf_compute_power_spectrum(signal_frame, padded);
-  knf_mel_compute(c->mel_banks, signal_frame, c->mel_energies);
-  for (int32_t i = 0; i < opts->mel_opts.num_bins; ++i) {
-    float v = c->mel_energies[i];
-    if (v < 1e-20f) v = 1e-20f;
-    c->mel_energies[i] = logf(v);
-  }
+// Mel filtering of the power spectrum, log, DCT, liftering and energy.
+static void knf_mfcc_finish(knf_mfcc_computer *c, const knf_mel_banks *banks,
+                            float log_energy, const float *spectrum,
+                            float *feature) {
+  const knf_mfcc_opts *opts = &c->opts;
+  knf_mel_compute(banks, spectrum, c->mel_energies);
+  knf_mfcc_log(c, c->mel_energies, opts->mel_opts.num_bins);
 
   for (int32_t i = 0; i < opts->num_ceps; ++i) {
     feature[i] = knf_inner_product(c->dct_matrix + i * opts->mel_opts.num_bins,
@@ -172,11 +178,10 @@ void knf_mfcc_compute(knf_mfcc_computer *c, float signal_raw_log_energy,
     }
   }
   if (opts->use_energy) {
-    if (opts->energy_floor > 0.0f &&
-        signal_raw_log_energy < c->log_energy_floor) {
-      signal_raw_log_energy = c->log_energy_floor;
+    if (opts->energy_floor > 0.0f && log_energy < c->log_energy_floor) {
+      log_energy = c->log_energy_floor;
     }
-    feature[0] = signal_raw_log_energy;
+    feature[0] = log_energy;
   }
   if (opts->htk_compat) {
     float energy = feature[0];
@@ -189,3 +194,90 @@ void knf_mfcc_compute(knf_mfcc_computer *c, float signal_raw_log_energy,
     feature[opts->num_ceps - 1] = energy;
   }
 }
+
+void knf_mfcc_compute(knf_mfcc_computer *c, float signal_raw_log_energy,
+                      float vtln_warp, float *signal_frame, float *feature) {
+  if (c == nullptr || signal_frame == nullptr || feature == nullptr ||
+      c->rfft == nullptr || c->mel_banks == nullptr ||
+      c->mel_energies == nullptr || c->dct_matrix == nullptr) {
+    return;
+  }
+
+  int32_t dim = knf_mfcc_dim(c);
+  float log_energy =
+      knf_mfcc_log_energy(c, signal_raw_log_energy, signal_frame);
+
+  const knf_mel_banks *banks =
+      knf_mel_warped_get(&c->warped, c->mel_banks, &c->opts.mel_opts,
+                         &c->opts.frame_opts, vtln_warp);
+  // Only the bins some mel filter reads are computed.
+  if (banks == nullptr ||
+      !knf_rfft_compute_power_range_with_scratch(
+          c->rfft, signal_frame, false, banks->bin_begin, banks->bin_end,
+          c->rfft_scratch)) {
+    memset(feature, 0, sizeof(float) * (size_t)dim);
+    return;
+  }
+  knf_mfcc_finish(c, banks, log_energy, signal_frame, feature);
+}
+
+void knf_mfcc_compute_spectrum(knf_mfcc_computer *c,
+                               float signal_raw_log_energy, float vtln_warp,
+                               const float *signal_frame,
+                               const float *spectrum, float *feature) {
+  if (c == nullptr || signal_frame == nullptr || spectrum == nullptr ||
+      feature == nullptr || c->mel_banks == nullptr ||
+      c->mel_energies == nullptr || c->dct_matrix == nullptr) {
+    return;
+  }
+  const knf_mel_banks *banks =
+      knf_mel_warped_get(&c->warped, c->mel_banks, &c->opts.mel_opts,
+                         &c->opts.frame_opts, vtln_warp);
+  if (banks == nullptr) {
+    memset(feature, 0, sizeof(float) * (size_t)knf_mfcc_dim(c));
+    return;
+  }
+  knf_mfcc_finish(
+      c, banks, knf_mfcc_log_energy(c, signal_raw_log_energy, signal_frame),
+      spectrum, feature);
+}
+
+void knf_mfcc_compute_warps(knf_mfcc_computer *c, const float *vtln_warps,
+                            int32_t num_warps, knf_frame_matrix *frames,
+                            float *features) {
+  if (c == nullptr || vtln_warps == nullptr || num_warps <= 0 ||
+      frames == nullptr || frames->data == nullptr || features == nullptr ||
+      c->rfft == nullptr || c->mel_banks == nullptr ||
+      c->mel_energies == nullptr || c->dct_matrix == nullptr) {
+    return;
+  }
+  int32_t dim = knf_mfcc_dim(c);
+  size_t block = (size_t)dim * (size_t)frames->rows;
+  auto banks = (knf_mel_banks **)calloc((size_t)num_warps,
+                                        sizeof(knf_mel_banks *));
+  int32_t bin_begin = 0;
+  int32_t bin_end = 0;
+  bool ok = banks != nullptr &&
+            knf_mel_warps_acquire(c->mel_banks, &c->opts.mel_opts,
+                                  &c->opts.frame_opts, vtln_warps, num_warps,
+                                  banks, &bin_begin, &bin_end);
+  const bool held = ok;
+  for (int32_t i = 0; ok && i < frames->rows; ++i) {
+    float *row = frames->data + (size_t)i * (size_t)frames->stride;
+    float log_energy = knf_mfcc_log_energy(c, frames->log_energies[i], row);
+    if (!knf_rfft_compute_power_range_with_scratch(
+            c->rfft, row, false, bin_begin, bin_end, c->rfft_scratch)) {
+      ok = false;
+      break;
+    }
+    for (int32_t k = 0; k < num_warps; ++k) {
+      knf_mfcc_finish(c, banks[k], log_energy, row,
+                      features + (size_t)k * block + (size_t)i * dim);
+    }
+  }
+  if (held) knf_mel_warps_release(c->mel_banks, banks, num_warps);
+  free(banks);
+  if (!ok) {
+    memset(features, 0, sizeof(float) * block * (size_t)num_warps);
+  }
+}
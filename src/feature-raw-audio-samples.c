@@ -14,7 +14,7 @@ void knf_raw_audio_opts_default(knf_raw_audio_opts *opts) {
     return false;
   }
   out->opts = *opts;
-  return true;
+  return knf_frame_geometry_init(&opts->frame_opts, nullptr, &out->geometry);
 }
 
 void knf_raw_audio_computer_destroy(
@@ -32,7 +32,7 @@ int32_t knf_raw_audio_dim(const knf_raw_audio_computer *c) {
   if (c == nullptr) {
     return 0;
   }
-  return knf_padded_window_size(&c->opts.frame_opts);
+  return c->geometry.padded;
 }
 
 bool knf_raw_audio_need_raw_log_energy(
@@ -47,9 +47,5 @@ void knf_raw_audio_compute(knf_raw_audio_computer *c,
   if (c == nullptr || signal_frame == nullptr || feature == nullptr) {
     return;
   }
-  int32_t dim = knf_padded_window_size(&c->opts.frame_opts);
-  if (dim <= 0) {
-    return;
-  }
-  memcpy(feature, signal_frame, sizeof(float) * dim);
+  memcpy(feature, signal_frame, sizeof(float) * c->geometry.padded);
 }
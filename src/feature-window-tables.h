@@ -0,0 +1,270 @@
+// Windows of the standard frame configurations, dumped from knf_make_window.
+// Generated by tools/gen_feature_tables.c (zig build tables); do not edit.
+
+// povey, 400 samples
+static const float knf_window_table_0[400] = {
+    0x0p+0f, 0x1.1607ecp-12f, 0x1.c3a38ap-11f, 0x1.c1dc64p-10f,
+    0x1.6ec474p-9f, 0x1.0bf0e2p-8f, 0x1.6d3a32p-8f, 0x1.da8a76p-8f,
+    0x1.29a816p-7f, 0x1.6b88b6p-7f, 0x1.b2b2bap-7f, 0x1.fef83ap-7f,
+    0x1.281826p-6f, 0x1.531b02p-6f, 0x1.8073d6p-6f, 0x1.b0131ap-6f,
+    0x1.e1ea5cp-6f, 0x1.0af60cp-5f, 0x1.2605ccp-5f, 0x1.421e66p-5f,
+    0x1.5f3a1cp-5f, 0x1.7d5374p-5f, 0x1.9c6526p-5f, 0x1.bc6a2p-5f,
+    0x1.dd5d7ap-5f, 0x1.ff3a7p-5f, 0x1.10fe32p-4f, 0x1.22cf6ap-4f,
+    0x1.350eacp-4f, 0x1.47b9d2p-4f, 0x1.5acebap-4f, 0x1.6e4b56p-4f,
+    0x1.822d98p-4f, 0x1.96737ep-4f, 0x1.ab1b0cp-4f, 0x1.c0224cp-4f,
+    0x1.d5874ep-4f, 0x1.eb4826p-4f, 0x1.00b176p-3f, 0x1.0beae2p-3f,
+    0x1.174f64p-3f, 0x1.22de1p-3f, 0x1.2e95fcp-3f, 0x1.3a7638p-3f,
+    0x1.467dep-3f, 0x1.52ac0ap-3f, 0x1.5effcep-3f, 0x1.6b7846p-3f,
+    0x1.78148cp-3f, 0x1.84d3bcp-3f, 0x1.91b4f2p-3f, 0x1.9eb74ap-3f,
+    0x1.abd9e4p-3f, 0x1.b91bdap-3f, 0x1.c67c4cp-3f, 0x1.d3fa58p-3f,
+    0x1.e1951ep-3f, 0x1.ef4bbcp-3f, 0x1.fd1d54p-3f, 0x1.058482p-2f,
+    0x1.0c86f8p-2f, 0x1.13959ap-2f, 0x1.1aaff8p-2f, 0x1.21d5a6p-2f,
+    0x1.290632p-2f, 0x1.30412ep-2f, 0x1.37862cp-2f, 0x1.3ed4bap-2f,
+    0x1.462c6cp-2f, 0x1.4d8cd4p-2f, 0x1.54f58p-2f, 0x1.5c6606p-2f,
+    0x1.63ddf4p-2f, 0x1.6b5cdep-2f, 0x1.72e254p-2f, 0x1.7a6decp-2f,
+    0x1.81ff36p-2f, 0x1.8995c4p-2f, 0x1.91312ap-2f, 0x1.98d0fap-2f,
+    0x1.a074c8p-2f, 0x1.a81c26p-2f, 0x1.afc6a8p-2f, 0x1.b773e4p-2f,
+    0x1.bf236ap-2f, 0x1.c6d4d2p-2f, 0x1.ce87aep-2f, 0x1.d63b94p-2f,
+    0x1.ddf018p-2f, 0x1.e5a4cep-2f, 0x1.ed595p-2f, 0x1.f50d3p-2f,
+    0x1.fcc004p-2f, 0x1.0238b2p-1f, 0x1.061074p-1f, 0x1.09e712p-1f,
+    0x1.0dbc5ap-1f, 0x1.119016p-1f, 0x1.156214p-1f, 0x1.19321ep-1f,
+    0x1.1d0002p-1f, 0x1.20cb8cp-1f, 0x1.24948ap-1f, 0x1.285acap-1f,
+    0x1.2c1e18p-1f, 0x1.2fde42p-1f, 0x1.339b16p-1f, 0x1.375464p-1f,
+    0x1.3b09f6p-1f, 0x1.3ebbap-1f, 0x1.42693p-1f, 0x1.461272p-1f,
+    0x1.49b73ap-1f, 0x1.4d5754p-1f, 0x1.50f294p-1f, 0x1.5488c8p-1f,
+    0x1.5819c2p-1f, 0x1.5ba552p-1f, 0x1.5f2b4cp-1f, 0x1.62ab7ep-1f,
+    0x1.6625cp-1f, 0x1.6999dep-1f, 0x1.6d07bp-1f, 0x1.706f08p-1f,
+    0x1.73cfbap-1f, 0x1.772998p-1f, 0x1.7a7c78p-1f, 0x1.7dc83p-1f,
+    0x1.810c94p-1f, 0x1.84497ap-1f, 0x1.877eb8p-1f, 0x1.8aac26p-1f,
+    0x1.8dd198p-1f, 0x1.90eee8p-1f, 0x1.9403ecp-1f, 0x1.97107ep-1f,
+    0x1.9a1476p-1f, 0x1.9d0facp-1f, 0x1.a001fcp-1f, 0x1.a2eb4p-1f,
+    0x1.a5cb52p-1f, 0x1.a8a20cp-1f, 0x1.ab6f4ap-1f, 0x1.ae32eap-1f,
+    0x1.b0ecc8p-1f, 0x1.b39ccp-1f, 0x1.b642bp-1f, 0x1.b8de76p-1f,
+    0x1.bb6ff2p-1f, 0x1.bdf7p-1f, 0x1.c07384p-1f, 0x1.c2e55ep-1f,
+    0x1.c54c6cp-1f, 0x1.c7a89p-1f, 0x1.c9f9acp-1f, 0x1.cc3fa6p-1f,
+    0x1.ce7a5cp-1f, 0x1.d0a9b6p-1f, 0x1.d2cd94p-1f, 0x1.d4e5dep-1f,
+    0x1.d6f27ap-1f, 0x1.d8f34ap-1f, 0x1.dae83ap-1f, 0x1.dcd12cp-1f,
+    0x1.deae0cp-1f, 0x1.e07ebep-1f, 0x1.e2433p-1f, 0x1.e3fb48p-1f,
+    0x1.e5a6f2p-1f, 0x1.e74618p-1f, 0x1.e8d8a4p-1f, 0x1.ea5e86p-1f,
+    0x1.ebd7a8p-1f, 0x1.ed43f8p-1f, 0x1.eea364p-1f, 0x1.eff5dcp-1f,
+    0x1.f13b4cp-1f, 0x1.f273a8p-1f, 0x1.f39edcp-1f, 0x1.f4bcdep-1f,
+    0x1.f5cd9ep-1f, 0x1.f6d10cp-1f, 0x1.f7c71ep-1f, 0x1.f8afc8p-1f,
+    0x1.f98afep-1f, 0x1.fa58b6p-1f, 0x1.fb18e4p-1f, 0x1.fbcb7ep-1f,
+    0x1.fc708p-1f, 0x1.fd07dcp-1f, 0x1.fd918ep-1f, 0x1.fe0d8ep-1f,
+    0x1.fe7bd6p-1f, 0x1.fedc62p-1f, 0x1.ff2f2ap-1f, 0x1.ff742ep-1f,
+    0x1.ffab68p-1f, 0x1.ffd4d6p-1f, 0x1.fff076p-1f, 0x1.fffe46p-1f,
+    0x1.fffe46p-1f, 0x1.fff076p-1f, 0x1.ffd4d6p-1f, 0x1.ffab68p-1f,
+    0x1.ff742ep-1f, 0x1.ff2f2ap-1f, 0x1.fedc62p-1f, 0x1.fe7bd6p-1f,
+    0x1.fe0d8ep-1f, 0x1.fd918ep-1f, 0x1.fd07dcp-1f, 0x1.fc708p-1f,
+    0x1.fbcb7ep-1f, 0x1.fb18e4p-1f, 0x1.fa58b6p-1f, 0x1.f98afep-1f,
+    0x1.f8afc8p-1f, 0x1.f7c71ep-1f, 0x1.f6d10cp-1f, 0x1.f5cd9ep-1f,
+    0x1.f4bcdep-1f, 0x1.f39edcp-1f, 0x1.f273a8p-1f, 0x1.f13b4cp-1f,
+    0x1.eff5dcp-1f, 0x1.eea364p-1f, 0x1.ed43f8p-1f, 0x1.ebd7a8p-1f,
+    0x1.ea5e86p-1f, 0x1.e8d8a4p-1f, 0x1.e74618p-1f, 0x1.e5a6f2p-1f,
+    0x1.e3fb48p-1f, 0x1.e2433p-1f, 0x1.e07ebep-1f, 0x1.deae0cp-1f,
+    0x1.dcd12cp-1f, 0x1.dae83ap-1f, 0x1.d8f34ap-1f, 0x1.d6f27ap-1f,
+    0x1.d4e5dep-1f, 0x1.d2cd94p-1f, 0x1.d0a9b6p-1f, 0x1.ce7a5cp-1f,
+    0x1.cc3fa6p-1f, 0x1.c9f9acp-1f, 0x1.c7a89p-1f, 0x1.c54c6cp-1f,
+    0x1.c2e55ep-1f, 0x1.c07384p-1f, 0x1.bdf7p-1f, 0x1.bb6ff2p-1f,
+    0x1.b8de76p-1f, 0x1.b642bp-1f, 0x1.b39ccp-1f, 0x1.b0ecc8p-1f,
+    0x1.ae32eap-1f, 0x1.ab6f4ap-1f, 0x1.a8a20cp-1f, 0x1.a5cb52p-1f,
+    0x1.a2eb4p-1f, 0x1.a001fcp-1f, 0x1.9d0facp-1f, 0x1.9a1476p-1f,
+    0x1.97107ep-1f, 0x1.9403ecp-1f, 0x1.90eee8p-1f, 0x1.8dd198p-1f,
+    0x1.8aac26p-1f, 0x1.877eb8p-1f, 0x1.84497ap-1f, 0x1.810c94p-1f,
+    0x1.7dc83p-1f, 0x1.7a7c78p-1f, 0x1.772998p-1f, 0x1.73cfbap-1f,
+    0x1.706f08p-1f, 0x1.6d07bp-1f, 0x1.6999dep-1f, 0x1.6625cp-1f,
+    0x1.62ab7ep-1f, 0x1.5f2b4cp-1f, 0x1.5ba552p-1f, 0x1.5819c2p-1f,
+    0x1.5488c8p-1f, 0x1.50f294p-1f, 0x1.4d5754p-1f, 0x1.49b73ap-1f,
+    0x1.461272p-1f, 0x1.42693p-1f, 0x1.3ebbap-1f, 0x1.3b09f6p-1f,
+    0x1.375464p-1f, 0x1.339b16p-1f, 0x1.2fde42p-1f, 0x1.2c1e18p-1f,
+    0x1.285acap-1f, 0x1.24948ap-1f, 0x1.20cb8cp-1f, 0x1.1d0002p-1f,
+    0x1.19321ep-1f, 0x1.156214p-1f, 0x1.119016p-1f, 0x1.0dbc5ap-1f,
+    0x1.09e712p-1f, 0x1.061074p-1f, 0x1.0238b2p-1f, 0x1.fcc004p-2f,
+    0x1.f50d3p-2f, 0x1.ed595p-2f, 0x1.e5a4cep-2f, 0x1.ddf018p-2f,
+    0x1.d63b94p-2f, 0x1.ce87aep-2f, 0x1.c6d4d2p-2f, 0x1.bf236ap-2f,
+    0x1.b773e4p-2f, 0x1.afc6a8p-2f, 0x1.a81c26p-2f, 0x1.a074c8p-2f,
+    0x1.98d0fap-2f, 0x1.91312ap-2f, 0x1.8995c4p-2f, 0x1.81ff36p-2f,
+    0x1.7a6decp-2f, 0x1.72e254p-2f, 0x1.6b5cdep-2f, 0x1.63ddf4p-2f,
+    0x1.5c6606p-2f, 0x1.54f58p-2f, 0x1.4d8cd4p-2f, 0x1.462c6cp-2f,
+    0x1.3ed4bap-2f, 0x1.37862cp-2f, 0x1.30412ep-2f, 0x1.290632p-2f,
+    0x1.21d5a6p-2f, 0x1.1aaff8p-2f, 0x1.13959ap-2f, 0x1.0c86f8p-2f,
+    0x1.058482p-2f, 0x1.fd1d54p-3f, 0x1.ef4bbcp-3f, 0x1.e1951ep-3f,
+    0x1.d3fa58p-3f, 0x1.c67c4cp-3f, 0x1.b91bdap-3f, 0x1.abd9e4p-3f,
+    0x1.9eb74ap-3f, 0x1.91b4f2p-3f, 0x1.84d3bcp-3f, 0x1.78148cp-3f,
+    0x1.6b7846p-3f, 0x1.5effcep-3f, 0x1.52ac0ap-3f, 0x1.467dep-3f,
+    0x1.3a7638p-3f, 0x1.2e95fcp-3f, 0x1.22de1p-3f, 0x1.174f64p-3f,
+    0x1.0beae2p-3f, 0x1.00b176p-3f, 0x1.eb4826p-4f, 0x1.d5874ep-4f,
+    0x1.c0224cp-4f, 0x1.ab1b0cp-4f, 0x1.96737ep-4f, 0x1.822d98p-4f,
+    0x1.6e4b56p-4f, 0x1.5acebap-4f, 0x1.47b9d2p-4f, 0x1.350eacp-4f,
+    0x1.22cf6ap-4f, 0x1.10fe32p-4f, 0x1.ff3a7p-5f, 0x1.dd5d7ap-5f,
+    0x1.bc6a2p-5f, 0x1.9c6526p-5f, 0x1.7d5374p-5f, 0x1.5f3a1cp-5f,
+    0x1.421e66p-5f, 0x1.2605ccp-5f, 0x1.0af60cp-5f, 0x1.e1ea5cp-6f,
+    0x1.b0131ap-6f, 0x1.8073d6p-6f, 0x1.531b02p-6f, 0x1.281826p-6f,
+    0x1.fef83ap-7f, 0x1.b2b2bap-7f, 0x1.6b88b6p-7f, 0x1.29a816p-7f,
+    0x1.da8a76p-8f, 0x1.6d3a32p-8f, 0x1.0bf0e2p-8f, 0x1.6ec474p-9f,
+    0x1.c1dc64p-10f, 0x1.c3a38ap-11f, 0x1.1607ecp-12f, 0x0p+0f,
+};
+
+// povey, 200 samples
+static const float knf_window_table_1[200] = {
+    0x0p+0f, 0x1.c591c8p-11f, 0x1.7055b8p-9f, 0x1.6ec99ep-8f,
+    0x1.2aed6ap-7f, 0x1.b48d7cp-7f, 0x1.295b3cp-6f, 0x1.8216e2p-6f,
+    0x1.e3f6fap-6f, 0x1.27456cp-5f, 0x1.60b74ep-5f, 0x1.9e23fp-5f,
+    0x1.df61a8p-5f, 0x1.1224c4p-4f, 0x1.365b64p-4f, 0x1.5c432ap-4f,
+    0x1.83cb38p-4f, 0x1.ace336p-4f, 0x1.d77b44p-4f, 0x1.01c1ecp-3f,
+    0x1.1876dap-3f, 0x1.2fd4ecp-3f, 0x1.47d4b8p-3f, 0x1.606eecp-3f,
+    0x1.799c44p-3f, 0x1.935588p-3f, 0x1.ad939p-3f, 0x1.c84f38p-3f,
+    0x1.e3816ap-3f, 0x1.ff230ep-3f, 0x1.0d968ep-2f, 0x1.1bcc44p-2f,
+    0x1.2a2f26p-2f, 0x1.38bbb6p-2f, 0x1.476e76p-2f, 0x1.5643eap-2f,
+    0x1.653896p-2f, 0x1.744904p-2f, 0x1.8371c2p-2f, 0x1.92af58p-2f,
+    0x1.a1fe5ap-2f, 0x1.b15b58p-2f, 0x1.c0c2eep-2f, 0x1.d031b2p-2f,
+    0x1.dfa444p-2f, 0x1.ef1748p-2f, 0x1.fe8764p-2f, 0x1.06f8a4p-1f,
+    0x1.0ea8d2p-1f, 0x1.165298p-1f, 0x1.1df458p-1f, 0x1.258c72p-1f,
+    0x1.2d194cp-1f, 0x1.349956p-1f, 0x1.3c0af8p-1f, 0x1.436caap-1f,
+    0x1.4abce2p-1f, 0x1.51fa1ap-1f, 0x1.5922d6p-1f, 0x1.60359cp-1f,
+    0x1.6730f8p-1f, 0x1.6e137cp-1f, 0x1.74dbbep-1f, 0x1.7b885cp-1f,
+    0x1.8217fcp-1f, 0x1.888948p-1f, 0x1.8edafp-1f, 0x1.950baep-1f,
+    0x1.9b1a4p-1f, 0x1.a1056ep-1f, 0x1.a6cc06p-1f, 0x1.ac6cep-1f,
+    0x1.b1e6d8p-1f, 0x1.b738d6p-1f, 0x1.bc61c8p-1f, 0x1.c160a6p-1f,
+    0x1.c6347p-1f, 0x1.cadc3p-1f, 0x1.cf56f6p-1f, 0x1.d3a3ep-1f,
+    0x1.d7c20ep-1f, 0x1.dbb0b2p-1f, 0x1.df6f02p-1f, 0x1.e2fc4p-1f,
+    0x1.e657b6p-1f, 0x1.e980bcp-1f, 0x1.ec76aep-1f, 0x1.ef38f6p-1f,
+    0x1.f1c70cp-1f, 0x1.f4206ap-1f, 0x1.f64498p-1f, 0x1.f8332ep-1f,
+    0x1.f9ebc8p-1f, 0x1.fb6e0cp-1f, 0x1.fcb9b2p-1f, 0x1.fdce76p-1f,
+    0x1.feac2p-1f, 0x1.ff5288p-1f, 0x1.ffc188p-1f, 0x1.fff90ep-1f,
+    0x1.fff90ep-1f, 0x1.ffc188p-1f, 0x1.ff5288p-1f, 0x1.feac2p-1f,
+    0x1.fdce76p-1f, 0x1.fcb9b2p-1f, 0x1.fb6e0cp-1f, 0x1.f9ebc8p-1f,
+    0x1.f8332ep-1f, 0x1.f64498p-1f, 0x1.f4206ap-1f, 0x1.f1c70cp-1f,
+    0x1.ef38f6p-1f, 0x1.ec76aep-1f, 0x1.e980bcp-1f, 0x1.e657b6p-1f,
+    0x1.e2fc4p-1f, 0x1.df6f02p-1f, 0x1.dbb0b2p-1f, 0x1.d7c20ep-1f,
+    0x1.d3a3ep-1f, 0x1.cf56f6p-1f, 0x1.cadc3p-1f, 0x1.c6347p-1f,
+    0x1.c160a6p-1f, 0x1.bc61c8p-1f, 0x1.b738d6p-1f, 0x1.b1e6d8p-1f,
+    0x1.ac6cep-1f, 0x1.a6cc06p-1f, 0x1.a1056ep-1f, 0x1.9b1a4p-1f,
+    0x1.950baep-1f, 0x1.8edafp-1f, 0x1.888948p-1f, 0x1.8217fcp-1f,
+    0x1.7b885cp-1f, 0x1.74dbbep-1f, 0x1.6e137cp-1f, 0x1.6730f8p-1f,
+    0x1.60359cp-1f, 0x1.5922d6p-1f, 0x1.51fa1ap-1f, 0x1.4abce2p-1f,
+    0x1.436caap-1f, 0x1.3c0af8p-1f, 0x1.349956p-1f, 0x1.2d194cp-1f,
+    0x1.258c72p-1f, 0x1.1df458p-1f, 0x1.165298p-1f, 0x1.0ea8d2p-1f,
+    0x1.06f8a4p-1f, 0x1.fe8764p-2f, 0x1.ef1748p-2f, 0x1.dfa444p-2f,
+    0x1.d031b2p-2f, 0x1.c0c2eep-2f, 0x1.b15b58p-2f, 0x1.a1fe5ap-2f,
+    0x1.92af58p-2f, 0x1.8371c2p-2f, 0x1.744904p-2f, 0x1.653896p-2f,
+    0x1.5643eap-2f, 0x1.476e76p-2f, 0x1.38bbb6p-2f, 0x1.2a2f26p-2f,
+    0x1.1bcc44p-2f, 0x1.0d968ep-2f, 0x1.ff230ep-3f, 0x1.e3816ap-3f,
+    0x1.c84f38p-3f, 0x1.ad939p-3f, 0x1.935588p-3f, 0x1.799c44p-3f,
+    0x1.606eecp-3f, 0x1.47d4b8p-3f, 0x1.2fd4ecp-3f, 0x1.1876dap-3f,
+    0x1.01c1ecp-3f, 0x1.d77b44p-4f, 0x1.ace336p-4f, 0x1.83cb38p-4f,
+    0x1.5c432ap-4f, 0x1.365b64p-4f, 0x1.1224c4p-4f, 0x1.df61a8p-5f,
+    0x1.9e23fp-5f, 0x1.60b74ep-5f, 0x1.27456cp-5f, 0x1.e3f6fap-6f,
+    0x1.8216e2p-6f, 0x1.295b3cp-6f, 0x1.b48d7cp-7f, 0x1.2aed6ap-7f,
+    0x1.6ec99ep-8f, 0x1.7055b8p-9f, 0x1.c591c8p-11f, 0x0p+0f,
+};
+
+// hann, 400 samples
+static const float knf_window_table_2[400] = {
+    0x0p+0f, 0x1.02b86ep-14f, 0x1.02b458p-12f, 0x1.23033ap-11f,
+    0x1.02a402p-10f, 0x1.940d1ep-10f, 0x1.22d9ep-9f, 0x1.8bc65ap-9f,
+    0x1.0262aep-8f, 0x1.46e7ap-8f, 0x1.936dbp-8f, 0x1.e7f006p-8f,
+    0x1.2234a8p-7f, 0x1.5469dap-7f, 0x1.8a946cp-7f, 0x1.c4b0f4p-7f,
+    0x1.015de2p-6f, 0x1.22587cp-6f, 0x1.45462ep-6f, 0x1.6a24c4p-6f,
+    0x1.90f1ecp-6f, 0x1.b9ab32p-6f, 0x1.e44e04p-6f, 0x1.086bd8p-5f,
+    0x1.1fa2b2p-5f, 0x1.37ca18p-5f, 0x1.50e086p-5f, 0x1.6ae466p-5f,
+    0x1.85d412p-5f, 0x1.a1add6p-5f, 0x1.be6ff2p-5f, 0x1.dc1892p-5f,
+    0x1.faa5d8p-5f, 0x1.0d0aecp-4f, 0x1.1d3348p-4f, 0x1.2dcafep-4f,
+    0x1.3ed1p-4f, 0x1.50443ap-4f, 0x1.622394p-4f, 0x1.746decp-4f,
+    0x1.87221ap-4f, 0x1.9a3eeep-4f, 0x1.adc336p-4f, 0x1.c1adb4p-4f,
+    0x1.d5fd28p-4f, 0x1.eab046p-4f, 0x1.ffc5c4p-4f, 0x1.0a9e26p-3f,
+    0x1.15894p-3f, 0x1.20a38p-3f, 0x1.2bec34p-3f, 0x1.3762a2p-3f,
+    0x1.430616p-3f, 0x1.4ed5cep-3f, 0x1.5ad11p-3f, 0x1.66f718p-3f,
+    0x1.73472p-3f, 0x1.7fc064p-3f, 0x1.8c6218p-3f, 0x1.992b7p-3f,
+    0x1.a61bap-3f, 0x1.b331d2p-3f, 0x1.c06d38p-3f, 0x1.cdccf6p-3f,
+    0x1.db5038p-3f, 0x1.e8f622p-3f, 0x1.f6bdd8p-3f, 0x1.02533ep-2f,
+    0x1.095796p-2f, 0x1.106b8p-2f, 0x1.178e8ep-2f, 0x1.1ec04cp-2f,
+    0x1.260042p-2f, 0x1.2d4dfep-2f, 0x1.34a908p-2f, 0x1.3c10eap-2f,
+    0x1.43852ep-2f, 0x1.4b0558p-2f, 0x1.5290f2p-2f, 0x1.5a278p-2f,
+    0x1.61c886p-2f, 0x1.69738cp-2f, 0x1.712814p-2f, 0x1.78e5a2p-2f,
+    0x1.80abb8p-2f, 0x1.8879dap-2f, 0x1.904f88p-2f, 0x1.982c44p-2f,
+    0x1.a00f8ep-2f, 0x1.a7f8e8p-2f, 0x1.afe7d2p-2f, 0x1.b7dbccp-2f,
+    0x1.bfd452p-2f, 0x1.c7d0e8p-2f, 0x1.cfd10ap-2f, 0x1.d7d436p-2f,
+    0x1.dfd9ecp-2f, 0x1.e7e1aap-2f, 0x1.efeaeep-2f, 0x1.f7f536p-2f,
+    0x1p-1f, 0x1.040566p-1f, 0x1.080a8ap-1f, 0x1.0c0f2cp-1f,
+    0x1.10130ap-1f, 0x1.1415e6p-1f, 0x1.18177cp-1f, 0x1.1c178cp-1f,
+    0x1.2015d6p-1f, 0x1.24121ap-1f, 0x1.280c16p-1f, 0x1.2c038cp-1f,
+    0x1.2ff838p-1f, 0x1.33e9dep-1f, 0x1.37d83cp-1f, 0x1.3bc314p-1f,
+    0x1.3faa24p-1f, 0x1.438d3p-1f, 0x1.476bf6p-1f, 0x1.4b463ap-1f,
+    0x1.4f1bbcp-1f, 0x1.52ec4p-1f, 0x1.56b788p-1f, 0x1.5a7d54p-1f,
+    0x1.5e3d6ap-1f, 0x1.61f78ap-1f, 0x1.65ab7cp-1f, 0x1.695902p-1f,
+    0x1.6cffep-1f, 0x1.709fdap-1f, 0x1.7438b8p-1f, 0x1.77ca4p-1f,
+    0x1.7b5436p-1f, 0x1.7ed662p-1f, 0x1.82508ap-1f, 0x1.85c278p-1f,
+    0x1.892bf2p-1f, 0x1.8c8cc2p-1f, 0x1.8fe4b2p-1f, 0x1.93338cp-1f,
+    0x1.967918p-1f, 0x1.99b524p-1f, 0x1.9ce77ap-1f, 0x1.a00fe8p-1f,
+    0x1.a32e38p-1f, 0x1.a6423ap-1f, 0x1.a94bbcp-1f, 0x1.ac4a8cp-1f,
+    0x1.af3e7ap-1f, 0x1.b22758p-1f, 0x1.b504f4p-1f, 0x1.b7d72p-1f,
+    0x1.ba9dbp-1f, 0x1.bd5876p-1f, 0x1.c00748p-1f, 0x1.c2a9f8p-1f,
+    0x1.c5405cp-1f, 0x1.c7ca4ap-1f, 0x1.ca479ap-1f, 0x1.ccb822p-1f,
+    0x1.cf1bbcp-1f, 0x1.d17242p-1f, 0x1.d3bb8ep-1f, 0x1.d5f778p-1f,
+    0x1.d825ep-1f, 0x1.da46ap-1f, 0x1.dc5996p-1f, 0x1.de5ea2p-1f,
+    0x1.e055a2p-1f, 0x1.e23e76p-1f, 0x1.e419p-1f, 0x1.e5e522p-1f,
+    0x1.e7a2bep-1f, 0x1.e951bap-1f, 0x1.eaf1f8p-1f, 0x1.ec835ep-1f,
+    0x1.ee05d4p-1f, 0x1.ef7942p-1f, 0x1.f0dd9p-1f, 0x1.f232a6p-1f,
+    0x1.f3787p-1f, 0x1.f4aedap-1f, 0x1.f5d5cep-1f, 0x1.f6ed3cp-1f,
+    0x1.f7f51p-1f, 0x1.f8ed3cp-1f, 0x1.f9d5aep-1f, 0x1.faae58p-1f,
+    0x1.fb772ep-1f, 0x1.fc302p-1f, 0x1.fcd924p-1f, 0x1.fd723p-1f,
+    0x1.fdfb3ap-1f, 0x1.fe743ap-1f, 0x1.fedd26p-1f, 0x1.ff35fap-1f,
+    0x1.ff7eaep-1f, 0x1.ffb74p-1f, 0x1.ffdfaap-1f, 0x1.fff7eap-1f,
+    0x1p+0f, 0x1.fff7eap-1f, 0x1.ffdfaap-1f, 0x1.ffb74p-1f,
+    0x1.ff7eaep-1f, 0x1.ff35fap-1f, 0x1.fedd26p-1f, 0x1.fe743ap-1f,
+    0x1.fdfb3ap-1f, 0x1.fd723p-1f, 0x1.fcd924p-1f, 0x1.fc302p-1f,
+    0x1.fb772ep-1f, 0x1.faae58p-1f, 0x1.f9d5aep-1f, 0x1.f8ed3cp-1f,
+    0x1.f7f51p-1f, 0x1.f6ed3cp-1f, 0x1.f5d5cep-1f, 0x1.f4aedap-1f,
+    0x1.f3787p-1f, 0x1.f232a6p-1f, 0x1.f0dd9p-1f, 0x1.ef7942p-1f,
+    0x1.ee05d4p-1f, 0x1.ec835ep-1f, 0x1.eaf1f8p-1f, 0x1.e951bap-1f,
+    0x1.e7a2bep-1f, 0x1.e5e522p-1f, 0x1.e419p-1f, 0x1.e23e76p-1f,
+    0x1.e055a2p-1f, 0x1.de5ea2p-1f, 0x1.dc5996p-1f, 0x1.da46ap-1f,
+    0x1.d825ep-1f, 0x1.d5f778p-1f, 0x1.d3bb8ep-1f, 0x1.d17242p-1f,
+    0x1.cf1bbcp-1f, 0x1.ccb822p-1f, 0x1.ca479ap-1f, 0x1.c7ca4ap-1f,
+    0x1.c5405cp-1f, 0x1.c2a9f8p-1f, 0x1.c00748p-1f, 0x1.bd5876p-1f,
+    0x1.ba9dbp-1f, 0x1.b7d72p-1f, 0x1.b504f4p-1f, 0x1.b22758p-1f,
+    0x1.af3e7ap-1f, 0x1.ac4a8cp-1f, 0x1.a94bbcp-1f, 0x1.a6423ap-1f,
+    0x1.a32e38p-1f, 0x1.a00fe8p-1f, 0x1.9ce77ap-1f, 0x1.99b524p-1f,
+    0x1.967918p-1f, 0x1.93338cp-1f, 0x1.8fe4b2p-1f, 0x1.8c8cc2p-1f,
+    0x1.892bf2p-1f, 0x1.85c278p-1f, 0x1.82508ap-1f, 0x1.7ed662p-1f,
+    0x1.7b5436p-1f, 0x1.77ca4p-1f, 0x1.7438b8p-1f, 0x1.709fdap-1f,
+    0x1.6cffep-1f, 0x1.695902p-1f, 0x1.65ab7cp-1f, 0x1.61f78ap-1f,
+    0x1.5e3d6ap-1f, 0x1.5a7d54p-1f, 0x1.56b788p-1f, 0x1.52ec4p-1f,
+    0x1.4f1bbcp-1f, 0x1.4b463ap-1f, 0x1.476bf6p-1f, 0x1.438d3p-1f,
+    0x1.3faa24p-1f, 0x1.3bc314p-1f, 0x1.37d83cp-1f, 0x1.33e9dep-1f,
+    0x1.2ff838p-1f, 0x1.2c038cp-1f, 0x1.280c16p-1f, 0x1.24121ap-1f,
+    0x1.2015d6p-1f, 0x1.1c178cp-1f, 0x1.18177cp-1f, 0x1.1415e6p-1f,
+    0x1.10130ap-1f, 0x1.0c0f2cp-1f, 0x1.080a8ap-1f, 0x1.040566p-1f,
+    0x1p-1f, 0x1.f7f536p-2f, 0x1.efeaeep-2f, 0x1.e7e1aap-2f,
+    0x1.dfd9ecp-2f, 0x1.d7d436p-2f, 0x1.cfd10ap-2f, 0x1.c7d0e8p-2f,
+    0x1.bfd452p-2f, 0x1.b7dbccp-2f, 0x1.afe7d2p-2f, 0x1.a7f8e8p-2f,
+    0x1.a00f8ep-2f, 0x1.982c44p-2f, 0x1.904f88p-2f, 0x1.8879dap-2f,
+    0x1.80abb8p-2f, 0x1.78e5a2p-2f, 0x1.712814p-2f, 0x1.69738cp-2f,
+    0x1.61c886p-2f, 0x1.5a278p-2f, 0x1.5290f2p-2f, 0x1.4b0558p-2f,
+    0x1.43852ep-2f, 0x1.3c10eap-2f, 0x1.34a908p-2f, 0x1.2d4dfep-2f,
+    0x1.260042p-2f, 0x1.1ec04cp-2f, 0x1.178e8ep-2f, 0x1.106b8p-2f,
+    0x1.095796p-2f, 0x1.02533ep-2f, 0x1.f6bdd8p-3f, 0x1.e8f622p-3f,
+    0x1.db5038p-3f, 0x1.cdccf6p-3f, 0x1.c06d38p-3f, 0x1.b331d2p-3f,
+    0x1.a61bap-3f, 0x1.992b7p-3f, 0x1.8c6218p-3f, 0x1.7fc064p-3f,
+    0x1.73472p-3f, 0x1.66f718p-3f, 0x1.5ad11p-3f, 0x1.4ed5cep-3f,
+    0x1.430616p-3f, 0x1.3762a2p-3f, 0x1.2bec34p-3f, 0x1.20a38p-3f,
+    0x1.15894p-3f, 0x1.0a9e26p-3f, 0x1.ffc5c4p-4f, 0x1.eab046p-4f,
+    0x1.d5fd28p-4f, 0x1.c1adb4p-4f, 0x1.adc336p-4f, 0x1.9a3eeep-4f,
+    0x1.87221ap-4f, 0x1.746decp-4f, 0x1.622394p-4f, 0x1.50443ap-4f,
+    0x1.3ed1p-4f, 0x1.2dcafep-4f, 0x1.1d3348p-4f, 0x1.0d0aecp-4f,
+    0x1.faa5d8p-5f, 0x1.dc1892p-5f, 0x1.be6ff2p-5f, 0x1.a1add6p-5f,
+    0x1.85d412p-5f, 0x1.6ae466p-5f, 0x1.50e086p-5f, 0x1.37ca18p-5f,
+    0x1.1fa2b2p-5f, 0x1.086bd8p-5f, 0x1.e44e04p-6f, 0x1.b9ab32p-6f,
+    0x1.90f1ecp-6f, 0x1.6a24c4p-6f, 0x1.45462ep-6f, 0x1.22587cp-6f,
+    0x1.015de2p-6f, 0x1.c4b0f4p-7f, 0x1.8a946cp-7f, 0x1.5469dap-7f,
+    0x1.2234a8p-7f, 0x1.e7f006p-8f, 0x1.936dbp-8f, 0x1.46e7ap-8f,
+    0x1.0262aep-8f, 0x1.8bc65ap-9f, 0x1.22d9ep-9f, 0x1.940d1ep-10f,
+    0x1.02a402p-10f, 0x1.23033ap-11f, 0x1.02b458p-12f, 0x1.02b86ep-14f,
+};
+
+static const knf_window_table knf_window_tables[] = {
+    {"povey", 400, knf_window_table_0},
+    {"povey", 200, knf_window_table_1},
+    {"hann", 400, knf_window_table_2},
+};
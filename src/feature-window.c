@@ -6,9 +6,9 @@
 #include <string.h>
 
 #include "kaldi-native-fbank/feature-window.h"
+#include "kaldi-native-fbank/kaldi-math.h"
 #include "kaldi-native-fbank/log.h"
 
-constexpr double KNF_PI = 3.14159265358979323846;
 constexpr int32_t KNF_MAX_POWER_OF_TWO = INT32_C(1) << 30;
 
 static bool knf_fixed_cstr_eq(const char *text, size_t text_cap,
@@ -50,6 +50,7 @@ void knf_frame_opts_default(knf_frame_opts *opts) {
   opts->frame_shift_ms = 10.0f;
   opts->frame_length_ms = 25.0f;
   opts->dither = 0.00003f;
+  opts->dither_seed = 0;
   opts->preemph_coeff = 0.97f;
   opts->remove_dc_offset = true;
   memcpy(opts->window_type, "povey", sizeof("povey"));
@@ -98,6 +99,28 @@ static bool knf_window_match(const char *type, const char *target) {
   return knf_fixed_cstr_eq(type, 16, target);
 }
 
+#ifndef KNF_NO_EMBEDDED_TABLES
+typedef struct {
+  const char *type;
+  int32_t size;
+  const float *data;
+} knf_window_table;
+
+#include "feature-window-tables.h"
+
+static const float *knf_find_window_table(const char *window_type,
+                                          int32_t window_size) {
+  for (size_t i = 0;
+       i < sizeof(knf_window_tables) / sizeof(knf_window_tables[0]); ++i) {
+    const knf_window_table *t = &knf_window_tables[i];
+    if (t->size == window_size && knf_window_match(window_type, t->type)) {
+      return t->data;
+    }
+  }
+  return nullptr;
+}
+#endif
+
 [[nodiscard]] bool knf_make_window(const char *window_type, int32_t window_size,
                                    float blackman_coeff, knf_window *out) {
   if (out == nullptr) {
@@ -106,9 +129,20 @@ static bool knf_window_match(const char *type, const char *target) {
 
   out->data = nullptr;
   out->size = 0;
+  out->embedded = false;
   if (window_type == nullptr || window_size <= 0) return false;
-  out->data = (float *)calloc((size_t)window_size, sizeof(float));
-  if (out->data == nullptr) return false;
+#ifndef KNF_NO_EMBEDDED_TABLES
+  const float *table = knf_find_window_table(window_type, window_size);
+  if (table != nullptr) {
+    out->data = table;
+    out->size = window_size;
+    out->embedded = true;
+    return true;
+  }
+#endif
+  auto data = (float *)calloc((size_t)window_size, sizeof(float));
+  if (data == nullptr) return false;
+  out->data = data;
   out->size = window_size;
 
   auto a = 2.0 * KNF_PI / (window_size > 1 ? window_size - 1 : 1);
@@ -119,22 +153,22 @@ static bool knf_window_match(const char *type, const char *target) {
   for (int32_t i = 0; i < window_size; ++i) {
     auto x = (double)i;
     if (knf_window_match(window_type, "hanning")) {
-      out->data[i] = (float)(0.5 - 0.5 * cos(a * x));
+      data[i] = (float)(0.5 - 0.5 * cos(a * x));
     } else if (knf_window_match(window_type, "sine")) {
-      out->data[i] = (float)sin(0.5 * a * x);
+      data[i] = (float)sin(0.5 * a * x);
     } else if (knf_window_match(window_type, "hamming")) {
-      out->data[i] = (float)(0.54 - 0.46 * cos(a * x));
+      data[i] = (float)(0.54 - 0.46 * cos(a * x));
     } else if (knf_window_match(window_type, "hann")) {
-      out->data[i] = (float)(0.50 - 0.50 * cos(a * x));
+      data[i] = (float)(0.50 - 0.50 * cos(a * x));
     } else if (knf_window_match(window_type, "povey")) {
-      out->data[i] = (float)pow(0.5 - 0.5 * cos(a * x), 0.85);
+      data[i] = (float)pow(0.5 - 0.5 * cos(a * x), 0.85);
     } else if (knf_window_match(window_type, "rectangular")) {
-      out->data[i] = 1.0f;
+      data[i] = 1.0f;
     } else if (knf_window_match(window_type, "blackman")) {
-      out->data[i] = (float)(blackman_coeff - 0.5 * cos(a * x) +
+      data[i] = (float)(blackman_coeff - 0.5 * cos(a * x) +
                              (0.5 - blackman_coeff) * cos(2 * a * x));
     } else {
-      free(out->data);
+      free(data);
       out->data = nullptr;
       out->size = 0;
       return false;
@@ -154,9 +188,10 @@ static bool knf_window_match(const char *type, const char *target) {
 
 void knf_free_window(knf_window *window) {
   if (window != nullptr && window->data != nullptr) {
-    free(window->data);
+    if (!window->embedded) free((void *)window->data);
     window->data = nullptr;
     window->size = 0;
+    window->embedded = false;
   }
 }
 
@@ -169,31 +204,82 @@ void knf_apply_window(const knf_window *window, float *wave) {
   }
 }
 
-int64_t knf_first_sample_of_frame(int32_t frame, const knf_frame_opts *opts) {
-  if (frame < 0 || opts == nullptr) {
-    return -1;
+[[nodiscard]] bool knf_frame_geometry_init(const knf_frame_opts *opts,
+                                           const knf_window *window,
+                                           knf_frame_geometry *out) {
+  if (opts == nullptr || out == nullptr) {
+    return false;
+  }
+  memset(out, 0, sizeof(*out));
+  out->shift = knf_window_shift(opts);
+  out->size = knf_window_size(opts);
+  out->padded = knf_padded_window_size(opts);
+  if (out->size <= 0 || out->padded < out->size) {
+    return false;
+  }
+  out->snip_edges = opts->snip_edges;
+  out->remove_dc_offset = opts->remove_dc_offset;
+  out->dither = opts->dither;
+  out->dither_seed = opts->dither_seed;
+  out->preemph_coeff = opts->preemph_coeff;
+  if (window != nullptr) {
+    if (window->data == nullptr || window->size != out->size) {
+      return false;
+    }
+    out->window = window->data;
+  }
+  return true;
+}
+
+// Geometry for the option-based functions below, which apply a window of the
+// wrong size only if it is shorter than the frame, to its first samples.
+static bool knf_frame_geometry_legacy(const knf_frame_opts *opts,
+                                      const knf_window *window_function,
+                                      knf_frame_geometry *out,
+                                      const knf_window **partial) {
+  *partial = nullptr;
+  if (!knf_frame_geometry_init(opts, nullptr, out)) {
+    return false;
   }
+  if (window_function != nullptr && window_function->data != nullptr &&
+      window_function->size > 0) {
+    if (window_function->size == out->size) {
+      out->window = window_function->data;
+    } else if (window_function->size < out->size) {
+      *partial = window_function;
+    }
+  }
+  return true;
+}
 
-  int64_t frame_shift = knf_window_shift(opts);
-  int32_t window_size = knf_window_size(opts);
-  if (frame_shift <= 0 || window_size <= 0) {
+int64_t knf_frame_geometry_first_sample(const knf_frame_geometry *g,
+                                        int32_t frame) {
+  if (frame < 0 || g->shift <= 0) {
     return -1;
   }
-  if (opts->snip_edges) {
-    return (int64_t)frame * frame_shift;
+  if (g->snip_edges) {
+    return (int64_t)frame * g->shift;
   }
-  int64_t midpoint = frame_shift * frame + frame_shift / 2;
-  return midpoint - window_size / 2;
+  int64_t midpoint = (int64_t)g->shift * frame + g->shift / 2;
+  return midpoint - g->size / 2;
 }
 
-int32_t knf_num_frames(int64_t num_samples, const knf_frame_opts *opts,
-                       bool flush) {
-  int64_t frame_shift = knf_window_shift(opts);
-  int64_t frame_length = knf_window_size(opts);
-  if (frame_shift <= 0 || frame_length <= 0 || num_samples <= 0) {
+int64_t knf_first_sample_of_frame(int32_t frame, const knf_frame_opts *opts) {
+  knf_frame_geometry g;
+  if (!knf_frame_geometry_init(opts, nullptr, &g)) {
+    return -1;
+  }
+  return knf_frame_geometry_first_sample(&g, frame);
+}
+
+int32_t knf_frame_geometry_num_frames(const knf_frame_geometry *g,
+                                      int64_t num_samples, bool flush) {
+  int64_t frame_shift = g->shift;
+  int64_t frame_length = g->size;
+  if (frame_shift <= 0 || num_samples <= 0) {
     return 0;
   }
-  if (opts->snip_edges) {
+  if (g->snip_edges) {
     if (num_samples < frame_length) return 0;
     int64_t frames = 1 + (num_samples - frame_length) / frame_shift;
     if (frames > INT32_MAX) {
@@ -211,7 +297,7 @@ int32_t knf_num_frames(int64_t num_samples, const knf_frame_opts *opts,
   if (num_frames <= 0) return 0;
 
   int64_t end_sample =
-      knf_first_sample_of_frame(num_frames - 1, opts) + frame_length;
+      knf_frame_geometry_first_sample(g, num_frames - 1) + frame_length;
   while (num_frames > 0 && end_sample > num_samples) {
     num_frames--;
     end_sample -= frame_shift;
@@ -219,33 +305,359 @@ int32_t knf_num_frames(int64_t num_samples, const knf_frame_opts *opts,
   return num_frames;
 }
 
-static float knf_rand_uniform() {
-  return (float)rand() / (float)RAND_MAX - 0.5f;
+int32_t knf_num_frames(int64_t num_samples, const knf_frame_opts *opts,
+                       bool flush) {
+  knf_frame_geometry g;
+  if (!knf_frame_geometry_init(opts, nullptr, &g)) {
+    return 0;
+  }
+  return knf_frame_geometry_num_frames(&g, num_samples, flush);
 }
 
-[[nodiscard]] bool knf_extract_window(int64_t sample_offset, const float *wave,
-                                      int32_t wave_size, int32_t frame_index,
-                                      const knf_frame_opts *opts,
-                                      const knf_window *window_function,
-                                      float *window,
-                                      float *log_energy_pre_window) {
-  if (sample_offset < 0 || wave == nullptr || opts == nullptr ||
-      window == nullptr || wave_size <= 0 || frame_index < 0) {
-    return false;
+// Lanes of the partial sums in the frame kernels. Eight independent sums let
+// the loops vectorize without reassociating a single accumulator.
+constexpr int32_t KNF_FRAME_LANES = 8;
+
+// Dither noise is drawn this many samples at a time; a multiple of the four
+// values per generator block.
+constexpr int32_t KNF_DITHER_CHUNK = 64;
+
+// G.711 decode tables (ITU-T G.711), indexed by the coded byte; the values
+// are the decoded 16-bit linear samples.
+static const float knf_mulaw_table[256] = {
+    -32124.0f, -31100.0f, -30076.0f, -29052.0f, -28028.0f, -27004.0f, -25980.0f,
+    -24956.0f, -23932.0f, -22908.0f, -21884.0f, -20860.0f, -19836.0f, -18812.0f,
+    -17788.0f, -16764.0f, -15996.0f, -15484.0f, -14972.0f, -14460.0f, -13948.0f,
+    -13436.0f, -12924.0f, -12412.0f, -11900.0f, -11388.0f, -10876.0f, -10364.0f,
+    -9852.0f, -9340.0f, -8828.0f, -8316.0f, -7932.0f, -7676.0f, -7420.0f,
+    -7164.0f, -6908.0f, -6652.0f, -6396.0f, -6140.0f, -5884.0f, -5628.0f,
+    -5372.0f, -5116.0f, -4860.0f, -4604.0f, -4348.0f, -4092.0f, -3900.0f,
+    -3772.0f, -3644.0f, -3516.0f, -3388.0f, -3260.0f, -3132.0f, -3004.0f,
+    -2876.0f, -2748.0f, -2620.0f, -2492.0f, -2364.0f, -2236.0f, -2108.0f,
+    -1980.0f, -1884.0f, -1820.0f, -1756.0f, -1692.0f, -1628.0f, -1564.0f,
+    -1500.0f, -1436.0f, -1372.0f, -1308.0f, -1244.0f, -1180.0f, -1116.0f,
+    -1052.0f, -988.0f, -924.0f, -876.0f, -844.0f, -812.0f, -780.0f, -748.0f,
+    -716.0f, -684.0f, -652.0f, -620.0f, -588.0f, -556.0f, -524.0f, -492.0f,
+    -460.0f, -428.0f, -396.0f, -372.0f, -356.0f, -340.0f, -324.0f, -308.0f,
+    -292.0f, -276.0f, -260.0f, -244.0f, -228.0f, -212.0f, -196.0f, -180.0f,
+    -164.0f, -148.0f, -132.0f, -120.0f, -112.0f, -104.0f, -96.0f, -88.0f,
+    -80.0f, -72.0f, -64.0f, -56.0f, -48.0f, -40.0f, -32.0f, -24.0f, -16.0f,
+    -8.0f, 0.0f, 32124.0f, 31100.0f, 30076.0f, 29052.0f, 28028.0f, 27004.0f,
+    25980.0f, 24956.0f, 23932.0f, 22908.0f, 21884.0f, 20860.0f, 19836.0f,
+    18812.0f, 17788.0f, 16764.0f, 15996.0f, 15484.0f, 14972.0f, 14460.0f,
+    13948.0f, 13436.0f, 12924.0f, 12412.0f, 11900.0f, 11388.0f, 10876.0f,
+    10364.0f, 9852.0f, 9340.0f, 8828.0f, 8316.0f, 7932.0f, 7676.0f, 7420.0f,
+    7164.0f, 6908.0f, 6652.0f, 6396.0f, 6140.0f, 5884.0f, 5628.0f, 5372.0f,
+    5116.0f, 4860.0f, 4604.0f, 4348.0f, 4092.0f, 3900.0f, 3772.0f, 3644.0f,
+    3516.0f, 3388.0f, 3260.0f, 3132.0f, 3004.0f, 2876.0f, 2748.0f, 2620.0f,
+    2492.0f, 2364.0f, 2236.0f, 2108.0f, 1980.0f, 1884.0f, 1820.0f, 1756.0f,
+    1692.0f, 1628.0f, 1564.0f, 1500.0f, 1436.0f, 1372.0f, 1308.0f, 1244.0f,
+    1180.0f, 1116.0f, 1052.0f, 988.0f, 924.0f, 876.0f, 844.0f, 812.0f, 780.0f,
+    748.0f, 716.0f, 684.0f, 652.0f, 620.0f, 588.0f, 556.0f, 524.0f, 492.0f,
+    460.0f, 428.0f, 396.0f, 372.0f, 356.0f, 340.0f, 324.0f, 308.0f, 292.0f,
+    276.0f, 260.0f, 244.0f, 228.0f, 212.0f, 196.0f, 180.0f, 164.0f, 148.0f,
+    132.0f, 120.0f, 112.0f, 104.0f, 96.0f, 88.0f, 80.0f, 72.0f, 64.0f, 56.0f,
+    48.0f, 40.0f, 32.0f, 24.0f, 16.0f, 8.0f, 0.0f,
+};
+
+static const float knf_alaw_table[256] = {
+    -5504.0f, -5248.0f, -6016.0f, -5760.0f, -4480.0f, -4224.0f, -4992.0f,
+    -4736.0f, -7552.0f, -7296.0f, -8064.0f, -7808.0f, -6528.0f, -6272.0f,
+    -7040.0f, -6784.0f, -2752.0f, -2624.0f, -3008.0f, -2880.0f, -2240.0f,
+    -2112.0f, -2496.0f, -2368.0f, -3776.0f, -3648.0f, -4032.0f, -3904.0f,
+    -3264.0f, -3136.0f, -3520.0f, -3392.0f, -22016.0f, -20992.0f, -24064.0f,
+    -23040.0f, -17920.0f, -16896.0f, -19968.0f, -18944.0f, -30208.0f, -29184.0f,
+    -32256.0f, -31232.0f, -26112.0f, -25088.0f, -28160.0f, -27136.0f, -11008.0f,
+    -10496.0f, -12032.0f, -11520.0f, -8960.0f, -8448.0f, -9984.0f, -9472.0f,
+    -15104.0f, -14592.0f, -16128.0f, -15616.0f, -13056.0f, -12544.0f, -14080.0f,
+    -13568.0f, -344.0f, -328.0f, -376.0f, -360.0f, -280.0f, -264.0f, -312.0f,
+    -296.0f, -472.0f, -456.0f, -504.0f, -488.0f, -408.0f, -392.0f, -440.0f,
+    -424.0f, -88.0f, -72.0f, -120.0f, -104.0f, -24.0f, -8.0f, -56.0f, -40.0f,
+    -216.0f, -200.0f, -248.0f, -232.0f, -152.0f, -136.0f, -184.0f, -168.0f,
+    -1376.0f, -1312.0f, -1504.0f, -1440.0f, -1120.0f, -1056.0f, -1248.0f,
+    -1184.0f, -1888.0f, -1824.0f, -2016.0f, -1952.0f, -1632.0f, -1568.0f,
+    -1760.0f, -1696.0f, -688.0f, -656.0f, -752.0f, -720.0f, -560.0f, -528.0f,
+    -624.0f, -592.0f, -944.0f, -912.0f, -1008.0f, -976.0f, -816.0f, -784.0f,
+    -880.0f, -848.0f, 5504.0f, 5248.0f, 6016.0f, 5760.0f, 4480.0f, 4224.0f,
+    4992.0f, 4736.0f, 7552.0f, 7296.0f, 8064.0f, 7808.0f, 6528.0f, 6272.0f,
+    7040.0f, 6784.0f, 2752.0f, 2624.0f, 3008.0f, 2880.0f, 2240.0f, 2112.0f,
+    2496.0f, 2368.0f, 3776.0f, 3648.0f, 4032.0f, 3904.0f, 3264.0f, 3136.0f,
+    3520.0f, 3392.0f, 22016.0f, 20992.0f, 24064.0f, 23040.0f, 17920.0f,
+    16896.0f, 19968.0f, 18944.0f, 30208.0f, 29184.0f, 32256.0f, 31232.0f,
+    26112.0f, 25088.0f, 28160.0f, 27136.0f, 11008.0f, 10496.0f, 12032.0f,
+    11520.0f, 8960.0f, 8448.0f, 9984.0f, 9472.0f, 15104.0f, 14592.0f, 16128.0f,
+    15616.0f, 13056.0f, 12544.0f, 14080.0f, 13568.0f, 344.0f, 328.0f, 376.0f,
+    360.0f, 280.0f, 264.0f, 312.0f, 296.0f, 472.0f, 456.0f, 504.0f, 488.0f,
+    408.0f, 392.0f, 440.0f, 424.0f, 88.0f, 72.0f, 120.0f, 104.0f, 24.0f, 8.0f,
+    56.0f, 40.0f, 216.0f, 200.0f, 248.0f, 232.0f, 152.0f, 136.0f, 184.0f,
+    168.0f, 1376.0f, 1312.0f, 1504.0f, 1440.0f, 1120.0f, 1056.0f, 1248.0f,
+    1184.0f, 1888.0f, 1824.0f, 2016.0f, 1952.0f, 1632.0f, 1568.0f, 1760.0f,
+    1696.0f, 688.0f, 656.0f, 752.0f, 720.0f, 560.0f, 528.0f, 624.0f, 592.0f,
+    944.0f, 912.0f, 1008.0f, 976.0f, 816.0f, 784.0f, 880.0f, 848.0f,
+};
+
+size_t knf_sample_size(knf_sample_format format) {
+  switch (format) {
+    case KNF_SAMPLE_INT16:
+      return sizeof(int16_t);
+    case KNF_SAMPLE_INT32:
+      return sizeof(int32_t);
+    case KNF_SAMPLE_FLOAT64:
+      return sizeof(double);
+    case KNF_SAMPLE_MULAW:
+    case KNF_SAMPLE_ALAW:
+      return sizeof(uint8_t);
+    case KNF_SAMPLE_FLOAT32:
+    default:
+      return sizeof(float);
+  }
+}
+
+void knf_convert_samples(const void *src, knf_sample_format format,
+                         int64_t offset, int32_t n, float *out) {
+  switch (format) {
+    case KNF_SAMPLE_INT16: {
+      const int16_t *in = (const int16_t *)src + offset;
+      for (int32_t i = 0; i < n; ++i) out[i] = (float)in[i];
+      break;
+    }
+    case KNF_SAMPLE_INT32: {
+      const int32_t *in = (const int32_t *)src + offset;
+      for (int32_t i = 0; i < n; ++i) out[i] = (float)in[i] * (1.0f / 65536);
+      break;
+    }
+    case KNF_SAMPLE_FLOAT64: {
+      const double *in = (const double *)src + offset;
+      for (int32_t i = 0; i < n; ++i) out[i] = (float)in[i];
+      break;
+    }
+    case KNF_SAMPLE_MULAW:
+    case KNF_SAMPLE_ALAW: {
+      const uint8_t *in = (const uint8_t *)src + offset;
+      const float *table =
+          format == KNF_SAMPLE_MULAW ? knf_mulaw_table : knf_alaw_table;
+      for (int32_t i = 0; i < n; ++i) out[i] = table[in[i]];
+      break;
+    }
+    case KNF_SAMPLE_FLOAT32:
+    default: {
+      const float *in = (const float *)src + offset;
+      if (in != out) memmove(out, in, sizeof(float) * (size_t)n);
+      break;
+    }
+  }
+}
+
+// Loops of knf_convert_channel for samples of type T decoded by DECODE.
+#define KNF_CONVERT_CHANNEL(T, DECODE)                                   \
+  do {                                                                   \
+    const T *in = (const T *)src + offset * channels;                    \
+    if (channel >= 0) {                                                  \
+      for (int32_t i = 0; i < n; ++i) {                                  \
+        out[i] = DECODE(in[(size_t)i * (size_t)channels + channel]);     \
+      }                                                                  \
+    } else {                                                             \
+      for (int32_t i = 0; i < n; ++i) {                                  \
+        const T *x = in + (size_t)i * (size_t)channels;                  \
+        float sum = 0.0f;                                                \
+        for (int32_t c = 0; c < channels; ++c) sum += DECODE(x[c]);      \
+        out[i] = sum * scale;                                            \
+      }                                                                  \
+    }                                                                    \
+  } while (0)
+#define KNF_DECODE_CAST(x) ((float)(x))
+#define KNF_DECODE_INT32(x) ((float)(x) * (1.0f / 65536))
+#define KNF_DECODE_TABLE(x) (table[(x)])
+
+void knf_convert_channel(const void *src, knf_sample_format format,
+                         int32_t channels, int32_t channel, int64_t offset,
+                         int32_t n, float *out) {
+  if (channels == 1) {
+    knf_convert_samples(src, format, offset, n, out);
+    return;
+  }
+  float scale = 1.0f / (float)channels;
+  const float *table =
+      format == KNF_SAMPLE_MULAW ? knf_mulaw_table : knf_alaw_table;
+  switch (format) {
+    case KNF_SAMPLE_INT16:
+      KNF_CONVERT_CHANNEL(int16_t, KNF_DECODE_CAST);
+      break;
+    case KNF_SAMPLE_INT32:
+      KNF_CONVERT_CHANNEL(int32_t, KNF_DECODE_INT32);
+      break;
+    case KNF_SAMPLE_FLOAT64:
+      KNF_CONVERT_CHANNEL(double, KNF_DECODE_CAST);
+      break;
+    case KNF_SAMPLE_MULAW:
+    case KNF_SAMPLE_ALAW:
+      KNF_CONVERT_CHANNEL(uint8_t, KNF_DECODE_TABLE);
+      break;
+    case KNF_SAMPLE_FLOAT32:
+    default:
+      KNF_CONVERT_CHANNEL(float, KNF_DECODE_CAST);
+      break;
+  }
+}
+
+#undef KNF_DECODE_TABLE
+#undef KNF_DECODE_INT32
+#undef KNF_DECODE_CAST
+#undef KNF_CONVERT_CHANNEL
+
+// Index of the dither noise for one channel of a frame. The channels of a
+// frame take consecutive indices, so that channels holding the same samples
+// still get different noise; a downmix counts as a single channel.
+static uint64_t knf_dither_index(int32_t frame_index, int32_t channels,
+                                 int32_t channel) {
+  if (channel == KNF_CHANNEL_DOWNMIX) {
+    return (uint64_t)frame_index;
+  }
+  return (uint64_t)frame_index * (uint64_t)channels + (uint64_t)channel;
+}
+
+// First pass: converts the frame from sample offset of src, which may be
+// window itself, adding the dither noise numbered dither_index, and returns
+// its sum for the DC offset. Each chunk is converted, dithered and summed
+// while it is still in cache.
+static double knf_frame_load(const knf_frame_geometry *g,
+                             uint64_t dither_index, const void *src,
+                             knf_sample_format format, int32_t channels,
+                             int32_t channel, int64_t offset, float *window) {
+  int32_t n = g->size;
+  knf_random_state rng;
+  if (g->dither != 0.0f) {
+    knf_random_state_seed(&rng, g->dither_seed);
+    rng.counter = dither_index * (uint64_t)((n + 3) / 4);
+  }
+  double sums[KNF_FRAME_LANES] = {};
+  float noise[KNF_DITHER_CHUNK];
+  for (int32_t i = 0; i < n; i += KNF_DITHER_CHUNK) {
+    int32_t m = n - i < KNF_DITHER_CHUNK ? n - i : KNF_DITHER_CHUNK;
+    float *x = window + i;
+    knf_convert_channel(src, format, channels, channel, offset + i, m, x);
+    if (g->dither != 0.0f) {
+      knf_rand_uniform_block(&rng, noise, m);
+      for (int32_t j = 0; j < m; ++j) {
+        x[j] += g->dither * (noise[j] - 0.5f);
+      }
+    }
+    if (!g->remove_dc_offset) continue;
+    int32_t j = 0;
+    for (; j + KNF_FRAME_LANES <= m; j += KNF_FRAME_LANES) {
+      for (int32_t k = 0; k < KNF_FRAME_LANES; ++k) sums[k] += x[j + k];
+    }
+    for (; j < m; ++j) sums[0] += x[j];
+  }
+  double sum = 0.0;
+  for (int32_t j = 0; j < KNF_FRAME_LANES; ++j) sum += sums[j];
+  return sum;
+}
+
+// Second pass: DC removal, pre-emphasis, the energy before windowing and the
+// window itself, in place. Blocks run from the end of the frame so that
+// pre-emphasis still reads the unmodified previous sample.
+static void knf_frame_finish(const knf_frame_geometry *g, float *window,
+                             double sum, float *log_energy_pre_window) {
+  int32_t n = g->size;
+  float mean = g->remove_dc_offset ? (float)(sum / n) : 0.0f;
+  float coeff = g->preemph_coeff;
+  const float *w = g->window;
+  float energy[KNF_FRAME_LANES] = {};
+  int32_t i = n;
+  for (; i > KNF_FRAME_LANES; i -= KNF_FRAME_LANES) {
+    float *x = window + i - KNF_FRAME_LANES;
+    float cur[KNF_FRAME_LANES];
+    float prev[KNF_FRAME_LANES];
+    for (int32_t j = 0; j < KNF_FRAME_LANES; ++j) {
+      cur[j] = x[j] - mean;
+      prev[j] = x[j - 1] - mean;
+    }
+    for (int32_t j = 0; j < KNF_FRAME_LANES; ++j) {
+      float y = cur[j] - coeff * prev[j];
+      energy[j] += y * y;
+      x[j] = w != nullptr ? y * w[i - KNF_FRAME_LANES + j] : y;
+    }
+  }
+  // The first samples; sample 0 is pre-emphasized against itself.
+  for (int32_t k = i - 1; k >= 0; --k) {
+    float cur = window[k] - mean;
+    float y = cur - coeff * (k > 0 ? window[k - 1] - mean : cur);
+    energy[0] += y * y;
+    window[k] = w != nullptr ? y * w[k] : y;
   }
-  int32_t frame_length = knf_window_size(opts);
-  int32_t frame_length_padded = knf_padded_window_size(opts);
-  if (frame_length <= 0 || frame_length_padded < frame_length) {
+  if (log_energy_pre_window != nullptr) {
+    float total = 0.0f;
+    for (int32_t j = 0; j < KNF_FRAME_LANES; ++j) total += energy[j];
+    if (total < 1e-10f) total = 1e-10f;
+    *log_energy_pre_window = logf(total);
+  }
+}
+
+// Reverses x[0, n) in place.
+static void knf_reverse(float *x, int32_t n) {
+  for (int32_t i = 0, j = n - 1; i < j; ++i, --j) {
+    float t = x[i];
+    x[i] = x[j];
+    x[j] = t;
+  }
+}
+
+// window[s] = wave[s + wave_start] for 0 <= s < n, with indices outside
+// [0, wave_size) reflected at the edges (-1 -> 0, wave_size -> wave_size - 1).
+// Unless the wave is shorter than the overhang, the reflected edges are the
+// first and last samples of the wave converted as blocks and reversed.
+static void knf_gather_reflected(const void *wave, knf_sample_format format,
+                                 int32_t channels, int32_t channel,
+                                 int32_t wave_start, int32_t wave_size,
+                                 int32_t n, float *window) {
+  int64_t left = -(int64_t)wave_start;
+  left = left < 0 ? 0 : (left > n ? n : left);
+  int64_t right = (int64_t)wave_size - wave_start;
+  right = right < 0 ? 0 : (right > n ? n : right);
+  if (left <= wave_size && n - right <= wave_size) {
+    knf_convert_channel(wave, format, channels, channel, 0, (int32_t)left,
+                        window);
+    knf_reverse(window, (int32_t)left);
+    knf_convert_channel(wave, format, channels, channel, wave_start + left,
+                        (int32_t)(right - left), window + left);
+    knf_convert_channel(wave, format, channels, channel,
+                        wave_size - (n - right), (int32_t)(n - right),
+                        window + right);
+    knf_reverse(window + right, (int32_t)(n - right));
+    return;
+  }
+  // Reflection is periodic in 2 * wave_size.
+  int64_t period = 2 * (int64_t)wave_size;
+  for (int32_t s = 0; s < n; ++s) {
+    int64_t i = ((int64_t)s + wave_start) % period;
+    if (i < 0) i += period;
+    if (i >= wave_size) i = period - 1 - i;
+    knf_convert_channel(wave, format, channels, channel, i, 1, &window[s]);
+  }
+}
+
+[[nodiscard]] bool knf_frame_geometry_extract_channel(
+    const knf_frame_geometry *g, int64_t sample_offset, const void *wave,
+    knf_sample_format format, int32_t channels, int32_t channel,
+    int32_t wave_size, int32_t frame_index, float *window,
+    float *log_energy_pre_window) {
+  if (sample_offset < 0 || wave == nullptr || window == nullptr ||
+      wave_size <= 0 || frame_index < 0 || channels < 1 ||
+      channel < KNF_CHANNEL_DOWNMIX || channel >= channels) {
     return false;
   }
+  int32_t frame_length = g->size;
+  int32_t frame_length_padded = g->padded;
   int64_t num_samples = sample_offset + wave_size;
-  int64_t start_sample = knf_first_sample_of_frame(frame_index, opts);
-  if (start_sample < 0) {
+  if (g->shift <= 0) {
     return false;
   }
+  // Negative for the first frames without snip_edges; they are reflected.
+  int64_t start_sample = knf_frame_geometry_first_sample(g, frame_index);
   int64_t end_sample = start_sample + frame_length;
 
-  if (opts->snip_edges) {
+  if (g->snip_edges) {
     if (!(start_sample >= sample_offset && end_sample <= num_samples)) {
       return false;
     }
@@ -253,81 +665,180 @@ static float knf_rand_uniform() {
     return false;
   }
 
-  memset(window, 0, sizeof(float) * frame_length_padded);
   int32_t wave_start = (int32_t)(start_sample - sample_offset);
   int32_t wave_end = wave_start + frame_length;
 
-  if (wave_start >= 0 && wave_end <= wave_size) {
-    memcpy(window, wave + wave_start, sizeof(float) * frame_length);
-  } else {
-    for (int32_t s = 0; s < frame_length; ++s) {
-      int32_t s_in_wave = s + wave_start;
-      while (s_in_wave < 0 || s_in_wave >= wave_size) {
-        if (s_in_wave < 0) {
-          s_in_wave = -s_in_wave - 1;
-        } else {
-          s_in_wave = 2 * wave_size - 1 - s_in_wave;
-        }
-      }
-      window[s] = wave[s_in_wave];
-    }
+  // Frames reaching past the edges are gathered into window first.
+  bool reflected = wave_start < 0 || wave_end > wave_size;
+  if (reflected) {
+    knf_gather_reflected(wave, format, channels, channel, wave_start,
+                         wave_size, frame_length, window);
   }
 
-  knf_process_window(opts, window_function, window, log_energy_pre_window);
-  for (int32_t i = frame_length; i < frame_length_padded; ++i) {
-    window[i] = 0.0f;
+  uint64_t dither_index = knf_dither_index(frame_index, channels, channel);
+  double sum =
+      reflected ? knf_frame_load(g, dither_index, window, KNF_SAMPLE_FLOAT32,
+                                 1, 0, 0, window)
+                : knf_frame_load(g, dither_index, wave, format, channels,
+                                 channel, wave_start, window);
+  knf_frame_finish(g, window, sum, log_energy_pre_window);
+  if (frame_length_padded > frame_length) {
+    memset(window + frame_length, 0,
+           sizeof(float) * (size_t)(frame_length_padded - frame_length));
   }
   return true;
 }
 
-void knf_process_window(const knf_frame_opts *opts,
-                        const knf_window *window_function, float *window,
-                        float *log_energy_pre_window) {
-  if (opts == nullptr || window == nullptr) {
-    return;
+[[nodiscard]] bool knf_frame_geometry_extract_typed(
+    const knf_frame_geometry *g, int64_t sample_offset, const void *wave,
+    knf_sample_format format, int32_t wave_size, int32_t frame_index,
+    float *window, float *log_energy_pre_window) {
+  return knf_frame_geometry_extract_channel(g, sample_offset, wave, format, 1,
+                                            0, wave_size, frame_index, window,
+                                            log_energy_pre_window);
+}
+
+[[nodiscard]] bool knf_frame_geometry_extract(const knf_frame_geometry *g,
+                                              int64_t sample_offset,
+                                              const float *wave,
+                                              int32_t wave_size,
+                                              int32_t frame_index,
+                                              float *window,
+                                              float *log_energy_pre_window) {
+  return knf_frame_geometry_extract_typed(g, sample_offset, wave,
+                                          KNF_SAMPLE_FLOAT32, wave_size,
+                                          frame_index, window,
+                                          log_energy_pre_window);
+}
+
+[[nodiscard]] bool knf_extract_window(int64_t sample_offset, const float *wave,
+                                      int32_t wave_size, int32_t frame_index,
+                                      const knf_frame_opts *opts,
+                                      const knf_window *window_function,
+                                      float *window,
+                                      float *log_energy_pre_window) {
+  knf_frame_geometry g;
+  const knf_window *partial = nullptr;
+  if (!knf_frame_geometry_legacy(opts, window_function, &g, &partial) ||
+      !knf_frame_geometry_extract(&g, sample_offset, wave, wave_size,
+                                  frame_index, window,
+                                  log_energy_pre_window)) {
+    return false;
   }
-  int32_t window_size = knf_window_size(opts);
-  if (window_size <= 0) {
-    return;
+  knf_apply_window(partial, window);
+  return true;
+}
+
+// Floats per 64 bytes, the row alignment of knf_frame_matrix.
+constexpr int32_t KNF_FRAME_ROW_ALIGN = 16;
+
+static bool knf_frame_matrix_reserve(knf_frame_matrix *m, int32_t cols,
+                                     int32_t rows) {
+  int32_t stride = (cols + KNF_FRAME_ROW_ALIGN - 1) / KNF_FRAME_ROW_ALIGN *
+                   KNF_FRAME_ROW_ALIGN;
+  if (m->data != nullptr && m->stride == stride && m->capacity >= rows) {
+    m->cols = cols;
+    return true;
   }
+  if ((size_t)rows > SIZE_MAX / sizeof(float) / (size_t)stride) {
+    return false;
+  }
+  size_t bytes = sizeof(float) * (size_t)stride * (size_t)rows;
+  float *data = (float *)aligned_alloc(sizeof(float) * KNF_FRAME_ROW_ALIGN,
+                                       bytes);
+  float *log_energies = (float *)malloc(sizeof(float) * (size_t)rows);
+  if (data == nullptr || log_energies == nullptr) {
+    free(data);
+    free(log_energies);
+    return false;
+  }
+  knf_frame_matrix_free(m);
+  m->data = data;
+  m->log_energies = log_energies;
+  m->cols = cols;
+  m->stride = stride;
+  m->capacity = rows;
+  return true;
+}
 
-  if (opts->dither != 0.0f) {
-    for (int32_t i = 0; i < window_size; ++i) {
-      window[i] += opts->dither * knf_rand_uniform();
+[[nodiscard]] bool knf_extract_windows(const knf_frame_geometry *g,
+                                       int64_t sample_offset,
+                                       const void *wave,
+                                       knf_sample_format format,
+                                       int32_t channels, bool downmix,
+                                       int32_t wave_size, int32_t first_frame,
+                                       int32_t count, knf_frame_matrix *out) {
+  if (g == nullptr || out == nullptr) {
+    return false;
+  }
+  out->rows = 0;
+  int32_t per_frame = downmix ? 1 : channels;
+  if (count <= 0 || first_frame < 0 || first_frame > INT32_MAX - count ||
+      channels < 1 || count > INT32_MAX / per_frame ||
+      !knf_frame_matrix_reserve(out, g->padded, count * per_frame)) {
+    return false;
+  }
+  for (int32_t i = 0; i < count * per_frame; ++i) {
+    float *row = out->data + (size_t)i * (size_t)out->stride;
+    int32_t channel = downmix ? KNF_CHANNEL_DOWNMIX : i % per_frame;
+    if (!knf_frame_geometry_extract_channel(
+            g, sample_offset, wave, format, channels, channel, wave_size,
+            first_frame + i / per_frame, row, &out->log_energies[i])) {
+      return false;
+    }
+    if (out->stride > g->padded) {
+      memset(row + g->padded, 0,
+             sizeof(float) * (size_t)(out->stride - g->padded));
     }
   }
+  out->rows = count * per_frame;
+  return true;
+}
 
-  if (opts->remove_dc_offset) {
-    double sum = 0.0;
-    for (int32_t i = 0; i < window_size; ++i) sum += window[i];
-    float mean = (float)(sum / window_size);
-    for (int32_t i = 0; i < window_size; ++i) window[i] -= mean;
-  }
+void knf_frame_matrix_free(knf_frame_matrix *m) {
+  if (m == nullptr) return;
+  free(m->data);
+  free(m->log_energies);
+  memset(m, 0, sizeof(*m));
+}
 
-  if (opts->preemph_coeff != 0.0f) {
-    float last = window[0];
-    for (int32_t i = window_size - 1; i > 0; --i) {
-      float prev = window[i - 1];
-      window[i] -= opts->preemph_coeff * prev;
-      last = prev;
-    }
-    window[0] -= opts->preemph_coeff * last;
+void knf_frame_geometry_process(const knf_frame_geometry *g,
+                                int32_t frame_index, float *window,
+                                float *log_energy_pre_window) {
+  if (window == nullptr || frame_index < 0) {
+    return;
   }
+  double sum =
+      knf_frame_load(g, (uint64_t)frame_index, window, KNF_SAMPLE_FLOAT32, 1,
+                     0, 0, window);
+  knf_frame_finish(g, window, sum, log_energy_pre_window);
+}
 
-  if (log_energy_pre_window != nullptr) {
-    float energy = 0.0f;
-    for (int32_t i = 0; i < window_size; ++i) energy += window[i] * window[i];
-    if (energy < 1e-10f) energy = 1e-10f;
-    *log_energy_pre_window = logf(energy);
+bool knf_process_window_at(const knf_frame_opts *opts,
+                           const knf_window *window_function,
+                           int32_t frame_index, float *window,
+                           float *log_energy_pre_window) {
+  knf_frame_geometry g;
+  const knf_window *partial = nullptr;
+  if (window == nullptr || frame_index < 0 ||
+      !knf_frame_geometry_legacy(opts, window_function, &g, &partial)) {
+    return false;
   }
+  knf_frame_geometry_process(&g, frame_index, window, log_energy_pre_window);
+  knf_apply_window(partial, window);
+  return true;
+}
 
-  if (window_function != nullptr && window_function->data != nullptr &&
-      window_function->size > 0) {
-    if (window_function->size > window_size) {
-      return;
-    }
-    knf_apply_window(window_function, window);
+bool knf_process_window(const knf_frame_opts *opts,
+                        const knf_window *window_function, float *window,
+                        float *log_energy_pre_window) {
+  if (opts != nullptr && opts->dither != 0.0f) {
+    KNF_LOG_ERROR("knf_process_window cannot dither without a frame index; "
+                  "use knf_process_window_at");
+    return false;
   }
+  return knf_process_window_at(opts, window_function, 0, window,
+                               log_energy_pre_window);
 }
 
 float knf_inner_product(const float *a, const float *b, int32_t n) {
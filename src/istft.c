@@ -10,6 +10,9 @@
 #include "kaldi-native-fbank/log.h"
 #include "kaldi-native-fbank/rfft.h"
 
+// Frames handed to knf_rfft_compute_batch at a time.
+constexpr int32_t KNF_ISTFT_BATCH = 16;
+
 void knf_istft_config_default(knf_istft_config *cfg) {
   if (cfg == nullptr) {
     return;
@@ -32,10 +35,11 @@ void knf_istft_config_default(knf_istft_config *cfg) {
   bool ok = false;
   float *samples = nullptr;
   float *denom = nullptr;
-  knf_window window = {nullptr, 0};
+  knf_window window = {};
   bool owns_window = false;
   knf_rfft *fft = nullptr;
   float *frame = nullptr;
+  void *scratch = nullptr;
 
   if (out_samples == nullptr || num_samples == nullptr) {
     return false;
@@ -95,40 +99,52 @@ void knf_istft_config_default(knf_istft_config *cfg) {
     goto cleanup;
   }
 
-  frame = (float *)calloc((size_t)n_fft, sizeof(float));
-  if (frame == nullptr) {
+  frame = (float *)calloc((size_t)KNF_ISTFT_BATCH * (size_t)n_fft,
+                         sizeof(float));
+  // One scratch buffer serves every batch of this call.
+  scratch = malloc(knf_rfft_batch_scratch_size(fft));
+  if (frame == nullptr || scratch == nullptr) {
     goto cleanup;
   }
   auto inv_n = 1.0f / (float)n_fft;
   auto pre_scale = cfg->normalized ? sqrtf((float)n_fft) : 1.0f;
 
-  for (int32_t i = 0; i < frames; ++i) {
-    const float *real = stft->real + i * bins;
-    const float *imag = stft->imag + i * bins;
-
-    frame[0] = real[0] * pre_scale;
-    frame[1] = real[n_fft / 2] * pre_scale;
-    for (int32_t k = 1; k < n_fft / 2; ++k) {
-      frame[2 * k] = real[k] * pre_scale;
-      frame[2 * k + 1] = imag[k] * pre_scale;
+  for (int32_t i0 = 0; i0 < frames; i0 += KNF_ISTFT_BATCH) {
+    auto count = frames - i0 < KNF_ISTFT_BATCH ? frames - i0 : KNF_ISTFT_BATCH;
+    for (int32_t b = 0; b < count; ++b) {
+      const float *real = stft->real + (i0 + b) * bins;
+      const float *imag = stft->imag + (i0 + b) * bins;
+      float *f = frame + (size_t)b * n_fft;
+
+      f[0] = real[0] * pre_scale;
+      f[1] = real[n_fft / 2] * pre_scale;
+      for (int32_t k = 1; k < n_fft / 2; ++k) {
+        f[2 * k] = real[k] * pre_scale;
+        f[2 * k + 1] = imag[k] * pre_scale;
+      }
     }
 
-    if (!knf_rfft_compute(fft, frame)) {
+    if (!knf_rfft_compute_batch_with_scratch(fft, frame, count, n_fft,
+                                             scratch)) {
       goto cleanup;
     }
-    for (int32_t k = 0; k < n_fft; ++k) {
-      frame[k] *= inv_n;
-    }
 
-    if (window.size > 0) {
-      for (int32_t k = 0; k < n_fft && k < window.size; ++k) {
-        frame[k] *= window.data[k];
+    for (int32_t b = 0; b < count; ++b) {
+      float *f = frame + (size_t)b * n_fft;
+      for (int32_t k = 0; k < n_fft; ++k) {
+        f[k] *= inv_n;
+      }
+
+      if (window.size > 0) {
+        for (int32_t k = 0; k < n_fft && k < window.size; ++k) {
+          f[k] *= window.data[k];
+        }
       }
-    }
 
-    int32_t start = i * hop;
-    for (int32_t k = 0; k < n_fft; ++k) {
-      samples[start + k] += frame[k];
+      int32_t start = (i0 + b) * hop;
+      for (int32_t k = 0; k < n_fft; ++k) {
+        samples[start + k] += f[k];
+      }
     }
   }
 
@@ -170,6 +186,7 @@ void knf_istft_config_default(knf_istft_config *cfg) {
 
 cleanup:
   free(frame);
+  free(scratch);
   free(samples);
   free(denom);
   knf_rfft_destroy(fft);
@@ -2,26 +2,120 @@
 
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "kaldi-native-fbank/kaldi-math.h"
 
+// Philox4x32 multipliers and Weyl key increments (Salmon et al., SC'11).
+constexpr uint32_t KNF_PHILOX_M0 = 0xD2511F53u;
+constexpr uint32_t KNF_PHILOX_M1 = 0xCD9E8D57u;
+constexpr uint32_t KNF_PHILOX_W0 = 0x9E3779B9u;
+constexpr uint32_t KNF_PHILOX_W1 = 0xBB67AE85u;
+constexpr int32_t KNF_PHILOX_ROUNDS = 10;
+// Blocks generated side by side; the loops over them vectorize.
+constexpr int32_t KNF_PHILOX_LANES = 8;
+// Bits of sqrt(0.5f): mantissas are reduced to [sqrt(0.5), sqrt(2)).
+constexpr uint32_t KNF_LOG_SQRT_HALF_BITS = 0x3f3504f3u;
+// ln 2 split into a part exact in a few bits and the remainder (Cephes).
+constexpr float KNF_LOG_LN2_HI = 0.693359375f;
+constexpr float KNF_LOG_LN2_LO = -2.12194440e-4f;
+
 void knf_random_state_init(knf_random_state *state) {
   if (state == nullptr) {
     return;
   }
-  state->seed = (unsigned)rand();
+  knf_random_state_seed(state, ((uint64_t)(unsigned)rand() << 32) |
+                                   (unsigned)rand());
+}
+
+void knf_random_state_seed(knf_random_state *state, uint64_t seed) {
+  if (state == nullptr) {
+    return;
+  }
+  state->key[0] = (uint32_t)seed;
+  state->key[1] = (uint32_t)(seed >> 32);
+  state->counter = 0;
+}
+
+void knf_rand_block(const knf_random_state *state, uint64_t counter,
+                    uint32_t out[4]) {
+  uint32_t c0 = (uint32_t)counter;
+  uint32_t c1 = (uint32_t)(counter >> 32);
+  uint32_t c2 = 0;
+  uint32_t c3 = 0;
+  uint32_t k0 = state->key[0];
+  uint32_t k1 = state->key[1];
+  for (int32_t r = 0; r < KNF_PHILOX_ROUNDS; ++r) {
+    uint64_t p0 = (uint64_t)KNF_PHILOX_M0 * c0;
+    uint64_t p1 = (uint64_t)KNF_PHILOX_M1 * c2;
+    c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+    c1 = (uint32_t)p1;
+    c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+    c3 = (uint32_t)p0;
+    k0 += KNF_PHILOX_W0;
+    k1 += KNF_PHILOX_W1;
+  }
+  out[0] = c0;
+  out[1] = c1;
+  out[2] = c2;
+  out[3] = c3;
+}
+
+// KNF_PHILOX_LANES consecutive blocks from counter; out[i][j] is value i of
+// block counter + j.
+static void knf_rand_lanes(const knf_random_state *state, uint64_t counter,
+                           uint32_t out[4][KNF_PHILOX_LANES]) {
+  uint32_t c0[KNF_PHILOX_LANES];
+  uint32_t c1[KNF_PHILOX_LANES];
+  uint32_t c2[KNF_PHILOX_LANES] = {};
+  uint32_t c3[KNF_PHILOX_LANES] = {};
+  for (int32_t j = 0; j < KNF_PHILOX_LANES; ++j) {
+    c0[j] = (uint32_t)(counter + (uint64_t)j);
+    c1[j] = (uint32_t)((counter + (uint64_t)j) >> 32);
+  }
+  uint32_t k0 = state->key[0];
+  uint32_t k1 = state->key[1];
+  for (int32_t r = 0; r < KNF_PHILOX_ROUNDS; ++r) {
+    for (int32_t j = 0; j < KNF_PHILOX_LANES; ++j) {
+      uint64_t p0 = (uint64_t)KNF_PHILOX_M0 * c0[j];
+      uint64_t p1 = (uint64_t)KNF_PHILOX_M1 * c2[j];
+      c0[j] = (uint32_t)(p1 >> 32) ^ c1[j] ^ k0;
+      c1[j] = (uint32_t)p1;
+      c2[j] = (uint32_t)(p0 >> 32) ^ c3[j] ^ k1;
+      c3[j] = (uint32_t)p0;
+    }
+    k0 += KNF_PHILOX_W0;
+    k1 += KNF_PHILOX_W1;
+  }
+  for (int32_t j = 0; j < KNF_PHILOX_LANES; ++j) {
+    out[0][j] = c0[j];
+    out[1][j] = c1[j];
+    out[2][j] = c2[j];
+    out[3][j] = c3[j];
+  }
+}
+
+// Top 24 bits, centred in their interval: uniform in (0, 1), never 0 or 1.
+static inline float knf_rand_to_unit(uint32_t x) {
+  return ((float)(x >> 8) + 0.5f) * 0x1.0p-24f;
 }
 
 int knf_rand(knf_random_state *state) {
   if (state == nullptr) {
     return rand();
   }
-  state->seed = (1103515245 * state->seed + 12345) & 0x7fffffff;
-  return (int)state->seed;
+  uint32_t block[4];
+  knf_rand_block(state, state->counter++, block);
+  return (int)(block[0] >> 1);
 }
 
 float knf_rand_uniform(knf_random_state *state) {
-  return (float)((knf_rand(state) + 1.0) / (RAND_MAX + 2.0));
+  if (state == nullptr) {
+    return (float)((rand() + 1.0) / (RAND_MAX + 2.0));
+  }
+  uint32_t block[4];
+  knf_rand_block(state, state->counter++, block);
+  return knf_rand_to_unit(block[0]);
 }
 
 float knf_rand_gauss(knf_random_state *state) {
@@ -30,6 +124,40 @@ float knf_rand_gauss(knf_random_state *state) {
   return (float)(sqrtf(-2.0f * logf(u1)) * cosf(2.0f * KNF_PI_F * u2));
 }
 
+void knf_rand_uniform_block(knf_random_state *state, float *out, int32_t n) {
+  if (state == nullptr || out == nullptr || n <= 0) {
+    return;
+  }
+  uint32_t lanes[4][KNF_PHILOX_LANES];
+  for (int32_t i = 0; i < n; i += 4 * KNF_PHILOX_LANES) {
+    knf_rand_lanes(state, state->counter, lanes);
+    int32_t m = n - i < 4 * KNF_PHILOX_LANES ? n - i : 4 * KNF_PHILOX_LANES;
+    for (int32_t k = 0; k < m; ++k) {
+      out[i + k] = knf_rand_to_unit(lanes[k % 4][k / 4]);
+    }
+    state->counter += (uint64_t)(m + 3) / 4;
+  }
+}
+
+void knf_rand_gauss_block(knf_random_state *state, float *out, int32_t n) {
+  if (state == nullptr || out == nullptr || n <= 0) {
+    return;
+  }
+  knf_rand_uniform_block(state, out, n);
+  // Box-Muller on values 0, 1 and 2, 3 of each block. A lone last value
+  // pairs with a fresh uniform.
+  for (int32_t i = 0; i + 1 < n; i += 2) {
+    float r = sqrtf(-2.0f * logf(out[i]));
+    float theta = 2.0f * KNF_PI_F * out[i + 1];
+    out[i] = r * cosf(theta);
+    out[i + 1] = r * sinf(theta);
+  }
+  if (n % 2 == 1) {
+    float u = knf_rand_uniform(state);
+    out[n - 1] = sqrtf(-2.0f * logf(out[n - 1])) * cosf(2.0f * KNF_PI_F * u);
+  }
+}
+
 void knf_sqrt_inplace(float *in_out, int32_t n) {
   if (in_out == nullptr || n <= 0) {
     return;
@@ -39,3 +167,48 @@ void knf_sqrt_inplace(float *in_out, int32_t n) {
     in_out[i] = sqrtf(in_out[i]);
   }
 }
+
+void knf_log_floor(float *in_out, int32_t n, float floor) {
+  if (in_out == nullptr || n <= 0) {
+    return;
+  }
+
+  for (int32_t i = 0; i < n; ++i) {
+    float v = in_out[i];
+    in_out[i] = logf(v < floor ? floor : v);
+  }
+}
+
+// x = 2^k * m with m in [sqrt(0.5), sqrt(2)) by integer operations on the
+// bits, then log(m) = f - f^2/2 + f^3 P(f) with f = m - 1 and the Cephes
+// logf polynomial. No branches or calls, so the loop vectorizes.
+void knf_log_floor_fast(float *in_out, int32_t n, float floor) {
+  if (in_out == nullptr || n <= 0) {
+    return;
+  }
+
+  for (int32_t i = 0; i < n; ++i) {
+    float v = in_out[i];
+    v = v < floor ? floor : v;
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    bits += 0x3f800000u - KNF_LOG_SQRT_HALF_BITS;
+    float k = (float)((int32_t)(bits >> 23) - 127);
+    bits = (bits & 0x007fffffu) + KNF_LOG_SQRT_HALF_BITS;
+    float m;
+    memcpy(&m, &bits, sizeof(m));
+    float f = m - 1.0f;
+    float z = f * f;
+    float p = 7.0376836292e-2f;
+    p = p * f - 1.1514610310e-1f;
+    p = p * f + 1.1676998740e-1f;
+    p = p * f - 1.2420140846e-1f;
+    p = p * f + 1.4249322787e-1f;
+    p = p * f - 1.6668057665e-1f;
+    p = p * f + 2.0000714765e-1f;
+    p = p * f - 2.4999993993e-1f;
+    p = p * f + 3.3333331174e-1f;
+    float y = f * z * p + k * KNF_LOG_LN2_LO - 0.5f * z;
+    in_out[i] = f + y + k * KNF_LOG_LN2_HI;
+  }
+}
@@ -7,6 +7,22 @@
 
 #include "kaldi-native-fbank/log.h"
 #include "kaldi-native-fbank/mel-computations.h"
+#include "spin-lock.h"
+
+// Lanes of the partial sums in knf_mel_compute, so that the band loop
+// vectorizes.
+constexpr int32_t KNF_MEL_LANES = 8;
+// Frames knf_mel_compute_batch runs through a filter together; their
+// partial sums stay in registers.
+constexpr int32_t KNF_MEL_FRAME_BLOCK = 4;
+// Frames whose spectra are kept hot in cache while every filter runs over
+// them.
+constexpr int32_t KNF_MEL_FRAME_CHUNK = 64;
+// Warped banks that stay around after their last user releases them.
+constexpr int32_t KNF_MEL_CACHE_SIZE = 16;
+// Warps are rounded to multiples of 1 / KNF_MEL_WARP_STEPS before building
+// banks, so nearby factors share an entry.
+constexpr int32_t KNF_MEL_WARP_STEPS = 1000;
 
 static float knf_mel_scale(float freq) {
   return 1127.0f * logf(1.0f + freq / 700.0f);
@@ -16,6 +32,36 @@ static float knf_inverse_mel_scale(float mel) {
   return 700.0f * (expf(mel / 1127.0f) - 1.0f);
 }
 
+#ifndef KNF_NO_EMBEDDED_TABLES
+// Banks for the inputs knf_init_weights reads when vtln_warp is 1; keep the
+// two in sync.
+typedef struct {
+  int32_t num_bins;
+  float low_freq;
+  float high_freq;
+  float samp_freq;
+  int32_t padded;
+  knf_mel_banks banks;
+} knf_mel_table;
+
+#include "mel-tables.h"
+
+static knf_mel_banks *knf_find_mel_table(const knf_mel_opts *opts,
+                                         const knf_frame_opts *frame_opts) {
+  int32_t padded = knf_padded_window_size(frame_opts);
+  for (size_t i = 0; i < sizeof(knf_mel_tables) / sizeof(knf_mel_tables[0]);
+       ++i) {
+    const knf_mel_table *t = &knf_mel_tables[i];
+    if (t->num_bins == opts->num_bins && t->low_freq == opts->low_freq &&
+        t->high_freq == opts->high_freq &&
+        t->samp_freq == frame_opts->samp_freq && t->padded == padded) {
+      return (knf_mel_banks *)&t->banks;
+    }
+  }
+  return nullptr;
+}
+#endif
+
 void knf_mel_opts_default(knf_mel_opts *opts) {
   if (opts == nullptr) {
     return;
@@ -57,6 +103,20 @@ static float knf_vtln_warp_mel(float vtln_low, float vtln_high, float low_freq,
   return knf_mel_scale(warped);
 }
 
+// Frees the arrays of banks and zeroes its sizes.
+static void knf_mel_banks_free_arrays(knf_mel_banks *banks) {
+  free(banks->weights);
+  free(banks->first_bin);
+  free(banks->length);
+  free(banks->start);
+  banks->weights = nullptr;
+  banks->first_bin = nullptr;
+  banks->length = nullptr;
+  banks->start = nullptr;
+  banks->num_bins = 0;
+  banks->num_fft_bins = 0;
+}
+
 static bool knf_init_weights(const knf_mel_opts *opts,
                              const knf_frame_opts *frame_opts, float vtln_warp,
                              knf_mel_banks *banks) {
@@ -98,14 +158,24 @@ static bool knf_init_weights(const knf_mel_opts *opts,
 
   banks->num_bins = opts->num_bins;
   banks->num_fft_bins = num_fft_bins;
-  if ((size_t)opts->num_bins > SIZE_MAX / (size_t)num_fft_bins) {
-    return false;
-  }
-  banks->weights = (float *)calloc(
-      (size_t)opts->num_bins * (size_t)num_fft_bins, sizeof(float));
-  if (banks->weights == nullptr) {
+  size_t num_bins = (size_t)opts->num_bins;
+  // One filter at a time goes through a dense row; only its band is kept.
+  float *row = (float *)malloc(sizeof(float) * (size_t)num_fft_bins);
+  int32_t weights_cap = num_fft_bins;
+  banks->weights = (float *)malloc(sizeof(float) * (size_t)weights_cap);
+  banks->first_bin = (int32_t *)calloc(num_bins, sizeof(int32_t));
+  banks->length = (int32_t *)calloc(num_bins, sizeof(int32_t));
+  banks->start = (int32_t *)calloc(num_bins, sizeof(int32_t));
+  if (row == nullptr || banks->weights == nullptr ||
+      banks->first_bin == nullptr || banks->length == nullptr ||
+      banks->start == nullptr) {
+    free(row);
+    knf_mel_banks_free_arrays(banks);
     return false;
   }
+  banks->bin_begin = num_fft_bins;
+  banks->bin_end = 0;
+  int32_t num_weights = 0;
 
   for (int32_t bin = 0; bin < opts->num_bins; ++bin) {
     float left_mel = mel_low + bin * mel_delta;
@@ -122,6 +192,7 @@ static bool knf_init_weights(const knf_mel_opts *opts,
     }
 
     int32_t first = -1, last = -1;
+    memset(row, 0, sizeof(float) * (size_t)num_fft_bins);
     for (int32_t i = 0; i < num_fft_bins; ++i) {
       float freq = fft_bin_width * i;
       float mel = knf_mel_scale(freq);
@@ -136,20 +207,256 @@ static bool knf_init_weights(const knf_mel_opts *opts,
       if (weight != 0.0f) {
         if (first == -1) first = i;
         last = i;
-        banks->weights[bin * num_fft_bins + i] = weight;
+        row[i] = weight;
       }
     }
     if (first == -1 || last == -1) {
-      free(banks->weights);
-      banks->weights = nullptr;
-      banks->num_bins = 0;
-      banks->num_fft_bins = 0;
+      free(row);
+      knf_mel_banks_free_arrays(banks);
+      return false;
+    }
+    int32_t length = last - first + 1;
+    if (num_weights > INT32_MAX - length) {
+      free(row);
+      knf_mel_banks_free_arrays(banks);
       return false;
     }
+    if (num_weights + length > weights_cap) {
+      weights_cap = num_weights + length > INT32_MAX / 2
+                        ? INT32_MAX
+                        : 2 * (num_weights + length);
+      auto weights = (float *)realloc(banks->weights,
+                                      sizeof(float) * (size_t)weights_cap);
+      if (weights == nullptr) {
+        free(row);
+        knf_mel_banks_free_arrays(banks);
+        return false;
+      }
+      banks->weights = weights;
+    }
+    memcpy(banks->weights + num_weights, row + first,
+           sizeof(float) * (size_t)length);
+    banks->first_bin[bin] = first;
+    banks->length[bin] = length;
+    banks->start[bin] = num_weights;
+    num_weights += length;
+    if (first < banks->bin_begin) banks->bin_begin = first;
+    if (last + 1 > banks->bin_end) banks->bin_end = last + 1;
   }
+  free(row);
   return true;
 }
 
+// Warped banks shared through knf_mel_cache, with the inputs
+// knf_init_weights read to build them.
+typedef struct {
+  knf_mel_banks banks;  // first, so that a pointer to it is the entry
+  int32_t num_bins;
+  float low_freq;
+  float high_freq;
+  float vtln_low;
+  float vtln_high;
+  float samp_freq;
+  int32_t padded;
+  int32_t warp_key;  // the warp in units of 1 / KNF_MEL_WARP_STEPS
+  int32_t refs;      // knf_mel_banks_acquire calls not yet released
+  bool cached;       // listed in knf_mel_cache; freed with the last ref if not
+  uint64_t last_used;
+} knf_mel_cached;
+
+// Guards knf_mel_cache, knf_mel_clock and the refs of every entry.
+static knf_spin_lock knf_mel_lock = false;
+static knf_mel_cached *knf_mel_cache[KNF_MEL_CACHE_SIZE];
+static uint64_t knf_mel_clock = 0;
+
+static void knf_mel_lock_acquire(void) {
+  knf_spin_lock_acquire(&knf_mel_lock);
+}
+
+static void knf_mel_lock_release(void) {
+  knf_spin_lock_release(&knf_mel_lock);
+}
+
+static bool knf_mel_cached_matches(const knf_mel_cached *e,
+                                   const knf_mel_cached *key) {
+  return e->num_bins == key->num_bins && e->low_freq == key->low_freq &&
+         e->high_freq == key->high_freq && e->vtln_low == key->vtln_low &&
+         e->vtln_high == key->vtln_high && e->samp_freq == key->samp_freq &&
+         e->padded == key->padded && e->warp_key == key->warp_key;
+}
+
+static void knf_mel_cached_free(knf_mel_cached *e) {
+  if (e == nullptr) return;
+  knf_mel_banks_free_arrays(&e->banks);
+  free(e);
+}
+
+// The cached entry matching key with one more ref, or nullptr. Call with the
+// lock held.
+static knf_mel_cached *knf_mel_cache_find(const knf_mel_cached *key) {
+  for (int32_t i = 0; i < KNF_MEL_CACHE_SIZE; ++i) {
+    knf_mel_cached *e = knf_mel_cache[i];
+    if (e != nullptr && knf_mel_cached_matches(e, key)) {
+      ++e->refs;
+      e->last_used = ++knf_mel_clock;
+      return e;
+    }
+  }
+  return nullptr;
+}
+
+[[nodiscard]] knf_mel_banks *knf_mel_banks_acquire(
+    const knf_mel_opts *opts, const knf_frame_opts *frame_opts,
+    float vtln_warp) {
+  if (opts == nullptr || frame_opts == nullptr || !(vtln_warp > 0.0f) ||
+      vtln_warp > (float)(INT32_MAX / KNF_MEL_WARP_STEPS)) {
+    return nullptr;
+  }
+
+  knf_mel_cached key = {};
+  key.num_bins = opts->num_bins;
+  key.low_freq = opts->low_freq;
+  key.high_freq = opts->high_freq;
+  key.vtln_low = opts->vtln_low;
+  key.vtln_high = opts->vtln_high;
+  key.samp_freq = frame_opts->samp_freq;
+  key.padded = knf_padded_window_size(frame_opts);
+  key.warp_key = (int32_t)lroundf(vtln_warp * KNF_MEL_WARP_STEPS);
+  if (key.warp_key <= 0) return nullptr;
+  float warp = (float)key.warp_key / KNF_MEL_WARP_STEPS;
+#ifndef KNF_NO_EMBEDDED_TABLES
+  if (warp == 1.0f) {
+    knf_mel_banks *table = knf_find_mel_table(opts, frame_opts);
+    if (table != nullptr) return table;
+  }
+#endif
+
+  knf_mel_lock_acquire();
+  knf_mel_cached *found = knf_mel_cache_find(&key);
+  knf_mel_lock_release();
+  if (found != nullptr) return &found->banks;
+
+  // Build outside the lock; another thread may race us to the same banks.
+  auto entry = (knf_mel_cached *)calloc(1, sizeof(knf_mel_cached));
+  if (entry == nullptr) return nullptr;
+  *entry = key;
+  if (!knf_init_weights(opts, frame_opts, warp, &entry->banks)) {
+    free(entry);
+    return nullptr;
+  }
+
+  knf_mel_cached *evicted = nullptr;
+  knf_mel_lock_acquire();
+  found = knf_mel_cache_find(&key);
+  if (found != nullptr) {
+    knf_mel_lock_release();
+    knf_mel_cached_free(entry);
+    return &found->banks;
+  }
+  // An empty slot, or else the least recently used entry nobody holds.
+  int32_t slot = -1;
+  for (int32_t i = 0; i < KNF_MEL_CACHE_SIZE; ++i) {
+    knf_mel_cached *e = knf_mel_cache[i];
+    if (e == nullptr) {
+      slot = i;
+      break;
+    }
+    if (e->refs == 0 &&
+        (slot < 0 || e->last_used < knf_mel_cache[slot]->last_used)) {
+      slot = i;
+    }
+  }
+  entry->refs = 1;
+  entry->last_used = ++knf_mel_clock;
+  if (slot >= 0) {
+    evicted = knf_mel_cache[slot];
+    knf_mel_cache[slot] = entry;
+    entry->cached = true;
+  }
+  knf_mel_lock_release();
+  knf_mel_cached_free(evicted);
+  return &entry->banks;
+}
+
+void knf_mel_banks_release(knf_mel_banks *banks) {
+  if (banks == nullptr || banks->embedded) return;
+  auto entry = (knf_mel_cached *)banks;
+  knf_mel_lock_acquire();
+  const bool drop = --entry->refs == 0 && !entry->cached;
+  knf_mel_lock_release();
+  if (drop) knf_mel_cached_free(entry);
+}
+
+void knf_mel_clear_cache(void) {
+  knf_mel_cached *unused[KNF_MEL_CACHE_SIZE] = {};
+  knf_mel_lock_acquire();
+  for (int32_t i = 0; i < KNF_MEL_CACHE_SIZE; ++i) {
+    knf_mel_cached *e = knf_mel_cache[i];
+    if (e == nullptr) continue;
+    if (e->refs == 0) {
+      unused[i] = e;
+    } else {
+      e->cached = false;  // freed by its last knf_mel_banks_release
+    }
+    knf_mel_cache[i] = nullptr;
+  }
+  knf_mel_lock_release();
+  for (int32_t i = 0; i < KNF_MEL_CACHE_SIZE; ++i) {
+    knf_mel_cached_free(unused[i]);
+  }
+}
+
+const knf_mel_banks *knf_mel_warped_get(knf_mel_warped *w,
+                                        const knf_mel_banks *unwarped,
+                                        const knf_mel_opts *opts,
+                                        const knf_frame_opts *frame_opts,
+                                        float vtln_warp) {
+  if (vtln_warp == 1.0f) return unwarped;
+  if (w->banks == nullptr || w->warp != vtln_warp) {
+    knf_mel_banks *banks = knf_mel_banks_acquire(opts, frame_opts, vtln_warp);
+    if (banks == nullptr) return nullptr;
+    knf_mel_banks_release(w->banks);
+    w->banks = banks;
+    w->warp = vtln_warp;
+  }
+  return w->banks;
+}
+
+void knf_mel_warped_release(knf_mel_warped *w) {
+  if (w == nullptr) return;
+  knf_mel_banks_release(w->banks);
+  w->banks = nullptr;
+}
+
+[[nodiscard]] bool knf_mel_warps_acquire(
+    knf_mel_banks *unwarped, const knf_mel_opts *opts,
+    const knf_frame_opts *frame_opts, const float *vtln_warps,
+    int32_t num_warps, knf_mel_banks **banks, int32_t *bin_begin,
+    int32_t *bin_end) {
+  *bin_begin = unwarped->num_fft_bins;
+  *bin_end = 0;
+  for (int32_t k = 0; k < num_warps; ++k) {
+    banks[k] = vtln_warps[k] == 1.0f
+                   ? unwarped
+                   : knf_mel_banks_acquire(opts, frame_opts, vtln_warps[k]);
+    if (banks[k] == nullptr) {
+      knf_mel_warps_release(unwarped, banks, k);
+      return false;
+    }
+    if (banks[k]->bin_begin < *bin_begin) *bin_begin = banks[k]->bin_begin;
+    if (banks[k]->bin_end > *bin_end) *bin_end = banks[k]->bin_end;
+  }
+  return true;
+}
+
+void knf_mel_warps_release(const knf_mel_banks *unwarped,
+                           knf_mel_banks **banks, int32_t num_warps) {
+  for (int32_t k = 0; k < num_warps; ++k) {
+    if (banks[k] != unwarped) knf_mel_banks_release(banks[k]);
+    banks[k] = nullptr;
+  }
+}
+
 [[nodiscard]] knf_mel_banks *knf_mel_banks_create(
     const knf_mel_opts *opts, const knf_frame_opts *frame_opts,
     float vtln_warp) {
@@ -157,6 +464,12 @@ static bool knf_init_weights(const knf_mel_opts *opts,
     return nullptr;
   }
 
+#ifndef KNF_NO_EMBEDDED_TABLES
+  if (vtln_warp == 1.0f) {
+    knf_mel_banks *table = knf_find_mel_table(opts, frame_opts);
+    if (table != nullptr) return table;
+  }
+#endif
   auto banks = (knf_mel_banks *)calloc(1, sizeof(knf_mel_banks));
   if (banks == nullptr) return nullptr;
   if (!knf_init_weights(opts, frame_opts, vtln_warp, banks)) {
@@ -167,9 +480,8 @@ static bool knf_init_weights(const knf_mel_opts *opts,
 }
 
 void knf_mel_banks_destroy(knf_mel_banks *banks) {
-  if (banks == nullptr) return;
-  free(banks->weights);
-  banks->weights = nullptr;
+  if (banks == nullptr || banks->embedded) return;
+  knf_mel_banks_free_arrays(banks);
   free(banks);
 }
 
@@ -181,14 +493,78 @@ void knf_mel_compute(const knf_mel_banks *banks, const float *fft_energies,
     return;
   }
 
-  int32_t num_bins = banks->num_bins;
-  int32_t cols = banks->num_fft_bins;
-  for (int32_t r = 0; r < num_bins; ++r) {
-    float sum = 0.0f;
-    const float *w = banks->weights + r * cols;
-    for (int32_t c = 0; c < cols; ++c) {
-      sum += w[c] * fft_energies[c];
+  for (int32_t r = 0; r < banks->num_bins; ++r) {
+    const float *w = banks->weights + banks->start[r];
+    const float *x = fft_energies + banks->first_bin[r];
+    int32_t n = banks->length[r];
+    float sums[KNF_MEL_LANES] = {};
+    int32_t i = 0;
+    for (; i + KNF_MEL_LANES <= n; i += KNF_MEL_LANES) {
+      for (int32_t j = 0; j < KNF_MEL_LANES; ++j) {
+        sums[j] += w[i + j] * x[i + j];
+      }
     }
+    for (; i < n; ++i) sums[0] += w[i] * x[i];
+    float sum = 0.0f;
+    for (int32_t j = 0; j < KNF_MEL_LANES; ++j) sum += sums[j];
     mel_energies_out[r] = sum;
   }
 }
+
+// Filter r over the block of KNF_MEL_FRAME_BLOCK spectra starting at x.
+static void knf_mel_filter_block(const knf_mel_banks *banks, int32_t r,
+                                 const float *x, int32_t stride, float *out,
+                                 int32_t out_stride) {
+  const float *w = banks->weights + banks->start[r];
+  int32_t n = banks->length[r];
+  x += banks->first_bin[r];
+  float sums[KNF_MEL_FRAME_BLOCK][KNF_MEL_LANES] = {};
+  int32_t i = 0;
+  for (; i + KNF_MEL_LANES <= n; i += KNF_MEL_LANES) {
+    for (int32_t f = 0; f < KNF_MEL_FRAME_BLOCK; ++f) {
+      const float *xf = x + (size_t)f * (size_t)stride + i;
+      for (int32_t j = 0; j < KNF_MEL_LANES; ++j) {
+        sums[f][j] += w[i + j] * xf[j];
+      }
+    }
+  }
+  for (; i < n; ++i) {
+    for (int32_t f = 0; f < KNF_MEL_FRAME_BLOCK; ++f) {
+      sums[f][0] += w[i] * x[(size_t)f * (size_t)stride + i];
+    }
+  }
+  for (int32_t f = 0; f < KNF_MEL_FRAME_BLOCK; ++f) {
+    float sum = 0.0f;
+    for (int32_t j = 0; j < KNF_MEL_LANES; ++j) sum += sums[f][j];
+    out[(size_t)f * (size_t)out_stride + r] = sum;
+  }
+}
+
+void knf_mel_compute_batch(const knf_mel_banks *banks,
+                           const float *fft_energies, int32_t count,
+                           int32_t stride, float *mel_energies_out,
+                           int32_t out_stride) {
+  if (banks == nullptr || fft_energies == nullptr ||
+      mel_energies_out == nullptr || banks->weights == nullptr ||
+      banks->num_bins <= 0 || count <= 0 || stride < banks->bin_end ||
+      out_stride < banks->num_bins) {
+    return;
+  }
+  for (int32_t c0 = 0; c0 < count; c0 += KNF_MEL_FRAME_CHUNK) {
+    int32_t chunk =
+        count - c0 < KNF_MEL_FRAME_CHUNK ? count - c0 : KNF_MEL_FRAME_CHUNK;
+    int32_t blocked = chunk / KNF_MEL_FRAME_BLOCK * KNF_MEL_FRAME_BLOCK;
+    const float *x = fft_energies + (size_t)c0 * (size_t)stride;
+    float *out = mel_energies_out + (size_t)c0 * (size_t)out_stride;
+    for (int32_t r = 0; r < banks->num_bins; ++r) {
+      for (int32_t f = 0; f < blocked; f += KNF_MEL_FRAME_BLOCK) {
+        knf_mel_filter_block(banks, r, x + (size_t)f * (size_t)stride, stride,
+                             out + (size_t)f * (size_t)out_stride, out_stride);
+      }
+    }
+    for (int32_t f = blocked; f < chunk; ++f) {
+      knf_mel_compute(banks, x + (size_t)f * (size_t)stride,
+                      out + (size_t)f * (size_t)out_stride);
+    }
+  }
+}
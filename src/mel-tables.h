@@ -0,0 +1,569 @@
+// Mel filter banks of the standard configurations, dumped from
+// knf_mel_banks_create without VTLN warping. Generated by
+// tools/gen_feature_tables.c (zig build tables); do not edit.
+
+// 16 kHz 80-bin fbank
+static const float knf_mel_weights_0[501] = {
+    0x1.0209a6p-1f, 0x1.15f6e4p-3f, 0x1.ba8246p-1f, 0x1.a9000cp-1f,
+    0x1.5bffdp-3f, 0x1.26530ap-1f, 0x1.b359eep-2f, 0x1.77181p-2f,
+    0x1.4473f8p-1f, 0x1.9bcfe6p-3f, 0x1.990c06p-1f, 0x1.380a42p-4f,
+    0x1.d8feb8p-1f, 0x1.fa52c4p-1f, 0x1.6b4efcp-7f, 0x1.dfa96ep-1f,
+    0x1.02b496p-4f, 0x1.d5e392p-1f, 0x1.50e374p-4f, 0x1.dbf9eap-1f,
+    0x1.2030aap-4f, 0x1.f0fddcp-1f, 0x1.413a04p-5f, 0x1.e0449ap-6f,
+    0x1.ebec6p-1f, 0x1.11ca38p-3f, 0x1.bb8d72p-1f, 0x1.02c446p-2f,
+    0x1.7e9ddep-1f, 0x1.94724ap-2f, 0x1.35c6dap-1f, 0x1.1e5ab4p-1f,
+    0x1.c34a98p-2f, 0x1.7d358p-1f, 0x1.059502p-2f, 0x1.e643fcp-1f,
+    0x1.642254p-3f, 0x1.9bc04p-5f, 0x1.a6f76ap-1f, 0x1.aa202ep-2f,
+    0x1.2aefe8p-1f, 0x1.59edd4p-1f, 0x1.4c2458p-2f, 0x1.e73d6cp-1f,
+    0x1.f285aap-3f, 0x1.8c2946p-5f, 0x1.835e96p-1f, 0x1.19bfd2p-1f,
+    0x1.cc805ap-2f, 0x1.be47eap-1f, 0x1.a7ab7p-3f, 0x1.06e05ap-3f,
+    0x1.961524p-1f, 0x1.1c5ffcp-1f, 0x1.c74008p-2f, 0x1.d56294p-1f,
+    0x1.29642ep-2f, 0x1.54eb58p-4f, 0x1.6b4de8p-1f, 0x1.5a124ap-1f,
+    0x1.2a429ep-4f, 0x1.4bdb6ep-2f, 0x1.dab7acp-1f, 0x1.ec3d5ep-2f,
+    0x1.09e152p-1f, 0x1.cc613ap-1f, 0x1.4fbeb6p-2f, 0x1.9cf63p-4f,
+    0x1.5820a4p-1f, 0x1.886afp-1f, 0x1.b76056p-3f, 0x1.de5442p-3f,
+    0x1.9227eap-1f, 0x1.57fca6p-1f, 0x1.1ac55cp-3f, 0x1.5006b4p-2f,
+    0x1.b94ea8p-1f, 0x1.39d126p-1f, 0x1.89b578p-4f, 0x1.8c5db6p-2f,
+    0x1.cec95p-1f, 0x1.2cc014p-1f, 0x1.62694ep-4f, 0x1.a67fdap-2f,
+    0x1.d3b2d6p-1f, 0x1.2fbdep-1f, 0x1.b7b302p-4f, 0x1.a0843ep-2f,
+    0x1.c909ap-1f, 0x1.41d7fep-1f, 0x1.412052p-3f, 0x1.7c5004p-2f,
+    0x1.afb7ecp-1f, 0x1.622deap-1f, 0x1.ddbc74p-3f, 0x1.3ba42cp-2f,
+    0x1.8890e2p-1f, 0x1.8ff39cp-1f, 0x1.574c5cp-2f, 0x1.c0318ep-3f,
+    0x1.5459d2p-1f, 0x1.ca6ec4p-1f, 0x1.d871f2p-2f, 0x1.0f0a3ap-5f,
+    0x1.ac89dap-4f, 0x1.13c708p-1f, 0x1.ef0f5cp-1f, 0x1.38829p-1f,
+    0x1.8b725ap-3f, 0x1.8efadep-2f, 0x1.9d236ap-1f, 0x1.8fea48p-1f,
+    0x1.7f3ab6p-2f, 0x1.c056ep-3f, 0x1.4062a4p-1f, 0x1.f1e288p-1f,
+    0x1.26ab32p-1f, 0x1.779df4p-3f, 0x1.c3afp-6f, 0x1.b2a99cp-2f,
+    0x1.a21882p-1f, 0x1.9788a4p-1f, 0x1.a6fed8p-2f, 0x1.1be72ep-5f,
+    0x1.a1dd7p-3f, 0x1.2c8094p-1f, 0x1.ee418ep-1f, 0x1.52382ep-1f,
+    0x1.29c09ep-2f, 0x1.5b8fa2p-2f, 0x1.6b1fb2p-1f, 0x1.d9a906p-1f,
+    0x1.20875cp-1f, 0x1.a5baep-3f, 0x1.32b7ccp-4f, 0x1.bef148p-2f,
+    0x1.969148p-1f, 0x1.b454ep-1f, 0x1.012ce4p-1f, 0x1.3fb85ap-3f,
+    0x1.2eac7cp-3f, 0x1.fda636p-2f, 0x1.b011eap-1f, 0x1.a08dfp-1f,
+    0x1.e600dap-2f, 0x1.1cfc12p-3f, 0x1.7dc84p-3f, 0x1.0cff94p-1f,
+    0x1.b8c0fcp-1f, 0x1.9d3e18p-1f, 0x1.e9e9cep-2f, 0x1.396eacp-3f,
+    0x1.8b07a4p-3f, 0x1.0b0b1ap-1f, 0x1.b1a456p-1f, 0x1.a9685p-1f,
+    0x1.06146p-1f, 0x1.9154a6p-3f, 0x1.5a5ebcp-3f, 0x1.f3d74p-2f,
+    0x1.9baad6p-1f, 0x1.c4261p-1f, 0x1.257dd8p-1f, 0x1.10a952p-2f,
+    0x1.decf8p-4f, 0x1.b5045p-2f, 0x1.77ab56p-1f, 0x1.eca394p-1f,
+    0x1.526406p-1f, 0x1.731f56p-2f, 0x1.10f19p-4f, 0x1.35c6c4p-5f,
+    0x1.5b37f4p-2f, 0x1.467056p-1f, 0x1.dde1cep-1f, 0x1.8c0b1ap-1f,
+    0x1.ee9ec6p-2f, 0x1.8f9416p-3f, 0x1.cfd398p-3f, 0x1.08b09ep-1f,
+    0x1.9c1afap-1f, 0x1.d1c58p-1f, 0x1.40ebb4p-1f, 0x1.62a374p-2f,
+    0x1.17978cp-4f, 0x1.71d3fcp-4f, 0x1.7e2896p-2f, 0x1.4eae46p-1f,
+    0x1.dd0d0ep-1f, 0x1.95c888p-1f, 0x1.09ce46p-1f, 0x1.fbfe1cp-3f,
+    0x1.a8dddep-3f, 0x1.ec6372p-2f, 0x1.81007ap-1f, 0x1.f5555cp-1f,
+    0x1.6ccd04p-1f, 0x1.cac2cep-2f, 0x1.7c37aep-3f, 0x1.55546ap-6f,
+    0x1.2665fap-2f, 0x1.1a9e98p-1f, 0x1.a0f214p-1f, 0x1.d9ccfcp-1f,
+    0x1.559adep-1f, 0x1.a4e7e4p-2f, 0x1.414c9ep-3f, 0x1.31981ap-4f,
+    0x1.54ca46p-2f, 0x1.2d8c0ep-1f, 0x1.afacd8p-1f, 0x1.cf34d8p-1f,
+    0x1.4f14e2p-1f, 0x1.9fe0ep-2f, 0x1.4707dep-3f, 0x1.86594p-4f,
+    0x1.61d63ap-2f, 0x1.300f9p-1f, 0x1.ae3e08p-1f, 0x1.d486aap-1f,
+    0x1.583a56p-1f, 0x1.b9b582p-2f, 0x1.898b5ep-3f, 0x1.5bcab4p-4f,
+    0x1.4f8b54p-2f, 0x1.23253ep-1f, 0x1.9d9d28p-1f, 0x1.e8cfdap-1f,
+    0x1.702p-1f, 0x1.f0997ep-2f, 0x1.02ac28p-2f, 0x1.66cf06p-6f,
+    0x1.730262p-5f, 0x1.1fcp-2f, 0x1.07b342p-1f, 0x1.7ea9ecp-1f,
+    0x1.f4c988p-1f, 0x1.95ece6p-1f, 0x1.2174d4p-1f, 0x1.5b98dep-2f,
+    0x1.d7802p-4f, 0x1.a84c6cp-3f, 0x1.bd1658p-2f, 0x1.523392p-1f,
+    0x1.c50ffcp-1f, 0x1.c8dcdp-1f, 0x1.5790f8p-1f, 0x1.ce119ap-2f,
+    0x1.dd0d84p-3f, 0x1.07658p-6f, 0x1.b91986p-4f, 0x1.50de1p-2f,
+    0x1.18f734p-1f, 0x1.88bc9ep-1f, 0x1.f7c4d4p-1f, 0x1.99f02ep-1f,
+    0x1.2c5eb4p-1f, 0x1.7f0ba4p-2f, 0x1.4d8p-3f, 0x1.983f4cp-3f,
+    0x1.a7429ap-2f, 0x1.407a2ep-1f, 0x1.acap-1f, 0x1.e7ee34p-1f,
+    0x1.7d2cd8p-1f, 0x1.1319eep-1f, 0x1.536564p-2f, 0x1.03d52p-3f,
+    0x1.811cbep-5f, 0x1.05a64ep-2f, 0x1.d9cc22p-2f, 0x1.564d4ep-1f,
+    0x1.bf0ab8p-1f, 0x1.d8dfc8p-1f, 0x1.716f6p-1f, 0x1.0aa258p-1f,
+    0x1.48eda8p-2f, 0x1.f757eap-4f, 0x1.3901c2p-4f, 0x1.1d214p-2f,
+    0x1.eabb52p-2f, 0x1.5b892cp-1f, 0x1.c11502p-1f, 0x1.d9fcfcp-1f,
+    0x1.75abe2p-1f, 0x1.11f314p-1f, 0x1.5da51ep-2f, 0x1.311e44p-3f,
+    0x1.301824p-4f, 0x1.14a83cp-2f, 0x1.dc19dap-2f, 0x1.512d7p-1f,
+    0x1.b3b86ep-1f, 0x1.ea5224p-1f, 0x1.88f086p-1f, 0x1.281df8p-1f,
+    0x1.8fb8a4p-2f, 0x1.a09f9p-3f, 0x1.1fda82p-6f, 0x1.5addccp-5f,
+    0x1.dc3deap-3f, 0x1.afc41p-2f, 0x1.3823aep-1f, 0x1.97d81cp-1f,
+    0x1.f7012cp-1f, 0x1.aa60fcp-1f, 0x1.4c4bb8p-1f, 0x1.dd7a6ep-2f,
+    0x1.236cc6p-2f, 0x1.a995p-4f, 0x1.567c12p-3f, 0x1.67688ep-2f,
+    0x1.1142c8p-1f, 0x1.6e499cp-1f, 0x1.cacd6p-1f, 0x1.d931eep-1f,
+    0x1.7db272p-1f, 0x1.22b342p-1f, 0x1.906332p-2f, 0x1.b8bd3ap-3f,
+    0x1.4a7c62p-5f, 0x1.367098p-4f, 0x1.049b1cp-2f, 0x1.ba997cp-2f,
+    0x1.37ce68p-1f, 0x1.91d0b2p-1f, 0x1.eb583ap-1f, 0x1.bb9becp-1f,
+    0x1.6308fap-1f, 0x1.0aed1ap-1f, 0x1.66926ep-2f, 0x1.70667ap-3f,
+    0x1.57cfbcp-7f, 0x1.11905p-3f, 0x1.39ee0ap-2f, 0x1.ea25ccp-2f,
+    0x1.4cb6cap-1f, 0x1.a3e662p-1f, 0x1.faa0c2p-1f, 0x1.af1864p-1f,
+    0x1.594226p-1f, 0x1.03de5ap-1f, 0x1.5dd2a4p-2f, 0x1.698c28p-3f,
+    0x1.922ff6p-7f, 0x1.439e7p-3f, 0x1.4d7bb4p-2f, 0x1.f8434ap-2f,
+    0x1.5116aep-1f, 0x1.a59cf6p-1f, 0x1.f9b74p-1f, 0x1.b29c28p-1f,
+    0x1.5f59bp-1f, 0x1.0c815ep-1f, 0x1.74248ap-2f, 0x1.a02ddcp-3f,
+    0x1.66c094p-5f, 0x1.358f62p-3f, 0x1.414c9ep-2f, 0x1.e6fd42p-2f,
+    0x1.45edbcp-1f, 0x1.97f488p-1f, 0x1.e993f6p-1f, 0x1.c53222p-1f,
+    0x1.745cd6p-1f, 0x1.23ec26p-1f, 0x1.a7bc7p-2f, 0x1.08643ep-2f,
+    0x1.a73ee8p-4f, 0x1.d66eecp-4f, 0x1.174652p-2f, 0x1.b827b4p-2f,
+    0x1.2c21c8p-1f, 0x1.7bcdep-1f, 0x1.cb1822p-1f, 0x1.e5fda4p-1f,
+    0x1.977296p-1f, 0x1.4945aap-1f, 0x1.f6efa2p-2f, 0x1.5c0abp-2f,
+    0x1.83b8fap-3f, 0x1.43284cp-5f, 0x1.a025bap-5f, 0x1.a235acp-3f,
+    0x1.6d74aap-2f, 0x1.04882ep-1f, 0x1.51faa8p-1f, 0x1.9f11c2p-1f,
+    0x1.ebcd7cp-1f, 0x1.c7d212p-1f, 0x1.7bca3p-1f, 0x1.3019fcp-1f,
+    0x1.c986a4p-2f, 0x1.338322p-2f, 0x1.3c5dfap-3f, 0x1.305a98p-7f,
+    0x1.c16f76p-4f, 0x1.086bap-2f, 0x1.9fcc06p-2f, 0x1.1b3caep-1f,
+    0x1.663e7p-1f, 0x1.b0e882p-1f, 0x1.fb3e96p-1f, 0x1.bac04p-1f,
+    0x1.7114p-1f, 0x1.27b9e6p-1f, 0x1.bd65b8p-2f, 0x1.2bfa18p-2f,
+    0x1.3661d4p-3f, 0x1.610a92p-7f, 0x1.14fefep-3f, 0x1.1dd8p-2f,
+    0x1.b08c34p-2f, 0x1.214d24p-1f, 0x1.6a02f4p-1f, 0x1.b2678cp-1f,
+    0x1.fa7bd6p-1f, 0x1.bdbf5ep-1f, 0x1.76490ap-1f, 0x1.2f2128p-1f,
+    0x1.d08d9ep-2f, 0x1.4373fcp-2f, 0x1.6de36cp-3f, 0x1.58454p-5f,
+    0x1.090286p-3f, 0x1.136decp-2f, 0x1.a1bdaep-2f, 0x1.17b93p-1f,
+    0x1.5e4602p-1f, 0x1.a48724p-1f, 0x1.ea7bacp-1f, 0x1.cfd98ep-1f,
+    0x1.8a798p-1f, 0x1.45625cp-1f, 0x1.00951p-1f, 0x1.78215cp-2f,
+    0x1.df4d76p-3f, 0x1.9ee8f8p-4f, 0x1.813396p-4f, 0x1.d61a02p-3f,
+    0x1.753b48p-2f, 0x1.fed5ep-2f, 0x1.43ef52p-1f, 0x1.882ca2p-1f,
+    0x1.cc22ep-1f, 0x1.f02edep-1f, 0x1.acc6c4p-1f, 0x1.69a2f6p-1f,
+    0x1.26c54ep-1f, 0x1.c857e6p-2f, 0x1.43abf2p-2f, 0x1.7f112ep-3f,
+    0x1.df4262p-5f, 0x1.fa2426p-6f, 0x1.4ce4fp-3f, 0x1.2cba14p-2f,
+    0x1.b27564p-2f, 0x1.1bd40cp-1f, 0x1.5e2a08p-1f, 0x1.a03bb4p-1f,
+    0x1.e20bdap-1f, 0x1.dc684ep-1f, 0x1.9b1d12p-1f, 0x1.5a1272p-1f,
+    0x1.194a46p-1f, 0x1.b18392p-2f, 0x1.30f01ep-2f, 0x1.61bbc8p-3f,
+    0x1.8a498p-5f, 0x1.1cbd9p-4f, 0x1.938bbap-3f, 0x1.4bdb1ep-2f,
+    0x1.cd6b76p-2f, 0x1.273e38p-1f, 0x1.6787fp-1f, 0x1.a7910ep-1f,
+    0x1.e75b68p-1f, 0x1.d91828p-1f, 0x1.99c998p-1f, 0x1.5ab8ep-1f,
+    0x1.1be426p-1f, 0x1.ba98bp-2f, 0x1.3de4cp-2f, 0x1.834686p-3f,
+    0x1.17670cp-4f, 0x1.373ec8p-4f, 0x1.98d99ep-3f, 0x1.4a8e4p-2f,
+    0x1.c837b2p-2f, 0x1.22b3a8p-1f, 0x1.610dap-1f, 0x1.9f2e5ep-1f,
+    0x1.dd131ep-1f, 0x1.e54328p-1f, 0x1.a7d382p-1f, 0x1.6a9d18p-1f,
+    0x1.2da0d2p-1f, 0x1.e1bb8ep-2f, 0x1.68a438p-2f, 0x1.dffeacp-3f,
+    0x1.df1d78p-4f,
+};
+static const int32_t knf_mel_first_bin_0[80] = {
+    1, 2, 3, 3, 4, 5, 6, 7,
+    8, 8, 9, 10, 11, 12, 14, 15,
+    16, 17, 18, 19, 21, 22, 23, 25,
+    26, 28, 29, 31, 33, 34, 36, 38,
+    40, 42, 44, 46, 48, 50, 52, 55,
+    57, 59, 62, 65, 67, 70, 73, 76,
+    79, 82, 85, 89, 92, 96, 99, 103,
+    107, 111, 115, 120, 124, 129, 133, 138,
+    143, 148, 154, 159, 165, 171, 177, 183,
+    189, 196, 203, 210, 217, 224, 232, 240,
+};
+static const int32_t knf_mel_length_0[80] = {
+    2, 1, 1, 2, 2, 2, 2, 1,
+    1, 2, 2, 2, 3, 3, 2, 2,
+    2, 2, 3, 3, 2, 3, 3, 3,
+    3, 3, 4, 3, 3, 4, 4, 4,
+    4, 4, 4, 4, 4, 5, 5, 4,
+    5, 6, 5, 5, 6, 6, 6, 6,
+    6, 7, 7, 7, 7, 7, 8, 8,
+    8, 9, 9, 9, 9, 9, 10, 10,
+    11, 11, 11, 12, 12, 12, 12, 13,
+    14, 14, 14, 14, 15, 16, 16, 16,
+};
+static const int32_t knf_mel_start_0[80] = {
+    0, 2, 3, 4, 6, 8, 10, 12,
+    13, 14, 16, 18, 20, 23, 26, 28,
+    30, 32, 34, 37, 40, 42, 45, 48,
+    51, 54, 57, 61, 64, 67, 71, 75,
+    79, 83, 87, 91, 95, 99, 104, 109,
+    113, 118, 124, 129, 134, 140, 146, 152,
+    158, 164, 171, 178, 185, 192, 199, 207,
+    215, 223, 232, 241, 250, 259, 268, 278,
+    288, 299, 310, 321, 333, 345, 357, 369,
+    382, 396, 410, 424, 438, 453, 469, 485,
+};
+
+// Kaldi demo, 23 bins
+static const float knf_mel_weights_1[480] = {
+    0x1.31d28ap-3f, 0x1.1ad144p-1f, 0x1.e0e38ap-1f, 0x1.60b04cp-1f,
+    0x1.52b1c8p-2f, 0x1.3e9f66p-2f, 0x1.56a71cp-1f, 0x1.f8942p-1f,
+    0x1.4ded6ap-1f, 0x1.51f82ep-2f, 0x1.2c3328p-6f, 0x1.daf7dap-7f,
+    0x1.64252cp-2f, 0x1.5703e8p-1f, 0x1.f69e66p-1f, 0x1.6ec82cp-1f,
+    0x1.b1c388p-2f, 0x1.1d9e9ep-3f, 0x1.226fa8p-2f, 0x1.271e3cp-1f,
+    0x1.b89858p-1f, 0x1.ba18ccp-1f, 0x1.30b9a2p-1f, 0x1.562734p-2f,
+    0x1.47a42cp-4f, 0x1.179cd4p-3f, 0x1.9e8cbcp-2f, 0x1.54ec66p-1f,
+    0x1.d70b7ap-1f, 0x1.aa2de2p-1f, 0x1.2e949ep-1f, 0x1.6c0252p-2f,
+    0x1.013982p-3f, 0x1.57487ap-3f, 0x1.a2d6c2p-2f, 0x1.49fed6p-1f,
+    0x1.bfb1ap-1f, 0x1.cd5a16p-1f, 0x1.5d0416p-1f, 0x1.de5d42p-2f,
+    0x1.077c14p-2f, 0x1.a97a46p-5f, 0x1.952f52p-4f, 0x1.45f7d6p-2f,
+    0x1.10d15ep-1f, 0x1.7c41f6p-1f, 0x1.e5685cp-1f, 0x1.b3a386p-1f,
+    0x1.4eca4ap-1f, 0x1.d7ecf6p-2f, 0x1.16276ap-2f, 0x1.6076aep-4f,
+    0x1.3171e8p-3f, 0x1.626b6ap-2f, 0x1.140986p-1f, 0x1.74ec4ap-1f,
+    0x1.d3f12ap-1f, 0x1.ced604p-1f, 0x1.7357d2p-1f, 0x1.198462p-1f,
+    0x1.829884p-2f, 0x1.aa840ap-3f, 0x1.5750a2p-5f, 0x1.894fdcp-4f,
+    0x1.19505cp-2f, 0x1.ccf73ap-2f, 0x1.3eb3bep-1f, 0x1.955efep-1f,
+    0x1.ea8af6p-1f, 0x1.c1bb5cp-1f, 0x1.6f6762p-1f, 0x1.1e6d7cp-1f,
+    0x1.9d857ap-2f, 0x1.00b81ep-2f, 0x1.997bbcp-4f, 0x1.f22528p-4f,
+    0x1.21313ep-2f, 0x1.c32508p-2f, 0x1.313d44p-1f, 0x1.7fa3fp-1f,
+    0x1.ccd088p-1f, 0x1.e73362p-1f, 0x1.9c5e3cp-1f, 0x1.52a7d2p-1f,
+    0x1.0a072p-1f, 0x1.84e86cp-2f, 0x1.ef9ecap-3f, 0x1.b2ce54p-4f,
+    0x1.8cc9dap-5f, 0x1.8e8712p-3f, 0x1.5ab05cp-2f, 0x1.ebf1c2p-2f,
+    0x1.3d8bcap-1f, 0x1.84184ep-1f, 0x1.c9a636p-1f, 0x1.f1c362p-1f,
+    0x1.ae1e34p-1f, 0x1.6b631cp-1f, 0x1.298c1ap-1f, 0x1.d1264cp-2f,
+    0x1.50e50ap-2f, 0x1.a49382p-3f, 0x1.5521a6p-4f, 0x1.c793aep-6f,
+    0x1.478734p-3f, 0x1.2939c8p-2f, 0x1.ace7cep-2f, 0x1.176cdap-1f,
+    0x1.578d7ap-1f, 0x1.96db2p-1f, 0x1.d55bccp-1f, 0x1.ecec44p-1f,
+    0x1.aff75p-1f, 0x1.73c0fap-1f, 0x1.384498p-1f, 0x1.fafb9ep-2f,
+    0x1.86d032p-2f, 0x1.13fefep-2f, 0x1.450028p-3f, 0x1.926092p-5f,
+    0x1.313bc2p-5f, 0x1.4022cp-3f, 0x1.187e0ep-2f, 0x1.8f76cep-2f,
+    0x1.02823p-1f, 0x1.3c97e6p-1f, 0x1.76008p-1f, 0x1.aebff6p-1f,
+    0x1.e6d9f6p-1f, 0x1.e1ad6p-1f, 0x1.aad2c6p-1f, 0x1.74928ep-1f,
+    0x1.3ee9b4p-1f, 0x1.09d464p-1f, 0x1.aaa00cp-2f, 0x1.42b2e8p-2f,
+    0x1.b7b47ep-3f, 0x1.d848f8p-4f, 0x1.1540f2p-6f, 0x1.e52ap-5f,
+    0x1.54b4e4p-3f, 0x1.16dae4p-2f, 0x1.822c98p-2f, 0x1.ec5738p-2f,
+    0x1.2aaffap-1f, 0x1.5ea68cp-1f, 0x1.9212ep-1f, 0x1.c4f6ep-1f,
+    0x1.f755f8p-1f, 0x1.d6cd42p-1f, 0x1.a5707ap-1f, 0x1.7490aep-1f,
+    0x1.442bfp-1f, 0x1.143f2p-1f, 0x1.c991b6p-2f, 0x1.6b8cdp-2f,
+    0x1.0e6ae6p-2f, 0x1.644fbep-3f, 0x1.5aff94p-4f, 0x1.4995eap-4f,
+    0x1.6a3e14p-3f, 0x1.16dea4p-2f, 0x1.77a81ep-2f, 0x1.d781c2p-2f,
+    0x1.1b3724p-1f, 0x1.4a3998p-1f, 0x1.78ca8cp-1f, 0x1.a6ec1p-1f,
+    0x1.d4a00ep-1f, 0x1.fe1792p-1f, 0x1.d1385ap-1f, 0x1.a4c0e8p-1f,
+    0x1.78af34p-1f, 0x1.4d0174p-1f, 0x1.21b5bep-1f, 0x1.ed9522p-2f,
+    0x1.987c5p-2f, 0x1.441e44p-2f, 0x1.e0eddp-3f, 0x1.3b0788p-3f,
+    0x1.2d0874p-4f, 0x1.e86d9ep-9f, 0x1.763d38p-4f, 0x1.6cfc5ep-3f,
+    0x1.0ea198p-2f, 0x1.65fd1ap-2f, 0x1.bc9484p-2f, 0x1.09356ep-1f,
+    0x1.33c1d8p-1f, 0x1.5df0dep-1f, 0x1.87c48cp-1f, 0x1.b13e1ep-1f,
+    0x1.da5ef2p-1f, 0x1.fcd6ecp-1f, 0x1.d462a8p-1f, 0x1.ac42c2p-1f,
+    0x1.8475dep-1f, 0x1.5cfa54p-1f, 0x1.35cf0ep-1f, 0x1.0ef2f4p-1f,
+    0x1.d0c90cp-2f, 0x1.844552p-2f, 0x1.38584ap-2f, 0x1.da0098p-3f,
+    0x1.447424p-3f, 0x1.600fdap-4f, 0x1.cb7092p-7f, 0x1.948a16p-8f,
+    0x1.5ceabep-4f, 0x1.4ef4f4p-3f, 0x1.ee288ap-3f, 0x1.460b58p-2f,
+    0x1.9461e4p-2f, 0x1.e21a16p-2f, 0x1.179b7ap-1f, 0x1.3ddd56p-1f,
+    0x1.63d3dcp-1f, 0x1.897fdap-1f, 0x1.aee2f8p-1f, 0x1.d3fe04p-1f,
+    0x1.f8d23ep-1f, 0x1.e29facp-1f, 0x1.be563cp-1f, 0x1.9a509cp-1f,
+    0x1.768e44p-1f, 0x1.530d48p-1f, 0x1.2fcda8p-1f, 0x1.0ccdcp-1f,
+    0x1.d41a96p-2f, 0x1.8f15d4p-2f, 0x1.4a8c22p-2f, 0x1.067b52p-2f,
+    0x1.85c37ap-3f, 0x1.fef93p-4f, 0x1.e8768p-5f, 0x1.d60534p-5f,
+    0x1.06a712p-3f, 0x1.96bd9p-3f, 0x1.12e378p-2f, 0x1.59e572p-2f,
+    0x1.a064bp-2f, 0x1.e6648p-2f, 0x1.15f2b6p-1f, 0x1.387516p-1f,
+    0x1.5ab9eep-1f, 0x1.7cc258p-1f, 0x1.9e8f22p-1f, 0x1.c020dap-1f,
+    0x1.e17898p-1f, 0x1.fd695ep-1f, 0x1.dc8364p-1f, 0x1.bbd57ap-1f,
+    0x1.9b5e88p-1f, 0x1.7b1e48p-1f, 0x1.5b1316p-1f, 0x1.3b3d38p-1f,
+    0x1.1b9b96p-1f, 0x1.f85b46p-2f, 0x1.b9e51ep-2f, 0x1.7bd398p-2f,
+    0x1.3e25ap-2f, 0x1.00d98cp-2f, 0x1.87dc94p-3f, 0x1.0ec57ep-3f,
+    0x1.2cd74ep-4f, 0x1.eccde8p-7f, 0x1.4b510ap-8f, 0x1.1be4ep-4f,
+    0x1.10aa18p-3f, 0x1.9285ep-3f, 0x1.09c37p-2f, 0x1.49d9d4p-2f,
+    0x1.89859p-2f, 0x1.c8c8d4p-2f, 0x1.03d25cp-1f, 0x1.230d72p-1f,
+    0x1.421634p-1f, 0x1.60ed3p-1f, 0x1.7f933ap-1f, 0x1.9e08dap-1f,
+    0x1.bc4eap-1f, 0x1.da6516p-1f, 0x1.f84cc8p-1f, 0x1.e9fa06p-1f,
+    0x1.cc6df6p-1f, 0x1.af0f04p-1f, 0x1.91dc6p-1f, 0x1.74d60ap-1f,
+    0x1.57fb76p-1f, 0x1.3b4b46p-1f, 0x1.1ec604p-1f, 0x1.026a9ap-1f,
+    0x1.cc70f8p-2f, 0x1.945f52p-2f, 0x1.5c9e9ep-2f, 0x1.252dc6p-2f,
+    0x1.dc1aacp-3f, 0x1.6e751ep-3f, 0x1.016ae6p-3f, 0x1.29f3aap-4f,
+    0x1.490688p-6f, 0x1.605f9ep-5f, 0x1.9c9054p-4f, 0x1.43c3fp-3f,
+    0x1.b88e7ep-3f, 0x1.1653eap-2f, 0x1.500914p-2f, 0x1.896976p-2f,
+    0x1.c273f8p-2f, 0x1.fb2accp-2f, 0x1.19c784p-1f, 0x1.35d058p-1f,
+    0x1.51b0bp-1f, 0x1.6d691cp-1f, 0x1.88f956p-1f, 0x1.a462b8p-1f,
+    0x1.bfa546p-1f, 0x1.dac18ap-1f, 0x1.f5b7ccp-1f, 0x1.ef7722p-1f,
+    0x1.d4cbccp-1f, 0x1.ba44d6p-1f, 0x1.9fe284p-1f, 0x1.85a406p-1f,
+    0x1.6b88dp-1f, 0x1.519126p-1f, 0x1.37bbf2p-1f, 0x1.1e0978p-1f,
+    0x1.04792ep-1f, 0x1.d61484p-2f, 0x1.a37a7ep-2f, 0x1.71221ap-2f,
+    0x1.3f0b58p-2f, 0x1.0d3494p-2f, 0x1.b73dcep-3f, 0x1.54904p-3f,
+    0x1.e4c0fcp-4f, 0x1.215ae4p-4f, 0x1.7bb00cp-6f, 0x1.088ddcp-5f,
+    0x1.59a19ep-4f, 0x1.16ecaap-3f, 0x1.8075fp-3f, 0x1.e96fe8p-3f,
+    0x1.28ee62p-2f, 0x1.5cddb4p-2f, 0x1.90881ep-2f, 0x1.c3ed1p-2f,
+    0x1.f70da2p-2f, 0x1.14f5bep-1f, 0x1.2e42c2p-1f, 0x1.476ef4p-1f,
+    0x1.607a54p-1f, 0x1.7965b6p-1f, 0x1.92308cp-1f, 0x1.aadbfp-1f,
+    0x1.c367ep-1f, 0x1.dbd4a4p-1f, 0x1.f4228p-1f, 0x1.f3ae46p-1f,
+    0x1.db9d2p-1f, 0x1.c3a9c8p-1f, 0x1.abd442p-1f, 0x1.941bfcp-1f,
+    0x1.7c80b4p-1f, 0x1.65026ap-1f, 0x1.4da09p-1f, 0x1.365ae2p-1f,
+    0x1.1f311ap-1f, 0x1.08237ap-1f, 0x1.e261dep-2f, 0x1.b4b2eep-2f,
+    0x1.873a22p-2f, 0x1.59f77ep-2f, 0x1.2ce95ap-2f, 0x1.000f2ep-2f,
+    0x1.a6d41cp-3f, 0x1.4dee82p-3f, 0x1.eae1a6p-4f, 0x1.3aad5ep-4f,
+    0x1.1684bep-5f, 0x1.8a3752p-6f, 0x1.231704p-4f, 0x1.e2b1bap-4f,
+    0x1.50aefcp-3f, 0x1.af900ep-3f, 0x1.06fe96p-2f, 0x1.35fb2cp-2f,
+    0x1.64bedep-2f, 0x1.934a3ap-2f, 0x1.c19dcep-2f, 0x1.efb90ap-2f,
+    0x1.0ecf1p-1f, 0x1.25a68ap-1f, 0x1.3c62eep-1f, 0x1.530442p-1f,
+    0x1.698b52p-1f, 0x1.7ff86ap-1f, 0x1.964af8p-1f, 0x1.ac846p-1f,
+    0x1.c2a3ccp-1f, 0x1.d8aa54p-1f, 0x1.ee97b4p-1f, 0x1.fb9416p-1f,
+    0x1.e5d838p-1f, 0x1.d034f8p-1f, 0x1.baa9c8p-1f, 0x1.a536aap-1f,
+    0x1.8fdb56p-1f, 0x1.7a9788p-1f, 0x1.656af8p-1f, 0x1.5055a6p-1f,
+    0x1.3b574ep-1f, 0x1.266feep-1f, 0x1.119efcp-1f, 0x1.f9c978p-2f,
+    0x1.d080b8p-2f, 0x1.a76448p-2f, 0x1.7e730cp-2f, 0x1.55ad94p-2f,
+    0x1.2d135p-2f, 0x1.04a328p-2f, 0x1.b8ba3ep-3f, 0x1.68838p-3f,
+    0x1.189fe4p-3f, 0x1.921a74p-4f, 0x1.e736dp-5f, 0x1.56f908p-6f,
+    0x1.1afaa2p-7f, 0x1.a27c7cp-5f, 0x1.7e584p-4f, 0x1.1558dep-3f,
+    0x1.6b2558p-3f, 0x1.c092a6p-3f, 0x1.0ad0f2p-2f, 0x1.352a12p-2f,
+    0x1.5f54b4p-2f, 0x1.895164p-2f, 0x1.b32024p-2f, 0x1.dcc20ap-2f,
+    0x1.031b44p-1f, 0x1.17bfa4p-1f, 0x1.2c4ddcp-1f, 0x1.40c67ap-1f,
+    0x1.552936p-1f, 0x1.697658p-1f, 0x1.7dae6cp-1f, 0x1.91d17p-1f,
+    0x1.a5df2p-1f, 0x1.b9d808p-1f, 0x1.cdbcb2p-1f, 0x1.e18c92p-1f,
+    0x1.f54838p-1f, 0x1.f71018p-1f, 0x1.e37ca4p-1f, 0x1.cffc9cp-1f,
+    0x1.bc90cep-1f, 0x1.a93826p-1f, 0x1.95f2a4p-1f, 0x1.82c0d2p-1f,
+    0x1.6fa1dep-1f, 0x1.5c9582p-1f, 0x1.499c4cp-1f, 0x1.36b5aep-1f,
+    0x1.23e162p-1f, 0x1.111f6ap-1f, 0x1.fcdf88p-2f, 0x1.d7a3cap-2f,
+    0x1.b28c26p-2f, 0x1.8d9926p-2f, 0x1.68c81p-2f, 0x1.441a86p-2f,
+    0x1.1f8ffep-2f, 0x1.f64fd8p-3f, 0x1.adc386p-3f, 0x1.657c1cp-3f,
+    0x1.1d7888p-3f, 0x1.ab6d28p-4f, 0x1.1c70e6p-4f, 0x1.1beb7p-5f,
+};
+static const int32_t knf_mel_first_bin_1[23] = {
+    1, 4, 6, 10, 13, 17, 21, 26,
+    31, 37, 43, 50, 58, 67, 77, 87,
+    99, 113, 127, 144, 162, 182, 204,
+};
+static const int32_t knf_mel_length_1[23] = {
+    5, 6, 7, 7, 8, 9, 10, 11,
+    12, 13, 15, 17, 19, 20, 22, 26,
+    28, 31, 35, 38, 42, 47, 52,
+};
+static const int32_t knf_mel_start_1[23] = {
+    0, 5, 11, 18, 25, 33, 42, 52,
+    63, 75, 88, 103, 120, 139, 159, 181,
+    207, 235, 266, 301, 339, 381, 428,
+};
+
+// whisper, 80 bins
+static const float knf_mel_weights_2[392] = {
+    0x1.b5e9ep-3f, 0x1.928588p-1f, 0x1.0b1cbep-1f, 0x1.e9c682p-2f,
+    0x1.d4153cp-1f, 0x1.5f561ep-4f, 0x1.88858ep-2f, 0x1.3bbd3ap-1f,
+    0x1.d81472p-1f, 0x1.3f5c6ep-4f, 0x1.0c702cp-1f, 0x1.e71fa8p-2f,
+    0x1.7a7f4p-3f, 0x1.a1603p-1f, 0x1.cc401cp-1f, 0x1.9dff18p-4f,
+    0x1.533418p-1f, 0x1.5997dp-2f, 0x1.e338cp-2f, 0x1.0e63ap-1f,
+    0x1.4b950cp-2f, 0x1.5a357ap-1f, 0x1.b8fdcap-3f, 0x1.91c08ep-1f,
+    0x1.267f84p-3f, 0x1.b6602p-1f, 0x1.b5a2f8p-4f, 0x1.c94bap-1f,
+    0x1.a2ff9p-4f, 0x1.cba00ep-1f, 0x1.068b5p-3f, 0x1.be5d2cp-1f,
+    0x1.764376p-3f, 0x1.a26f22p-1f, 0x1.0ea888p-2f, 0x1.78abbcp-1f,
+    0x1.7c504p-2f, 0x1.41d7ep-1f, 0x1.0157bcp-1f, 0x1.fd508ap-2f,
+    0x1.503bd8p-1f, 0x1.5f885p-2f, 0x1.aa3b5cp-1f, 0x1.d9044p-6f,
+    0x1.57129p-3f, 0x1.f137dep-1f, 0x1.f57af4p-3f, 0x1.82a142p-1f,
+    0x1.eb0692p-2f, 0x1.0a7cb8p-1f, 0x1.76c50ep-1f, 0x1.75479p-10f,
+    0x1.1275e4p-2f, 0x1.ff455cp-1f, 0x1.25ffep-2f, 0x1.6d001p-1f,
+    0x1.2d38aap-1f, 0x1.a58eacp-2f, 0x1.cf0e1p-1f, 0x1.e0bebp-3f,
+    0x1.878f88p-4f, 0x1.87d054p-1f, 0x1.2850a6p-1f, 0x1.af5eb4p-2f,
+    0x1.df2886p-1f, 0x1.38ea7ap-2f, 0x1.06bbccp-4f, 0x1.638ac2p-1f,
+    0x1.5ff70cp-1f, 0x1.4b914p-4f, 0x1.4011eap-2f, 0x1.d68dd8p-1f,
+    0x1.f159dep-2f, 0x1.07531p-1f, 0x1.cd71f2p-1f, 0x1.4f1e8ep-2f,
+    0x1.94706cp-4f, 0x1.5870b8p-1f, 0x1.86d3dep-1f, 0x1.ac4fa2p-3f,
+    0x1.e4b086p-3f, 0x1.94ec18p-1f, 0x1.5422d4p-1f, 0x1.075fd8p-3f,
+    0x1.57ba56p-2f, 0x1.be280ap-1f, 0x1.340cdep-1f, 0x1.54d9d2p-4f,
+    0x1.97e642p-2f, 0x1.d564c6p-1f, 0x1.255fb4p-1f, 0x1.21d068p-4f,
+    0x1.b5409ap-2f, 0x1.dbc5f4p-1f, 0x1.2709p-1f, 0x1.6d6c36p-4f,
+    0x1.b1edfep-2f, 0x1.d2527ap-1f, 0x1.380b82p-1f, 0x1.181a0ep-3f,
+    0x1.8fe8fcp-2f, 0x1.b9f97cp-1f, 0x1.57832p-1f, 0x1.b1a0f2p-3f,
+    0x1.50f9c2p-2f, 0x1.9397c4p-1f, 0x1.849c3p-1f, 0x1.401232p-2f,
+    0x1.ed8f3cp-3f, 0x1.5ff6e6p-1f, 0x1.be9754p-1f, 0x1.c062dap-2f,
+    0x1.309a24p-7f, 0x1.05a2b2p-3f, 0x1.1fce92p-1f, 0x1.fb3d98p-1f,
+    0x1.2c37cp-1f, 0x1.59ed74p-3f, 0x1.a7908p-2f, 0x1.a984a4p-1f,
+    0x1.837ea4p-1f, 0x1.66584p-2f, 0x1.f20574p-3f, 0x1.4cd3ep-1f,
+    0x1.e5744ap-1f, 0x1.1a4708p-1f, 0x1.464e72p-3f, 0x1.a8bb52p-5f,
+    0x1.cb71f2p-2f, 0x1.ae6c64p-1f, 0x1.8b4b7p-1f, 0x1.8ebfdp-2f,
+    0x1.707d1cp-7f, 0x1.d2d24p-3f, 0x1.38a018p-1f, 0x1.fa3e0cp-1f,
+    0x1.46656ep-1f, 0x1.12755p-2f, 0x1.733524p-2f, 0x1.76c558p-1f,
+    0x1.ce36acp-1f, 0x1.154d28p-1f, 0x1.79c386p-3f, 0x1.8e4aa2p-4f,
+    0x1.d565bp-2f, 0x1.a18f1ep-1f, 0x1.a997bap-1f, 0x1.ed6abcp-2f,
+    0x1.16fbbap-3f, 0x1.59a118p-3f, 0x1.094aa2p-1f, 0x1.ba4112p-1f,
+    0x1.96ab4cp-1f, 0x1.d2de1cp-2f, 0x1.f008ap-4f, 0x1.a552dp-3f,
+    0x1.1690f2p-1f, 0x1.c1feecp-1f, 0x1.94576cp-1f, 0x1.d8d1d8p-2f,
+    0x1.18b362p-3f, 0x1.aea24ep-3f, 0x1.139714p-1f, 0x1.b9d328p-1f,
+    0x1.a19a12p-1f, 0x1.fd51aep-2f, 0x1.754018p-3f, 0x1.7997b8p-3f,
+    0x1.01572ap-1f, 0x1.a2affap-1f, 0x1.bd88b8p-1f, 0x1.1f4ab2p-1f,
+    0x1.051bap-2f, 0x1.09dd1ep-3f, 0x1.c16a9ep-2f, 0x1.7d723p-1f,
+    0x1.e74c24p-1f, 0x1.4d7d78p-1f, 0x1.6a36dp-2f, 0x1.e1f1c6p-5f,
+    0x1.8b3dcp-5f, 0x1.65051p-2f, 0x1.4ae498p-1f, 0x1.e1e0e4p-1f,
+    0x1.888336p-1f, 0x1.e87ed2p-2f, 0x1.853c7ap-3f, 0x1.ddf32ap-3f,
+    0x1.0bc098p-1f, 0x1.9eb0e2p-1f, 0x1.cfab0ap-1f, 0x1.3f4e9ap-1f,
+    0x1.6066d8p-2f, 0x1.12a782p-4f, 0x1.82a7b4p-4f, 0x1.8162ccp-2f,
+    0x1.4fcc94p-1f, 0x1.ddab1p-1f, 0x1.95aabep-1f, 0x1.0a3326p-1f,
+    0x1.ff9b9cp-3f, 0x1.a95506p-3f, 0x1.eb99b6p-2f, 0x1.80191ap-1f,
+    0x1.f6c262p-1f, 0x1.6ebf66p-1f, 0x1.cfb42ap-2f, 0x1.883776p-3f,
+    0x1.27b3dep-6f, 0x1.228134p-2f, 0x1.1825ecp-1f, 0x1.9df222p-1f,
+    0x1.dd5546p-1f, 0x1.59aca6p-1f, 0x1.ae20b6p-2f, 0x1.55eb9ep-3f,
+    0x1.1555d4p-4f, 0x1.4ca6b2p-2f, 0x1.28efa6p-1f, 0x1.aa8518p-1f,
+    0x1.d4e8a6p-1f, 0x1.555508p-1f, 0x1.ad78c8p-2f, 0x1.6473a2p-3f,
+    0x1.58baccp-4f, 0x1.5555f2p-2f, 0x1.29439cp-1f, 0x1.a6e318p-1f,
+    0x1.dc6f48p-1f, 0x1.60b298p-1f, 0x1.cbc2c2p-2f, 0x1.afe738p-3f,
+    0x1.1c85c2p-4f, 0x1.3e9acep-2f, 0x1.1a1e9ep-1f, 0x1.940632p-1f,
+    0x1.f2f832p-1f, 0x1.7ad6eap-1f, 0x1.039626p-1f, 0x1.1a60d6p-2f,
+    0x1.7a2fe4p-5f, 0x1.a0f9bap-6f, 0x1.0a522ep-2f, 0x1.f8d3b6p-2f,
+    0x1.72cf96p-1f, 0x1.e85d02p-1f, 0x1.a2ea62p-1f, 0x1.2f059p-1f,
+    0x1.77dfdp-2f, 0x1.26971ep-3f, 0x1.745674p-3f, 0x1.a1f4e2p-2f,
+    0x1.441018p-1f, 0x1.b65a38p-1f, 0x1.d8272cp-1f, 0x1.676e9ep-1f,
+    0x1.eef49p-2f, 0x1.108edcp-2f, 0x1.9d43d2p-5f, 0x1.3ec69ep-4f,
+    0x1.3122c4p-2f, 0x1.0885b8p-1f, 0x1.77b892p-1f, 0x1.e62bc2p-1f,
+    0x1.ac1ce8p-1f, 0x1.3f1fb6p-1f, 0x1.a5b5cp-2f, 0x1.9d275ap-3f,
+    0x1.4f8c6p-3f, 0x1.81c094p-2f, 0x1.2d252p-1f, 0x1.98b62ap-1f,
+    0x1.fc6c9ap-1f, 0x1.92409ap-1f, 0x1.28c03p-1f, 0x1.7fdc2ep-2f,
+    0x1.5f16fcp-3f, 0x1.c9b33ep-8f, 0x1.b6fd96p-3f, 0x1.ae7fap-2f,
+    0x1.4011eap-1f, 0x1.a83a4p-1f, 0x1.f04556p-1f, 0x1.896934p-1f,
+    0x1.23306ep-1f, 0x1.7b361p-2f, 0x1.628e18p-3f, 0x1.f75552p-6f,
+    0x1.da5b32p-3f, 0x1.b99f22p-2f, 0x1.4264f8p-1f, 0x1.a75c7ap-1f,
+    0x1.f44bbap-1f, 0x1.908d44p-1f, 0x1.2d690ap-1f, 0x1.95bc46p-2f,
+    0x1.a39c5cp-3f, 0x1.e1a854p-7f, 0x1.7688a8p-6f, 0x1.bdcaf2p-3f,
+    0x1.a52deep-2f, 0x1.3521dcp-1f, 0x1.9718eap-1f, 0x1.f8795ep-1f,
+    0x1.a6b832p-1f, 0x1.4679f8p-1f, 0x1.cd97dep-2f, 0x1.0f56bap-2f,
+    0x1.48b378p-4f, 0x1.651f36p-3f, 0x1.730c12p-2f, 0x1.19341p-1f,
+    0x1.7854a2p-1f, 0x1.d6e992p-1f, 0x1.cb0c22p-1f, 0x1.6d89bep-1f,
+    0x1.108f58p-1f, 0x1.683464p-2f, 0x1.60a93p-3f, 0x1.a79ef2p-4f,
+    0x1.24ec82p-2f, 0x1.dee14ep-2f, 0x1.4be5cep-1f, 0x1.a7d5b4p-1f,
+    0x1.fcbcp-1f, 0x1.a1cf76p-1f, 0x1.4762b2p-1f, 0x1.dae992p-2f,
+    0x1.2809a8p-2f, 0x1.d87202p-4f, 0x1.a1ffd6p-8f, 0x1.78c228p-3f,
+    0x1.713a9cp-2f, 0x1.128b36p-1f, 0x1.6bfb2cp-1f, 0x1.c4f1cp-1f,
+    0x1.e294b6p-1f, 0x1.8a92bap-1f, 0x1.330938p-1f, 0x1.b7eae2p-2f,
+    0x1.0aaecap-2f, 0x1.797162p-4f, 0x1.d6b4a2p-5f, 0x1.d5b516p-3f,
+    0x1.99ed9p-2f, 0x1.240a9p-1f, 0x1.7aa89ap-1f, 0x1.d0d1d4p-1f,
+    0x1.d976f6p-1f, 0x1.8431c2p-1f, 0x1.2f5ccep-1f, 0x1.b5f038p-2f,
+    0x1.0e000cp-2f, 0x1.9bb2fap-4f, 0x1.34484ap-4f, 0x1.ef38fcp-3f,
+    0x1.a14664p-2f, 0x1.2507e4p-1f, 0x1.78fffap-1f, 0x1.cc89ap-1f,
+    0x1.e05878p-1f, 0x1.8da572p-1f, 0x1.3b5b6p-1f, 0x1.d2f656p-2f,
+    0x1.300604p-2f, 0x1.1bc09ep-3f, 0x1.fa7876p-5f, 0x1.c96a3ap-3f,
+    0x1.894942p-2f, 0x1.1684d4p-1f, 0x1.67fcfep-1f, 0x1.b90fd8p-1f,
+    0x1.f6446ep-1f, 0x1.a5fd1ap-1f, 0x1.56194p-1f, 0x1.0698e2p-1f,
+    0x1.6ef456p-2f, 0x1.a2ed2p-3f, 0x1.a5e0dp-5f, 0x1.37722ep-6f,
+    0x1.680b98p-3f, 0x1.53cd8p-2f, 0x1.f2ce3cp-2f, 0x1.4885d6p-1f,
+    0x1.9744b8p-1f, 0x1.e5a1f4p-1f, 0x1.cc5ed2p-1f, 0x1.7ebe84p-1f,
+    0x1.317a62p-1f, 0x1.c92884p-2f, 0x1.300f24p-2f, 0x1.2f5c44p-3f,
+};
+static const int32_t knf_mel_first_bin_2[80] = {
+    1, 1, 2, 2, 3, 3, 4, 5,
+    5, 6, 7, 8, 8, 9, 10, 11,
+    12, 13, 14, 15, 16, 17, 18, 19,
+    20, 21, 22, 24, 25, 26, 28, 29,
+    30, 32, 33, 35, 37, 38, 40, 42,
+    44, 46, 48, 50, 52, 54, 56, 59,
+    61, 63, 66, 69, 71, 74, 77, 80,
+    83, 86, 89, 93, 96, 100, 103, 107,
+    111, 115, 119, 124, 128, 133, 137, 142,
+    147, 153, 158, 163, 169, 175, 181, 187,
+};
+static const int32_t knf_mel_length_2[80] = {
+    1, 1, 1, 1, 1, 2, 1, 1,
+    2, 2, 1, 1, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2,
+    2, 3, 3, 2, 3, 3, 2, 3,
+    3, 3, 4, 3, 3, 4, 4, 4,
+    4, 4, 4, 4, 4, 5, 5, 4,
+    5, 6, 5, 5, 6, 6, 6, 6,
+    6, 7, 7, 7, 7, 7, 8, 8,
+    8, 9, 9, 9, 9, 9, 10, 11,
+    11, 10, 11, 12, 12, 12, 13, 13,
+};
+static const int32_t knf_mel_start_2[80] = {
+    0, 1, 2, 3, 4, 5, 7, 8,
+    9, 11, 13, 14, 15, 17, 19, 21,
+    23, 25, 27, 29, 31, 33, 35, 37,
+    39, 41, 44, 47, 49, 52, 55, 57,
+    60, 63, 66, 70, 73, 76, 80, 84,
+    88, 92, 96, 100, 104, 108, 113, 118,
+    122, 127, 133, 138, 143, 149, 155, 161,
+    167, 173, 180, 187, 194, 201, 208, 216,
+    224, 232, 241, 250, 259, 268, 277, 287,
+    298, 309, 319, 330, 342, 354, 366, 379,
+};
+
+// 8 kHz telephony, 23 bins
+static const float knf_mel_weights_3[241] = {
+    0x1.9632fap-3f, 0x1.77a4bcp-1f, 0x1.81463cp-1f, 0x1.08b404p-2f,
+    0x1.fae71p-3f, 0x1.7ba5fep-1f, 0x1.90d584p-1f, 0x1.4c17ep-2f,
+    0x1.bca9f2p-3f, 0x1.59f41p-1f, 0x1.c3626ap-1f, 0x1.d09bdep-2f,
+    0x1.450e8p-5f, 0x1.e4ecaep-4f, 0x1.17b212p-1f, 0x1.ebaf18p-1f,
+    0x1.46f96ap-1f, 0x1.ff7f3p-3f, 0x1.720d2cp-2f, 0x1.802034p-1f,
+    0x1.bea62p-1f, 0x1.02f602p-1f, 0x1.320146p-3f, 0x1.05678p-3f,
+    0x1.fa13fep-2f, 0x1.b37faep-1f, 0x1.9afc92p-1f, 0x1.dc503ep-2f,
+    0x1.1714f2p-3f, 0x1.940db6p-3f, 0x1.11d7ep-1f, 0x1.ba3ac4p-1f,
+    0x1.a19abap-1f, 0x1.0174p-1f, 0x1.947ef8p-3f, 0x1.79951cp-3f,
+    0x1.fd18p-2f, 0x1.9ae042p-1f, 0x1.cc708cp-1f, 0x1.373ba4p-1f,
+    0x1.4ab31p-2f, 0x1.6a56dcp-5f, 0x1.9c7bap-4f, 0x1.9188b6p-2f,
+    0x1.5aa678p-1f, 0x1.e95a92p-1f, 0x1.8afbe8p-1f, 0x1.023d3p-1f,
+    0x1.f128eap-3f, 0x1.d41064p-3f, 0x1.fb85ap-2f, 0x1.83b5c6p-1f,
+    0x1.f90684p-1f, 0x1.7857p-1f, 0x1.f4447ep-2f, 0x1.f9422cp-3f,
+    0x1.32af4ap-7f, 0x1.be5f28p-7f, 0x1.0f51fep-2f, 0x1.05ddc2p-1f,
+    0x1.81af74p-1f, 0x1.fb3542p-1f, 0x1.8d7bc4p-1f, 0x1.184f18p-1f,
+    0x1.4a6326p-2f, 0x1.a08906p-4f, 0x1.ca10f2p-3f, 0x1.cf61cep-2f,
+    0x1.5ace6cp-1f, 0x1.cbeeep-1f, 0x1.c4dc7ep-1f, 0x1.5782f6p-1f,
+    0x1.d7ea36p-2f, 0x1.0448cap-2f, 0x1.a021fp-5f, 0x1.d91c0ep-4f,
+    0x1.50fa14p-2f, 0x1.140ae4p-1f, 0x1.7ddb9ap-1f, 0x1.e5fdep-1f,
+    0x1.b38106p-1f, 0x1.4e9464p-1f, 0x1.d65f02p-2f, 0x1.128ef2p-2f,
+    0x1.46827cp-4f, 0x1.31fbe8p-3f, 0x1.62d738p-2f, 0x1.14d07ep-1f,
+    0x1.76b886p-1f, 0x1.d72fbp-1f, 0x1.c9bf8p-1f, 0x1.6c0b3ap-1f,
+    0x1.0fa92p-1f, 0x1.691f82p-2f, 0x1.6adb04p-3f, 0x1.0a57b8p-8f,
+    0x1.b20404p-4f, 0x1.27e98cp-2f, 0x1.e0adcp-2f, 0x1.4b704p-1f,
+    0x1.a5494p-1f, 0x1.fdeb5p-1f, 0x1.aaa186p-1f, 0x1.54555p-1f,
+    0x1.fe50d6p-2f, 0x1.562786p-2f, 0x1.603d68p-3f, 0x1.8563aap-7f,
+    0x1.5579e6p-3f, 0x1.57556p-2f, 0x1.00d794p-1f, 0x1.54ec3cp-1f,
+    0x1.a7f0a6p-1f, 0x1.f9ea72p-1f, 0x1.b51ecp-1f, 0x1.65251ep-1f,
+    0x1.16227cp-1f, 0x1.902216p-2f, 0x1.ebab3p-3f, 0x1.7553d4p-4f,
+    0x1.2b85p-3f, 0x1.35b5c4p-2f, 0x1.d3bb08p-2f, 0x1.37eef4p-1f,
+    0x1.851534p-1f, 0x1.d15586p-1f, 0x1.e34ad4p-1f, 0x1.98c6f6p-1f,
+    0x1.4f1966p-1f, 0x1.063dc8p-1f, 0x1.7c5e7p-2f, 0x1.dba6cep-3f,
+    0x1.834138p-4f, 0x1.cb52bp-5f, 0x1.9ce42ap-3f, 0x1.61cd36p-2f,
+    0x1.f3846ep-2f, 0x1.41d0c8p-1f, 0x1.89164cp-1f, 0x1.cf97dap-1f,
+    0x1.eaa71cp-1f, 0x1.a5a264p-1f, 0x1.615548p-1f, 0x1.1dbd4p-1f,
+    0x1.b5ab8p-2f, 0x1.3136acp-2f, 0x1.5c2ba6p-3f, 0x1.6207dp-5f,
+    0x1.558e3ep-5f, 0x1.697672p-3f, 0x1.3d557p-2f, 0x1.c4858p-2f,
+    0x1.252a4p-1f, 0x1.6764aap-1f, 0x1.a8f516p-1f, 0x1.e9df82p-1f,
+    0x1.d5d986p-1f, 0x1.9631d6p-1f, 0x1.57279cp-1f, 0x1.18b736p-1f,
+    0x1.b5bb2p-2f, 0x1.3b2fdcp-2f, 0x1.838f16p-3f, 0x1.25f464p-4f,
+    0x1.5133d4p-4f, 0x1.a738acp-3f, 0x1.51b0c8p-2f, 0x1.ce9192p-2f,
+    0x1.25227p-1f, 0x1.626812p-1f, 0x1.9f1c3ap-1f, 0x1.db4174p-1f,
+    0x1.e925p-1f, 0x1.ae154ep-1f, 0x1.738cbep-1f, 0x1.3988fp-1f,
+    0x1.00075cp-1f, 0x1.8e0bfep-2f, 0x1.1d04fep-2f, 0x1.59ec28p-3f,
+    0x1.eece7ep-5f, 0x1.6db008p-5f, 0x1.47aac4p-3f, 0x1.18e684p-2f,
+    0x1.8cee2p-2f, 0x1.fff14ap-2f, 0x1.38fa02p-1f, 0x1.717d82p-1f,
+    0x1.a984f6p-1f, 0x1.e11318p-1f, 0x1.e7d672p-1f, 0x1.b135dap-1f,
+    0x1.7b0866p-1f, 0x1.454d02p-1f, 0x1.1001acp-1f, 0x1.b64926p-2f,
+    0x1.4d6716p-2f, 0x1.cab47cp-3f, 0x1.f87ed8p-4f, 0x1.7b37fcp-6f,
+    0x1.8298dp-5f, 0x1.3b2898p-3f, 0x1.09ef32p-2f, 0x1.7565fep-2f,
+    0x1.dffcaap-2f, 0x1.24db6ep-1f, 0x1.594c76p-1f, 0x1.8d52e2p-1f,
+    0x1.c0f026p-1f, 0x1.f4264p-1f, 0x1.d9095ap-1f, 0x1.a69d06p-1f,
+    0x1.7493acp-1f, 0x1.42eb22p-1f, 0x1.11a24cp-1f, 0x1.c16f18p-2f,
+    0x1.6053eep-2f, 0x1.ffde38p-3f, 0x1.407ce8p-3f, 0x1.05020ap-4f,
+    0x1.37b534p-4f, 0x1.658beap-3f, 0x1.16d8a6p-2f, 0x1.7a29bcp-2f,
+    0x1.dcbb66p-2f, 0x1.1f4874p-1f, 0x1.4fd608p-1f, 0x1.800872p-1f,
+    0x1.afe0c6p-1f, 0x1.df5fbep-1f, 0x1.f17818p-1f, 0x1.c2a6cp-1f,
+    0x1.942a0ap-1f, 0x1.66019ap-1f, 0x1.382b9ep-1f, 0x1.0aa75cp-1f,
+    0x1.bae6c2p-2f, 0x1.611d2ap-2f, 0x1.07f07ep-2f, 0x1.5ebba8p-3f,
+    0x1.5d91ccp-4f,
+};
+static const int32_t knf_mel_first_bin_3[23] = {
+    1, 3, 5, 7, 10, 12, 15, 18,
+    21, 25, 28, 33, 37, 42, 47, 53,
+    59, 65, 72, 80, 88, 97, 107,
+};
+static const int32_t knf_mel_length_3[23] = {
+    4, 4, 5, 5, 5, 6, 6, 7,
+    7, 8, 9, 9, 10, 11, 12, 12,
+    13, 15, 16, 17, 19, 20, 21,
+};
+static const int32_t knf_mel_start_3[23] = {
+    0, 4, 8, 13, 18, 23, 29, 35,
+    42, 49, 57, 66, 75, 85, 96, 108,
+    120, 133, 148, 164, 181, 200, 220,
+};
+
+static const knf_mel_table knf_mel_tables[] = {
+    {80, 0x1.4p+4f, 0x0p+0f, 0x1.f4p+13f, 512,
+     {.num_bins = 80,
+      .num_fft_bins = 256,
+      .weights = (float *)knf_mel_weights_0,
+      .first_bin = (int32_t *)knf_mel_first_bin_0,
+      .length = (int32_t *)knf_mel_length_0,
+      .start = (int32_t *)knf_mel_start_0,
+      .bin_begin = 1,
+      .bin_end = 256,
+      .embedded = true}},
+    {23, 0x1.4p+4f, 0x0p+0f, 0x1.f4p+13f, 512,
+     {.num_bins = 23,
+      .num_fft_bins = 256,
+      .weights = (float *)knf_mel_weights_1,
+      .first_bin = (int32_t *)knf_mel_first_bin_1,
+      .length = (int32_t *)knf_mel_length_1,
+      .start = (int32_t *)knf_mel_start_1,
+      .bin_begin = 1,
+      .bin_end = 256,
+      .embedded = true}},
+    {80, 0x0p+0f, 0x0p+0f, 0x1.f4p+13f, 400,
+     {.num_bins = 80,
+      .num_fft_bins = 200,
+      .weights = (float *)knf_mel_weights_2,
+      .first_bin = (int32_t *)knf_mel_first_bin_2,
+      .length = (int32_t *)knf_mel_length_2,
+      .start = (int32_t *)knf_mel_start_2,
+      .bin_begin = 1,
+      .bin_end = 200,
+      .embedded = true}},
+    {23, 0x1.4p+4f, 0x0p+0f, 0x1.f4p+12f, 256,
+     {.num_bins = 23,
+      .num_fft_bins = 128,
+      .weights = (float *)knf_mel_weights_3,
+      .first_bin = (int32_t *)knf_mel_first_bin_3,
+      .length = (int32_t *)knf_mel_length_3,
+      .start = (int32_t *)knf_mel_start_3,
+      .bin_begin = 1,
+      .bin_end = 128,
+      .embedded = true}},
+};
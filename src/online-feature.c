@@ -23,8 +23,14 @@ static bool knf_online_init_common(knf_online_feature *f, void *computer,
   if (opts == nullptr || !knf_make_window_from_opts(opts, &f->window_fn)) {
     return false;
   }
+  if (!knf_frame_geometry_init(opts, &f->window_fn, &f->geometry)) {
+    knf_free_window(&f->window_fn);
+    return false;
+  }
   f->waveform_cap = 1024;
-  f->waveform = (float *)calloc((size_t)f->waveform_cap, sizeof(float));
+  f->waveform = calloc((size_t)f->waveform_cap, sizeof(float));
+  f->format = KNF_SAMPLE_FLOAT32;
+  f->num_channels = 1;
   if (f->waveform == nullptr) {
     knf_free_window(&f->window_fn);
     return false;
@@ -38,82 +44,136 @@ static bool knf_online_init_common(knf_online_feature *f, void *computer,
   return true;
 }
 
-static bool knf_online_compute_new(knf_online_feature *f) {
-  if (f == nullptr || f->computer == nullptr || f->frame_opts == nullptr ||
-      f->dim == nullptr || f->need_raw_energy == nullptr ||
-      f->compute == nullptr) {
-    return false;
+// Channels of features per frame.
+static int32_t knf_online_out_channels(const knf_online_feature *f) {
+  return f->downmix ? 1 : f->num_channels;
+}
+
+// Bytes per sample of all channels in the buffer.
+static size_t knf_online_sample_bytes(const knf_online_feature *f) {
+  return knf_sample_size(f->format) * (size_t)f->num_channels;
+}
+
+// The size samples of the buffer from start as float32, downmixed if needed.
+static const float *knf_online_float_frame(knf_online_feature *f,
+                                           int64_t start) {
+  int64_t offset = start - f->waveform_offset;
+  if (f->format == KNF_SAMPLE_FLOAT32 && f->num_channels == 1) {
+    return (const float *)f->waveform + offset;
   }
+  knf_convert_channel(f->waveform, f->format, f->num_channels,
+                      f->downmix ? KNF_CHANNEL_DOWNMIX : 0, offset,
+                      f->geometry.size, f->sliding_frame);
+  return f->sliding_frame;
+}
 
-  const knf_frame_opts *opts = f->frame_opts(f->computer);
-  if (opts == nullptr) {
+static bool knf_online_compute_new(knf_online_feature *f) {
+  if (f == nullptr || f->computer == nullptr || f->dim == nullptr ||
+      f->need_raw_energy == nullptr || f->compute == nullptr) {
     return false;
   }
+
+  const knf_frame_geometry *g = &f->geometry;
   int64_t total_samples = f->waveform_offset + f->waveform_size;
   int32_t prev_frames = f->num_features;
-  int32_t new_frames = knf_num_frames(total_samples, opts, f->input_finished);
+  int32_t new_frames =
+      knf_frame_geometry_num_frames(g, total_samples, f->input_finished);
   if (new_frames <= prev_frames) return true;
 
-  int32_t padded = knf_padded_window_size(opts);
-  if (padded <= 0) {
+  // All pending frames of all channels at once, into rows the computers then
+  // transform in place.
+  if (!knf_extract_windows(g, f->waveform_offset, f->waveform, f->format,
+                           f->num_channels, f->downmix, f->waveform_size,
+                           prev_frames, new_frames - prev_frames,
+                           &f->frames)) {
     return false;
   }
-  float *window = (float *)calloc((size_t)padded, sizeof(float));
-  if (window == nullptr) {
+  int32_t out_channels = knf_online_out_channels(f);
+  bool need_raw_energy = f->need_raw_energy(f->computer);
+  int32_t dim = f->dim(f->computer);
+  if (dim <= 0) {
     return false;
   }
-  for (int32_t frame = prev_frames; frame < new_frames; ++frame) {
-    float raw_log_energy = 0.0f;
-    if (!knf_extract_window(
-            f->waveform_offset, f->waveform, f->waveform_size, frame, opts,
-            &f->window_fn, window,
-            f->need_raw_energy(f->computer) ? &raw_log_energy : nullptr)) {
-      free(window);
+  bool batched = f->compute_batch != nullptr && f->sliding == nullptr;
+  if (batched) {
+    int32_t rows = f->frames.rows;
+    if ((size_t)rows > SIZE_MAX / sizeof(float) / (size_t)dim) {
       return false;
     }
+    if (rows > f->batch_features_cap) {
+      auto batch = (float *)realloc(
+          f->batch_features, sizeof(float) * (size_t)rows * (size_t)dim);
+      if (batch == nullptr) {
+        return false;
+      }
+      f->batch_features = batch;
+      f->batch_features_cap = rows;
+    }
+    f->compute_batch(f->computer, 1.0f, &f->frames, f->batch_features);
+  }
+  for (int32_t frame = prev_frames; frame < new_frames; ++frame) {
     if (f->num_features == f->features_cap) {
       int32_t next_cap = 16;
       if (f->features_cap > 0) {
         if (f->features_cap > INT32_MAX / 2) {
-          free(window);
           return false;
         }
         next_cap = f->features_cap * 2;
       }
       if ((size_t)next_cap > SIZE_MAX / sizeof(float *)) {
-        free(window);
         return false;
       }
       auto new_features =
           (float **)realloc(f->features, sizeof(float *) * (size_t)next_cap);
       if (new_features == nullptr) {
-        free(window);
         return false;
       }
       f->features_cap = next_cap;
       f->features = new_features;
     }
-    int32_t dim = f->dim(f->computer);
-    if (dim <= 0) {
-      free(window);
-      return false;
-    }
-    f->features[f->num_features] = (float *)calloc((size_t)dim, sizeof(float));
+    size_t frame_dim = (size_t)dim * (size_t)out_channels;
+    f->features[f->num_features] = (float *)calloc(frame_dim, sizeof(float));
     if (f->features[f->num_features] == nullptr) {
-      free(window);
       return false;
     }
-    f->compute(f->computer, raw_log_energy, 1.0f, window,
-               f->features[f->num_features]);
+    if (batched) {
+      // The rows of a frame's channels are consecutive, as is its feature.
+      memcpy(f->features[f->num_features],
+             f->batch_features + (size_t)(frame - prev_frames) * frame_dim,
+             sizeof(float) * frame_dim);
+      f->num_features++;
+      continue;
+    }
+    int64_t start = knf_frame_geometry_first_sample(g, frame);
+    for (int32_t c = 0; c < out_channels; ++c) {
+      int32_t row = (frame - prev_frames) * out_channels + c;
+      float *window = f->frames.data + (size_t)row * (size_t)f->frames.stride;
+      float *feature = f->features[f->num_features] + (size_t)c * (size_t)dim;
+      float raw_log_energy =
+          need_raw_energy ? f->frames.log_energies[row] : 0.0f;
+      // The sliding DFT follows a single stream.
+      if (f->sliding != nullptr && out_channels == 1 &&
+          start >= f->waveform_offset &&
+          start + g->size <= f->waveform_offset + f->waveform_size &&
+          knf_sliding_dft_compute(f->sliding, start,
+                                  knf_online_float_frame(f, start),
+                                  f->spectrum)) {
+        f->compute_spectrum(f->computer, raw_log_energy, 1.0f, window,
+                            f->spectrum, feature);
+      } else {
+        knf_sliding_dft_reset(f->sliding);
+        f->compute(f->computer, raw_log_energy, 1.0f, window, feature);
+      }
+    }
     f->num_features++;
   }
-  free(window);
 
-  int64_t first_sample_next = knf_first_sample_of_frame(new_frames, opts);
+  int64_t first_sample_next = knf_frame_geometry_first_sample(g, new_frames);
   int32_t discard = (int32_t)(first_sample_next - f->waveform_offset);
   if (discard > 0 && discard <= f->waveform_size) {
-    memmove(f->waveform, f->waveform + discard,
-            sizeof(float) * (f->waveform_size - discard));
+    size_t sample_bytes = knf_online_sample_bytes(f);
+    memmove(f->waveform, (char *)f->waveform + sample_bytes * (size_t)discard,
+            sample_bytes * (size_t)(f->waveform_size - discard));
     f->waveform_size -= discard;
     f->waveform_offset += discard;
   }
@@ -134,6 +194,18 @@ static void knf_online_compute_fbank(void *c, float e, float v, float *w,
   knf_fbank_compute((knf_fbank_computer *)c, e, v, w, f);
 }
 
+static void knf_online_compute_spectrum_fbank(void *c, float e, float v,
+                                              const float *w, const float *s,
+                                              float *f) {
+  knf_fbank_compute_spectrum((knf_fbank_computer *)c, e, v, w, s, f);
+}
+
+static void knf_online_compute_batch_fbank(void *c, float v,
+                                           knf_frame_matrix *frames,
+                                           float *f) {
+  knf_fbank_compute_batch((knf_fbank_computer *)c, v, frames, f);
+}
+
 static int32_t knf_online_dim_mfcc(const void *c) {
   return knf_mfcc_dim((const knf_mfcc_computer *)c);
 }
@@ -148,6 +220,12 @@ static void knf_online_compute_mfcc(void *c, float e, float v, float *w,
   knf_mfcc_compute((knf_mfcc_computer *)c, e, v, w, f);
 }
 
+static void knf_online_compute_spectrum_mfcc(void *c, float e, float v,
+                                             const float *w, const float *s,
+                                             float *f) {
+  knf_mfcc_compute_spectrum((knf_mfcc_computer *)c, e, v, w, s, f);
+}
+
 static int32_t knf_online_dim_raw(const void *c) {
   return knf_raw_audio_dim((const knf_raw_audio_computer *)c);
 }
@@ -162,6 +240,12 @@ static void knf_online_compute_raw(void *c, float e, float v, float *w,
   knf_raw_audio_compute((knf_raw_audio_computer *)c, e, v, w, f);
 }
 
+static void knf_online_compute_batch_whisper(void *c, float v,
+                                             knf_frame_matrix *frames,
+                                             float *f) {
+  knf_whisper_compute_batch((knf_whisper_computer *)c, v, frames, f);
+}
+
 static int32_t knf_online_dim_whisper(const void *c) {
   return knf_whisper_dim((const knf_whisper_computer *)c);
 }
@@ -176,6 +260,44 @@ static void knf_online_compute_whisper(void *c, float e, float v, float *w,
   knf_whisper_compute((knf_whisper_computer *)c, e, v, w, f);
 }
 
+// Computes spectra with a sliding DFT from now on if the engine asks for it,
+// or for AUTO if that is cheaper than an FFT per frame for the mel banks' bins.
+static bool knf_online_init_sliding(knf_online_feature *f,
+                                    const knf_frame_opts *opts,
+                                    const knf_mel_banks *mel_banks,
+                                    knf_spectrum_engine engine, bool magnitude,
+                                    knf_compute_spectrum_fn compute_spectrum) {
+  if (engine == KNF_SPECTRUM_SLIDING && !knf_sliding_dft_supported(opts)) {
+    KNF_LOG_ERROR("sliding DFT needs no dither, no pre-emphasis and a "
+                  "cosine-sum window");
+    return false;
+  }
+  if (engine == KNF_SPECTRUM_FFT ||
+      (engine == KNF_SPECTRUM_AUTO &&
+       !knf_sliding_dft_cheaper(opts, mel_banks->bin_begin,
+                                mel_banks->bin_end))) {
+    return true;
+  }
+  f->sliding = (knf_sliding_dft *)calloc(1, sizeof(knf_sliding_dft));
+  f->spectrum = (float *)calloc((size_t)mel_banks->bin_end, sizeof(float));
+  f->sliding_frame = (float *)calloc((size_t)knf_window_size(opts),
+                                     sizeof(float));
+  if (f->sliding == nullptr || f->spectrum == nullptr ||
+      f->sliding_frame == nullptr ||
+      !knf_sliding_dft_create(opts, mel_banks->bin_begin, mel_banks->bin_end,
+                              magnitude, f->sliding)) {
+    free(f->sliding);
+    free(f->spectrum);
+    free(f->sliding_frame);
+    f->sliding = nullptr;
+    f->spectrum = nullptr;
+    f->sliding_frame = nullptr;
+    return false;
+  }
+  f->compute_spectrum = compute_spectrum;
+  return true;
+}
+
 [[nodiscard]] bool knf_online_fbank_create(const knf_fbank_opts *opts,
                                            knf_online_feature *out) {
   knf_fbank_computer *c =
@@ -192,6 +314,13 @@ static void knf_online_compute_whisper(void *c, float e, float v, float *w,
     free(c);
     return false;
   }
+  out->compute_batch = knf_online_compute_batch_fbank;
+  if (!knf_online_init_sliding(out, &opts->frame_opts, c->mel_banks,
+                               opts->spectrum_engine, !opts->use_power,
+                               knf_online_compute_spectrum_fbank)) {
+    knf_online_feature_destroy(out);
+    return false;
+  }
   return true;
 }
 
@@ -211,6 +340,12 @@ static void knf_online_compute_whisper(void *c, float e, float v, float *w,
     free(c);
     return false;
   }
+  if (!knf_online_init_sliding(out, &opts->frame_opts, c->mel_banks,
+                               opts->spectrum_engine, false,
+                               knf_online_compute_spectrum_mfcc)) {
+    knf_online_feature_destroy(out);
+    return false;
+  }
   return true;
 }
 
@@ -250,6 +385,7 @@ static void knf_online_compute_whisper(void *c, float e, float v, float *w,
     free(c);
     return false;
   }
+  out->compute_batch = knf_online_compute_batch_whisper;
   return true;
 }
 
@@ -272,6 +408,14 @@ void knf_online_feature_destroy(knf_online_feature *f) {
     }
     free(f->computer);
   }
+  knf_sliding_dft_destroy(f->sliding);
+  free(f->sliding);
+  free(f->spectrum);
+  free(f->sliding_frame);
+  free(f->batch_features);
+  knf_resampler_destroy(f->resampler);
+  free(f->resampler);
+  knf_frame_matrix_free(&f->frames);
   knf_free_window(&f->window_fn);
   free(f->waveform);
   for (int32_t i = 0; i < f->num_features; ++i) free(f->features[i]);
@@ -279,10 +423,141 @@ void knf_online_feature_destroy(knf_online_feature *f) {
   memset(f, 0, sizeof(*f));
 }
 
-[[nodiscard]] bool knf_online_accept_waveform(knf_online_feature *f,
-                                              float sampling_rate,
-                                              const float *waveform,
-                                              int32_t n) {
+// Grows the buffer to hold needed samples of the given format, converting
+// what it holds to float32 if that format differs from the buffered one. A
+// float32 buffer stays as it is; the caller converts the new samples.
+static bool knf_online_reserve(knf_online_feature *f, knf_sample_format format,
+                               int64_t needed) {
+  if (needed > INT32_MAX / f->num_channels) {
+    return false;
+  }
+  size_t old_size = knf_sample_size(f->format);
+  if (f->waveform_size == 0 && format != f->format) {
+    // Nothing to convert; reuse the allocation for the new format.
+    f->waveform_cap =
+        (int32_t)((size_t)f->waveform_cap * old_size / knf_sample_size(format));
+    f->format = format;
+  }
+  bool promote = format != f->format && f->format != KNF_SAMPLE_FLOAT32;
+  knf_sample_format target = promote ? KNF_SAMPLE_FLOAT32 : f->format;
+  size_t sample_bytes = knf_sample_size(target) * (size_t)f->num_channels;
+  if (!promote && needed <= f->waveform_cap) {
+    return true;
+  }
+  int32_t next_cap = f->waveform_cap > 0 ? f->waveform_cap : 1024;
+  while (needed > next_cap) {
+    if (next_cap > INT32_MAX / 2) {
+      next_cap = INT32_MAX;
+    } else {
+      next_cap *= 2;
+    }
+    if (next_cap == INT32_MAX && needed > next_cap) {
+      return false;
+    }
+  }
+  if ((size_t)next_cap > SIZE_MAX / sample_bytes) {
+    return false;
+  }
+  if (promote) {
+    float *converted = (float *)malloc(sample_bytes * (size_t)next_cap);
+    if (converted == nullptr) {
+      return false;
+    }
+    knf_convert_samples(f->waveform, f->format, 0,
+                        f->waveform_size * f->num_channels, converted);
+    free(f->waveform);
+    f->waveform = converted;
+    f->format = KNF_SAMPLE_FLOAT32;
+  } else {
+    void *new_waveform = realloc(f->waveform, sample_bytes * (size_t)next_cap);
+    if (new_waveform == nullptr) {
+      return false;
+    }
+    f->waveform = new_waveform;
+  }
+  f->waveform_cap = next_cap;
+  return true;
+}
+
+// Resamples straight into the end of the (float) waveform buffer.
+static bool knf_online_resample(knf_online_feature *f, float sampling_rate,
+                                const void *waveform, knf_sample_format format,
+                                int32_t n, bool flush) {
+  if (fabsf(sampling_rate - (float)f->resampler->in_rate) > 1e-6f) {
+    return false;
+  }
+  int32_t bound = knf_resampler_max_output(f->resampler, n);
+  if (bound < 0 ||
+      !knf_online_reserve(f, KNF_SAMPLE_FLOAT32,
+                          (int64_t)f->waveform_size + bound)) {
+    return false;
+  }
+  int32_t produced = 0;
+  if (!knf_resampler_process(f->resampler, waveform, format, n, flush,
+                             (float *)f->waveform + f->waveform_size,
+                             &produced)) {
+    return false;
+  }
+  f->waveform_size += produced;
+  return knf_online_compute_new(f);
+}
+
+[[nodiscard]] bool knf_online_set_input_rate(knf_online_feature *f,
+                                             float sampling_rate) {
+  if (f == nullptr || f->computer == nullptr || f->frame_opts == nullptr ||
+      f->resampler != nullptr || f->num_channels > 1 ||
+      f->waveform_size > 0 || f->waveform_offset > 0 || f->input_finished) {
+    return false;
+  }
+  const knf_frame_opts *opts = f->frame_opts(f->computer);
+  if (opts == nullptr) {
+    return false;
+  }
+  if (fabsf(sampling_rate - opts->samp_freq) <= 1e-6f) {
+    return true;
+  }
+  float in_rate = roundf(sampling_rate);
+  float out_rate = roundf(opts->samp_freq);
+  if (!(in_rate >= 1.0f && in_rate <= (float)INT32_MAX / 2) ||
+      fabsf(sampling_rate - in_rate) > 1e-3f ||
+      fabsf(opts->samp_freq - out_rate) > 1e-3f) {
+    KNF_LOG_ERROR("Cannot resample from %f to %f Hz: rates must be integers",
+                  sampling_rate, opts->samp_freq);
+    return false;
+  }
+  f->resampler = (knf_resampler *)calloc(1, sizeof(knf_resampler));
+  if (f->resampler == nullptr) {
+    return false;
+  }
+  if (!knf_resampler_create((int32_t)in_rate, (int32_t)out_rate,
+                            f->resampler)) {
+    free(f->resampler);
+    f->resampler = nullptr;
+    return false;
+  }
+  return true;
+}
+
+[[nodiscard]] bool knf_online_set_channels(knf_online_feature *f,
+                                           int32_t num_channels,
+                                           bool downmix) {
+  if (f == nullptr || f->computer == nullptr || num_channels < 1 ||
+      (f->resampler != nullptr && num_channels > 1) || f->waveform_size > 0 ||
+      f->waveform_offset > 0 || f->input_finished) {
+    return false;
+  }
+  // The buffer is empty; only its capacity in samples changes.
+  f->waveform_cap = f->waveform_cap * f->num_channels / num_channels;
+  f->num_channels = num_channels;
+  f->downmix = downmix && num_channels > 1;
+  return true;
+}
+
+[[nodiscard]] bool knf_online_accept_waveform_typed(knf_online_feature *f,
+                                                    float sampling_rate,
+                                                    const void *waveform,
+                                                    knf_sample_format format,
+                                                    int32_t n) {
   if (f == nullptr || f->computer == nullptr || f->frame_opts == nullptr) {
     return false;
   }
@@ -292,50 +567,49 @@ void knf_online_feature_destroy(knf_online_feature *f) {
   if (n == 0) {
     return true;
   }
-  if (waveform == nullptr || f->input_finished) {
+  if (waveform == nullptr || f->input_finished ||
+      (uint32_t)format > KNF_SAMPLE_ALAW) {
     return false;
   }
+  if (f->resampler != nullptr) {
+    return knf_online_resample(f, sampling_rate, waveform, format, n, false);
+  }
   const knf_frame_opts *opts = f->frame_opts(f->computer);
   if (opts == nullptr || fabsf(sampling_rate - opts->samp_freq) > 1e-6f) {
     return false;
   }
-  int64_t needed = (int64_t)f->waveform_size + n;
-  if (needed > INT32_MAX) {
+  if (!knf_online_reserve(f, format, (int64_t)f->waveform_size + n)) {
     return false;
   }
-  if (needed > f->waveform_cap) {
-    int32_t next_cap = f->waveform_cap > 0 ? f->waveform_cap : 1024;
-    while (needed > next_cap) {
-      if (next_cap > INT32_MAX / 2) {
-        next_cap = INT32_MAX;
-      } else {
-        next_cap *= 2;
-      }
-      if (next_cap == INT32_MAX && needed > next_cap) {
-        return false;
-      }
-    }
-    if ((size_t)next_cap > SIZE_MAX / sizeof(float)) {
-      return false;
-    }
-    auto new_waveform =
-        (float *)realloc(f->waveform, sizeof(float) * (size_t)next_cap);
-    if (new_waveform == nullptr) {
-      return false;
-    }
-    f->waveform_cap = next_cap;
-    f->waveform = new_waveform;
+  size_t sample_bytes = knf_online_sample_bytes(f);
+  void *tail = (char *)f->waveform + sample_bytes * (size_t)f->waveform_size;
+  if (format == f->format) {
+    memcpy(tail, waveform, sample_bytes * (size_t)n);
+  } else {
+    knf_convert_samples(waveform, format, 0, n * f->num_channels,
+                        (float *)tail);
   }
-  memcpy(f->waveform + f->waveform_size, waveform, sizeof(float) * n);
   f->waveform_size += n;
   return knf_online_compute_new(f);
 }
 
+[[nodiscard]] bool knf_online_accept_waveform(knf_online_feature *f,
+                                              float sampling_rate,
+                                              const float *waveform,
+                                              int32_t n) {
+  return knf_online_accept_waveform_typed(f, sampling_rate, waveform,
+                                          KNF_SAMPLE_FLOAT32, n);
+}
+
 [[nodiscard]] bool knf_online_input_finished(knf_online_feature *f) {
   if (f == nullptr || f->computer == nullptr || f->input_finished) {
     return false;
   }
   f->input_finished = true;
+  if (f->resampler != nullptr) {
+    return knf_online_resample(f, (float)f->resampler->in_rate, nullptr,
+                               KNF_SAMPLE_FLOAT32, 0, true);
+  }
   return knf_online_compute_new(f);
 }
 
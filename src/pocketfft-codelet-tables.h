@@ -0,0 +1,567 @@
+/*
+ * This file is part of pocketfft.
+ * Licensed under a 3-clause BSD style license - see LICENSE.md
+ */
+
+/*
+ *  Twiddle factors of the codelet lengths, dumped from
+ *  rfftp_comp_twiddle_f. Generated by tools/gen_fft_codelets.c (zig build
+ *  codelets); do not edit.
+ */
+
+/* 16 = 4 * 4 */
+static const float rfftp_codelet_tw_16[9] = {
+    0x1.d906bcp-1f, 0x1.87de2ap-2f, 0x0p+0f, 0x1.6a09e6p-1f,
+    0x1.6a09e6p-1f, 0x0p+0f, 0x1.87de2ap-2f, 0x1.d906bcp-1f,
+    0x0p+0f,
+};
+
+/* 20 = 4 * 5 */
+static const float rfftp_codelet_tw_20[12] = {
+    0x1.e6f0e2p-1f, 0x1.3c6ef4p-2f, 0x1.9e377ap-1f, 0x1.2cf23p-1f,
+    0x1.9e377ap-1f, 0x1.2cf23p-1f, 0x1.3c6ef4p-2f, 0x1.e6f0e2p-1f,
+    0x1.2cf23p-1f, 0x1.9e377ap-1f, -0x1.3c6ef4p-2f, 0x1.e6f0e2p-1f,
+};
+
+/* 32 = 2 * 4 * 4 */
+static const float rfftp_codelet_tw_32[24] = {
+    0x1.f6297cp-1f, 0x1.8f8b84p-3f, 0x1.d906bcp-1f, 0x1.87de2ap-2f,
+    0x1.a9b662p-1f, 0x1.1c73b4p-1f, 0x1.6a09e6p-1f, 0x1.6a09e6p-1f,
+    0x1.1c73b4p-1f, 0x1.a9b662p-1f, 0x1.87de2ap-2f, 0x1.d906bcp-1f,
+    0x1.8f8b84p-3f, 0x1.f6297cp-1f, 0x0p+0f, 0x1.d906bcp-1f,
+    0x1.87de2ap-2f, 0x0p+0f, 0x1.6a09e6p-1f, 0x1.6a09e6p-1f,
+    0x0p+0f, 0x1.87de2ap-2f, 0x1.d906bcp-1f, 0x0p+0f,
+};
+
+/* 40 = 2 * 4 * 5 */
+static const float rfftp_codelet_tw_40[31] = {
+    0x1.f9b24ap-1f, 0x1.4060b6p-3f, 0x1.e6f0e2p-1f, 0x1.3c6ef4p-2f,
+    0x1.c83202p-1f, 0x1.d0e2e2p-2f, 0x1.9e377ap-1f, 0x1.2cf23p-1f,
+    0x1.6a09e6p-1f, 0x1.6a09e6p-1f, 0x1.2cf23p-1f, 0x1.9e377ap-1f,
+    0x1.d0e2e2p-2f, 0x1.c83202p-1f, 0x1.3c6ef4p-2f, 0x1.e6f0e2p-1f,
+    0x1.4060b6p-3f, 0x1.f9b24ap-1f, 0x0p+0f, 0x1.e6f0e2p-1f,
+    0x1.3c6ef4p-2f, 0x1.9e377ap-1f, 0x1.2cf23p-1f, 0x1.9e377ap-1f,
+    0x1.2cf23p-1f, 0x1.3c6ef4p-2f, 0x1.e6f0e2p-1f, 0x1.2cf23p-1f,
+    0x1.9e377ap-1f, -0x1.3c6ef4p-2f, 0x1.e6f0e2p-1f,
+};
+
+/* 50 = 2 * 5 * 5 */
+static const float rfftp_codelet_tw_50[40] = {
+    0x1.fbf676p-1f, 0x1.00aeb6p-3f, 0x1.efea22p-1f, 0x1.fd512p-3f,
+    0x1.dc0baap-1f, 0x1.78f5a4p-2f, 0x1.c0ab44p-1f, 0x1.ed50d6p-2f,
+    0x1.9e377ap-1f, 0x1.2cf23p-1f, 0x1.753b6p-1f, 0x1.5e7cf6p-1f,
+    0x1.465c7p-1f, 0x1.8a80b6p-1f, 0x1.1257e4p-1f, 0x1.b04bcp-1f,
+    0x1.b3ff7cp-2f, 0x1.cf457ep-1f, 0x1.3c6ef4p-2f, 0x1.e6f0e2p-1f,
+    0x1.7fc1c6p-3f, 0x1.f6ee5ap-1f, 0x1.0130a2p-4f, 0x1.fefd5cp-1f,
+    0x1.efea22p-1f, 0x1.fd512p-3f, 0x1.c0ab44p-1f, 0x1.ed50d6p-2f,
+    0x1.c0ab44p-1f, 0x1.ed50d6p-2f, 0x1.1257e4p-1f, 0x1.b04bcp-1f,
+    0x1.753b6p-1f, 0x1.5e7cf6p-1f, 0x1.0130a2p-4f, 0x1.fefd5cp-1f,
+    0x1.1257e4p-1f, 0x1.b04bcp-1f, -0x1.b3ff7cp-2f, 0x1.cf457ep-1f,
+};
+
+/* 64 = 4 * 4 * 4 */
+static const float rfftp_codelet_tw_64[54] = {
+    0x1.fd88dap-1f, 0x1.917a6cp-4f, 0x1.f6297cp-1f, 0x1.8f8b84p-3f,
+    0x1.e9f416p-1f, 0x1.294062p-2f, 0x1.d906bcp-1f, 0x1.87de2ap-2f,
+    0x1.c38b3p-1f, 0x1.e2b5d4p-2f, 0x1.a9b662p-1f, 0x1.1c73b4p-1f,
+    0x1.8bc806p-1f, 0x1.44cf32p-1f, 0x0p+0f, 0x1.f6297cp-1f,
+    0x1.8f8b84p-3f, 0x1.d906bcp-1f, 0x1.87de2ap-2f, 0x1.a9b662p-1f,
+    0x1.1c73b4p-1f, 0x1.6a09e6p-1f, 0x1.6a09e6p-1f, 0x1.1c73b4p-1f,
+    0x1.a9b662p-1f, 0x1.87de2ap-2f, 0x1.d906bcp-1f, 0x1.8f8b84p-3f,
+    0x1.f6297cp-1f, 0x0p+0f, 0x1.e9f416p-1f, 0x1.294062p-2f,
+    0x1.a9b662p-1f, 0x1.1c73b4p-1f, 0x1.44cf32p-1f, 0x1.8bc806p-1f,
+    0x1.87de2ap-2f, 0x1.d906bcp-1f, 0x1.917a6cp-4f, 0x1.fd88dap-1f,
+    -0x1.8f8b84p-3f, 0x1.f6297cp-1f, -0x1.e2b5d4p-2f, 0x1.c38b3p-1f,
+    0x0p+0f, 0x1.d906bcp-1f, 0x1.87de2ap-2f, 0x0p+0f,
+    0x1.6a09e6p-1f, 0x1.6a09e6p-1f, 0x0p+0f, 0x1.87de2ap-2f,
+    0x1.d906bcp-1f, 0x0p+0f,
+};
+
+/* 80 = 4 * 4 * 5 */
+static const float rfftp_codelet_tw_80[69] = {
+    0x1.fe6bf2p-1f, 0x1.415e54p-4f, 0x1.f9b24ap-1f, 0x1.4060b6p-3f,
+    0x1.f1da78p-1f, 0x1.de189ap-3f, 0x1.e6f0e2p-1f, 0x1.3c6ef4p-2f,
+    0x1.d906bcp-1f, 0x1.87de2ap-2f, 0x1.c83202p-1f, 0x1.d0e2e2p-2f,
+    0x1.b48d4p-1f, 0x1.0b84eep-1f, 0x1.9e377ap-1f, 0x1.2cf23p-1f,
+    0x1.8553eep-1f, 0x1.4c8474p-1f, 0x0p+0f, 0x1.f9b24ap-1f,
+    0x1.4060b6p-3f, 0x1.e6f0e2p-1f, 0x1.3c6ef4p-2f, 0x1.c83202p-1f,
+    0x1.d0e2e2p-2f, 0x1.9e377ap-1f, 0x1.2cf23p-1f, 0x1.6a09e6p-1f,
+    0x1.6a09e6p-1f, 0x1.2cf23p-1f, 0x1.9e377ap-1f, 0x1.d0e2e2p-2f,
+    0x1.c83202p-1f, 0x1.3c6ef4p-2f, 0x1.e6f0e2p-1f, 0x1.4060b6p-3f,
+    0x1.f9b24ap-1f, 0x0p+0f, 0x1.f1da78p-1f, 0x1.de189ap-3f,
+    0x1.c83202p-1f, 0x1.d0e2e2p-2f, 0x1.8553eep-1f, 0x1.4c8474p-1f,
+    0x1.2cf23p-1f, 0x1.9e377ap-1f, 0x1.87de2ap-2f, 0x1.d906bcp-1f,
+    0x1.4060b6p-3f, 0x1.f9b24ap-1f, -0x1.415e54p-4f, 0x1.fe6bf2p-1f,
+    -0x1.3c6ef4p-2f, 0x1.e6f0e2p-1f, -0x1.0b84eep-1f, 0x1.b48d4p-1f,
+    0x0p+0f, 0x1.e6f0e2p-1f, 0x1.3c6ef4p-2f, 0x1.9e377ap-1f,
+    0x1.2cf23p-1f, 0x1.9e377ap-1f, 0x1.2cf23p-1f, 0x1.3c6ef4p-2f,
+    0x1.e6f0e2p-1f, 0x1.2cf23p-1f, 0x1.9e377ap-1f, -0x1.3c6ef4p-2f,
+    0x1.e6f0e2p-1f,
+};
+
+/* 100 = 4 * 5 * 5 */
+static const float rfftp_codelet_tw_100[88] = {
+    0x1.fefd5cp-1f, 0x1.0130a2p-4f, 0x1.fbf676p-1f, 0x1.00aeb6p-3f,
+    0x1.f6ee5ap-1f, 0x1.7fc1c6p-3f, 0x1.efea22p-1f, 0x1.fd512p-3f,
+    0x1.e6f0e2p-1f, 0x1.3c6ef4p-2f, 0x1.dc0baap-1f, 0x1.78f5a4p-2f,
+    0x1.cf457ep-1f, 0x1.b3ff7cp-2f, 0x1.c0ab44p-1f, 0x1.ed50d6p-2f,
+    0x1.b04bcp-1f, 0x1.1257e4p-1f, 0x1.9e377ap-1f, 0x1.2cf23p-1f,
+    0x1.8a80b6p-1f, 0x1.465c7p-1f, 0x1.753b6p-1f, 0x1.5e7cf6p-1f,
+    0x1.fbf676p-1f, 0x1.00aeb6p-3f, 0x1.efea22p-1f, 0x1.fd512p-3f,
+    0x1.dc0baap-1f, 0x1.78f5a4p-2f, 0x1.c0ab44p-1f, 0x1.ed50d6p-2f,
+    0x1.9e377ap-1f, 0x1.2cf23p-1f, 0x1.753b6p-1f, 0x1.5e7cf6p-1f,
+    0x1.465c7p-1f, 0x1.8a80b6p-1f, 0x1.1257e4p-1f, 0x1.b04bcp-1f,
+    0x1.b3ff7cp-2f, 0x1.cf457ep-1f, 0x1.3c6ef4p-2f, 0x1.e6f0e2p-1f,
+    0x1.7fc1c6p-3f, 0x1.f6ee5ap-1f, 0x1.0130a2p-4f, 0x1.fefd5cp-1f,
+    0x1.f6ee5ap-1f, 0x1.7fc1c6p-3f, 0x1.dc0baap-1f, 0x1.78f5a4p-2f,
+    0x1.b04bcp-1f, 0x1.1257e4p-1f, 0x1.753b6p-1f, 0x1.5e7cf6p-1f,
+    0x1.2cf23p-1f, 0x1.9e377ap-1f, 0x1.b3ff7cp-2f, 0x1.cf457ep-1f,
+    0x1.fd512p-3f, 0x1.efea22p-1f, 0x1.0130a2p-4f, 0x1.fefd5cp-1f,
+    -0x1.00aeb6p-3f, 0x1.fbf676p-1f, -0x1.3c6ef4p-2f, 0x1.e6f0e2p-1f,
+    -0x1.ed50d6p-2f, 0x1.c0ab44p-1f, -0x1.465c7p-1f, 0x1.8a80b6p-1f,
+    0x1.efea22p-1f, 0x1.fd512p-3f, 0x1.c0ab44p-1f, 0x1.ed50d6p-2f,
+    0x1.c0ab44p-1f, 0x1.ed50d6p-2f, 0x1.1257e4p-1f, 0x1.b04bcp-1f,
+    0x1.753b6p-1f, 0x1.5e7cf6p-1f, 0x1.0130a2p-4f, 0x1.fefd5cp-1f,
+    0x1.1257e4p-1f, 0x1.b04bcp-1f, -0x1.b3ff7cp-2f, 0x1.cf457ep-1f,
+};
+
+/* 128 = 2 * 4 * 4 * 4 */
+static const float rfftp_codelet_tw_128[117] = {
+    0x1.ff621ep-1f, 0x1.91f66p-5f, 0x1.fd88dap-1f, 0x1.917a6cp-4f,
+    0x1.fa7558p-1f, 0x1.2c8106p-3f, 0x1.f6297cp-1f, 0x1.8f8b84p-3f,
+    0x1.f0a7fp-1f, 0x1.f19f98p-3f, 0x1.e9f416p-1f, 0x1.294062p-2f,
+    0x1.e2121p-1f, 0x1.58f9a8p-2f, 0x1.d906bcp-1f, 0x1.87de2ap-2f,
+    0x1.ced7bp-1f, 0x1.b5d1p-2f, 0x1.c38b3p-1f, 0x1.e2b5d4p-2f,
+    0x1.b72834p-1f, 0x1.07387ap-1f, 0x1.a9b662p-1f, 0x1.1c73b4p-1f,
+    0x1.9b3e04p-1f, 0x1.30ff8p-1f, 0x1.8bc806p-1f, 0x1.44cf32p-1f,
+    0x1.7b5df2p-1f, 0x1.57d694p-1f, 0x1.6a09e6p-1f, 0x1.6a09e6p-1f,
+    0x1.57d694p-1f, 0x1.7b5df2p-1f, 0x1.44cf32p-1f, 0x1.8bc806p-1f,
+    0x1.30ff8p-1f, 0x1.9b3e04p-1f, 0x1.1c73b4p-1f, 0x1.a9b662p-1f,
+    0x1.07387ap-1f, 0x1.b72834p-1f, 0x1.e2b5d4p-2f, 0x1.c38b3p-1f,
+    0x1.b5d1p-2f, 0x1.ced7bp-1f, 0x1.87de2ap-2f, 0x1.d906bcp-1f,
+    0x1.58f9a8p-2f, 0x1.e2121p-1f, 0x1.294062p-2f, 0x1.e9f416p-1f,
+    0x1.f19f98p-3f, 0x1.f0a7fp-1f, 0x1.8f8b84p-3f, 0x1.f6297cp-1f,
+    0x1.2c8106p-3f, 0x1.fa7558p-1f, 0x1.917a6cp-4f, 0x1.fd88dap-1f,
+    0x1.91f66p-5f, 0x1.ff621ep-1f, 0x0p+0f, 0x1.fd88dap-1f,
+    0x1.917a6cp-4f, 0x1.f6297cp-1f, 0x1.8f8b84p-3f, 0x1.e9f416p-1f,
+    0x1.294062p-2f, 0x1.d906bcp-1f, 0x1.87de2ap-2f, 0x1.c38b3p-1f,
+    0x1.e2b5d4p-2f, 0x1.a9b662p-1f, 0x1.1c73b4p-1f, 0x1.8bc806p-1f,
+    0x1.44cf32p-1f, 0x0p+0f, 0x1.f6297cp-1f, 0x1.8f8b84p-3f,
+    0x1.d906bcp-1f, 0x1.87de2ap-2f, 0x1.a9b662p-1f, 0x1.1c73b4p-1f,
+    0x1.6a09e6p-1f, 0x1.6a09e6p-1f, 0x1.1c73b4p-1f, 0x1.a9b662p-1f,
+    0x1.87de2ap-2f, 0x1.d906bcp-1f, 0x1.8f8b84p-3f, 0x1.f6297cp-1f,
+    0x0p+0f, 0x1.e9f416p-1f, 0x1.294062p-2f, 0x1.a9b662p-1f,
+    0x1.1c73b4p-1f, 0x1.44cf32p-1f, 0x1.8bc806p-1f, 0x1.87de2ap-2f,
+    0x1.d906bcp-1f, 0x1.917a6cp-4f, 0x1.fd88dap-1f, -0x1.8f8b84p-3f,
+    0x1.f6297cp-1f, -0x1.e2b5d4p-2f, 0x1.c38b3p-1f, 0x0p+0f,
+    0x1.d906bcp-1f, 0x1.87de2ap-2f, 0x0p+0f, 0x1.6a09e6p-1f,
+    0x1.6a09e6p-1f, 0x0p+0f, 0x1.87de2ap-2f, 0x1.d906bcp-1f,
+    0x0p+0f,
+};
+
+/* 256 = 4 * 4 * 4 * 4 */
+static const float rfftp_codelet_tw_256[243] = {
+    0x1.ffd886p-1f, 0x1.92156p-6f, 0x1.ff621ep-1f, 0x1.91f66p-5f,
+    0x1.fe9cdap-1f, 0x1.2d520ap-4f, 0x1.fd88dap-1f, 0x1.917a6cp-4f,
+    0x1.fc2648p-1f, 0x1.f564e6p-4f, 0x1.fa7558p-1f, 0x1.2c8106p-3f,
+    0x1.f8765p-1f, 0x1.5e2144p-3f, 0x1.f6297cp-1f, 0x1.8f8b84p-3f,
+    0x1.f38f3ap-1f, 0x1.c0b826p-3f, 0x1.f0a7fp-1f, 0x1.f19f98p-3f,
+    0x1.ed740ep-1f, 0x1.111d26p-2f, 0x1.e9f416p-1f, 0x1.294062p-2f,
+    0x1.e6288ep-1f, 0x1.4135cap-2f, 0x1.e2121p-1f, 0x1.58f9a8p-2f,
+    0x1.ddb13cp-1f, 0x1.708854p-2f, 0x1.d906bcp-1f, 0x1.87de2ap-2f,
+    0x1.d4134ep-1f, 0x1.9ef794p-2f, 0x1.ced7bp-1f, 0x1.b5d1p-2f,
+    0x1.c954b2p-1f, 0x1.cc66eap-2f, 0x1.c38b3p-1f, 0x1.e2b5d4p-2f,
+    0x1.bd7c0ap-1f, 0x1.f8ba4ep-2f, 0x1.b72834p-1f, 0x1.07387ap-1f,
+    0x1.b090a6p-1f, 0x1.11eb36p-1f, 0x1.a9b662p-1f, 0x1.1c73b4p-1f,
+    0x1.a29a7ap-1f, 0x1.26d054p-1f, 0x1.9b3e04p-1f, 0x1.30ff8p-1f,
+    0x1.93a224p-1f, 0x1.3affa2p-1f, 0x1.8bc806p-1f, 0x1.44cf32p-1f,
+    0x1.83b0ep-1f, 0x1.4e6cacp-1f, 0x1.7b5df2p-1f, 0x1.57d694p-1f,
+    0x1.72d084p-1f, 0x1.610b76p-1f, 0x0p+0f, 0x1.ff621ep-1f,
+    0x1.91f66p-5f, 0x1.fd88dap-1f, 0x1.917a6cp-4f, 0x1.fa7558p-1f,
+    0x1.2c8106p-3f, 0x1.f6297cp-1f, 0x1.8f8b84p-3f, 0x1.f0a7fp-1f,
+    0x1.f19f98p-3f, 0x1.e9f416p-1f, 0x1.294062p-2f, 0x1.e2121p-1f,
+    0x1.58f9a8p-2f, 0x1.d906bcp-1f, 0x1.87de2ap-2f, 0x1.ced7bp-1f,
+    0x1.b5d1p-2f, 0x1.c38b3p-1f, 0x1.e2b5d4p-2f, 0x1.b72834p-1f,
+    0x1.07387ap-1f, 0x1.a9b662p-1f, 0x1.1c73b4p-1f, 0x1.9b3e04p-1f,
+    0x1.30ff8p-1f, 0x1.8bc806p-1f, 0x1.44cf32p-1f, 0x1.7b5df2p-1f,
+    0x1.57d694p-1f, 0x1.6a09e6p-1f, 0x1.6a09e6p-1f, 0x1.57d694p-1f,
+    0x1.7b5df2p-1f, 0x1.44cf32p-1f, 0x1.8bc806p-1f, 0x1.30ff8p-1f,
+    0x1.9b3e04p-1f, 0x1.1c73b4p-1f, 0x1.a9b662p-1f, 0x1.07387ap-1f,
+    0x1.b72834p-1f, 0x1.e2b5d4p-2f, 0x1.c38b3p-1f, 0x1.b5d1p-2f,
+    0x1.ced7bp-1f, 0x1.87de2ap-2f, 0x1.d906bcp-1f, 0x1.58f9a8p-2f,
+    0x1.e2121p-1f, 0x1.294062p-2f, 0x1.e9f416p-1f, 0x1.f19f98p-3f,
+    0x1.f0a7fp-1f, 0x1.8f8b84p-3f, 0x1.f6297cp-1f, 0x1.2c8106p-3f,
+    0x1.fa7558p-1f, 0x1.917a6cp-4f, 0x1.fd88dap-1f, 0x1.91f66p-5f,
+    0x1.ff621ep-1f, 0x0p+0f, 0x1.fe9cdap-1f, 0x1.2d520ap-4f,
+    0x1.fa7558p-1f, 0x1.2c8106p-3f, 0x1.f38f3ap-1f, 0x1.c0b826p-3f,
+    0x1.e9f416p-1f, 0x1.294062p-2f, 0x1.ddb13cp-1f, 0x1.708854p-2f,
+    0x1.ced7bp-1f, 0x1.b5d1p-2f, 0x1.bd7c0ap-1f, 0x1.f8ba4ep-2f,
+    0x1.a9b662p-1f, 0x1.1c73b4p-1f, 0x1.93a224p-1f, 0x1.3affa2p-1f,
+    0x1.7b5df2p-1f, 0x1.57d694p-1f, 0x1.610b76p-1f, 0x1.72d084p-1f,
+    0x1.44cf32p-1f, 0x1.8bc806p-1f, 0x1.26d054p-1f, 0x1.a29a7ap-1f,
+    0x1.07387ap-1f, 0x1.b72834p-1f, 0x1.cc66eap-2f, 0x1.c954b2p-1f,
+    0x1.87de2ap-2f, 0x1.d906bcp-1f, 0x1.4135cap-2f, 0x1.e6288ep-1f,
+    0x1.f19f98p-3f, 0x1.f0a7fp-1f, 0x1.5e2144p-3f, 0x1.f8765p-1f,
+    0x1.917a6cp-4f, 0x1.fd88dap-1f, 0x1.92156p-6f, 0x1.ffd886p-1f,
+    -0x1.91f66p-5f, 0x1.ff621ep-1f, -0x1.f564e6p-4f, 0x1.fc2648p-1f,
+    -0x1.8f8b84p-3f, 0x1.f6297cp-1f, -0x1.111d26p-2f, 0x1.ed740ep-1f,
+    -0x1.58f9a8p-2f, 0x1.e2121p-1f, -0x1.9ef794p-2f, 0x1.d4134ep-1f,
+    -0x1.e2b5d4p-2f, 0x1.c38b3p-1f, -0x1.11eb36p-1f, 0x1.b090a6p-1f,
+    -0x1.30ff8p-1f, 0x1.9b3e04p-1f, -0x1.4e6cacp-1f, 0x1.83b0ep-1f,
+    0x0p+0f, 0x1.fd88dap-1f, 0x1.917a6cp-4f, 0x1.f6297cp-1f,
+    0x1.8f8b84p-3f, 0x1.e9f416p-1f, 0x1.294062p-2f, 0x1.d906bcp-1f,
+    0x1.87de2ap-2f, 0x1.c38b3p-1f, 0x1.e2b5d4p-2f, 0x1.a9b662p-1f,
+    0x1.1c73b4p-1f, 0x1.8bc806p-1f, 0x1.44cf32p-1f, 0x0p+0f,
+    0x1.f6297cp-1f, 0x1.8f8b84p-3f, 0x1.d906bcp-1f, 0x1.87de2ap-2f,
+    0x1.a9b662p-1f, 0x1.1c73b4p-1f, 0x1.6a09e6p-1f, 0x1.6a09e6p-1f,
+    0x1.1c73b4p-1f, 0x1.a9b662p-1f, 0x1.87de2ap-2f, 0x1.d906bcp-1f,
+    0x1.8f8b84p-3f, 0x1.f6297cp-1f, 0x0p+0f, 0x1.e9f416p-1f,
+    0x1.294062p-2f, 0x1.a9b662p-1f, 0x1.1c73b4p-1f, 0x1.44cf32p-1f,
+    0x1.8bc806p-1f, 0x1.87de2ap-2f, 0x1.d906bcp-1f, 0x1.917a6cp-4f,
+    0x1.fd88dap-1f, -0x1.8f8b84p-3f, 0x1.f6297cp-1f, -0x1.e2b5d4p-2f,
+    0x1.c38b3p-1f, 0x0p+0f, 0x1.d906bcp-1f, 0x1.87de2ap-2f,
+    0x0p+0f, 0x1.6a09e6p-1f, 0x1.6a09e6p-1f, 0x0p+0f,
+    0x1.87de2ap-2f, 0x1.d906bcp-1f, 0x0p+0f,
+};
+
+/* 320 = 4 * 4 * 4 * 5 */
+static const float rfftp_codelet_tw_320[306] = {
+    0x1.ffe6bcp-1f, 0x1.41adacp-6f, 0x1.ff9af2p-1f, 0x1.419dcep-5f,
+    0x1.ff1cacp-1f, 0x1.e24506p-5f, 0x1.fe6bf2p-1f, 0x1.415e54p-4f,
+    0x1.fd88dap-1f, 0x1.917a6cp-4f, 0x1.fc7378p-1f, 0x1.e16ee4p-4f,
+    0x1.fb2be8p-1f, 0x1.1899eep-3f, 0x1.f9b24ap-1f, 0x1.4060b6p-3f,
+    0x1.f806c2p-1f, 0x1.6807e2p-3f, 0x1.f6297cp-1f, 0x1.8f8b84p-3f,
+    0x1.f41aa8p-1f, 0x1.b6e7b8p-3f, 0x1.f1da78p-1f, 0x1.de189ap-3f,
+    0x1.ef6926p-1f, 0x1.028d26p-2f, 0x1.ecc6eep-1f, 0x1.15f47cp-2f,
+    0x1.e9f416p-1f, 0x1.294062p-2f, 0x1.e6f0e2p-1f, 0x1.3c6ef4p-2f,
+    0x1.e3bd9ep-1f, 0x1.4f7e4ap-2f, 0x1.e05a9ep-1f, 0x1.626c82p-2f,
+    0x1.dcc834p-1f, 0x1.7537c2p-2f, 0x1.d906bcp-1f, 0x1.87de2ap-2f,
+    0x1.d51696p-1f, 0x1.9a5de6p-2f, 0x1.d0f824p-1f, 0x1.acb524p-2f,
+    0x1.ccabcep-1f, 0x1.bee21p-2f, 0x1.c83202p-1f, 0x1.d0e2e2p-2f,
+    0x1.c38b3p-1f, 0x1.e2b5d4p-2f, 0x1.beb7ccp-1f, 0x1.f4592p-2f,
+    0x1.b9b852p-1f, 0x1.02e586p-1f, 0x1.b48d4p-1f, 0x1.0b84eep-1f,
+    0x1.af3718p-1f, 0x1.1409fp-1f, 0x1.a9b662p-1f, 0x1.1c73b4p-1f,
+    0x1.a40ba8p-1f, 0x1.24c164p-1f, 0x1.9e377ap-1f, 0x1.2cf23p-1f,
+    0x1.983a6ap-1f, 0x1.350548p-1f, 0x1.92151p-1f, 0x1.3cf9e2p-1f,
+    0x1.8bc806p-1f, 0x1.44cf32p-1f, 0x1.8553eep-1f, 0x1.4c8474p-1f,
+    0x1.7eb96ap-1f, 0x1.5418e6p-1f, 0x1.77f91ep-1f, 0x1.5b8bc6p-1f,
+    0x1.7113b8p-1f, 0x1.62dc58p-1f, 0x0p+0f, 0x1.ff9af2p-1f,
+    0x1.419dcep-5f, 0x1.fe6bf2p-1f, 0x1.415e54p-4f, 0x1.fc7378p-1f,
+    0x1.e16ee4p-4f, 0x1.f9b24ap-1f, 0x1.4060b6p-3f, 0x1.f6297cp-1f,
+    0x1.8f8b84p-3f, 0x1.f1da78p-1f, 0x1.de189ap-3f, 0x1.ecc6eep-1f,
+    0x1.15f47cp-2f, 0x1.e6f0e2p-1f, 0x1.3c6ef4p-2f, 0x1.e05a9ep-1f,
+    0x1.626c82p-2f, 0x1.d906bcp-1f, 0x1.87de2ap-2f, 0x1.d0f824p-1f,
+    0x1.acb524p-2f, 0x1.c83202p-1f, 0x1.d0e2e2p-2f, 0x1.beb7ccp-1f,
+    0x1.f4592p-2f, 0x1.b48d4p-1f, 0x1.0b84eep-1f, 0x1.a9b662p-1f,
+    0x1.1c73b4p-1f, 0x1.9e377ap-1f, 0x1.2cf23p-1f, 0x1.92151p-1f,
+    0x1.3cf9e2p-1f, 0x1.8553eep-1f, 0x1.4c8474p-1f, 0x1.77f91ep-1f,
+    0x1.5b8bc6p-1f, 0x1.6a09e6p-1f, 0x1.6a09e6p-1f, 0x1.5b8bc6p-1f,
+    0x1.77f91ep-1f, 0x1.4c8474p-1f, 0x1.8553eep-1f, 0x1.3cf9e2p-1f,
+    0x1.92151p-1f, 0x1.2cf23p-1f, 0x1.9e377ap-1f, 0x1.1c73b4p-1f,
+    0x1.a9b662p-1f, 0x1.0b84eep-1f, 0x1.b48d4p-1f, 0x1.f4592p-2f,
+    0x1.beb7ccp-1f, 0x1.d0e2e2p-2f, 0x1.c83202p-1f, 0x1.acb524p-2f,
+    0x1.d0f824p-1f, 0x1.87de2ap-2f, 0x1.d906bcp-1f, 0x1.626c82p-2f,
+    0x1.e05a9ep-1f, 0x1.3c6ef4p-2f, 0x1.e6f0e2p-1f, 0x1.15f47cp-2f,
+    0x1.ecc6eep-1f, 0x1.de189ap-3f, 0x1.f1da78p-1f, 0x1.8f8b84p-3f,
+    0x1.f6297cp-1f, 0x1.4060b6p-3f, 0x1.f9b24ap-1f, 0x1.e16ee4p-4f,
+    0x1.fc7378p-1f, 0x1.415e54p-4f, 0x1.fe6bf2p-1f, 0x1.419dcep-5f,
+    0x1.ff9af2p-1f, 0x0p+0f, 0x1.ff1cacp-1f, 0x1.e24506p-5f,
+    0x1.fc7378p-1f, 0x1.e16ee4p-4f, 0x1.f806c2p-1f, 0x1.6807e2p-3f,
+    0x1.f1da78p-1f, 0x1.de189ap-3f, 0x1.e9f416p-1f, 0x1.294062p-2f,
+    0x1.e05a9ep-1f, 0x1.626c82p-2f, 0x1.d51696p-1f, 0x1.9a5de6p-2f,
+    0x1.c83202p-1f, 0x1.d0e2e2p-2f, 0x1.b9b852p-1f, 0x1.02e586p-1f,
+    0x1.a9b662p-1f, 0x1.1c73b4p-1f, 0x1.983a6ap-1f, 0x1.350548p-1f,
+    0x1.8553eep-1f, 0x1.4c8474p-1f, 0x1.7113b8p-1f, 0x1.62dc58p-1f,
+    0x1.5b8bc6p-1f, 0x1.77f91ep-1f, 0x1.44cf32p-1f, 0x1.8bc806p-1f,
+    0x1.2cf23p-1f, 0x1.9e377ap-1f, 0x1.1409fp-1f, 0x1.af3718p-1f,
+    0x1.f4592p-2f, 0x1.beb7ccp-1f, 0x1.bee21p-2f, 0x1.ccabcep-1f,
+    0x1.87de2ap-2f, 0x1.d906bcp-1f, 0x1.4f7e4ap-2f, 0x1.e3bd9ep-1f,
+    0x1.15f47cp-2f, 0x1.ecc6eep-1f, 0x1.b6e7b8p-3f, 0x1.f41aa8p-1f,
+    0x1.4060b6p-3f, 0x1.f9b24ap-1f, 0x1.917a6cp-4f, 0x1.fd88dap-1f,
+    0x1.419dcep-5f, 0x1.ff9af2p-1f, -0x1.41adacp-6f, 0x1.ffe6bcp-1f,
+    -0x1.415e54p-4f, 0x1.fe6bf2p-1f, -0x1.1899eep-3f, 0x1.fb2be8p-1f,
+    -0x1.8f8b84p-3f, 0x1.f6297cp-1f, -0x1.028d26p-2f, 0x1.ef6926p-1f,
+    -0x1.3c6ef4p-2f, 0x1.e6f0e2p-1f, -0x1.7537c2p-2f, 0x1.dcc834p-1f,
+    -0x1.acb524p-2f, 0x1.d0f824p-1f, -0x1.e2b5d4p-2f, 0x1.c38b3p-1f,
+    -0x1.0b84eep-1f, 0x1.b48d4p-1f, -0x1.24c164p-1f, 0x1.a40ba8p-1f,
+    -0x1.3cf9e2p-1f, 0x1.92151p-1f, -0x1.5418e6p-1f, 0x1.7eb96ap-1f,
+    0x0p+0f, 0x1.fe6bf2p-1f, 0x1.415e54p-4f, 0x1.f9b24ap-1f,
+    0x1.4060b6p-3f, 0x1.f1da78p-1f, 0x1.de189ap-3f, 0x1.e6f0e2p-1f,
+    0x1.3c6ef4p-2f, 0x1.d906bcp-1f, 0x1.87de2ap-2f, 0x1.c83202p-1f,
+    0x1.d0e2e2p-2f, 0x1.b48d4p-1f, 0x1.0b84eep-1f, 0x1.9e377ap-1f,
+    0x1.2cf23p-1f, 0x1.8553eep-1f, 0x1.4c8474p-1f, 0x0p+0f,
+    0x1.f9b24ap-1f, 0x1.4060b6p-3f, 0x1.e6f0e2p-1f, 0x1.3c6ef4p-2f,
+    0x1.c83202p-1f, 0x1.d0e2e2p-2f, 0x1.9e377ap-1f, 0x1.2cf23p-1f,
+    0x1.6a09e6p-1f, 0x1.6a09e6p-1f, 0x1.2cf23p-1f, 0x1.9e377ap-1f,
+    0x1.d0e2e2p-2f, 0x1.c83202p-1f, 0x1.3c6ef4p-2f, 0x1.e6f0e2p-1f,
+    0x1.4060b6p-3f, 0x1.f9b24ap-1f, 0x0p+0f, 0x1.f1da78p-1f,
+    0x1.de189ap-3f, 0x1.c83202p-1f, 0x1.d0e2e2p-2f, 0x1.8553eep-1f,
+    0x1.4c8474p-1f, 0x1.2cf23p-1f, 0x1.9e377ap-1f, 0x1.87de2ap-2f,
+    0x1.d906bcp-1f, 0x1.4060b6p-3f, 0x1.f9b24ap-1f, -0x1.415e54p-4f,
+    0x1.fe6bf2p-1f, -0x1.3c6ef4p-2f, 0x1.e6f0e2p-1f, -0x1.0b84eep-1f,
+    0x1.b48d4p-1f, 0x0p+0f, 0x1.e6f0e2p-1f, 0x1.3c6ef4p-2f,
+    0x1.9e377ap-1f, 0x1.2cf23p-1f, 0x1.9e377ap-1f, 0x1.2cf23p-1f,
+    0x1.3c6ef4p-2f, 0x1.e6f0e2p-1f, 0x1.2cf23p-1f, 0x1.9e377ap-1f,
+    -0x1.3c6ef4p-2f, 0x1.e6f0e2p-1f,
+};
+
+/* 400 = 4 * 4 * 5 * 5 */
+static const float rfftp_codelet_tw_400[385] = {
+    0x1.ffefd4p-1f, 0x1.015944p-6f, 0x1.ffbf52p-1f, 0x1.015122p-5f,
+    0x1.ff6e7ep-1f, 0x1.81e564p-5f, 0x1.fefd5cp-1f, 0x1.0130a2p-4f,
+    0x1.fe6bf2p-1f, 0x1.415e54p-4f, 0x1.fdba4cp-1f, 0x1.8177b8p-4f,
+    0x1.fce874p-1f, 0x1.c178c4p-4f, 0x1.fbf676p-1f, 0x1.00aeb6p-3f,
+    0x1.fae462p-1f, 0x1.2090d4p-3f, 0x1.f9b24ap-1f, 0x1.4060b6p-3f,
+    0x1.f8604p-1f, 0x1.601c5ep-3f, 0x1.f6ee5ap-1f, 0x1.7fc1c6p-3f,
+    0x1.f55cb2p-1f, 0x1.9f4ef2p-3f, 0x1.f3ab5cp-1f, 0x1.bec1e2p-3f,
+    0x1.f1da78p-1f, 0x1.de189ap-3f, 0x1.efea22p-1f, 0x1.fd512p-3f,
+    0x1.edda78p-1f, 0x1.0e34bcp-2f, 0x1.ebab9ep-1f, 0x1.1dafd8p-2f,
+    0x1.e95db4p-1f, 0x1.2d18e8p-2f, 0x1.e6f0e2p-1f, 0x1.3c6ef4p-2f,
+    0x1.e4654cp-1f, 0x1.4bb102p-2f, 0x1.e1bb2p-1f, 0x1.5ade1ep-2f,
+    0x1.def286p-1f, 0x1.69f55p-2f, 0x1.dc0baap-1f, 0x1.78f5a4p-2f,
+    0x1.d906bcp-1f, 0x1.87de2ap-2f, 0x1.d5e3fp-1f, 0x1.96adfp-2f,
+    0x1.d2a374p-1f, 0x1.a56406p-2f, 0x1.cf457ep-1f, 0x1.b3ff7cp-2f,
+    0x1.cbca46p-1f, 0x1.c27f6ap-2f, 0x1.c83202p-1f, 0x1.d0e2e2p-2f,
+    0x1.c47ceep-1f, 0x1.df28fep-2f, 0x1.c0ab44p-1f, 0x1.ed50d6p-2f,
+    0x1.bcbd46p-1f, 0x1.fb5984p-2f, 0x1.b8b32ep-1f, 0x1.04a114p-1f,
+    0x1.b48d4p-1f, 0x1.0b84eep-1f, 0x1.b04bcp-1f, 0x1.1257e4p-1f,
+    0x1.abeef2p-1f, 0x1.191984p-1f, 0x1.a7771ap-1f, 0x1.1fc964p-1f,
+    0x1.a2e486p-1f, 0x1.266716p-1f, 0x1.9e377ap-1f, 0x1.2cf23p-1f,
+    0x1.997044p-1f, 0x1.336a48p-1f, 0x1.948f32p-1f, 0x1.39cef4p-1f,
+    0x1.8f9494p-1f, 0x1.401fcep-1f, 0x1.8a80b6p-1f, 0x1.465c7p-1f,
+    0x1.8553eep-1f, 0x1.4c8474p-1f, 0x1.800e8ep-1f, 0x1.529778p-1f,
+    0x1.7ab0eep-1f, 0x1.589518p-1f, 0x1.753b6p-1f, 0x1.5e7cf6p-1f,
+    0x1.6fae4p-1f, 0x1.644eaep-1f, 0x0p+0f, 0x1.ffbf52p-1f,
+    0x1.015122p-5f, 0x1.fefd5cp-1f, 0x1.0130a2p-4f, 0x1.fdba4cp-1f,
+    0x1.8177b8p-4f, 0x1.fbf676p-1f, 0x1.00aeb6p-3f, 0x1.f9b24ap-1f,
+    0x1.4060b6p-3f, 0x1.f6ee5ap-1f, 0x1.7fc1c6p-3f, 0x1.f3ab5cp-1f,
+    0x1.bec1e2p-3f, 0x1.efea22p-1f, 0x1.fd512p-3f, 0x1.ebab9ep-1f,
+    0x1.1dafd8p-2f, 0x1.e6f0e2p-1f, 0x1.3c6ef4p-2f, 0x1.e1bb2p-1f,
+    0x1.5ade1ep-2f, 0x1.dc0baap-1f, 0x1.78f5a4p-2f, 0x1.d5e3fp-1f,
+    0x1.96adfp-2f, 0x1.cf457ep-1f, 0x1.b3ff7cp-2f, 0x1.c83202p-1f,
+    0x1.d0e2e2p-2f, 0x1.c0ab44p-1f, 0x1.ed50d6p-2f, 0x1.b8b32ep-1f,
+    0x1.04a114p-1f, 0x1.b04bcp-1f, 0x1.1257e4p-1f, 0x1.a7771ap-1f,
+    0x1.1fc964p-1f, 0x1.9e377ap-1f, 0x1.2cf23p-1f, 0x1.948f32p-1f,
+    0x1.39cef4p-1f, 0x1.8a80b6p-1f, 0x1.465c7p-1f, 0x1.800e8ep-1f,
+    0x1.529778p-1f, 0x1.753b6p-1f, 0x1.5e7cf6p-1f, 0x1.6a09e6p-1f,
+    0x1.6a09e6p-1f, 0x1.5e7cf6p-1f, 0x1.753b6p-1f, 0x1.529778p-1f,
+    0x1.800e8ep-1f, 0x1.465c7p-1f, 0x1.8a80b6p-1f, 0x1.39cef4p-1f,
+    0x1.948f32p-1f, 0x1.2cf23p-1f, 0x1.9e377ap-1f, 0x1.1fc964p-1f,
+    0x1.a7771ap-1f, 0x1.1257e4p-1f, 0x1.b04bcp-1f, 0x1.04a114p-1f,
+    0x1.b8b32ep-1f, 0x1.ed50d6p-2f, 0x1.c0ab44p-1f, 0x1.d0e2e2p-2f,
+    0x1.c83202p-1f, 0x1.b3ff7cp-2f, 0x1.cf457ep-1f, 0x1.96adfp-2f,
+    0x1.d5e3fp-1f, 0x1.78f5a4p-2f, 0x1.dc0baap-1f, 0x1.5ade1ep-2f,
+    0x1.e1bb2p-1f, 0x1.3c6ef4p-2f, 0x1.e6f0e2p-1f, 0x1.1dafd8p-2f,
+    0x1.ebab9ep-1f, 0x1.fd512p-3f, 0x1.efea22p-1f, 0x1.bec1e2p-3f,
+    0x1.f3ab5cp-1f, 0x1.7fc1c6p-3f, 0x1.f6ee5ap-1f, 0x1.4060b6p-3f,
+    0x1.f9b24ap-1f, 0x1.00aeb6p-3f, 0x1.fbf676p-1f, 0x1.8177b8p-4f,
+    0x1.fdba4cp-1f, 0x1.0130a2p-4f, 0x1.fefd5cp-1f, 0x1.015122p-5f,
+    0x1.ffbf52p-1f, 0x0p+0f, 0x1.ff6e7ep-1f, 0x1.81e564p-5f,
+    0x1.fdba4cp-1f, 0x1.8177b8p-4f, 0x1.fae462p-1f, 0x1.2090d4p-3f,
+    0x1.f6ee5ap-1f, 0x1.7fc1c6p-3f, 0x1.f1da78p-1f, 0x1.de189ap-3f,
+    0x1.ebab9ep-1f, 0x1.1dafd8p-2f, 0x1.e4654cp-1f, 0x1.4bb102p-2f,
+    0x1.dc0baap-1f, 0x1.78f5a4p-2f, 0x1.d2a374p-1f, 0x1.a56406p-2f,
+    0x1.c83202p-1f, 0x1.d0e2e2p-2f, 0x1.bcbd46p-1f, 0x1.fb5984p-2f,
+    0x1.b04bcp-1f, 0x1.1257e4p-1f, 0x1.a2e486p-1f, 0x1.266716p-1f,
+    0x1.948f32p-1f, 0x1.39cef4p-1f, 0x1.8553eep-1f, 0x1.4c8474p-1f,
+    0x1.753b6p-1f, 0x1.5e7cf6p-1f, 0x1.644eaep-1f, 0x1.6fae4p-1f,
+    0x1.529778p-1f, 0x1.800e8ep-1f, 0x1.401fcep-1f, 0x1.8f9494p-1f,
+    0x1.2cf23p-1f, 0x1.9e377ap-1f, 0x1.191984p-1f, 0x1.abeef2p-1f,
+    0x1.04a114p-1f, 0x1.b8b32ep-1f, 0x1.df28fep-2f, 0x1.c47ceep-1f,
+    0x1.b3ff7cp-2f, 0x1.cf457ep-1f, 0x1.87de2ap-2f, 0x1.d906bcp-1f,
+    0x1.5ade1ep-2f, 0x1.e1bb2p-1f, 0x1.2d18e8p-2f, 0x1.e95db4p-1f,
+    0x1.fd512p-3f, 0x1.efea22p-1f, 0x1.9f4ef2p-3f, 0x1.f55cb2p-1f,
+    0x1.4060b6p-3f, 0x1.f9b24ap-1f, 0x1.c178c4p-4f, 0x1.fce874p-1f,
+    0x1.0130a2p-4f, 0x1.fefd5cp-1f, 0x1.015944p-6f, 0x1.ffefd4p-1f,
+    -0x1.015122p-5f, 0x1.ffbf52p-1f, -0x1.415e54p-4f, 0x1.fe6bf2p-1f,
+    -0x1.00aeb6p-3f, 0x1.fbf676p-1f, -0x1.601c5ep-3f, 0x1.f8604p-1f,
+    -0x1.bec1e2p-3f, 0x1.f3ab5cp-1f, -0x1.0e34bcp-2f, 0x1.edda78p-1f,
+    -0x1.3c6ef4p-2f, 0x1.e6f0e2p-1f, -0x1.69f55p-2f, 0x1.def286p-1f,
+    -0x1.96adfp-2f, 0x1.d5e3fp-1f, -0x1.c27f6ap-2f, 0x1.cbca46p-1f,
+    -0x1.ed50d6p-2f, 0x1.c0ab44p-1f, -0x1.0b84eep-1f, 0x1.b48d4p-1f,
+    -0x1.1fc964p-1f, 0x1.a7771ap-1f, -0x1.336a48p-1f, 0x1.997044p-1f,
+    -0x1.465c7p-1f, 0x1.8a80b6p-1f, -0x1.589518p-1f, 0x1.7ab0eep-1f,
+    0x0p+0f, 0x1.fefd5cp-1f, 0x1.0130a2p-4f, 0x1.fbf676p-1f,
+    0x1.00aeb6p-3f, 0x1.f6ee5ap-1f, 0x1.7fc1c6p-3f, 0x1.efea22p-1f,
+    0x1.fd512p-3f, 0x1.e6f0e2p-1f, 0x1.3c6ef4p-2f, 0x1.dc0baap-1f,
+    0x1.78f5a4p-2f, 0x1.cf457ep-1f, 0x1.b3ff7cp-2f, 0x1.c0ab44p-1f,
+    0x1.ed50d6p-2f, 0x1.b04bcp-1f, 0x1.1257e4p-1f, 0x1.9e377ap-1f,
+    0x1.2cf23p-1f, 0x1.8a80b6p-1f, 0x1.465c7p-1f, 0x1.753b6p-1f,
+    0x1.5e7cf6p-1f, 0x1.fbf676p-1f, 0x1.00aeb6p-3f, 0x1.efea22p-1f,
+    0x1.fd512p-3f, 0x1.dc0baap-1f, 0x1.78f5a4p-2f, 0x1.c0ab44p-1f,
+    0x1.ed50d6p-2f, 0x1.9e377ap-1f, 0x1.2cf23p-1f, 0x1.753b6p-1f,
+    0x1.5e7cf6p-1f, 0x1.465c7p-1f, 0x1.8a80b6p-1f, 0x1.1257e4p-1f,
+    0x1.b04bcp-1f, 0x1.b3ff7cp-2f, 0x1.cf457ep-1f, 0x1.3c6ef4p-2f,
+    0x1.e6f0e2p-1f, 0x1.7fc1c6p-3f, 0x1.f6ee5ap-1f, 0x1.0130a2p-4f,
+    0x1.fefd5cp-1f, 0x1.f6ee5ap-1f, 0x1.7fc1c6p-3f, 0x1.dc0baap-1f,
+    0x1.78f5a4p-2f, 0x1.b04bcp-1f, 0x1.1257e4p-1f, 0x1.753b6p-1f,
+    0x1.5e7cf6p-1f, 0x1.2cf23p-1f, 0x1.9e377ap-1f, 0x1.b3ff7cp-2f,
+    0x1.cf457ep-1f, 0x1.fd512p-3f, 0x1.efea22p-1f, 0x1.0130a2p-4f,
+    0x1.fefd5cp-1f, -0x1.00aeb6p-3f, 0x1.fbf676p-1f, -0x1.3c6ef4p-2f,
+    0x1.e6f0e2p-1f, -0x1.ed50d6p-2f, 0x1.c0ab44p-1f, -0x1.465c7p-1f,
+    0x1.8a80b6p-1f, 0x1.efea22p-1f, 0x1.fd512p-3f, 0x1.c0ab44p-1f,
+    0x1.ed50d6p-2f, 0x1.c0ab44p-1f, 0x1.ed50d6p-2f, 0x1.1257e4p-1f,
+    0x1.b04bcp-1f, 0x1.753b6p-1f, 0x1.5e7cf6p-1f, 0x1.0130a2p-4f,
+    0x1.fefd5cp-1f, 0x1.1257e4p-1f, 0x1.b04bcp-1f, -0x1.b3ff7cp-2f,
+    0x1.cf457ep-1f,
+};
+
+/* 512 = 2 * 4 * 4 * 4 * 4 */
+static const float rfftp_codelet_tw_512[498] = {
+    0x1.fff622p-1f, 0x1.921d2p-7f, 0x1.ffd886p-1f, 0x1.92156p-6f,
+    0x1.ffa72ep-1f, 0x1.2d8658p-5f, 0x1.ff621ep-1f, 0x1.91f66p-5f,
+    0x1.ff0956p-1f, 0x1.f656e8p-5f, 0x1.fe9cdap-1f, 0x1.2d520ap-4f,
+    0x1.fe1cbp-1f, 0x1.5f6dp-4f, 0x1.fd88dap-1f, 0x1.917a6cp-4f,
+    0x1.fce16p-1f, 0x1.c3785cp-4f, 0x1.fc2648p-1f, 0x1.f564e6p-4f,
+    0x1.fb5798p-1f, 0x1.139f0cp-3f, 0x1.fa7558p-1f, 0x1.2c8106p-3f,
+    0x1.f97f92p-1f, 0x1.45576cp-3f, 0x1.f8765p-1f, 0x1.5e2144p-3f,
+    0x1.f7599ap-1f, 0x1.76dd9ep-3f, 0x1.f6297cp-1f, 0x1.8f8b84p-3f,
+    0x1.f4e604p-1f, 0x1.a82a02p-3f, 0x1.f38f3ap-1f, 0x1.c0b826p-3f,
+    0x1.f2253p-1f, 0x1.d934fep-3f, 0x1.f0a7fp-1f, 0x1.f19f98p-3f,
+    0x1.ef178ap-1f, 0x1.04fb8p-2f, 0x1.ed740ep-1f, 0x1.111d26p-2f,
+    0x1.ebbd8cp-1f, 0x1.1d3444p-2f, 0x1.e9f416p-1f, 0x1.294062p-2f,
+    0x1.e817bap-1f, 0x1.35410cp-2f, 0x1.e6288ep-1f, 0x1.4135cap-2f,
+    0x1.e426a4p-1f, 0x1.4d1e24p-2f, 0x1.e2121p-1f, 0x1.58f9a8p-2f,
+    0x1.dfeae6p-1f, 0x1.64c7dep-2f, 0x1.ddb13cp-1f, 0x1.708854p-2f,
+    0x1.db6526p-1f, 0x1.7c3a94p-2f, 0x1.d906bcp-1f, 0x1.87de2ap-2f,
+    0x1.d69618p-1f, 0x1.9372a6p-2f, 0x1.d4134ep-1f, 0x1.9ef794p-2f,
+    0x1.d17e78p-1f, 0x1.aa6c82p-2f, 0x1.ced7bp-1f, 0x1.b5d1p-2f,
+    0x1.cc1f1p-1f, 0x1.c1249ep-2f, 0x1.c954b2p-1f, 0x1.cc66eap-2f,
+    0x1.c678b4p-1f, 0x1.d79776p-2f, 0x1.c38b3p-1f, 0x1.e2b5d4p-2f,
+    0x1.c08c42p-1f, 0x1.edc196p-2f, 0x1.bd7c0ap-1f, 0x1.f8ba4ep-2f,
+    0x1.ba5aa6p-1f, 0x1.01cfc8p-1f, 0x1.b72834p-1f, 0x1.07387ap-1f,
+    0x1.b3e4d4p-1f, 0x1.0c9704p-1f, 0x1.b090a6p-1f, 0x1.11eb36p-1f,
+    0x1.ad2bcap-1f, 0x1.1734d6p-1f, 0x1.a9b662p-1f, 0x1.1c73b4p-1f,
+    0x1.a63092p-1f, 0x1.21a79ap-1f, 0x1.a29a7ap-1f, 0x1.26d054p-1f,
+    0x1.9ef43ep-1f, 0x1.2bedb2p-1f, 0x1.9b3e04p-1f, 0x1.30ff8p-1f,
+    0x1.9777fp-1f, 0x1.36058cp-1f, 0x1.93a224p-1f, 0x1.3affa2p-1f,
+    0x1.8fbccap-1f, 0x1.3fed96p-1f, 0x1.8bc806p-1f, 0x1.44cf32p-1f,
+    0x1.87c4p-1f, 0x1.49a44ap-1f, 0x1.83b0ep-1f, 0x1.4e6cacp-1f,
+    0x1.7f8ecep-1f, 0x1.53282ap-1f, 0x1.7b5df2p-1f, 0x1.57d694p-1f,
+    0x1.771e76p-1f, 0x1.5c77bcp-1f, 0x1.72d084p-1f, 0x1.610b76p-1f,
+    0x1.6e7446p-1f, 0x1.659192p-1f, 0x1.6a09e6p-1f, 0x1.6a09e6p-1f,
+    0x1.659192p-1f, 0x1.6e7446p-1f, 0x1.610b76p-1f, 0x1.72d084p-1f,
+    0x1.5c77bcp-1f, 0x1.771e76p-1f, 0x1.57d694p-1f, 0x1.7b5df2p-1f,
+    0x1.53282ap-1f, 0x1.7f8ecep-1f, 0x1.4e6cacp-1f, 0x1.83b0ep-1f,
+    0x1.49a44ap-1f, 0x1.87c4p-1f, 0x1.44cf32p-1f, 0x1.8bc806p-1f,
+    0x1.3fed96p-1f, 0x1.8fbccap-1f, 0x1.3affa2p-1f, 0x1.93a224p-1f,
+    0x1.36058cp-1f, 0x1.9777fp-1f, 0x1.30ff8p-1f, 0x1.9b3e04p-1f,
+    0x1.2bedb2p-1f, 0x1.9ef43ep-1f, 0x1.26d054p-1f, 0x1.a29a7ap-1f,
+    0x1.21a79ap-1f, 0x1.a63092p-1f, 0x1.1c73b4p-1f, 0x1.a9b662p-1f,
+    0x1.1734d6p-1f, 0x1.ad2bcap-1f, 0x1.11eb36p-1f, 0x1.b090a6p-1f,
+    0x1.0c9704p-1f, 0x1.b3e4d4p-1f, 0x1.07387ap-1f, 0x1.b72834p-1f,
+    0x1.01cfc8p-1f, 0x1.ba5aa6p-1f, 0x1.f8ba4ep-2f, 0x1.bd7c0ap-1f,
+    0x1.edc196p-2f, 0x1.c08c42p-1f, 0x1.e2b5d4p-2f, 0x1.c38b3p-1f,
+    0x1.d79776p-2f, 0x1.c678b4p-1f, 0x1.cc66eap-2f, 0x1.c954b2p-1f,
+    0x1.c1249ep-2f, 0x1.cc1f1p-1f, 0x1.b5d1p-2f, 0x1.ced7bp-1f,
+    0x1.aa6c82p-2f, 0x1.d17e78p-1f, 0x1.9ef794p-2f, 0x1.d4134ep-1f,
+    0x1.9372a6p-2f, 0x1.d69618p-1f, 0x1.87de2ap-2f, 0x1.d906bcp-1f,
+    0x1.7c3a94p-2f, 0x1.db6526p-1f, 0x1.708854p-2f, 0x1.ddb13cp-1f,
+    0x1.64c7dep-2f, 0x1.dfeae6p-1f, 0x1.58f9a8p-2f, 0x1.e2121p-1f,
+    0x1.4d1e24p-2f, 0x1.e426a4p-1f, 0x1.4135cap-2f, 0x1.e6288ep-1f,
+    0x1.35410cp-2f, 0x1.e817bap-1f, 0x1.294062p-2f, 0x1.e9f416p-1f,
+    0x1.1d3444p-2f, 0x1.ebbd8cp-1f, 0x1.111d26p-2f, 0x1.ed740ep-1f,
+    0x1.04fb8p-2f, 0x1.ef178ap-1f, 0x1.f19f98p-3f, 0x1.f0a7fp-1f,
+    0x1.d934fep-3f, 0x1.f2253p-1f, 0x1.c0b826p-3f, 0x1.f38f3ap-1f,
+    0x1.a82a02p-3f, 0x1.f4e604p-1f, 0x1.8f8b84p-3f, 0x1.f6297cp-1f,
+    0x1.76dd9ep-3f, 0x1.f7599ap-1f, 0x1.5e2144p-3f, 0x1.f8765p-1f,
+    0x1.45576cp-3f, 0x1.f97f92p-1f, 0x1.2c8106p-3f, 0x1.fa7558p-1f,
+    0x1.139f0cp-3f, 0x1.fb5798p-1f, 0x1.f564e6p-4f, 0x1.fc2648p-1f,
+    0x1.c3785cp-4f, 0x1.fce16p-1f, 0x1.917a6cp-4f, 0x1.fd88dap-1f,
+    0x1.5f6dp-4f, 0x1.fe1cbp-1f, 0x1.2d520ap-4f, 0x1.fe9cdap-1f,
+    0x1.f656e8p-5f, 0x1.ff0956p-1f, 0x1.91f66p-5f, 0x1.ff621ep-1f,
+    0x1.2d8658p-5f, 0x1.ffa72ep-1f, 0x1.92156p-6f, 0x1.ffd886p-1f,
+    0x1.921d2p-7f, 0x1.fff622p-1f, 0x0p+0f, 0x1.ffd886p-1f,
+    0x1.92156p-6f, 0x1.ff621ep-1f, 0x1.91f66p-5f, 0x1.fe9cdap-1f,
+    0x1.2d520ap-4f, 0x1.fd88dap-1f, 0x1.917a6cp-4f, 0x1.fc2648p-1f,
+    0x1.f564e6p-4f, 0x1.fa7558p-1f, 0x1.2c8106p-3f, 0x1.f8765p-1f,
+    0x1.5e2144p-3f, 0x1.f6297cp-1f, 0x1.8f8b84p-3f, 0x1.f38f3ap-1f,
+    0x1.c0b826p-3f, 0x1.f0a7fp-1f, 0x1.f19f98p-3f, 0x1.ed740ep-1f,
+    0x1.111d26p-2f, 0x1.e9f416p-1f, 0x1.294062p-2f, 0x1.e6288ep-1f,
+    0x1.4135cap-2f, 0x1.e2121p-1f, 0x1.58f9a8p-2f, 0x1.ddb13cp-1f,
+    0x1.708854p-2f, 0x1.d906bcp-1f, 0x1.87de2ap-2f, 0x1.d4134ep-1f,
+    0x1.9ef794p-2f, 0x1.ced7bp-1f, 0x1.b5d1p-2f, 0x1.c954b2p-1f,
+    0x1.cc66eap-2f, 0x1.c38b3p-1f, 0x1.e2b5d4p-2f, 0x1.bd7c0ap-1f,
+    0x1.f8ba4ep-2f, 0x1.b72834p-1f, 0x1.07387ap-1f, 0x1.b090a6p-1f,
+    0x1.11eb36p-1f, 0x1.a9b662p-1f, 0x1.1c73b4p-1f, 0x1.a29a7ap-1f,
+    0x1.26d054p-1f, 0x1.9b3e04p-1f, 0x1.30ff8p-1f, 0x1.93a224p-1f,
+    0x1.3affa2p-1f, 0x1.8bc806p-1f, 0x1.44cf32p-1f, 0x1.83b0ep-1f,
+    0x1.4e6cacp-1f, 0x1.7b5df2p-1f, 0x1.57d694p-1f, 0x1.72d084p-1f,
+    0x1.610b76p-1f, 0x0p+0f, 0x1.ff621ep-1f, 0x1.91f66p-5f,
+    0x1.fd88dap-1f, 0x1.917a6cp-4f, 0x1.fa7558p-1f, 0x1.2c8106p-3f,
+    0x1.f6297cp-1f, 0x1.8f8b84p-3f, 0x1.f0a7fp-1f, 0x1.f19f98p-3f,
+    0x1.e9f416p-1f, 0x1.294062p-2f, 0x1.e2121p-1f, 0x1.58f9a8p-2f,
+    0x1.d906bcp-1f, 0x1.87de2ap-2f, 0x1.ced7bp-1f, 0x1.b5d1p-2f,
+    0x1.c38b3p-1f, 0x1.e2b5d4p-2f, 0x1.b72834p-1f, 0x1.07387ap-1f,
+    0x1.a9b662p-1f, 0x1.1c73b4p-1f, 0x1.9b3e04p-1f, 0x1.30ff8p-1f,
+    0x1.8bc806p-1f, 0x1.44cf32p-1f, 0x1.7b5df2p-1f, 0x1.57d694p-1f,
+    0x1.6a09e6p-1f, 0x1.6a09e6p-1f, 0x1.57d694p-1f, 0x1.7b5df2p-1f,
+    0x1.44cf32p-1f, 0x1.8bc806p-1f, 0x1.30ff8p-1f, 0x1.9b3e04p-1f,
+    0x1.1c73b4p-1f, 0x1.a9b662p-1f, 0x1.07387ap-1f, 0x1.b72834p-1f,
+    0x1.e2b5d4p-2f, 0x1.c38b3p-1f, 0x1.b5d1p-2f, 0x1.ced7bp-1f,
+    0x1.87de2ap-2f, 0x1.d906bcp-1f, 0x1.58f9a8p-2f, 0x1.e2121p-1f,
+    0x1.294062p-2f, 0x1.e9f416p-1f, 0x1.f19f98p-3f, 0x1.f0a7fp-1f,
+    0x1.8f8b84p-3f, 0x1.f6297cp-1f, 0x1.2c8106p-3f, 0x1.fa7558p-1f,
+    0x1.917a6cp-4f, 0x1.fd88dap-1f, 0x1.91f66p-5f, 0x1.ff621ep-1f,
+    0x0p+0f, 0x1.fe9cdap-1f, 0x1.2d520ap-4f, 0x1.fa7558p-1f,
+    0x1.2c8106p-3f, 0x1.f38f3ap-1f, 0x1.c0b826p-3f, 0x1.e9f416p-1f,
+    0x1.294062p-2f, 0x1.ddb13cp-1f, 0x1.708854p-2f, 0x1.ced7bp-1f,
+    0x1.b5d1p-2f, 0x1.bd7c0ap-1f, 0x1.f8ba4ep-2f, 0x1.a9b662p-1f,
+    0x1.1c73b4p-1f, 0x1.93a224p-1f, 0x1.3affa2p-1f, 0x1.7b5df2p-1f,
+    0x1.57d694p-1f, 0x1.610b76p-1f, 0x1.72d084p-1f, 0x1.44cf32p-1f,
+    0x1.8bc806p-1f, 0x1.26d054p-1f, 0x1.a29a7ap-1f, 0x1.07387ap-1f,
+    0x1.b72834p-1f, 0x1.cc66eap-2f, 0x1.c954b2p-1f, 0x1.87de2ap-2f,
+    0x1.d906bcp-1f, 0x1.4135cap-2f, 0x1.e6288ep-1f, 0x1.f19f98p-3f,
+    0x1.f0a7fp-1f, 0x1.5e2144p-3f, 0x1.f8765p-1f, 0x1.917a6cp-4f,
+    0x1.fd88dap-1f, 0x1.92156p-6f, 0x1.ffd886p-1f, -0x1.91f66p-5f,
+    0x1.ff621ep-1f, -0x1.f564e6p-4f, 0x1.fc2648p-1f, -0x1.8f8b84p-3f,
+    0x1.f6297cp-1f, -0x1.111d26p-2f, 0x1.ed740ep-1f, -0x1.58f9a8p-2f,
+    0x1.e2121p-1f, -0x1.9ef794p-2f, 0x1.d4134ep-1f, -0x1.e2b5d4p-2f,
+    0x1.c38b3p-1f, -0x1.11eb36p-1f, 0x1.b090a6p-1f, -0x1.30ff8p-1f,
+    0x1.9b3e04p-1f, -0x1.4e6cacp-1f, 0x1.83b0ep-1f, 0x0p+0f,
+    0x1.fd88dap-1f, 0x1.917a6cp-4f, 0x1.f6297cp-1f, 0x1.8f8b84p-3f,
+    0x1.e9f416p-1f, 0x1.294062p-2f, 0x1.d906bcp-1f, 0x1.87de2ap-2f,
+    0x1.c38b3p-1f, 0x1.e2b5d4p-2f, 0x1.a9b662p-1f, 0x1.1c73b4p-1f,
+    0x1.8bc806p-1f, 0x1.44cf32p-1f, 0x0p+0f, 0x1.f6297cp-1f,
+    0x1.8f8b84p-3f, 0x1.d906bcp-1f, 0x1.87de2ap-2f, 0x1.a9b662p-1f,
+    0x1.1c73b4p-1f, 0x1.6a09e6p-1f, 0x1.6a09e6p-1f, 0x1.1c73b4p-1f,
+    0x1.a9b662p-1f, 0x1.87de2ap-2f, 0x1.d906bcp-1f, 0x1.8f8b84p-3f,
+    0x1.f6297cp-1f, 0x0p+0f, 0x1.e9f416p-1f, 0x1.294062p-2f,
+    0x1.a9b662p-1f, 0x1.1c73b4p-1f, 0x1.44cf32p-1f, 0x1.8bc806p-1f,
+    0x1.87de2ap-2f, 0x1.d906bcp-1f, 0x1.917a6cp-4f, 0x1.fd88dap-1f,
+    -0x1.8f8b84p-3f, 0x1.f6297cp-1f, -0x1.e2b5d4p-2f, 0x1.c38b3p-1f,
+    0x0p+0f, 0x1.d906bcp-1f, 0x1.87de2ap-2f, 0x0p+0f,
+    0x1.6a09e6p-1f, 0x1.6a09e6p-1f, 0x0p+0f, 0x1.87de2ap-2f,
+    0x1.d906bcp-1f, 0x0p+0f,
+};
+
+/* Pass lengths with a codelet in the instantiation of the given lane
+   count. */
+static const struct {
+  size_t length, lanes;
+} rfftp_codelets[] = {
+    {16, 16},
+    {20, 16},
+    {32, 8},
+    {32, 16},
+    {40, 8},
+    {50, 8},
+    {64, 4},
+    {64, 8},
+    {80, 4},
+    {100, 4},
+    {128, 4},
+    {256, 1},
+    {256, 4},
+    {256, 8},
+    {256, 16},
+    {320, 1},
+    {320, 4},
+    {320, 8},
+    {400, 1},
+    {400, 4},
+    {400, 8},
+    {512, 1},
+    {512, 4},
+    {512, 8},
+};
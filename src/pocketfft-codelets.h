@@ -0,0 +1,469 @@
+/*
+ * This file is part of pocketfft.
+ * Licensed under a 3-clause BSD style license - see LICENSE.md
+ */
+
+/*
+ *  Codelets: rfftp_forward_passes and rfftp_backward_passes unrolled for
+ *  the lengths in pocketfft-codelet-tables.h, with constant strides and
+ *  twiddle tables so that every pass is specialized in place.
+ *  Generated by tools/gen_fft_codelets.c (zig build codelets); do not edit.
+ *
+ *  Included by pocketfft-rfftp.h for every instantiation that defines
+ *  RFFTP_CODELET_LANES, the lane count of its element type.
+ */
+
+#if RFFTP_CODELET_LANES == 16
+/* 16 = 4 * 4 */
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_forward_16)(RFFTP_T *c, RFFTP_T *ch,
+                                             size_t nonzero) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_16;
+  if (nonzero < 16)
+    RFFTP_NAME(radf4_pruned)(4, c, ch, nonzero);
+  else
+    RFFTP_NAME(radf4)(1, 4, c, ch, nullptr);
+  RFFTP_NAME(radf4)(4, 1, ch, c, tw + 0);
+  return c;
+}
+
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_backward_16)(RFFTP_T *c, RFFTP_T *ch) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_16;
+  RFFTP_NAME(radb4)(4, 1, c, ch, tw + 0);
+  RFFTP_NAME(radb4)(1, 4, ch, c, nullptr);
+  return c;
+}
+#endif
+
+#if RFFTP_CODELET_LANES == 16
+/* 20 = 4 * 5 */
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_forward_20)(RFFTP_T *c, RFFTP_T *ch,
+                                             size_t nonzero) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_20;
+  if (nonzero < 20)
+    memset(c + nonzero, 0, (20 - nonzero) * sizeof(RFFTP_T));
+  RFFTP_NAME(radf5)(1, 4, c, ch, nullptr);
+  RFFTP_NAME(radf4)(5, 1, ch, c, tw + 0);
+  return c;
+}
+
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_backward_20)(RFFTP_T *c, RFFTP_T *ch) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_20;
+  RFFTP_NAME(radb4)(5, 1, c, ch, tw + 0);
+  RFFTP_NAME(radb5)(1, 4, ch, c, nullptr);
+  return c;
+}
+#endif
+
+#if RFFTP_CODELET_LANES == 8 || RFFTP_CODELET_LANES == 16
+/* 32 = 2 * 4 * 4 */
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_forward_32)(RFFTP_T *c, RFFTP_T *ch,
+                                             size_t nonzero) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_32;
+  if (nonzero < 32)
+    RFFTP_NAME(radf4_pruned)(8, c, ch, nonzero);
+  else
+    RFFTP_NAME(radf4)(1, 8, c, ch, nullptr);
+  RFFTP_NAME(radf4)(4, 2, ch, c, tw + 15);
+  RFFTP_NAME(radf2)(16, 1, c, ch, tw + 0);
+  return ch;
+}
+
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_backward_32)(RFFTP_T *c, RFFTP_T *ch) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_32;
+  RFFTP_NAME(radb2)(16, 1, c, ch, tw + 0);
+  RFFTP_NAME(radb4)(4, 2, ch, c, tw + 15);
+  RFFTP_NAME(radb4)(1, 8, c, ch, nullptr);
+  return ch;
+}
+#endif
+
+#if RFFTP_CODELET_LANES == 8
+/* 40 = 2 * 4 * 5 */
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_forward_40)(RFFTP_T *c, RFFTP_T *ch,
+                                             size_t nonzero) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_40;
+  if (nonzero < 40)
+    memset(c + nonzero, 0, (40 - nonzero) * sizeof(RFFTP_T));
+  RFFTP_NAME(radf5)(1, 8, c, ch, nullptr);
+  RFFTP_NAME(radf4)(5, 2, ch, c, tw + 19);
+  RFFTP_NAME(radf2)(20, 1, c, ch, tw + 0);
+  return ch;
+}
+
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_backward_40)(RFFTP_T *c, RFFTP_T *ch) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_40;
+  RFFTP_NAME(radb2)(20, 1, c, ch, tw + 0);
+  RFFTP_NAME(radb4)(5, 2, ch, c, tw + 19);
+  RFFTP_NAME(radb5)(1, 8, c, ch, nullptr);
+  return ch;
+}
+#endif
+
+#if RFFTP_CODELET_LANES == 8
+/* 50 = 2 * 5 * 5 */
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_forward_50)(RFFTP_T *c, RFFTP_T *ch,
+                                             size_t nonzero) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_50;
+  if (nonzero < 50)
+    memset(c + nonzero, 0, (50 - nonzero) * sizeof(RFFTP_T));
+  RFFTP_NAME(radf5)(1, 10, c, ch, nullptr);
+  RFFTP_NAME(radf5)(5, 2, ch, c, tw + 24);
+  RFFTP_NAME(radf2)(25, 1, c, ch, tw + 0);
+  return ch;
+}
+
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_backward_50)(RFFTP_T *c, RFFTP_T *ch) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_50;
+  RFFTP_NAME(radb2)(25, 1, c, ch, tw + 0);
+  RFFTP_NAME(radb5)(5, 2, ch, c, tw + 24);
+  RFFTP_NAME(radb5)(1, 10, c, ch, nullptr);
+  return ch;
+}
+#endif
+
+#if RFFTP_CODELET_LANES == 4 || RFFTP_CODELET_LANES == 8
+/* 64 = 4 * 4 * 4 */
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_forward_64)(RFFTP_T *c, RFFTP_T *ch,
+                                             size_t nonzero) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_64;
+  if (nonzero < 64)
+    RFFTP_NAME(radf4_pruned)(16, c, ch, nonzero);
+  else
+    RFFTP_NAME(radf4)(1, 16, c, ch, nullptr);
+  RFFTP_NAME(radf4)(4, 4, ch, c, tw + 45);
+  RFFTP_NAME(radf4)(16, 1, c, ch, tw + 0);
+  return ch;
+}
+
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_backward_64)(RFFTP_T *c, RFFTP_T *ch) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_64;
+  RFFTP_NAME(radb4)(16, 1, c, ch, tw + 0);
+  RFFTP_NAME(radb4)(4, 4, ch, c, tw + 45);
+  RFFTP_NAME(radb4)(1, 16, c, ch, nullptr);
+  return ch;
+}
+#endif
+
+#if RFFTP_CODELET_LANES == 4
+/* 80 = 4 * 4 * 5 */
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_forward_80)(RFFTP_T *c, RFFTP_T *ch,
+                                             size_t nonzero) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_80;
+  if (nonzero < 80)
+    memset(c + nonzero, 0, (80 - nonzero) * sizeof(RFFTP_T));
+  RFFTP_NAME(radf5)(1, 16, c, ch, nullptr);
+  RFFTP_NAME(radf4)(5, 4, ch, c, tw + 57);
+  RFFTP_NAME(radf4)(20, 1, c, ch, tw + 0);
+  return ch;
+}
+
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_backward_80)(RFFTP_T *c, RFFTP_T *ch) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_80;
+  RFFTP_NAME(radb4)(20, 1, c, ch, tw + 0);
+  RFFTP_NAME(radb4)(5, 4, ch, c, tw + 57);
+  RFFTP_NAME(radb5)(1, 16, c, ch, nullptr);
+  return ch;
+}
+#endif
+
+#if RFFTP_CODELET_LANES == 4
+/* 100 = 4 * 5 * 5 */
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_forward_100)(RFFTP_T *c, RFFTP_T *ch,
+                                              size_t nonzero) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_100;
+  if (nonzero < 100)
+    memset(c + nonzero, 0, (100 - nonzero) * sizeof(RFFTP_T));
+  RFFTP_NAME(radf5)(1, 20, c, ch, nullptr);
+  RFFTP_NAME(radf5)(5, 4, ch, c, tw + 72);
+  RFFTP_NAME(radf4)(25, 1, c, ch, tw + 0);
+  return ch;
+}
+
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_backward_100)(RFFTP_T *c, RFFTP_T *ch) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_100;
+  RFFTP_NAME(radb4)(25, 1, c, ch, tw + 0);
+  RFFTP_NAME(radb5)(5, 4, ch, c, tw + 72);
+  RFFTP_NAME(radb5)(1, 20, c, ch, nullptr);
+  return ch;
+}
+#endif
+
+#if RFFTP_CODELET_LANES == 4
+/* 128 = 2 * 4 * 4 * 4 */
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_forward_128)(RFFTP_T *c, RFFTP_T *ch,
+                                              size_t nonzero) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_128;
+  if (nonzero < 128)
+    RFFTP_NAME(radf4_pruned)(32, c, ch, nonzero);
+  else
+    RFFTP_NAME(radf4)(1, 32, c, ch, nullptr);
+  RFFTP_NAME(radf4)(4, 8, ch, c, tw + 108);
+  RFFTP_NAME(radf4)(16, 2, c, ch, tw + 63);
+  RFFTP_NAME(radf2)(64, 1, ch, c, tw + 0);
+  return c;
+}
+
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_backward_128)(RFFTP_T *c, RFFTP_T *ch) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_128;
+  RFFTP_NAME(radb2)(64, 1, c, ch, tw + 0);
+  RFFTP_NAME(radb4)(16, 2, ch, c, tw + 63);
+  RFFTP_NAME(radb4)(4, 8, c, ch, tw + 108);
+  RFFTP_NAME(radb4)(1, 32, ch, c, nullptr);
+  return c;
+}
+#endif
+
+/* 256 = 4 * 4 * 4 * 4 */
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_forward_256)(RFFTP_T *c, RFFTP_T *ch,
+                                              size_t nonzero) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_256;
+  if (nonzero < 256)
+    RFFTP_NAME(radf4_pruned)(64, c, ch, nonzero);
+  else
+    RFFTP_NAME(radf4)(1, 64, c, ch, nullptr);
+  RFFTP_NAME(radf4)(4, 16, ch, c, tw + 234);
+  RFFTP_NAME(radf4)(16, 4, c, ch, tw + 189);
+  RFFTP_NAME(radf4)(64, 1, ch, c, tw + 0);
+  return c;
+}
+
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_backward_256)(RFFTP_T *c, RFFTP_T *ch) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_256;
+  RFFTP_NAME(radb4)(64, 1, c, ch, tw + 0);
+  RFFTP_NAME(radb4)(16, 4, ch, c, tw + 189);
+  RFFTP_NAME(radb4)(4, 16, c, ch, tw + 234);
+  RFFTP_NAME(radb4)(1, 64, ch, c, nullptr);
+  return c;
+}
+
+#if RFFTP_CODELET_LANES == 1 || RFFTP_CODELET_LANES == 4 || \
+    RFFTP_CODELET_LANES == 8
+/* 320 = 4 * 4 * 4 * 5 */
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_forward_320)(RFFTP_T *c, RFFTP_T *ch,
+                                              size_t nonzero) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_320;
+  if (nonzero < 320)
+    memset(c + nonzero, 0, (320 - nonzero) * sizeof(RFFTP_T));
+  RFFTP_NAME(radf5)(1, 64, c, ch, nullptr);
+  RFFTP_NAME(radf4)(5, 16, ch, c, tw + 294);
+  RFFTP_NAME(radf4)(20, 4, c, ch, tw + 237);
+  RFFTP_NAME(radf4)(80, 1, ch, c, tw + 0);
+  return c;
+}
+
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_backward_320)(RFFTP_T *c, RFFTP_T *ch) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_320;
+  RFFTP_NAME(radb4)(80, 1, c, ch, tw + 0);
+  RFFTP_NAME(radb4)(20, 4, ch, c, tw + 237);
+  RFFTP_NAME(radb4)(5, 16, c, ch, tw + 294);
+  RFFTP_NAME(radb5)(1, 64, ch, c, nullptr);
+  return c;
+}
+#endif
+
+#if RFFTP_CODELET_LANES == 1 || RFFTP_CODELET_LANES == 4 || \
+    RFFTP_CODELET_LANES == 8
+/* 400 = 4 * 4 * 5 * 5 */
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_forward_400)(RFFTP_T *c, RFFTP_T *ch,
+                                              size_t nonzero) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_400;
+  if (nonzero < 400)
+    memset(c + nonzero, 0, (400 - nonzero) * sizeof(RFFTP_T));
+  RFFTP_NAME(radf5)(1, 80, c, ch, nullptr);
+  RFFTP_NAME(radf5)(5, 16, ch, c, tw + 369);
+  RFFTP_NAME(radf4)(25, 4, c, ch, tw + 297);
+  RFFTP_NAME(radf4)(100, 1, ch, c, tw + 0);
+  return c;
+}
+
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_backward_400)(RFFTP_T *c, RFFTP_T *ch) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_400;
+  RFFTP_NAME(radb4)(100, 1, c, ch, tw + 0);
+  RFFTP_NAME(radb4)(25, 4, ch, c, tw + 297);
+  RFFTP_NAME(radb5)(5, 16, c, ch, tw + 369);
+  RFFTP_NAME(radb5)(1, 80, ch, c, nullptr);
+  return c;
+}
+#endif
+
+#if RFFTP_CODELET_LANES == 1 || RFFTP_CODELET_LANES == 4 || \
+    RFFTP_CODELET_LANES == 8
+/* 512 = 2 * 4 * 4 * 4 * 4 */
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_forward_512)(RFFTP_T *c, RFFTP_T *ch,
+                                              size_t nonzero) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_512;
+  if (nonzero < 512)
+    RFFTP_NAME(radf4_pruned)(128, c, ch, nonzero);
+  else
+    RFFTP_NAME(radf4)(1, 128, c, ch, nullptr);
+  RFFTP_NAME(radf4)(4, 32, ch, c, tw + 489);
+  RFFTP_NAME(radf4)(16, 8, c, ch, tw + 444);
+  RFFTP_NAME(radf4)(64, 2, ch, c, tw + 255);
+  RFFTP_NAME(radf2)(256, 1, c, ch, tw + 0);
+  return ch;
+}
+
+RFFTP_ATTR [[gnu::flatten]]
+static RFFTP_T *RFFTP_NAME(rfftp_backward_512)(RFFTP_T *c, RFFTP_T *ch) {
+  [[maybe_unused]] const float *tw = rfftp_codelet_tw_512;
+  RFFTP_NAME(radb2)(256, 1, c, ch, tw + 0);
+  RFFTP_NAME(radb4)(64, 2, ch, c, tw + 255);
+  RFFTP_NAME(radb4)(16, 8, c, ch, tw + 444);
+  RFFTP_NAME(radb4)(4, 32, ch, c, tw + 489);
+  RFFTP_NAME(radb4)(1, 128, c, ch, nullptr);
+  return ch;
+}
+#endif
+
+/* Runs the forward codelet of the given length; nullptr if this
+   instantiation has none. */
+RFFTP_ATTR
+static RFFTP_T *RFFTP_NAME(rfftp_codelet_forward)(size_t length, RFFTP_T *c,
+                                             RFFTP_T *ch, size_t nonzero) {
+  switch (length) {
+#if RFFTP_CODELET_LANES == 16
+  case 16:
+    return RFFTP_NAME(rfftp_forward_16)(c, ch, nonzero);
+#endif
+#if RFFTP_CODELET_LANES == 16
+  case 20:
+    return RFFTP_NAME(rfftp_forward_20)(c, ch, nonzero);
+#endif
+#if RFFTP_CODELET_LANES == 8 || RFFTP_CODELET_LANES == 16
+  case 32:
+    return RFFTP_NAME(rfftp_forward_32)(c, ch, nonzero);
+#endif
+#if RFFTP_CODELET_LANES == 8
+  case 40:
+    return RFFTP_NAME(rfftp_forward_40)(c, ch, nonzero);
+#endif
+#if RFFTP_CODELET_LANES == 8
+  case 50:
+    return RFFTP_NAME(rfftp_forward_50)(c, ch, nonzero);
+#endif
+#if RFFTP_CODELET_LANES == 4 || RFFTP_CODELET_LANES == 8
+  case 64:
+    return RFFTP_NAME(rfftp_forward_64)(c, ch, nonzero);
+#endif
+#if RFFTP_CODELET_LANES == 4
+  case 80:
+    return RFFTP_NAME(rfftp_forward_80)(c, ch, nonzero);
+#endif
+#if RFFTP_CODELET_LANES == 4
+  case 100:
+    return RFFTP_NAME(rfftp_forward_100)(c, ch, nonzero);
+#endif
+#if RFFTP_CODELET_LANES == 4
+  case 128:
+    return RFFTP_NAME(rfftp_forward_128)(c, ch, nonzero);
+#endif
+  case 256:
+    return RFFTP_NAME(rfftp_forward_256)(c, ch, nonzero);
+#if RFFTP_CODELET_LANES == 1 || RFFTP_CODELET_LANES == 4 || \
+    RFFTP_CODELET_LANES == 8
+  case 320:
+    return RFFTP_NAME(rfftp_forward_320)(c, ch, nonzero);
+#endif
+#if RFFTP_CODELET_LANES == 1 || RFFTP_CODELET_LANES == 4 || \
+    RFFTP_CODELET_LANES == 8
+  case 400:
+    return RFFTP_NAME(rfftp_forward_400)(c, ch, nonzero);
+#endif
+#if RFFTP_CODELET_LANES == 1 || RFFTP_CODELET_LANES == 4 || \
+    RFFTP_CODELET_LANES == 8
+  case 512:
+    return RFFTP_NAME(rfftp_forward_512)(c, ch, nonzero);
+#endif
+  default:
+    return nullptr;
+  }
+}
+
+/* Runs the backward codelet of the given length; nullptr if this
+   instantiation has none. */
+RFFTP_ATTR
+static RFFTP_T *RFFTP_NAME(rfftp_codelet_backward)(size_t length, RFFTP_T *c,
+                                             RFFTP_T *ch) {
+  switch (length) {
+#if RFFTP_CODELET_LANES == 16
+  case 16:
+    return RFFTP_NAME(rfftp_backward_16)(c, ch);
+#endif
+#if RFFTP_CODELET_LANES == 16
+  case 20:
+    return RFFTP_NAME(rfftp_backward_20)(c, ch);
+#endif
+#if RFFTP_CODELET_LANES == 8 || RFFTP_CODELET_LANES == 16
+  case 32:
+    return RFFTP_NAME(rfftp_backward_32)(c, ch);
+#endif
+#if RFFTP_CODELET_LANES == 8
+  case 40:
+    return RFFTP_NAME(rfftp_backward_40)(c, ch);
+#endif
+#if RFFTP_CODELET_LANES == 8
+  case 50:
+    return RFFTP_NAME(rfftp_backward_50)(c, ch);
+#endif
+#if RFFTP_CODELET_LANES == 4 || RFFTP_CODELET_LANES == 8
+  case 64:
+    return RFFTP_NAME(rfftp_backward_64)(c, ch);
+#endif
+#if RFFTP_CODELET_LANES == 4
+  case 80:
+    return RFFTP_NAME(rfftp_backward_80)(c, ch);
+#endif
+#if RFFTP_CODELET_LANES == 4
+  case 100:
+    return RFFTP_NAME(rfftp_backward_100)(c, ch);
+#endif
+#if RFFTP_CODELET_LANES == 4
+  case 128:
+    return RFFTP_NAME(rfftp_backward_128)(c, ch);
+#endif
+  case 256:
+    return RFFTP_NAME(rfftp_backward_256)(c, ch);
+#if RFFTP_CODELET_LANES == 1 || RFFTP_CODELET_LANES == 4 || \
+    RFFTP_CODELET_LANES == 8
+  case 320:
+    return RFFTP_NAME(rfftp_backward_320)(c, ch);
+#endif
+#if RFFTP_CODELET_LANES == 1 || RFFTP_CODELET_LANES == 4 || \
+    RFFTP_CODELET_LANES == 8
+  case 400:
+    return RFFTP_NAME(rfftp_backward_400)(c, ch);
+#endif
+#if RFFTP_CODELET_LANES == 1 || RFFTP_CODELET_LANES == 4 || \
+    RFFTP_CODELET_LANES == 8
+  case 512:
+    return RFFTP_NAME(rfftp_backward_512)(c, ch);
+#endif
+  default:
+    return nullptr;
+  }
+}
@@ -0,0 +1,1066 @@
+/*
+ * This file is part of pocketfft.
+ * Licensed under a 3-clause BSD style license - see LICENSE.md
+ */
+
+/*
+ *  Real-data passes and plans of the packed (FFTPACK-style) real FFT.
+ *
+ *  This is not a standalone header: pocketfft.c includes it once per element
+ *  type after defining
+ *    RFFTP_T        type of the transformed data
+ *    RFFTP_S        type of the twiddle factors and of the scale factor
+ *    RFFTP_NAME(x)  decoration applied to every function and type name
+ *  and optionally
+ *    RFFTP_ATTR     attributes placed on the passes and their drivers, e.g. a
+ *                   target ISA
+ *    RFFTP_PLAN     an existing plan type to drive the passes with; when set,
+ *                   only the passes and the pass drivers are emitted
+ *    RFFTP_CODELET_LANES
+ *                   lane count of RFFTP_T (1 for float); when set, plans
+ *                   flagged with codelet run the matching driver from
+ *                   pocketfft-codelets.h
+ *  on top of its RALLOC/DEALLOC/SWAP/NFCT helpers and sincos_2pibyn_half.
+ *  All parameters are undefined again at the end of this file.
+ *
+ *  Copyright (C) 2004-2018 Max-Planck-Society
+ *  \author Martin Reinecke
+ */
+
+#ifndef RFFTP_ATTR
+#define RFFTP_ATTR
+#endif
+
+#ifndef RFFTP_PLAN
+#define RFFTP_OWNS_PLAN
+typedef struct RFFTP_NAME(rfftp_fctdata) {
+  size_t fct;
+  RFFTP_S *tw, *tws;
+} RFFTP_NAME(rfftp_fctdata);
+
+typedef struct RFFTP_NAME(rfftp_plan_i) {
+  size_t length, nfct;
+  bool codelet; /* try pocketfft-codelets.h before the generic driver */
+  RFFTP_S *mem;
+  RFFTP_NAME(rfftp_fctdata) fct[NFCT];
+} RFFTP_NAME(rfftp_plan_i);
+typedef struct RFFTP_NAME(rfftp_plan_i) *RFFTP_NAME(rfftp_plan);
+#define RFFTP_PLAN RFFTP_NAME(rfftp_plan)
+#endif
+
+#define WA(x, i) wa[(i) + (x) * (ido - 1)]
+#define PM(a, b, c, d)                                                         \
+  {                                                                            \
+    a = c + d;                                                                 \
+    b = c - d;                                                                 \
+  }
+/* (a+ib) = conj(c+id) * (e+if) */
+#define MULPM(a, b, c, d, e, f)                                                \
+  {                                                                            \
+    a = c * e + d * f;                                                         \
+    b = c * f - d * e;                                                         \
+  }
+
+#define CC(a, b, c) cc[(a) + ido * ((b) + l1 * (c))]
+#define CH(a, b, c) ch[(a) + ido * ((b) + cdim * (c))]
+
+RFFTP_ATTR
+static NOINLINE void RFFTP_NAME(radf2)(size_t ido, size_t l1,
+                                       const RFFTP_T *restrict cc,
+                                       RFFTP_T *restrict ch,
+                                       const RFFTP_S *restrict wa) {
+  const size_t cdim = 2;
+
+  for (size_t k = 0; k < l1; k++)
+    PM(CH(0, 0, k), CH(ido - 1, 1, k), CC(0, k, 0), CC(0, k, 1))
+  if ((ido & 1) == 0)
+    for (size_t k = 0; k < l1; k++) {
+      CH(0, 1, k) = -CC(ido - 1, k, 1);
+      CH(ido - 1, 0, k) = CC(ido - 1, k, 0);
+    }
+  if (ido <= 2)
+    return;
+  for (size_t k = 0; k < l1; k++)
+    for (size_t i = 2; i < ido; i += 2) {
+      size_t ic = ido - i;
+      RFFTP_T tr2, ti2;
+      MULPM(tr2, ti2, WA(0, i - 2), WA(0, i - 1), CC(i - 1, k, 1), CC(i, k, 1))
+      PM(CH(i - 1, 0, k), CH(ic - 1, 1, k), CC(i - 1, k, 0), tr2)
+      PM(CH(i, 0, k), CH(ic, 1, k), ti2, CC(i, k, 0))
+    }
+}
+
+RFFTP_ATTR
+static NOINLINE void RFFTP_NAME(radf3)(size_t ido, size_t l1,
+                                       const RFFTP_T *restrict cc,
+                                       RFFTP_T *restrict ch,
+                                       const RFFTP_S *restrict wa) {
+  const size_t cdim = 3;
+  static constexpr RFFTP_S taur = -0.5;
+  static constexpr RFFTP_S taui = 0.86602540378443864676;
+
+  for (size_t k = 0; k < l1; k++) {
+    RFFTP_T cr2 = CC(0, k, 1) + CC(0, k, 2);
+    CH(0, 0, k) = CC(0, k, 0) + cr2;
+    CH(0, 2, k) = taui * (CC(0, k, 2) - CC(0, k, 1));
+    CH(ido - 1, 1, k) = CC(0, k, 0) + taur * cr2;
+  }
+  if (ido == 1)
+    return;
+  for (size_t k = 0; k < l1; k++)
+    for (size_t i = 2; i < ido; i += 2) {
+      size_t ic = ido - i;
+      RFFTP_T di2, di3, dr2, dr3;
+      MULPM(dr2, di2, WA(0, i - 2), WA(0, i - 1), CC(i - 1, k, 1),
+            CC(i, k, 1)) // d2=conj(WA0)*CC1
+      MULPM(dr3, di3, WA(1, i - 2), WA(1, i - 1), CC(i - 1, k, 2),
+            CC(i, k, 2))      // d3=conj(WA1)*CC2
+      RFFTP_T cr2 = dr2 + dr3; // c add
+      RFFTP_T ci2 = di2 + di3;
+      CH(i - 1, 0, k) = CC(i - 1, k, 0) + cr2; // c add
+      CH(i, 0, k) = CC(i, k, 0) + ci2;
+      RFFTP_T tr2 = CC(i - 1, k, 0) + taur * cr2; // c add
+      RFFTP_T ti2 = CC(i, k, 0) + taur * ci2;
+      RFFTP_T tr3 = taui * (di2 - di3); // t3 = taui*i*(d3-d2)?
+      RFFTP_T ti3 = taui * (dr3 - dr2);
+      PM(CH(i - 1, 2, k), CH(ic - 1, 1, k), tr2, tr3) // PM(i) = t2+t3
+      PM(CH(i, 2, k), CH(ic, 1, k), ti3, ti2)         // PM(ic) = conj(t2-t3)
+    }
+}
+
+RFFTP_ATTR
+static NOINLINE void RFFTP_NAME(radf4)(size_t ido, size_t l1,
+                                       const RFFTP_T *restrict cc,
+                                       RFFTP_T *restrict ch,
+                                       const RFFTP_S *restrict wa) {
+  const size_t cdim = 4;
+  static constexpr RFFTP_S hsqt2 = 0.70710678118654752440;
+
+  for (size_t k = 0; k < l1; k++) {
+    RFFTP_T tr1, tr2;
+    PM(tr1, CH(0, 2, k), CC(0, k, 3), CC(0, k, 1))
+    PM(tr2, CH(ido - 1, 1, k), CC(0, k, 0), CC(0, k, 2))
+    PM(CH(0, 0, k), CH(ido - 1, 3, k), tr2, tr1)
+  }
+  if ((ido & 1) == 0)
+    for (size_t k = 0; k < l1; k++) {
+      RFFTP_T ti1 = -hsqt2 * (CC(ido - 1, k, 1) + CC(ido - 1, k, 3));
+      RFFTP_T tr1 = hsqt2 * (CC(ido - 1, k, 1) - CC(ido - 1, k, 3));
+      PM(CH(ido - 1, 0, k), CH(ido - 1, 2, k), CC(ido - 1, k, 0), tr1)
+      PM(CH(0, 3, k), CH(0, 1, k), ti1, CC(ido - 1, k, 2))
+    }
+  if (ido <= 2)
+    return;
+  for (size_t k = 0; k < l1; k++)
+    for (size_t i = 2; i < ido; i += 2) {
+      size_t ic = ido - i;
+      RFFTP_T ci2, ci3, ci4, cr2, cr3, cr4, ti1, ti2, ti3, ti4, tr1, tr2, tr3,
+          tr4;
+      MULPM(cr2, ci2, WA(0, i - 2), WA(0, i - 1), CC(i - 1, k, 1), CC(i, k, 1))
+      MULPM(cr3, ci3, WA(1, i - 2), WA(1, i - 1), CC(i - 1, k, 2), CC(i, k, 2))
+      MULPM(cr4, ci4, WA(2, i - 2), WA(2, i - 1), CC(i - 1, k, 3), CC(i, k, 3))
+      PM(tr1, tr4, cr4, cr2)
+      PM(ti1, ti4, ci2, ci4)
+      PM(tr2, tr3, CC(i - 1, k, 0), cr3)
+      PM(ti2, ti3, CC(i, k, 0), ci3)
+      PM(CH(i - 1, 0, k), CH(ic - 1, 3, k), tr2, tr1)
+      PM(CH(i, 0, k), CH(ic, 3, k), ti1, ti2)
+      PM(CH(i - 1, 2, k), CH(ic - 1, 1, k), tr3, ti4)
+      PM(CH(i, 2, k), CH(ic, 1, k), tr4, ti3)
+    }
+}
+
+/* Index range [0, live) of butterflies in a first pass (ido == 1) whose
+   input j lies below nonzero, i.e. is not known to be zero. */
+#define LIVE_END(j)                                                            \
+  (nonzero > (j) * l1 ? (nonzero - (j) * l1 < l1 ? nonzero - (j) * l1 : l1)   \
+                      : 0)
+
+/* radf2 with ido == 1 for input that is zero from cc[nonzero] on; those
+   elements are never read. */
+RFFTP_ATTR
+static NOINLINE void RFFTP_NAME(radf2_pruned)(size_t l1,
+                                              const RFFTP_T *restrict cc,
+                                              RFFTP_T *restrict ch,
+                                              size_t nonzero) {
+  const size_t ido = 1, cdim = 2;
+  size_t e1 = LIVE_END(1), e0 = LIVE_END(0), k = 0;
+
+  for (; k < e1; k++)
+    PM(CH(0, 0, k), CH(0, 1, k), CC(0, k, 0), CC(0, k, 1))
+  for (; k < e0; k++)
+    CH(0, 0, k) = CH(0, 1, k) = CC(0, k, 0);
+  for (; k < l1; k++)
+    CH(0, 0, k) = CH(0, 1, k) = (RFFTP_T){0};
+}
+
+/* radf4 with ido == 1 for input that is zero from cc[nonzero] on; those
+   elements are never read. */
+RFFTP_ATTR
+static NOINLINE void RFFTP_NAME(radf4_pruned)(size_t l1,
+                                              const RFFTP_T *restrict cc,
+                                              RFFTP_T *restrict ch,
+                                              size_t nonzero) {
+  const size_t ido = 1, cdim = 4;
+  size_t e3 = LIVE_END(3), e2 = LIVE_END(2), e1 = LIVE_END(1),
+         e0 = LIVE_END(0), k = 0;
+
+  for (; k < e3; k++) {
+    RFFTP_T tr1, tr2;
+    PM(tr1, CH(0, 2, k), CC(0, k, 3), CC(0, k, 1))
+    PM(tr2, CH(0, 1, k), CC(0, k, 0), CC(0, k, 2))
+    PM(CH(0, 0, k), CH(0, 3, k), tr2, tr1)
+  }
+  for (; k < e2; k++) {
+    RFFTP_T tr2;
+    CH(0, 2, k) = -CC(0, k, 1);
+    PM(tr2, CH(0, 1, k), CC(0, k, 0), CC(0, k, 2))
+    PM(CH(0, 0, k), CH(0, 3, k), tr2, CC(0, k, 1))
+  }
+  for (; k < e1; k++) {
+    CH(0, 2, k) = -CC(0, k, 1);
+    CH(0, 1, k) = CC(0, k, 0);
+    PM(CH(0, 0, k), CH(0, 3, k), CC(0, k, 0), CC(0, k, 1))
+  }
+  for (; k < e0; k++) {
+    CH(0, 2, k) = (RFFTP_T){0};
+    CH(0, 0, k) = CH(0, 1, k) = CH(0, 3, k) = CC(0, k, 0);
+  }
+  for (; k < l1; k++)
+    CH(0, 0, k) = CH(0, 1, k) = CH(0, 2, k) = CH(0, 3, k) = (RFFTP_T){0};
+}
+
+#undef LIVE_END
+
+RFFTP_ATTR
+static NOINLINE void RFFTP_NAME(radf5)(size_t ido, size_t l1,
+                                       const RFFTP_T *restrict cc,
+                                       RFFTP_T *restrict ch,
+                                       const RFFTP_S *restrict wa) {
+  const size_t cdim = 5;
+  static constexpr RFFTP_S tr11 = 0.3090169943749474241;
+  static constexpr RFFTP_S ti11 = 0.95105651629515357212;
+  static constexpr RFFTP_S tr12 = -0.8090169943749474241;
+  static constexpr RFFTP_S ti12 = 0.58778525229247312917;
+
+  for (size_t k = 0; k < l1; k++) {
+    RFFTP_T cr2, cr3, ci4, ci5;
+    PM(cr2, ci5, CC(0, k, 4), CC(0, k, 1))
+    PM(cr3, ci4, CC(0, k, 3), CC(0, k, 2))
+    CH(0, 0, k) = CC(0, k, 0) + cr2 + cr3;
+    CH(ido - 1, 1, k) = CC(0, k, 0) + tr11 * cr2 + tr12 * cr3;
+    CH(0, 2, k) = ti11 * ci5 + ti12 * ci4;
+    CH(ido - 1, 3, k) = CC(0, k, 0) + tr12 * cr2 + tr11 * cr3;
+    CH(0, 4, k) = ti12 * ci5 - ti11 * ci4;
+  }
+  if (ido == 1)
+    return;
+  for (size_t k = 0; k < l1; ++k)
+    for (size_t i = 2; i < ido; i += 2) {
+      RFFTP_T ci2, di2, ci4, ci5, di3, di4, di5, ci3, cr2, cr3, dr2, dr3, dr4,
+          dr5, cr5, cr4, ti2, ti3, ti5, ti4, tr2, tr3, tr4, tr5;
+      size_t ic = ido - i;
+      MULPM(dr2, di2, WA(0, i - 2), WA(0, i - 1), CC(i - 1, k, 1), CC(i, k, 1))
+      MULPM(dr3, di3, WA(1, i - 2), WA(1, i - 1), CC(i - 1, k, 2), CC(i, k, 2))
+      MULPM(dr4, di4, WA(2, i - 2), WA(2, i - 1), CC(i - 1, k, 3), CC(i, k, 3))
+      MULPM(dr5, di5, WA(3, i - 2), WA(3, i - 1), CC(i - 1, k, 4), CC(i, k, 4))
+      PM(cr2, ci5, dr5, dr2)
+      PM(ci2, cr5, di2, di5)
+      PM(cr3, ci4, dr4, dr3)
+      PM(ci3, cr4, di3, di4)
+      CH(i - 1, 0, k) = CC(i - 1, k, 0) + cr2 + cr3;
+      CH(i, 0, k) = CC(i, k, 0) + ci2 + ci3;
+      tr2 = CC(i - 1, k, 0) + tr11 * cr2 + tr12 * cr3;
+      ti2 = CC(i, k, 0) + tr11 * ci2 + tr12 * ci3;
+      tr3 = CC(i - 1, k, 0) + tr12 * cr2 + tr11 * cr3;
+      ti3 = CC(i, k, 0) + tr12 * ci2 + tr11 * ci3;
+      MULPM(tr5, tr4, cr5, cr4, ti11, ti12)
+      MULPM(ti5, ti4, ci5, ci4, ti11, ti12)
+      PM(CH(i - 1, 2, k), CH(ic - 1, 1, k), tr2, tr5)
+      PM(CH(i, 2, k), CH(ic, 1, k), ti5, ti2)
+      PM(CH(i - 1, 4, k), CH(ic - 1, 3, k), tr3, tr4)
+      PM(CH(i, 4, k), CH(ic, 3, k), ti4, ti3)
+    }
+}
+
+#undef CC
+#undef CH
+#define C1(a, b, c) cc[(a) + ido * ((b) + l1 * (c))]
+#define C2(a, b) cc[(a) + idl1 * (b)]
+#define CH2(a, b) ch[(a) + idl1 * (b)]
+#define CC(a, b, c) cc[(a) + ido * ((b) + cdim * (c))]
+#define CH(a, b, c) ch[(a) + ido * ((b) + l1 * (c))]
+RFFTP_ATTR
+static NOINLINE void RFFTP_NAME(radfg)(size_t ido, size_t ip, size_t l1,
+                                       RFFTP_T *restrict cc,
+                                       RFFTP_T *restrict ch,
+                                       const RFFTP_S *restrict wa,
+                                       const RFFTP_S *restrict csarr) {
+  const size_t cdim = ip;
+  size_t ipph = (ip + 1) / 2;
+  size_t idl1 = ido * l1;
+
+  if (ido > 1) {
+    for (size_t j = 1, jc = ip - 1; j < ipph; ++j, --jc) // 114
+    {
+      size_t is = (j - 1) * (ido - 1), is2 = (jc - 1) * (ido - 1);
+      for (size_t k = 0; k < l1; ++k) // 113
+      {
+        size_t idij = is;
+        size_t idij2 = is2;
+        for (size_t i = 1; i <= ido - 2; i += 2) // 112
+        {
+          RFFTP_T t1 = C1(i, k, j), t2 = C1(i + 1, k, j), t3 = C1(i, k, jc),
+                 t4 = C1(i + 1, k, jc);
+          RFFTP_T x1 = wa[idij] * t1 + wa[idij + 1] * t2,
+                 x2 = wa[idij] * t2 - wa[idij + 1] * t1,
+                 x3 = wa[idij2] * t3 + wa[idij2 + 1] * t4,
+                 x4 = wa[idij2] * t4 - wa[idij2 + 1] * t3;
+          C1(i, k, j) = x1 + x3;
+          C1(i, k, jc) = x2 - x4;
+          C1(i + 1, k, j) = x2 + x4;
+          C1(i + 1, k, jc) = x3 - x1;
+          idij += 2;
+          idij2 += 2;
+        }
+      }
+    }
+  }
+
+  for (size_t j = 1, jc = ip - 1; j < ipph; ++j, --jc) // 123
+    for (size_t k = 0; k < l1; ++k)                    // 122
+    {
+      RFFTP_T t1 = C1(0, k, j), t2 = C1(0, k, jc);
+      C1(0, k, j) = t1 + t2;
+      C1(0, k, jc) = t2 - t1;
+    }
+
+  // everything in C
+  // memset(ch,0,ip*l1*ido*sizeof(RFFTP_T));
+
+  for (size_t l = 1, lc = ip - 1; l < ipph; ++l, --lc) // 127
+  {
+    for (size_t ik = 0; ik < idl1; ++ik) // 124
+    {
+      CH2(ik, l) =
+          C2(ik, 0) + csarr[2 * l] * C2(ik, 1) + csarr[4 * l] * C2(ik, 2);
+      CH2(ik, lc) =
+          csarr[2 * l + 1] * C2(ik, ip - 1) + csarr[4 * l + 1] * C2(ik, ip - 2);
+    }
+    size_t iang = 2 * l;
+    size_t j = 3, jc = ip - 3;
+    for (; j < ipph - 3; j += 4, jc -= 4) // 126
+    {
+      iang += l;
+      if (iang >= ip)
+        iang -= ip;
+      RFFTP_S ar1 = csarr[2 * iang], ai1 = csarr[2 * iang + 1];
+      iang += l;
+      if (iang >= ip)
+        iang -= ip;
+      RFFTP_S ar2 = csarr[2 * iang], ai2 = csarr[2 * iang + 1];
+      iang += l;
+      if (iang >= ip)
+        iang -= ip;
+      RFFTP_S ar3 = csarr[2 * iang], ai3 = csarr[2 * iang + 1];
+      iang += l;
+      if (iang >= ip)
+        iang -= ip;
+      RFFTP_S ar4 = csarr[2 * iang], ai4 = csarr[2 * iang + 1];
+      for (size_t ik = 0; ik < idl1; ++ik) // 125
+      {
+        CH2(ik, l) += ar1 * C2(ik, j) + ar2 * C2(ik, j + 1) +
+                      ar3 * C2(ik, j + 2) + ar4 * C2(ik, j + 3);
+        CH2(ik, lc) += ai1 * C2(ik, jc) + ai2 * C2(ik, jc - 1) +
+                       ai3 * C2(ik, jc - 2) + ai4 * C2(ik, jc - 3);
+      }
+    }
+    for (; j < ipph - 1; j += 2, jc -= 2) // 126
+    {
+      iang += l;
+      if (iang >= ip)
+        iang -= ip;
+      RFFTP_S ar1 = csarr[2 * iang], ai1 = csarr[2 * iang + 1];
+      iang += l;
+      if (iang >= ip)
+        iang -= ip;
+      RFFTP_S ar2 = csarr[2 * iang], ai2 = csarr[2 * iang + 1];
+      for (size_t ik = 0; ik < idl1; ++ik) // 125
+      {
+        CH2(ik, l) += ar1 * C2(ik, j) + ar2 * C2(ik, j + 1);
+        CH2(ik, lc) += ai1 * C2(ik, jc) + ai2 * C2(ik, jc - 1);
+      }
+    }
+    for (; j < ipph; ++j, --jc) // 126
+    {
+      iang += l;
+      if (iang >= ip)
+        iang -= ip;
+      RFFTP_S ar = csarr[2 * iang], ai = csarr[2 * iang + 1];
+      for (size_t ik = 0; ik < idl1; ++ik) // 125
+      {
+        CH2(ik, l) += ar * C2(ik, j);
+        CH2(ik, lc) += ai * C2(ik, jc);
+      }
+    }
+  }
+  for (size_t ik = 0; ik < idl1; ++ik) // 101
+    CH2(ik, 0) = C2(ik, 0);
+  for (size_t j = 1; j < ipph; ++j)      // 129
+    for (size_t ik = 0; ik < idl1; ++ik) // 128
+      CH2(ik, 0) += C2(ik, j);
+
+  // everything in CH at this point!
+  // memset(cc,0,ip*l1*ido*sizeof(RFFTP_T));
+
+  for (size_t k = 0; k < l1; ++k)    // 131
+    for (size_t i = 0; i < ido; ++i) // 130
+      CC(i, 0, k) = CH(i, k, 0);
+
+  for (size_t j = 1, jc = ip - 1; j < ipph; ++j, --jc) // 137
+  {
+    size_t j2 = 2 * j - 1;
+    for (size_t k = 0; k < l1; ++k) // 136
+    {
+      CC(ido - 1, j2, k) = CH(0, k, j);
+      CC(0, j2 + 1, k) = CH(0, k, jc);
+    }
+  }
+
+  if (ido == 1)
+    return;
+
+  for (size_t j = 1, jc = ip - 1; j < ipph; ++j, --jc) // 140
+  {
+    size_t j2 = 2 * j - 1;
+    for (size_t k = 0; k < l1; ++k)                                       // 139
+      for (size_t i = 1, ic = ido - i - 2; i <= ido - 2; i += 2, ic -= 2) // 138
+      {
+        CC(i, j2 + 1, k) = CH(i, k, j) + CH(i, k, jc);
+        CC(ic, j2, k) = CH(i, k, j) - CH(i, k, jc);
+        CC(i + 1, j2 + 1, k) = CH(i + 1, k, j) + CH(i + 1, k, jc);
+        CC(ic + 1, j2, k) = CH(i + 1, k, jc) - CH(i + 1, k, j);
+      }
+  }
+}
+#undef C1
+#undef C2
+#undef CH2
+
+#undef CH
+#undef CC
+#define CH(a, b, c) ch[(a) + ido * ((b) + l1 * (c))]
+#define CC(a, b, c) cc[(a) + ido * ((b) + cdim * (c))]
+
+RFFTP_ATTR
+static NOINLINE void RFFTP_NAME(radb2)(size_t ido, size_t l1,
+                                       const RFFTP_T *restrict cc,
+                                       RFFTP_T *restrict ch,
+                                       const RFFTP_S *restrict wa) {
+  const size_t cdim = 2;
+
+  for (size_t k = 0; k < l1; k++)
+    PM(CH(0, k, 0), CH(0, k, 1), CC(0, 0, k), CC(ido - 1, 1, k))
+  if ((ido & 1) == 0)
+    for (size_t k = 0; k < l1; k++) {
+      CH(ido - 1, k, 0) = 2 * CC(ido - 1, 0, k);
+      CH(ido - 1, k, 1) = -2 * CC(0, 1, k);
+    }
+  if (ido <= 2)
+    return;
+  for (size_t k = 0; k < l1; ++k)
+    for (size_t i = 2; i < ido; i += 2) {
+      size_t ic = ido - i;
+      RFFTP_T ti2, tr2;
+      PM(CH(i - 1, k, 0), tr2, CC(i - 1, 0, k), CC(ic - 1, 1, k))
+      PM(ti2, CH(i, k, 0), CC(i, 0, k), CC(ic, 1, k))
+      MULPM(CH(i, k, 1), CH(i - 1, k, 1), WA(0, i - 2), WA(0, i - 1), ti2, tr2)
+    }
+}
+
+RFFTP_ATTR
+static NOINLINE void RFFTP_NAME(radb3)(size_t ido, size_t l1,
+                                       const RFFTP_T *restrict cc,
+                                       RFFTP_T *restrict ch,
+                                       const RFFTP_S *restrict wa) {
+  const size_t cdim = 3;
+  static constexpr RFFTP_S taur = -0.5;
+  static constexpr RFFTP_S taui = 0.86602540378443864676;
+
+  for (size_t k = 0; k < l1; k++) {
+    RFFTP_T tr2 = 2 * CC(ido - 1, 1, k);
+    RFFTP_T cr2 = CC(0, 0, k) + taur * tr2;
+    CH(0, k, 0) = CC(0, 0, k) + tr2;
+    RFFTP_T ci3 = 2 * taui * CC(0, 2, k);
+    PM(CH(0, k, 2), CH(0, k, 1), cr2, ci3);
+  }
+  if (ido == 1)
+    return;
+  for (size_t k = 0; k < l1; k++)
+    for (size_t i = 2; i < ido; i += 2) {
+      size_t ic = ido - i;
+      RFFTP_T tr2 =
+          CC(i - 1, 2, k) + CC(ic - 1, 1, k); // t2=CC(I) + conj(CC(ic))
+      RFFTP_T ti2 = CC(i, 2, k) - CC(ic, 1, k);
+      RFFTP_T cr2 = CC(i - 1, 0, k) + taur * tr2; // c2=CC +taur*t2
+      RFFTP_T ci2 = CC(i, 0, k) + taur * ti2;
+      CH(i - 1, k, 0) = CC(i - 1, 0, k) + tr2; // CH=CC+t2
+      CH(i, k, 0) = CC(i, 0, k) + ti2;
+      RFFTP_T cr3 = taui * (CC(i - 1, 2, k) -
+                           CC(ic - 1, 1, k)); // c3=taui*(CC(i)-conj(CC(ic)))
+      RFFTP_T ci3 = taui * (CC(i, 2, k) + CC(ic, 1, k));
+      RFFTP_T di2, di3, dr2, dr3;
+      PM(dr3, dr2, cr2, ci3) // d2= (cr2-ci3, ci2+cr3) = c2+i*c3
+      PM(di2, di3, ci2, cr3) // d3= (cr2+ci3, ci2-cr3) = c2-i*c3
+      MULPM(CH(i, k, 1), CH(i - 1, k, 1), WA(0, i - 2), WA(0, i - 1), di2,
+            dr2) // ch = WA*d2
+      MULPM(CH(i, k, 2), CH(i - 1, k, 2), WA(1, i - 2), WA(1, i - 1), di3, dr3)
+    }
+}
+
+RFFTP_ATTR
+static NOINLINE void RFFTP_NAME(radb4)(size_t ido, size_t l1,
+                                       const RFFTP_T *restrict cc,
+                                       RFFTP_T *restrict ch,
+                                       const RFFTP_S *restrict wa) {
+  const size_t cdim = 4;
+  static constexpr RFFTP_S sqrt2 = 1.41421356237309504880;
+
+  for (size_t k = 0; k < l1; k++) {
+    RFFTP_T tr1, tr2;
+    PM(tr2, tr1, CC(0, 0, k), CC(ido - 1, 3, k))
+    RFFTP_T tr3 = 2 * CC(ido - 1, 1, k);
+    RFFTP_T tr4 = 2 * CC(0, 2, k);
+    PM(CH(0, k, 0), CH(0, k, 2), tr2, tr3)
+    PM(CH(0, k, 3), CH(0, k, 1), tr1, tr4)
+  }
+  if ((ido & 1) == 0)
+    for (size_t k = 0; k < l1; k++) {
+      RFFTP_T tr1, tr2, ti1, ti2;
+      PM(ti1, ti2, CC(0, 3, k), CC(0, 1, k))
+      PM(tr2, tr1, CC(ido - 1, 0, k), CC(ido - 1, 2, k))
+      CH(ido - 1, k, 0) = tr2 + tr2;
+      CH(ido - 1, k, 1) = sqrt2 * (tr1 - ti1);
+      CH(ido - 1, k, 2) = ti2 + ti2;
+      CH(ido - 1, k, 3) = -sqrt2 * (tr1 + ti1);
+    }
+  if (ido <= 2)
+    return;
+  for (size_t k = 0; k < l1; ++k)
+    for (size_t i = 2; i < ido; i += 2) {
+      RFFTP_T ci2, ci3, ci4, cr2, cr3, cr4, ti1, ti2, ti3, ti4, tr1, tr2, tr3,
+          tr4;
+      size_t ic = ido - i;
+      PM(tr2, tr1, CC(i - 1, 0, k), CC(ic - 1, 3, k))
+      PM(ti1, ti2, CC(i, 0, k), CC(ic, 3, k))
+      PM(tr4, ti3, CC(i, 2, k), CC(ic, 1, k))
+      PM(tr3, ti4, CC(i - 1, 2, k), CC(ic - 1, 1, k))
+      PM(CH(i - 1, k, 0), cr3, tr2, tr3)
+      PM(CH(i, k, 0), ci3, ti2, ti3)
+      PM(cr4, cr2, tr1, tr4)
+      PM(ci2, ci4, ti1, ti4)
+      MULPM(CH(i, k, 1), CH(i - 1, k, 1), WA(0, i - 2), WA(0, i - 1), ci2, cr2)
+      MULPM(CH(i, k, 2), CH(i - 1, k, 2), WA(1, i - 2), WA(1, i - 1), ci3, cr3)
+      MULPM(CH(i, k, 3), CH(i - 1, k, 3), WA(2, i - 2), WA(2, i - 1), ci4, cr4)
+    }
+}
+
+RFFTP_ATTR
+static NOINLINE void RFFTP_NAME(radb5)(size_t ido, size_t l1,
+                                       const RFFTP_T *restrict cc,
+                                       RFFTP_T *restrict ch,
+                                       const RFFTP_S *restrict wa) {
+  const size_t cdim = 5;
+  static constexpr RFFTP_S tr11 = 0.3090169943749474241;
+  static constexpr RFFTP_S ti11 = 0.95105651629515357212;
+  static constexpr RFFTP_S tr12 = -0.8090169943749474241;
+  static constexpr RFFTP_S ti12 = 0.58778525229247312917;
+
+  for (size_t k = 0; k < l1; k++) {
+    RFFTP_T ti5 = CC(0, 2, k) + CC(0, 2, k);
+    RFFTP_T ti4 = CC(0, 4, k) + CC(0, 4, k);
+    RFFTP_T tr2 = CC(ido - 1, 1, k) + CC(ido - 1, 1, k);
+    RFFTP_T tr3 = CC(ido - 1, 3, k) + CC(ido - 1, 3, k);
+    CH(0, k, 0) = CC(0, 0, k) + tr2 + tr3;
+    RFFTP_T cr2 = CC(0, 0, k) + tr11 * tr2 + tr12 * tr3;
+    RFFTP_T cr3 = CC(0, 0, k) + tr12 * tr2 + tr11 * tr3;
+    RFFTP_T ci4, ci5;
+    MULPM(ci5, ci4, ti5, ti4, ti11, ti12)
+    PM(CH(0, k, 4), CH(0, k, 1), cr2, ci5)
+    PM(CH(0, k, 3), CH(0, k, 2), cr3, ci4)
+  }
+  if (ido == 1)
+    return;
+  for (size_t k = 0; k < l1; ++k)
+    for (size_t i = 2; i < ido; i += 2) {
+      size_t ic = ido - i;
+      RFFTP_T tr2, tr3, tr4, tr5, ti2, ti3, ti4, ti5;
+      PM(tr2, tr5, CC(i - 1, 2, k), CC(ic - 1, 1, k))
+      PM(ti5, ti2, CC(i, 2, k), CC(ic, 1, k))
+      PM(tr3, tr4, CC(i - 1, 4, k), CC(ic - 1, 3, k))
+      PM(ti4, ti3, CC(i, 4, k), CC(ic, 3, k))
+      CH(i - 1, k, 0) = CC(i - 1, 0, k) + tr2 + tr3;
+      CH(i, k, 0) = CC(i, 0, k) + ti2 + ti3;
+      RFFTP_T cr2 = CC(i - 1, 0, k) + tr11 * tr2 + tr12 * tr3;
+      RFFTP_T ci2 = CC(i, 0, k) + tr11 * ti2 + tr12 * ti3;
+      RFFTP_T cr3 = CC(i - 1, 0, k) + tr12 * tr2 + tr11 * tr3;
+      RFFTP_T ci3 = CC(i, 0, k) + tr12 * ti2 + tr11 * ti3;
+      RFFTP_T ci4, ci5, cr5, cr4;
+      MULPM(cr5, cr4, tr5, tr4, ti11, ti12)
+      MULPM(ci5, ci4, ti5, ti4, ti11, ti12)
+      RFFTP_T dr2, dr3, dr4, dr5, di2, di3, di4, di5;
+      PM(dr4, dr3, cr3, ci4)
+      PM(di3, di4, ci3, cr4)
+      PM(dr5, dr2, cr2, ci5)
+      PM(di2, di5, ci2, cr5)
+      MULPM(CH(i, k, 1), CH(i - 1, k, 1), WA(0, i - 2), WA(0, i - 1), di2, dr2)
+      MULPM(CH(i, k, 2), CH(i - 1, k, 2), WA(1, i - 2), WA(1, i - 1), di3, dr3)
+      MULPM(CH(i, k, 3), CH(i - 1, k, 3), WA(2, i - 2), WA(2, i - 1), di4, dr4)
+      MULPM(CH(i, k, 4), CH(i - 1, k, 4), WA(3, i - 2), WA(3, i - 1), di5, dr5)
+    }
+}
+
+#undef CC
+#undef CH
+#define CC(a, b, c) cc[(a) + ido * ((b) + cdim * (c))]
+#define CH(a, b, c) ch[(a) + ido * ((b) + l1 * (c))]
+#define C1(a, b, c) cc[(a) + ido * ((b) + l1 * (c))]
+#define C2(a, b) cc[(a) + idl1 * (b)]
+#define CH2(a, b) ch[(a) + idl1 * (b)]
+
+RFFTP_ATTR
+static NOINLINE void RFFTP_NAME(radbg)(size_t ido, size_t ip, size_t l1,
+                                       RFFTP_T *restrict cc,
+                                       RFFTP_T *restrict ch,
+                                       const RFFTP_S *restrict wa,
+                                       const RFFTP_S *restrict csarr) {
+  const size_t cdim = ip;
+  size_t ipph = (ip + 1) / 2;
+  size_t idl1 = ido * l1;
+
+  for (size_t k = 0; k < l1; ++k)    // 102
+    for (size_t i = 0; i < ido; ++i) // 101
+      CH(i, k, 0) = CC(i, 0, k);
+  for (size_t j = 1, jc = ip - 1; j < ipph; ++j, --jc) // 108
+  {
+    size_t j2 = 2 * j - 1;
+    for (size_t k = 0; k < l1; ++k) {
+      CH(0, k, j) = 2 * CC(ido - 1, j2, k);
+      CH(0, k, jc) = 2 * CC(0, j2 + 1, k);
+    }
+  }
+
+  if (ido != 1) {
+    for (size_t j = 1, jc = ip - 1; j < ipph; ++j, --jc) // 111
+    {
+      size_t j2 = 2 * j - 1;
+      for (size_t k = 0; k < l1; ++k)
+        for (size_t i = 1, ic = ido - i - 2; i <= ido - 2;
+             i += 2, ic -= 2) // 109
+        {
+          CH(i, k, j) = CC(i, j2 + 1, k) + CC(ic, j2, k);
+          CH(i, k, jc) = CC(i, j2 + 1, k) - CC(ic, j2, k);
+          CH(i + 1, k, j) = CC(i + 1, j2 + 1, k) - CC(ic + 1, j2, k);
+          CH(i + 1, k, jc) = CC(i + 1, j2 + 1, k) + CC(ic + 1, j2, k);
+        }
+    }
+  }
+  for (size_t l = 1, lc = ip - 1; l < ipph; ++l, --lc) {
+    for (size_t ik = 0; ik < idl1; ++ik) {
+      C2(ik, l) =
+          CH2(ik, 0) + csarr[2 * l] * CH2(ik, 1) + csarr[4 * l] * CH2(ik, 2);
+      C2(ik, lc) = csarr[2 * l + 1] * CH2(ik, ip - 1) +
+                   csarr[4 * l + 1] * CH2(ik, ip - 2);
+    }
+    size_t iang = 2 * l;
+    size_t j = 3, jc = ip - 3;
+    for (; j < ipph - 3; j += 4, jc -= 4) {
+      iang += l;
+      if (iang > ip)
+        iang -= ip;
+      RFFTP_S ar1 = csarr[2 * iang], ai1 = csarr[2 * iang + 1];
+      iang += l;
+      if (iang > ip)
+        iang -= ip;
+      RFFTP_S ar2 = csarr[2 * iang], ai2 = csarr[2 * iang + 1];
+      iang += l;
+      if (iang > ip)
+        iang -= ip;
+      RFFTP_S ar3 = csarr[2 * iang], ai3 = csarr[2 * iang + 1];
+      iang += l;
+      if (iang > ip)
+        iang -= ip;
+      RFFTP_S ar4 = csarr[2 * iang], ai4 = csarr[2 * iang + 1];
+      for (size_t ik = 0; ik < idl1; ++ik) {
+        C2(ik, l) += ar1 * CH2(ik, j) + ar2 * CH2(ik, j + 1) +
+                     ar3 * CH2(ik, j + 2) + ar4 * CH2(ik, j + 3);
+        C2(ik, lc) += ai1 * CH2(ik, jc) + ai2 * CH2(ik, jc - 1) +
+                      ai3 * CH2(ik, jc - 2) + ai4 * CH2(ik, jc - 3);
+      }
+    }
+    for (; j < ipph - 1; j += 2, jc -= 2) {
+      iang += l;
+      if (iang > ip)
+        iang -= ip;
+      RFFTP_S ar1 = csarr[2 * iang], ai1 = csarr[2 * iang + 1];
+      iang += l;
+      if (iang > ip)
+        iang -= ip;
+      RFFTP_S ar2 = csarr[2 * iang], ai2 = csarr[2 * iang + 1];
+      for (size_t ik = 0; ik < idl1; ++ik) {
+        C2(ik, l) += ar1 * CH2(ik, j) + ar2 * CH2(ik, j + 1);
+        C2(ik, lc) += ai1 * CH2(ik, jc) + ai2 * CH2(ik, jc - 1);
+      }
+    }
+    for (; j < ipph; ++j, --jc) {
+      iang += l;
+      if (iang > ip)
+        iang -= ip;
+      RFFTP_S war = csarr[2 * iang], wai = csarr[2 * iang + 1];
+      for (size_t ik = 0; ik < idl1; ++ik) {
+        C2(ik, l) += war * CH2(ik, j);
+        C2(ik, lc) += wai * CH2(ik, jc);
+      }
+    }
+  }
+  for (size_t j = 1; j < ipph; ++j)
+    for (size_t ik = 0; ik < idl1; ++ik)
+      CH2(ik, 0) += CH2(ik, j);
+  for (size_t j = 1, jc = ip - 1; j < ipph; ++j, --jc) // 124
+    for (size_t k = 0; k < l1; ++k) {
+      CH(0, k, j) = C1(0, k, j) - C1(0, k, jc);
+      CH(0, k, jc) = C1(0, k, j) + C1(0, k, jc);
+    }
+
+  if (ido == 1)
+    return;
+
+  for (size_t j = 1, jc = ip - 1; j < ipph; ++j, --jc) // 127
+    for (size_t k = 0; k < l1; ++k)
+      for (size_t i = 1; i <= ido - 2; i += 2) {
+        CH(i, k, j) = C1(i, k, j) - C1(i + 1, k, jc);
+        CH(i, k, jc) = C1(i, k, j) + C1(i + 1, k, jc);
+        CH(i + 1, k, j) = C1(i + 1, k, j) + C1(i, k, jc);
+        CH(i + 1, k, jc) = C1(i + 1, k, j) - C1(i, k, jc);
+      }
+
+  // All in CH
+
+  for (size_t j = 1; j < ip; ++j) {
+    size_t is = (j - 1) * (ido - 1);
+    for (size_t k = 0; k < l1; ++k) {
+      size_t idij = is;
+      for (size_t i = 1; i <= ido - 2; i += 2) {
+        RFFTP_T t1 = CH(i, k, j), t2 = CH(i + 1, k, j);
+        CH(i, k, j) = wa[idij] * t1 - wa[idij + 1] * t2;
+        CH(i + 1, k, j) = wa[idij] * t2 + wa[idij + 1] * t1;
+        idij += 2;
+      }
+    }
+  }
+}
+#undef C1
+#undef C2
+#undef CH2
+
+#undef CC
+#undef CH
+#undef PM
+#undef MULPM
+#undef WA
+
+#ifdef RFFTP_CODELET_LANES
+#include "pocketfft-codelets.h"
+#endif
+
+/* Runs the forward passes on c, using ch as scratch; both hold plan->length
+   elements, of which only the first nonzero elements of c are read, the rest
+   being taken as zero. Returns whichever of the two holds the unnormalized
+   result. */
+RFFTP_ATTR static RFFTP_T *RFFTP_NAME(rfftp_forward_passes)(RFFTP_PLAN plan,
+                                                            RFFTP_T *c,
+                                                            RFFTP_T *ch,
+                                                            size_t nonzero) {
+  size_t n = plan->length;
+  size_t l1 = n, nf = plan->nfct;
+  RFFTP_T *p1 = c, *p2 = ch;
+
+#ifdef RFFTP_CODELET_LANES
+  if (plan->codelet) {
+    RFFTP_T *res = RFFTP_NAME(rfftp_codelet_forward)(n, c, ch, nonzero);
+    if (res)
+      return res;
+  }
+#endif
+
+  /* the first pass skips the zero tail for radix 2 and 4 and needs it
+     cleared otherwise */
+  if (nonzero < n && nf > 0 && plan->fct[nf - 1].fct != 2 &&
+      plan->fct[nf - 1].fct != 4)
+    memset(c + nonzero, 0, (n - nonzero) * sizeof(RFFTP_T));
+
+  for (size_t k1 = 0; k1 < nf; ++k1) {
+    size_t k = nf - k1 - 1;
+    size_t ip = plan->fct[k].fct;
+    size_t ido = n / l1;
+    l1 /= ip;
+    if (k1 == 0 && nonzero < n && ip == 4)
+      RFFTP_NAME(radf4_pruned)(l1, p1, p2, nonzero);
+    else if (k1 == 0 && nonzero < n && ip == 2)
+      RFFTP_NAME(radf2_pruned)(l1, p1, p2, nonzero);
+    else if (ip == 4)
+      RFFTP_NAME(radf4)(ido, l1, p1, p2, plan->fct[k].tw);
+    else if (ip == 2)
+      RFFTP_NAME(radf2)(ido, l1, p1, p2, plan->fct[k].tw);
+    else if (ip == 3)
+      RFFTP_NAME(radf3)(ido, l1, p1, p2, plan->fct[k].tw);
+    else if (ip == 5)
+      RFFTP_NAME(radf5)(ido, l1, p1, p2, plan->fct[k].tw);
+    else {
+      RFFTP_NAME(radfg)(ido, ip, l1, p1, p2, plan->fct[k].tw,
+                        plan->fct[k].tws);
+      SWAP(p1, p2, RFFTP_T *);
+    }
+    SWAP(p1, p2, RFFTP_T *);
+  }
+  return p1;
+}
+
+/* Backward counterpart of rfftp_forward_passes. */
+RFFTP_ATTR static RFFTP_T *RFFTP_NAME(rfftp_backward_passes)(RFFTP_PLAN plan,
+                                                             RFFTP_T *c,
+                                                             RFFTP_T *ch) {
+  size_t n = plan->length;
+  size_t l1 = 1, nf = plan->nfct;
+  RFFTP_T *p1 = c, *p2 = ch;
+
+#ifdef RFFTP_CODELET_LANES
+  if (plan->codelet) {
+    RFFTP_T *res = RFFTP_NAME(rfftp_codelet_backward)(n, c, ch);
+    if (res)
+      return res;
+  }
+#endif
+
+  for (size_t k = 0; k < nf; k++) {
+    size_t ip = plan->fct[k].fct, ido = n / (ip * l1);
+    if (ip == 4)
+      RFFTP_NAME(radb4)(ido, l1, p1, p2, plan->fct[k].tw);
+    else if (ip == 2)
+      RFFTP_NAME(radb2)(ido, l1, p1, p2, plan->fct[k].tw);
+    else if (ip == 3)
+      RFFTP_NAME(radb3)(ido, l1, p1, p2, plan->fct[k].tw);
+    else if (ip == 5)
+      RFFTP_NAME(radb5)(ido, l1, p1, p2, plan->fct[k].tw);
+    else
+      RFFTP_NAME(radbg)(ido, ip, l1, p1, p2, plan->fct[k].tw,
+                        plan->fct[k].tws);
+    SWAP(p1, p2, RFFTP_T *);
+    l1 *= ip;
+  }
+  return p1;
+}
+
+#ifdef RFFTP_OWNS_PLAN
+RFFTP_ATTR static void RFFTP_NAME(copy_and_norm)(RFFTP_T *c, RFFTP_T *p1,
+                                                 size_t n, RFFTP_S fct) {
+  if (p1 != c) {
+    if (fct != 1.)
+      for (size_t i = 0; i < n; ++i)
+        c[i] = fct * p1[i];
+    else
+      memcpy(c, p1, n * sizeof(RFFTP_T));
+  } else if (fct != 1.)
+    for (size_t i = 0; i < n; ++i)
+      c[i] *= fct;
+}
+
+/* rfftp_forward and rfftp_backward are unused by the float engine, which runs
+   the passes itself in the caller's scratch */
+[[maybe_unused]] WARN_UNUSED_RESULT
+RFFTP_ATTR static int RFFTP_NAME(rfftp_forward)(RFFTP_PLAN plan, RFFTP_T c[],
+                                                RFFTP_S fct) {
+  if (plan->length == 1)
+    return 0;
+  size_t n = plan->length;
+  RFFTP_T *ch = RALLOC(RFFTP_T, n);
+  if (!ch)
+    return -1;
+  RFFTP_T *p1 = RFFTP_NAME(rfftp_forward_passes)(plan, c, ch, n);
+  RFFTP_NAME(copy_and_norm)(c, p1, n, fct);
+  DEALLOC(ch);
+  return 0;
+}
+
+[[maybe_unused]] WARN_UNUSED_RESULT
+RFFTP_ATTR static int RFFTP_NAME(rfftp_backward)(RFFTP_PLAN plan, RFFTP_T c[],
+                                                 RFFTP_S fct) {
+  if (plan->length == 1)
+    return 0;
+  size_t n = plan->length;
+  RFFTP_T *ch = RALLOC(RFFTP_T, n);
+  if (!ch)
+    return -1;
+  RFFTP_T *p1 = RFFTP_NAME(rfftp_backward_passes)(plan, c, ch);
+  RFFTP_NAME(copy_and_norm)(c, p1, n, fct);
+  DEALLOC(ch);
+  return 0;
+}
+
+WARN_UNUSED_RESULT
+static int RFFTP_NAME(rfftp_factorize)(RFFTP_NAME(rfftp_plan) plan,
+                                       pocketfft_order order) {
+  size_t length = plan->length;
+  size_t nfct = 0;
+  while ((length % 4) == 0) {
+    if (nfct >= NFCT)
+      return -1;
+    plan->fct[nfct++].fct = 4;
+    length >>= 2;
+  }
+  if ((length % 2) == 0) {
+    length >>= 1;
+    // factor 2 should be at the front of the factor list
+    if (nfct >= NFCT)
+      return -1;
+    plan->fct[nfct++].fct = 2;
+    SWAP(plan->fct[0].fct, plan->fct[nfct - 1].fct, size_t);
+  }
+  size_t maxl = (size_t)(sqrt((double)length)) + 1;
+  for (size_t divisor = 3; (length > 1) && (divisor < maxl); divisor += 2)
+    if ((length % divisor) == 0) {
+      while ((length % divisor) == 0) {
+        if (nfct >= NFCT)
+          return -1;
+        plan->fct[nfct++].fct = divisor;
+        length /= divisor;
+      }
+      maxl = (size_t)(sqrt((double)length)) + 1;
+    }
+  if (length > 1)
+    plan->fct[nfct++].fct = length;
+  plan->nfct = nfct;
+  /* the odd radices only handle odd ido, so they stay behind the nfeven
+     factors 2 and 4, and each group is permuted on its own */
+  size_t nfeven = 0;
+  while (nfeven < nfct && (plan->fct[nfeven].fct & 1) == 0)
+    ++nfeven;
+  if (order == POCKETFFT_ORDER_REVERSED) {
+    for (size_t i = 0; i < nfeven / 2; ++i)
+      SWAP(plan->fct[i].fct, plan->fct[nfeven - 1 - i].fct, size_t);
+    for (size_t i = 0; i < (nfct - nfeven) / 2; ++i)
+      SWAP(plan->fct[nfeven + i].fct, plan->fct[nfct - 1 - i].fct, size_t);
+  } else if (order == POCKETFFT_ORDER_TWO_LAST && nfeven > 1 &&
+             plan->fct[0].fct == 2) {
+    for (size_t i = 0; i + 1 < nfeven; ++i)
+      plan->fct[i].fct = plan->fct[i + 1].fct;
+    plan->fct[nfeven - 1].fct = 2;
+  }
+  return 0;
+}
+
+static size_t RFFTP_NAME(rfftp_twsize)(RFFTP_NAME(rfftp_plan) plan) {
+  size_t twsize = 0, l1 = 1;
+  for (size_t k = 0; k < plan->nfct; ++k) {
+    size_t ip = plan->fct[k].fct, ido = plan->length / (l1 * ip);
+    twsize += (ip - 1) * (ido - 1);
+    if (ip > 5)
+      twsize += 2 * ip;
+    l1 *= ip;
+  }
+  return twsize;
+}
+
+WARN_UNUSED_RESULT static int
+RFFTP_NAME(rfftp_comp_twiddle)(RFFTP_NAME(rfftp_plan) plan) {
+  size_t length = plan->length;
+  double *twid = RALLOC(double, 2 * length);
+  if (!twid)
+    return -1;
+  sincos_2pibyn_half(length, twid);
+  size_t l1 = 1;
+  RFFTP_S *ptr = plan->mem;
+  for (size_t k = 0; k < plan->nfct; ++k) {
+    size_t ip = plan->fct[k].fct, ido = length / (l1 * ip);
+    if (k < plan->nfct - 1) // last factor doesn't need twiddles
+    {
+      plan->fct[k].tw = ptr;
+      ptr += (ip - 1) * (ido - 1);
+      for (size_t j = 1; j < ip; ++j)
+        for (size_t i = 1; i <= (ido - 1) / 2; ++i) {
+          plan->fct[k].tw[(j - 1) * (ido - 1) + 2 * i - 2] =
+              twid[2 * j * l1 * i];
+          plan->fct[k].tw[(j - 1) * (ido - 1) + 2 * i - 1] =
+              twid[2 * j * l1 * i + 1];
+        }
+    }
+    if (ip > 5) // special factors required by *g functions
+    {
+      plan->fct[k].tws = ptr;
+      ptr += 2 * ip;
+      plan->fct[k].tws[0] = 1.;
+      plan->fct[k].tws[1] = 0.;
+      for (size_t i = 1; i <= (ip >> 1); ++i) {
+        plan->fct[k].tws[2 * i] = twid[2 * i * (length / ip)];
+        plan->fct[k].tws[2 * i + 1] = twid[2 * i * (length / ip) + 1];
+        plan->fct[k].tws[2 * (ip - i)] = twid[2 * i * (length / ip)];
+        plan->fct[k].tws[2 * (ip - i) + 1] = -twid[2 * i * (length / ip) + 1];
+      }
+    }
+    l1 *= ip;
+  }
+  DEALLOC(twid);
+  return 0;
+}
+
+[[nodiscard]] static NOINLINE RFFTP_NAME(rfftp_plan)
+    RFFTP_NAME(make_rfftp_plan)(size_t length, pocketfft_order order) {
+  if (length == 0)
+    return nullptr;
+  RFFTP_NAME(rfftp_plan) plan = RALLOC(RFFTP_NAME(rfftp_plan_i), 1);
+  if (!plan)
+    return nullptr;
+  plan->length = length;
+  plan->nfct = 0;
+  plan->codelet = false;
+  plan->mem = nullptr;
+  for (size_t i = 0; i < NFCT; ++i)
+    plan->fct[i] = (RFFTP_NAME(rfftp_fctdata)){
+        .fct = 0, .tw = nullptr, .tws = nullptr};
+  if (length == 1)
+    return plan;
+  if (RFFTP_NAME(rfftp_factorize)(plan, order) != 0) {
+    DEALLOC(plan);
+    return nullptr;
+  }
+  size_t tws = RFFTP_NAME(rfftp_twsize)(plan);
+  plan->mem = RALLOC(RFFTP_S, tws);
+  if (!plan->mem) {
+    DEALLOC(plan);
+    return nullptr;
+  }
+  if (RFFTP_NAME(rfftp_comp_twiddle)(plan) != 0) {
+    DEALLOC(plan->mem);
+    DEALLOC(plan);
+    return nullptr;
+  }
+  return plan;
+}
+
+static NOINLINE void
+RFFTP_NAME(destroy_rfftp_plan)(RFFTP_NAME(rfftp_plan) plan) {
+  if (plan == nullptr)
+    return;
+  DEALLOC(plan->mem);
+  DEALLOC(plan);
+}
+
+#endif /* RFFTP_OWNS_PLAN */
+
+#undef RFFTP_OWNS_PLAN
+#undef RFFTP_CODELET_LANES
+#undef RFFTP_PLAN
+#undef RFFTP_ATTR
+#undef RFFTP_NAME
+#undef RFFTP_S
+#undef RFFTP_T
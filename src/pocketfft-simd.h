@@ -0,0 +1,355 @@
+/*
+ * This file is part of pocketfft.
+ * Licensed under a 3-clause BSD style license - see LICENSE.md
+ */
+
+/*
+ *  Vectorized single-precision real FFT for one instruction set.
+ *
+ *  A length-n transform is split into SIMD_W interleaved subsequences
+ *  x_l[t] = x[SIMD_W * t + l], which is exactly the layout of the input when
+ *  it is read as n / SIMD_W vectors. The packed real passes therefore run
+ *  unchanged on vectors, one subsequence per lane, and a final step combines
+ *  the lanes:
+ *    X[k + q * m] = sum_l exp(-2 pi i l k / n) X_l[k] exp(-2 pi i l q / W)
+ *  with m = n / W, i.e. a twiddle per lane followed by a W-point DFT across
+ *  the lanes, done with in-register shuffles. The backward transform runs the
+ *  same steps in reverse order.
+ *
+ *  This is not a standalone header: pocketfft.c includes it once per ISA
+ *  after defining
+ *    SIMD_V          vector type of SIMD_W floats
+ *    SIMD_W          number of lanes (4, 8 or 16)
+ *    SIMD_NAME(x)    decoration applied to every function name
+ *    SIMD_ATTR       attributes placed on every function, e.g. a target ISA
+ *    SIMD_XOR<h>(v)  v with lanes l and l ^ h swapped, for h < SIMD_W
+ *    SIMD_ZIPLO(a, b), SIMD_ZIPHI(a, b)
+ *                    the lanes of the low (high) halves of a and b, interleaved
+ *  on top of rfftf_plan_i and the rfftp_plan_f passes' plan type.
+ *  SIMD_V, SIMD_W, SIMD_NAME and SIMD_ATTR are undefined again at the end of
+ *  this file.
+ */
+
+#define RFFTP_T SIMD_V
+#define RFFTP_S float
+#define RFFTP_NAME(x) SIMD_NAME(x)
+#define RFFTP_ATTR SIMD_ATTR
+#define RFFTP_PLAN rfftp_plan_f
+#ifndef POCKETFFT_NO_CODELETS
+#define RFFTP_CODELET_LANES SIMD_W
+#endif
+#include "pocketfft-rfftp.h"
+
+/* SIMD_V only requires float alignment and may alias float. */
+#define SIMD_LOAD(v, ptr) ((v) = *(const SIMD_V *)(ptr))
+#define SIMD_STORE(ptr, v) (*(SIMD_V *)(ptr) = (v))
+
+/* One radix-2 decimation-in-frequency stage across the lanes; st holds the
+   lane signs and the twiddle factors of the stage. */
+#define SIMD_DIF_STAGE(h)                                                      \
+  {                                                                            \
+    SIMD_V sg, wr, wi;                                                         \
+    SIMD_LOAD(sg, st);                                                         \
+    SIMD_LOAD(wr, st + SIMD_W);                                                \
+    SIMD_LOAD(wi, st + 2 * SIMD_W);                                            \
+    SIMD_V tr = SIMD_XOR##h(r) + sg * r, ti = SIMD_XOR##h(i) + sg * i;         \
+    r = tr * wr - ti * wi;                                                     \
+    i = tr * wi + ti * wr;                                                     \
+    st += 3 * SIMD_W;                                                          \
+  }
+
+/* One radix-2 decimation-in-time stage with conjugated twiddle factors. */
+#define SIMD_DIT_STAGE(h)                                                      \
+  {                                                                            \
+    SIMD_V sg, wr, wi;                                                         \
+    SIMD_LOAD(sg, st);                                                         \
+    SIMD_LOAD(wr, st + SIMD_W);                                                \
+    SIMD_LOAD(wi, st + 2 * SIMD_W);                                            \
+    SIMD_V tr = r * wr + i * wi, ti = i * wr - r * wi;                         \
+    r = SIMD_XOR##h(tr) + sg * tr;                                             \
+    i = SIMD_XOR##h(ti) + sg * ti;                                             \
+    st -= 3 * SIMD_W;                                                          \
+  }
+
+/* Forward W-point DFT across the lanes of (*pr, *pi): natural order in,
+   bit-reversed order out. */
+SIMD_ATTR
+static void SIMD_NAME(lanes_forward)(const float *st, SIMD_V *pr,
+                                     SIMD_V *pi) {
+  SIMD_V r = *pr, i = *pi;
+#if SIMD_W >= 16
+  SIMD_DIF_STAGE(8)
+#endif
+#if SIMD_W >= 8
+  SIMD_DIF_STAGE(4)
+#endif
+  SIMD_DIF_STAGE(2)
+  SIMD_DIF_STAGE(1)
+  *pr = r;
+  *pi = i;
+}
+
+/* Backward W-point DFT across the lanes of (*pr, *pi): bit-reversed order in,
+   natural order out. st points at the table of the last forward stage. */
+SIMD_ATTR
+static void SIMD_NAME(lanes_backward)(const float *st, SIMD_V *pr,
+                                      SIMD_V *pi) {
+  SIMD_V r = *pr, i = *pi;
+  SIMD_DIT_STAGE(1)
+  SIMD_DIT_STAGE(2)
+#if SIMD_W >= 8
+  SIMD_DIT_STAGE(4)
+#endif
+#if SIMD_W >= 16
+  SIMD_DIT_STAGE(8)
+#endif
+  *pr = r;
+  *pi = i;
+}
+
+#undef SIMD_DIT_STAGE
+#undef SIMD_DIF_STAGE
+
+/* Combines the lane spectra X_l[k] = (*xr, *xi) into the output bins
+   k + q * m, q < W / 2, of the result (plus the Nyquist bin for k == 0),
+   written as packed coefficients, or as powers or magnitudes of the bins in
+   [begin, end). */
+SIMD_ATTR
+static void SIMD_NAME(scatter_forward)(const rfftf_plan_i *plan, size_t k,
+                                       const SIMD_V *xr, const SIMD_V *xi,
+                                       float *restrict out, float fct,
+                                       rfftf_output output, size_t begin,
+                                       size_t end) {
+  size_t n = plan->length, m = n / SIMD_W;
+  const float *tw = plan->tw + 2 * k * SIMD_W;
+  SIMD_V twr, twi;
+  SIMD_LOAD(twr, tw);
+  SIMD_LOAD(twi, tw + SIMD_W);
+  SIMD_V yr = *xr * twr - *xi * twi, yi = *xr * twi + *xi * twr;
+  SIMD_NAME(lanes_forward)(plan->tw + 2 * m * SIMD_W, &yr, &yi);
+
+  if (output != RFFTF_PACKED) {
+    float p[SIMD_W];
+    SIMD_V pw = (fct * fct) * (yr * yr + yi * yi);
+    SIMD_STORE(p, pw);
+    for (size_t q = 0; q < SIMD_W / 2; ++q) {
+      size_t j = k + q * m, l = plan->rev[q];
+      if (k == 0 && q == 0 && n / 2 >= begin && n / 2 < end)
+        out[n / 2] = output == RFFTF_MAGNITUDE
+                         ? sqrtf(p[plan->rev[SIMD_W / 2]])
+                         : p[plan->rev[SIMD_W / 2]];
+      if (j >= begin && j < end)
+        out[j] = output == RFFTF_MAGNITUDE ? sqrtf(p[l]) : p[l];
+    }
+    return;
+  }
+
+  float zr[SIMD_W], zi[SIMD_W];
+  SIMD_STORE(zr, yr);
+  SIMD_STORE(zi, yi);
+  size_t q = 0;
+  if (k == 0) {
+    out[0] = fct * zr[plan->rev[0]];
+    out[n - 1] = fct * zr[plan->rev[SIMD_W / 2]];
+    q = 1;
+  }
+  for (; q < SIMD_W / 2; ++q) {
+    size_t j = k + q * m;
+    out[2 * j - 1] = fct * zr[plan->rev[q]];
+    out[2 * j] = fct * zi[plan->rev[q]];
+  }
+}
+
+/* Whether scatter_forward(k) has an output bin in [begin, end). */
+static inline bool SIMD_NAME(wanted)(size_t k, size_t m, size_t begin,
+                                     size_t end) {
+  if (k == 0 && SIMD_W / 2 * m >= begin && SIMD_W / 2 * m < end)
+    return true;
+  size_t q = begin > k ? (begin - k + m - 1) / m : 0;
+  return q < SIMD_W / 2 && k + q * m < end;
+}
+
+/* Turns the per-lane packed spectra in h into the spectrum of the whole
+   sequence; power and magnitude outputs skip the lane combinations that feed
+   no bin in [begin, end). */
+SIMD_ATTR
+static void SIMD_NAME(finish_forward)(const rfftf_plan_i *plan,
+                                      const float *restrict h,
+                                      float *restrict out, float fct,
+                                      rfftf_output output, size_t begin,
+                                      size_t end) {
+  size_t m = plan->length / SIMD_W;
+  SIMD_V xr, xi = {0}, nxi;
+  if (output == RFFTF_PACKED) {
+    begin = 0;
+    end = plan->length / 2 + 1;
+  }
+  if (SIMD_NAME(wanted)(0, m, begin, end)) {
+    SIMD_LOAD(xr, h);
+    SIMD_NAME(scatter_forward)(plan, 0, &xr, &xi, out, fct, output, begin,
+                               end);
+  }
+  for (size_t k = 1; k < m / 2; ++k) {
+    bool lo = SIMD_NAME(wanted)(k, m, begin, end),
+         hi = SIMD_NAME(wanted)(m - k, m, begin, end);
+    if (!lo && !hi)
+      continue;
+    SIMD_LOAD(xr, h + (2 * k - 1) * SIMD_W);
+    SIMD_LOAD(xi, h + 2 * k * SIMD_W);
+    if (lo)
+      SIMD_NAME(scatter_forward)(plan, k, &xr, &xi, out, fct, output, begin,
+                                 end);
+    nxi = -xi;
+    if (hi)
+      SIMD_NAME(scatter_forward)(plan, m - k, &xr, &nxi, out, fct, output,
+                                 begin, end);
+  }
+  if (SIMD_NAME(wanted)(m / 2, m, begin, end)) {
+    SIMD_LOAD(xr, h + (m - 1) * SIMD_W);
+    xi = (SIMD_V){0};
+    SIMD_NAME(scatter_forward)(plan, m / 2, &xr, &xi, out, fct, output, begin,
+                               end);
+  }
+}
+
+/* Splits the packed spectrum c back into the packed spectra of the lanes,
+   scaled by W. */
+SIMD_ATTR
+static void SIMD_NAME(prepare_backward)(const rfftf_plan_i *plan,
+                                        const float *restrict c,
+                                        float *restrict h) {
+  size_t n = plan->length, m = n / SIMD_W;
+  const float *st =
+      plan->tw + 2 * m * SIMD_W + 3 * SIMD_W * (plan->nstages - 1);
+  for (size_t k = 0; k <= m / 2; ++k) {
+    float zr[SIMD_W], zi[SIMD_W];
+    for (size_t q = 0; q < SIMD_W; ++q) {
+      size_t j = k + q * m, l = plan->rev[q];
+      if (j == 0) {
+        zr[l] = c[0];
+        zi[l] = 0;
+      } else if (j < n / 2) {
+        zr[l] = c[2 * j - 1];
+        zi[l] = c[2 * j];
+      } else if (j == n / 2) {
+        zr[l] = c[n - 1];
+        zi[l] = 0;
+      } else {
+        zr[l] = c[2 * (n - j) - 1];
+        zi[l] = -c[2 * (n - j)];
+      }
+    }
+    SIMD_V yr, yi, twr, twi;
+    SIMD_LOAD(yr, zr);
+    SIMD_LOAD(yi, zi);
+    SIMD_NAME(lanes_backward)(st, &yr, &yi);
+    SIMD_LOAD(twr, plan->tw + 2 * k * SIMD_W);
+    SIMD_LOAD(twi, plan->tw + (2 * k + 1) * SIMD_W);
+    SIMD_V xr = yr * twr + yi * twi, xi = yi * twr - yr * twi;
+    if (k == 0)
+      SIMD_STORE(h, xr);
+    else if (k == m / 2)
+      SIMD_STORE(h + (m - 1) * SIMD_W, xr);
+    else {
+      SIMD_STORE(h + (2 * k - 1) * SIMD_W, xr);
+      SIMD_STORE(h + 2 * k * SIMD_W, xi);
+    }
+  }
+}
+
+SIMD_ATTR static void SIMD_NAME(rfftf_forward)(const rfftf_plan_i *plan,
+                                               float c[], float fct,
+                                               rfftf_output output,
+                                               size_t begin, size_t end,
+                                               float *scratch) {
+  size_t n = plan->length;
+  /* clear the zero tail up to the next whole vector; the passes skip or
+     clear the vectors past it */
+  size_t live = (plan->nonzero + SIMD_W - 1) / SIMD_W;
+  for (size_t i = plan->nonzero; i < live * SIMD_W; ++i)
+    c[i] = 0;
+  SIMD_V *ch = (SIMD_V *)scratch;
+  SIMD_V *p1 =
+      SIMD_NAME(rfftp_forward_passes)(plan->packplan, (SIMD_V *)c, ch, live);
+  float *out = (p1 == ch) ? c : (float *)ch;
+  SIMD_NAME(finish_forward)(plan, (const float *)p1, out, fct, output, begin,
+                            end);
+  if (out != c && output == RFFTF_PACKED)
+    memcpy(c, out, n * sizeof(float));
+  else if (out != c)
+    memcpy(c + begin, out + begin, (end - begin) * sizeof(float));
+}
+
+SIMD_ATTR static void SIMD_NAME(rfftf_backward)(const rfftf_plan_i *plan,
+                                                float c[], float fct,
+                                                float *scratch) {
+  size_t n = plan->length;
+  SIMD_V *ch = (SIMD_V *)scratch;
+  SIMD_NAME(prepare_backward)(plan, c, (float *)ch);
+  float *p1 = (float *)SIMD_NAME(rfftp_backward_passes)(plan->packplan, ch,
+                                                        (SIMD_V *)c);
+  if (p1 != c) {
+    for (size_t i = 0; i < n; ++i)
+      c[i] = fct * p1[i];
+  } else if (fct != 1.f)
+    for (size_t i = 0; i < n; ++i)
+      c[i] *= fct;
+}
+
+/* Writes fct times the transpose of the SIMD_W x SIMD_W block whose rows
+   start sstride floats apart at src to rows dstride floats apart at dst. */
+SIMD_ATTR
+static void SIMD_NAME(transpose)(const float *src, size_t sstride, float *dst,
+                                 size_t dstride, float fct) {
+  SIMD_V va[SIMD_W], vb[SIMD_W], *r = va, *z = vb;
+  for (size_t l = 0; l < SIMD_W; ++l)
+    SIMD_LOAD(r[l], src + l * sstride);
+  /* log2(SIMD_W) rounds of interleaving row i with row i + SIMD_W / 2 */
+  for (size_t s = 1; s < SIMD_W; s <<= 1) {
+    for (size_t i = 0; i < SIMD_W / 2; ++i) {
+      z[2 * i] = SIMD_ZIPLO(r[i], r[i + SIMD_W / 2]);
+      z[2 * i + 1] = SIMD_ZIPHI(r[i], r[i + SIMD_W / 2]);
+    }
+    SWAP(r, z, SIMD_V *);
+  }
+  for (size_t j = 0; j < SIMD_W; ++j) {
+    SIMD_V v = fct * r[j];
+    SIMD_STORE(dst + j * dstride, v);
+  }
+}
+
+/* Transforms SIMD_W frames of plan->length floats starting stride floats
+   apart, one frame per lane: the frames are interleaved into buf, run through
+   the packed passes of the full length, and written back. buf and ch hold
+   plan->length vectors each. */
+SIMD_ATTR
+static void SIMD_NAME(rfftf_batch)(const rfftf_plan_i *plan, float *c,
+                                   size_t stride, bool backward, float fct,
+                                   void *buf, void *ch) {
+  size_t n = plan->length, t;
+  /* forward passes never look at the interleaved zero tail */
+  size_t live = backward ? n : plan->nonzero;
+  float *b = buf;
+  for (t = 0; t + SIMD_W <= live; t += SIMD_W)
+    SIMD_NAME(transpose)(c + t, stride, b + t * SIMD_W, SIMD_W, 1.f);
+  for (; t < live; ++t)
+    for (size_t l = 0; l < SIMD_W; ++l)
+      b[t * SIMD_W + l] = c[l * stride + t];
+  const float *p1 =
+      (const float *)(backward ? SIMD_NAME(rfftp_backward_passes)(
+                                     plan->batchplan, buf, ch)
+                               : SIMD_NAME(rfftp_forward_passes)(
+                                     plan->batchplan, buf, ch, live));
+  for (t = 0; t + SIMD_W <= n; t += SIMD_W)
+    SIMD_NAME(transpose)(p1 + t * SIMD_W, SIMD_W, c + t, stride, fct);
+  for (; t < n; ++t)
+    for (size_t l = 0; l < SIMD_W; ++l)
+      c[l * stride + t] = fct * p1[t * SIMD_W + l];
+}
+
+#undef SIMD_STORE
+#undef SIMD_LOAD
+#undef SIMD_ATTR
+#undef SIMD_NAME
+#undef SIMD_W
+#undef SIMD_V
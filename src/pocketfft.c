@@ -1089,851 +1089,37 @@ static void destroy_cfftp_plan(cfftp_plan plan) {
   DEALLOC(plan);
 }
 
-typedef struct rfftp_fctdata {
-  size_t fct;
-  double *tw, *tws;
-} rfftp_fctdata;
-
-typedef struct rfftp_plan_i {
-  size_t length, nfct;
-  double *mem;
-  rfftp_fctdata fct[NFCT];
-} rfftp_plan_i;
-typedef struct rfftp_plan_i *rfftp_plan;
-
-#define WA(x, i) wa[(i) + (x) * (ido - 1)]
-#define PM(a, b, c, d)                                                         \
-  {                                                                            \
-    a = c + d;                                                                 \
-    b = c - d;                                                                 \
-  }
-/* (a+ib) = conj(c+id) * (e+if) */
-#define MULPM(a, b, c, d, e, f)                                                \
-  {                                                                            \
-    a = c * e + d * f;                                                         \
-    b = c * f - d * e;                                                         \
-  }
-
-#define CC(a, b, c) cc[(a) + ido * ((b) + l1 * (c))]
-#define CH(a, b, c) ch[(a) + ido * ((b) + cdim * (c))]
-
-static NOINLINE void radf2(size_t ido, size_t l1, const double *restrict cc,
-                           double *restrict ch, const double *restrict wa) {
-  const size_t cdim = 2;
-
-  for (size_t k = 0; k < l1; k++)
-    PM(CH(0, 0, k), CH(ido - 1, 1, k), CC(0, k, 0), CC(0, k, 1))
-  if ((ido & 1) == 0)
-    for (size_t k = 0; k < l1; k++) {
-      CH(0, 1, k) = -CC(ido - 1, k, 1);
-      CH(ido - 1, 0, k) = CC(ido - 1, k, 0);
-    }
-  if (ido <= 2)
-    return;
-  for (size_t k = 0; k < l1; k++)
-    for (size_t i = 2; i < ido; i += 2) {
-      size_t ic = ido - i;
-      double tr2, ti2;
-      MULPM(tr2, ti2, WA(0, i - 2), WA(0, i - 1), CC(i - 1, k, 1), CC(i, k, 1))
-      PM(CH(i - 1, 0, k), CH(ic - 1, 1, k), CC(i - 1, k, 0), tr2)
-      PM(CH(i, 0, k), CH(ic, 1, k), ti2, CC(i, k, 0))
-    }
-}
-
-static NOINLINE void radf3(size_t ido, size_t l1, const double *restrict cc,
-                           double *restrict ch, const double *restrict wa) {
-  const size_t cdim = 3;
-  static constexpr double taur = -0.5;
-  static constexpr double taui = 0.86602540378443864676;
-
-  for (size_t k = 0; k < l1; k++) {
-    double cr2 = CC(0, k, 1) + CC(0, k, 2);
-    CH(0, 0, k) = CC(0, k, 0) + cr2;
-    CH(0, 2, k) = taui * (CC(0, k, 2) - CC(0, k, 1));
-    CH(ido - 1, 1, k) = CC(0, k, 0) + taur * cr2;
-  }
-  if (ido == 1)
-    return;
-  for (size_t k = 0; k < l1; k++)
-    for (size_t i = 2; i < ido; i += 2) {
-      size_t ic = ido - i;
-      double di2, di3, dr2, dr3;
-      MULPM(dr2, di2, WA(0, i - 2), WA(0, i - 1), CC(i - 1, k, 1),
-            CC(i, k, 1)) // d2=conj(WA0)*CC1
-      MULPM(dr3, di3, WA(1, i - 2), WA(1, i - 1), CC(i - 1, k, 2),
-            CC(i, k, 2))      // d3=conj(WA1)*CC2
-      double cr2 = dr2 + dr3; // c add
-      double ci2 = di2 + di3;
-      CH(i - 1, 0, k) = CC(i - 1, k, 0) + cr2; // c add
-      CH(i, 0, k) = CC(i, k, 0) + ci2;
-      double tr2 = CC(i - 1, k, 0) + taur * cr2; // c add
-      double ti2 = CC(i, k, 0) + taur * ci2;
-      double tr3 = taui * (di2 - di3); // t3 = taui*i*(d3-d2)?
-      double ti3 = taui * (dr3 - dr2);
-      PM(CH(i - 1, 2, k), CH(ic - 1, 1, k), tr2, tr3) // PM(i) = t2+t3
-      PM(CH(i, 2, k), CH(ic, 1, k), ti3, ti2)         // PM(ic) = conj(t2-t3)
-    }
-}
-
-static NOINLINE void radf4(size_t ido, size_t l1, const double *restrict cc,
-                           double *restrict ch, const double *restrict wa) {
-  const size_t cdim = 4;
-  static constexpr double hsqt2 = 0.70710678118654752440;
-
-  for (size_t k = 0; k < l1; k++) {
-    double tr1, tr2;
-    PM(tr1, CH(0, 2, k), CC(0, k, 3), CC(0, k, 1))
-    PM(tr2, CH(ido - 1, 1, k), CC(0, k, 0), CC(0, k, 2))
-    PM(CH(0, 0, k), CH(ido - 1, 3, k), tr2, tr1)
-  }
-  if ((ido & 1) == 0)
-    for (size_t k = 0; k < l1; k++) {
-      double ti1 = -hsqt2 * (CC(ido - 1, k, 1) + CC(ido - 1, k, 3));
-      double tr1 = hsqt2 * (CC(ido - 1, k, 1) - CC(ido - 1, k, 3));
-      PM(CH(ido - 1, 0, k), CH(ido - 1, 2, k), CC(ido - 1, k, 0), tr1)
-      PM(CH(0, 3, k), CH(0, 1, k), ti1, CC(ido - 1, k, 2))
-    }
-  if (ido <= 2)
-    return;
-  for (size_t k = 0; k < l1; k++)
-    for (size_t i = 2; i < ido; i += 2) {
-      size_t ic = ido - i;
-      double ci2, ci3, ci4, cr2, cr3, cr4, ti1, ti2, ti3, ti4, tr1, tr2, tr3,
-          tr4;
-      MULPM(cr2, ci2, WA(0, i - 2), WA(0, i - 1), CC(i - 1, k, 1), CC(i, k, 1))
-      MULPM(cr3, ci3, WA(1, i - 2), WA(1, i - 1), CC(i - 1, k, 2), CC(i, k, 2))
-      MULPM(cr4, ci4, WA(2, i - 2), WA(2, i - 1), CC(i - 1, k, 3), CC(i, k, 3))
-      PM(tr1, tr4, cr4, cr2)
-      PM(ti1, ti4, ci2, ci4)
-      PM(tr2, tr3, CC(i - 1, k, 0), cr3)
-      PM(ti2, ti3, CC(i, k, 0), ci3)
-      PM(CH(i - 1, 0, k), CH(ic - 1, 3, k), tr2, tr1)
-      PM(CH(i, 0, k), CH(ic, 3, k), ti1, ti2)
-      PM(CH(i - 1, 2, k), CH(ic - 1, 1, k), tr3, ti4)
-      PM(CH(i, 2, k), CH(ic, 1, k), tr4, ti3)
-    }
-}
-
-static NOINLINE void radf5(size_t ido, size_t l1, const double *restrict cc,
-                           double *restrict ch, const double *restrict wa) {
-  const size_t cdim = 5;
-  static constexpr double tr11 = 0.3090169943749474241;
-  static constexpr double ti11 = 0.95105651629515357212;
-  static constexpr double tr12 = -0.8090169943749474241;
-  static constexpr double ti12 = 0.58778525229247312917;
-
-  for (size_t k = 0; k < l1; k++) {
-    double cr2, cr3, ci4, ci5;
-    PM(cr2, ci5, CC(0, k, 4), CC(0, k, 1))
-    PM(cr3, ci4, CC(0, k, 3), CC(0, k, 2))
-    CH(0, 0, k) = CC(0, k, 0) + cr2 + cr3;
-    CH(ido - 1, 1, k) = CC(0, k, 0) + tr11 * cr2 + tr12 * cr3;
-    CH(0, 2, k) = ti11 * ci5 + ti12 * ci4;
-    CH(ido - 1, 3, k) = CC(0, k, 0) + tr12 * cr2 + tr11 * cr3;
-    CH(0, 4, k) = ti12 * ci5 - ti11 * ci4;
-  }
-  if (ido == 1)
-    return;
-  for (size_t k = 0; k < l1; ++k)
-    for (size_t i = 2; i < ido; i += 2) {
-      double ci2, di2, ci4, ci5, di3, di4, di5, ci3, cr2, cr3, dr2, dr3, dr4,
-          dr5, cr5, cr4, ti2, ti3, ti5, ti4, tr2, tr3, tr4, tr5;
-      size_t ic = ido - i;
-      MULPM(dr2, di2, WA(0, i - 2), WA(0, i - 1), CC(i - 1, k, 1), CC(i, k, 1))
-      MULPM(dr3, di3, WA(1, i - 2), WA(1, i - 1), CC(i - 1, k, 2), CC(i, k, 2))
-      MULPM(dr4, di4, WA(2, i - 2), WA(2, i - 1), CC(i - 1, k, 3), CC(i, k, 3))
-      MULPM(dr5, di5, WA(3, i - 2), WA(3, i - 1), CC(i - 1, k, 4), CC(i, k, 4))
-      PM(cr2, ci5, dr5, dr2)
-      PM(ci2, cr5, di2, di5)
-      PM(cr3, ci4, dr4, dr3)
-      PM(ci3, cr4, di3, di4)
-      CH(i - 1, 0, k) = CC(i - 1, k, 0) + cr2 + cr3;
-      CH(i, 0, k) = CC(i, k, 0) + ci2 + ci3;
-      tr2 = CC(i - 1, k, 0) + tr11 * cr2 + tr12 * cr3;
-      ti2 = CC(i, k, 0) + tr11 * ci2 + tr12 * ci3;
-      tr3 = CC(i - 1, k, 0) + tr12 * cr2 + tr11 * cr3;
-      ti3 = CC(i, k, 0) + tr12 * ci2 + tr11 * ci3;
-      MULPM(tr5, tr4, cr5, cr4, ti11, ti12)
-      MULPM(ti5, ti4, ci5, ci4, ti11, ti12)
-      PM(CH(i - 1, 2, k), CH(ic - 1, 1, k), tr2, tr5)
-      PM(CH(i, 2, k), CH(ic, 1, k), ti5, ti2)
-      PM(CH(i - 1, 4, k), CH(ic - 1, 3, k), tr3, tr4)
-      PM(CH(i, 4, k), CH(ic, 3, k), ti4, ti3)
-    }
-}
-
-#undef CC
-#undef CH
-#define C1(a, b, c) cc[(a) + ido * ((b) + l1 * (c))]
-#define C2(a, b) cc[(a) + idl1 * (b)]
-#define CH2(a, b) ch[(a) + idl1 * (b)]
-#define CC(a, b, c) cc[(a) + ido * ((b) + cdim * (c))]
-#define CH(a, b, c) ch[(a) + ido * ((b) + l1 * (c))]
-static NOINLINE void radfg(size_t ido, size_t ip, size_t l1,
-                           double *restrict cc, double *restrict ch,
-                           const double *restrict wa,
-                           const double *restrict csarr) {
-  const size_t cdim = ip;
-  size_t ipph = (ip + 1) / 2;
-  size_t idl1 = ido * l1;
-
-  if (ido > 1) {
-    for (size_t j = 1, jc = ip - 1; j < ipph; ++j, --jc) // 114
-    {
-      size_t is = (j - 1) * (ido - 1), is2 = (jc - 1) * (ido - 1);
-      for (size_t k = 0; k < l1; ++k) // 113
-      {
-        size_t idij = is;
-        size_t idij2 = is2;
-        for (size_t i = 1; i <= ido - 2; i += 2) // 112
-        {
-          double t1 = C1(i, k, j), t2 = C1(i + 1, k, j), t3 = C1(i, k, jc),
-                 t4 = C1(i + 1, k, jc);
-          double x1 = wa[idij] * t1 + wa[idij + 1] * t2,
-                 x2 = wa[idij] * t2 - wa[idij + 1] * t1,
-                 x3 = wa[idij2] * t3 + wa[idij2 + 1] * t4,
-                 x4 = wa[idij2] * t4 - wa[idij2 + 1] * t3;
-          C1(i, k, j) = x1 + x3;
-          C1(i, k, jc) = x2 - x4;
-          C1(i + 1, k, j) = x2 + x4;
-          C1(i + 1, k, jc) = x3 - x1;
-          idij += 2;
-          idij2 += 2;
-        }
-      }
-    }
-  }
-
-  for (size_t j = 1, jc = ip - 1; j < ipph; ++j, --jc) // 123
-    for (size_t k = 0; k < l1; ++k)                    // 122
-    {
-      double t1 = C1(0, k, j), t2 = C1(0, k, jc);
-      C1(0, k, j) = t1 + t2;
-      C1(0, k, jc) = t2 - t1;
-    }
-
-  // everything in C
-  // memset(ch,0,ip*l1*ido*sizeof(double));
-
-  for (size_t l = 1, lc = ip - 1; l < ipph; ++l, --lc) // 127
-  {
-    for (size_t ik = 0; ik < idl1; ++ik) // 124
-    {
-      CH2(ik, l) =
-          C2(ik, 0) + csarr[2 * l] * C2(ik, 1) + csarr[4 * l] * C2(ik, 2);
-      CH2(ik, lc) =
-          csarr[2 * l + 1] * C2(ik, ip - 1) + csarr[4 * l + 1] * C2(ik, ip - 2);
-    }
-    size_t iang = 2 * l;
-    size_t j = 3, jc = ip - 3;
-    for (; j < ipph - 3; j += 4, jc -= 4) // 126
-    {
-      iang += l;
-      if (iang >= ip)
-        iang -= ip;
-      double ar1 = csarr[2 * iang], ai1 = csarr[2 * iang + 1];
-      iang += l;
-      if (iang >= ip)
-        iang -= ip;
-      double ar2 = csarr[2 * iang], ai2 = csarr[2 * iang + 1];
-      iang += l;
-      if (iang >= ip)
-        iang -= ip;
-      double ar3 = csarr[2 * iang], ai3 = csarr[2 * iang + 1];
-      iang += l;
-      if (iang >= ip)
-        iang -= ip;
-      double ar4 = csarr[2 * iang], ai4 = csarr[2 * iang + 1];
-      for (size_t ik = 0; ik < idl1; ++ik) // 125
-      {
-        CH2(ik, l) += ar1 * C2(ik, j) + ar2 * C2(ik, j + 1) +
-                      ar3 * C2(ik, j + 2) + ar4 * C2(ik, j + 3);
-        CH2(ik, lc) += ai1 * C2(ik, jc) + ai2 * C2(ik, jc - 1) +
-                       ai3 * C2(ik, jc - 2) + ai4 * C2(ik, jc - 3);
-      }
-    }
-    for (; j < ipph - 1; j += 2, jc -= 2) // 126
-    {
-      iang += l;
-      if (iang >= ip)
-        iang -= ip;
-      double ar1 = csarr[2 * iang], ai1 = csarr[2 * iang + 1];
-      iang += l;
-      if (iang >= ip)
-        iang -= ip;
-      double ar2 = csarr[2 * iang], ai2 = csarr[2 * iang + 1];
-      for (size_t ik = 0; ik < idl1; ++ik) // 125
-      {
-        CH2(ik, l) += ar1 * C2(ik, j) + ar2 * C2(ik, j + 1);
-        CH2(ik, lc) += ai1 * C2(ik, jc) + ai2 * C2(ik, jc - 1);
-      }
-    }
-    for (; j < ipph; ++j, --jc) // 126
-    {
-      iang += l;
-      if (iang >= ip)
-        iang -= ip;
-      double ar = csarr[2 * iang], ai = csarr[2 * iang + 1];
-      for (size_t ik = 0; ik < idl1; ++ik) // 125
-      {
-        CH2(ik, l) += ar * C2(ik, j);
-        CH2(ik, lc) += ai * C2(ik, jc);
-      }
-    }
-  }
-  for (size_t ik = 0; ik < idl1; ++ik) // 101
-    CH2(ik, 0) = C2(ik, 0);
-  for (size_t j = 1; j < ipph; ++j)      // 129
-    for (size_t ik = 0; ik < idl1; ++ik) // 128
-      CH2(ik, 0) += C2(ik, j);
-
-  // everything in CH at this point!
-  // memset(cc,0,ip*l1*ido*sizeof(double));
-
-  for (size_t k = 0; k < l1; ++k)    // 131
-    for (size_t i = 0; i < ido; ++i) // 130
-      CC(i, 0, k) = CH(i, k, 0);
-
-  for (size_t j = 1, jc = ip - 1; j < ipph; ++j, --jc) // 137
-  {
-    size_t j2 = 2 * j - 1;
-    for (size_t k = 0; k < l1; ++k) // 136
-    {
-      CC(ido - 1, j2, k) = CH(0, k, j);
-      CC(0, j2 + 1, k) = CH(0, k, jc);
-    }
-  }
-
-  if (ido == 1)
-    return;
-
-  for (size_t j = 1, jc = ip - 1; j < ipph; ++j, --jc) // 140
-  {
-    size_t j2 = 2 * j - 1;
-    for (size_t k = 0; k < l1; ++k)                                       // 139
-      for (size_t i = 1, ic = ido - i - 2; i <= ido - 2; i += 2, ic -= 2) // 138
-      {
-        CC(i, j2 + 1, k) = CH(i, k, j) + CH(i, k, jc);
-        CC(ic, j2, k) = CH(i, k, j) - CH(i, k, jc);
-        CC(i + 1, j2 + 1, k) = CH(i + 1, k, j) + CH(i + 1, k, jc);
-        CC(ic + 1, j2, k) = CH(i + 1, k, jc) - CH(i + 1, k, j);
-      }
-  }
-}
-#undef C1
-#undef C2
-#undef CH2
-
-#undef CH
-#undef CC
-#define CH(a, b, c) ch[(a) + ido * ((b) + l1 * (c))]
-#define CC(a, b, c) cc[(a) + ido * ((b) + cdim * (c))]
-
-static NOINLINE void radb2(size_t ido, size_t l1, const double *restrict cc,
-                           double *restrict ch, const double *restrict wa) {
-  const size_t cdim = 2;
-
-  for (size_t k = 0; k < l1; k++)
-    PM(CH(0, k, 0), CH(0, k, 1), CC(0, 0, k), CC(ido - 1, 1, k))
-  if ((ido & 1) == 0)
-    for (size_t k = 0; k < l1; k++) {
-      CH(ido - 1, k, 0) = 2. * CC(ido - 1, 0, k);
-      CH(ido - 1, k, 1) = -2. * CC(0, 1, k);
-    }
-  if (ido <= 2)
-    return;
-  for (size_t k = 0; k < l1; ++k)
-    for (size_t i = 2; i < ido; i += 2) {
-      size_t ic = ido - i;
-      double ti2, tr2;
-      PM(CH(i - 1, k, 0), tr2, CC(i - 1, 0, k), CC(ic - 1, 1, k))
-      PM(ti2, CH(i, k, 0), CC(i, 0, k), CC(ic, 1, k))
-      MULPM(CH(i, k, 1), CH(i - 1, k, 1), WA(0, i - 2), WA(0, i - 1), ti2, tr2)
-    }
-}
-
-static NOINLINE void radb3(size_t ido, size_t l1, const double *restrict cc,
-                           double *restrict ch, const double *restrict wa) {
-  const size_t cdim = 3;
-  static constexpr double taur = -0.5;
-  static constexpr double taui = 0.86602540378443864676;
-
-  for (size_t k = 0; k < l1; k++) {
-    double tr2 = 2. * CC(ido - 1, 1, k);
-    double cr2 = CC(0, 0, k) + taur * tr2;
-    CH(0, k, 0) = CC(0, 0, k) + tr2;
-    double ci3 = 2. * taui * CC(0, 2, k);
-    PM(CH(0, k, 2), CH(0, k, 1), cr2, ci3);
-  }
-  if (ido == 1)
-    return;
-  for (size_t k = 0; k < l1; k++)
-    for (size_t i = 2; i < ido; i += 2) {
-      size_t ic = ido - i;
-      double tr2 =
-          CC(i - 1, 2, k) + CC(ic - 1, 1, k); // t2=CC(I) + conj(CC(ic))
-      double ti2 = CC(i, 2, k) - CC(ic, 1, k);
-      double cr2 = CC(i - 1, 0, k) + taur * tr2; // c2=CC +taur*t2
-      double ci2 = CC(i, 0, k) + taur * ti2;
-      CH(i - 1, k, 0) = CC(i - 1, 0, k) + tr2; // CH=CC+t2
-      CH(i, k, 0) = CC(i, 0, k) + ti2;
-      double cr3 = taui * (CC(i - 1, 2, k) -
-                           CC(ic - 1, 1, k)); // c3=taui*(CC(i)-conj(CC(ic)))
-      double ci3 = taui * (CC(i, 2, k) + CC(ic, 1, k));
-      double di2, di3, dr2, dr3;
-      PM(dr3, dr2, cr2, ci3) // d2= (cr2-ci3, ci2+cr3) = c2+i*c3
-      PM(di2, di3, ci2, cr3) // d3= (cr2+ci3, ci2-cr3) = c2-i*c3
-      MULPM(CH(i, k, 1), CH(i - 1, k, 1), WA(0, i - 2), WA(0, i - 1), di2,
-            dr2) // ch = WA*d2
-      MULPM(CH(i, k, 2), CH(i - 1, k, 2), WA(1, i - 2), WA(1, i - 1), di3, dr3)
-    }
-}
-
-static NOINLINE void radb4(size_t ido, size_t l1, const double *restrict cc,
-                           double *restrict ch, const double *restrict wa) {
-  const size_t cdim = 4;
-  static constexpr double sqrt2 = 1.41421356237309504880;
-
-  for (size_t k = 0; k < l1; k++) {
-    double tr1, tr2;
-    PM(tr2, tr1, CC(0, 0, k), CC(ido - 1, 3, k))
-    double tr3 = 2. * CC(ido - 1, 1, k);
-    double tr4 = 2. * CC(0, 2, k);
-    PM(CH(0, k, 0), CH(0, k, 2), tr2, tr3)
-    PM(CH(0, k, 3), CH(0, k, 1), tr1, tr4)
-  }
-  if ((ido & 1) == 0)
-    for (size_t k = 0; k < l1; k++) {
-      double tr1, tr2, ti1, ti2;
-      PM(ti1, ti2, CC(0, 3, k), CC(0, 1, k))
-      PM(tr2, tr1, CC(ido - 1, 0, k), CC(ido - 1, 2, k))
-      CH(ido - 1, k, 0) = tr2 + tr2;
-      CH(ido - 1, k, 1) = sqrt2 * (tr1 - ti1);
-      CH(ido - 1, k, 2) = ti2 + ti2;
-      CH(ido - 1, k, 3) = -sqrt2 * (tr1 + ti1);
-    }
-  if (ido <= 2)
-    return;
-  for (size_t k = 0; k < l1; ++k)
-    for (size_t i = 2; i < ido; i += 2) {
-      double ci2, ci3, ci4, cr2, cr3, cr4, ti1, ti2, ti3, ti4, tr1, tr2, tr3,
-          tr4;
-      size_t ic = ido - i;
-      PM(tr2, tr1, CC(i - 1, 0, k), CC(ic - 1, 3, k))
-      PM(ti1, ti2, CC(i, 0, k), CC(ic, 3, k))
-      PM(tr4, ti3, CC(i, 2, k), CC(ic, 1, k))
-      PM(tr3, ti4, CC(i - 1, 2, k), CC(ic - 1, 1, k))
-      PM(CH(i - 1, k, 0), cr3, tr2, tr3)
-      PM(CH(i, k, 0), ci3, ti2, ti3)
-      PM(cr4, cr2, tr1, tr4)
-      PM(ci2, ci4, ti1, ti4)
-      MULPM(CH(i, k, 1), CH(i - 1, k, 1), WA(0, i - 2), WA(0, i - 1), ci2, cr2)
-      MULPM(CH(i, k, 2), CH(i - 1, k, 2), WA(1, i - 2), WA(1, i - 1), ci3, cr3)
-      MULPM(CH(i, k, 3), CH(i - 1, k, 3), WA(2, i - 2), WA(2, i - 1), ci4, cr4)
-    }
-}
-
-static NOINLINE void radb5(size_t ido, size_t l1, const double *restrict cc,
-                           double *restrict ch, const double *restrict wa) {
-  const size_t cdim = 5;
-  static constexpr double tr11 = 0.3090169943749474241;
-  static constexpr double ti11 = 0.95105651629515357212;
-  static constexpr double tr12 = -0.8090169943749474241;
-  static constexpr double ti12 = 0.58778525229247312917;
-
-  for (size_t k = 0; k < l1; k++) {
-    double ti5 = CC(0, 2, k) + CC(0, 2, k);
-    double ti4 = CC(0, 4, k) + CC(0, 4, k);
-    double tr2 = CC(ido - 1, 1, k) + CC(ido - 1, 1, k);
-    double tr3 = CC(ido - 1, 3, k) + CC(ido - 1, 3, k);
-    CH(0, k, 0) = CC(0, 0, k) + tr2 + tr3;
-    double cr2 = CC(0, 0, k) + tr11 * tr2 + tr12 * tr3;
-    double cr3 = CC(0, 0, k) + tr12 * tr2 + tr11 * tr3;
-    double ci4, ci5;
-    MULPM(ci5, ci4, ti5, ti4, ti11, ti12)
-    PM(CH(0, k, 4), CH(0, k, 1), cr2, ci5)
-    PM(CH(0, k, 3), CH(0, k, 2), cr3, ci4)
-  }
-  if (ido == 1)
-    return;
-  for (size_t k = 0; k < l1; ++k)
-    for (size_t i = 2; i < ido; i += 2) {
-      size_t ic = ido - i;
-      double tr2, tr3, tr4, tr5, ti2, ti3, ti4, ti5;
-      PM(tr2, tr5, CC(i - 1, 2, k), CC(ic - 1, 1, k))
-      PM(ti5, ti2, CC(i, 2, k), CC(ic, 1, k))
-      PM(tr3, tr4, CC(i - 1, 4, k), CC(ic - 1, 3, k))
-      PM(ti4, ti3, CC(i, 4, k), CC(ic, 3, k))
-      CH(i - 1, k, 0) = CC(i - 1, 0, k) + tr2 + tr3;
-      CH(i, k, 0) = CC(i, 0, k) + ti2 + ti3;
-      double cr2 = CC(i - 1, 0, k) + tr11 * tr2 + tr12 * tr3;
-      double ci2 = CC(i, 0, k) + tr11 * ti2 + tr12 * ti3;
-      double cr3 = CC(i - 1, 0, k) + tr12 * tr2 + tr11 * tr3;
-      double ci3 = CC(i, 0, k) + tr12 * ti2 + tr11 * ti3;
-      double ci4, ci5, cr5, cr4;
-      MULPM(cr5, cr4, tr5, tr4, ti11, ti12)
-      MULPM(ci5, ci4, ti5, ti4, ti11, ti12)
-      double dr2, dr3, dr4, dr5, di2, di3, di4, di5;
-      PM(dr4, dr3, cr3, ci4)
-      PM(di3, di4, ci3, cr4)
-      PM(dr5, dr2, cr2, ci5)
-      PM(di2, di5, ci2, cr5)
-      MULPM(CH(i, k, 1), CH(i - 1, k, 1), WA(0, i - 2), WA(0, i - 1), di2, dr2)
-      MULPM(CH(i, k, 2), CH(i - 1, k, 2), WA(1, i - 2), WA(1, i - 1), di3, dr3)
-      MULPM(CH(i, k, 3), CH(i - 1, k, 3), WA(2, i - 2), WA(2, i - 1), di4, dr4)
-      MULPM(CH(i, k, 4), CH(i - 1, k, 4), WA(3, i - 2), WA(3, i - 1), di5, dr5)
-    }
-}
-
-#undef CC
-#undef CH
-#define CC(a, b, c) cc[(a) + ido * ((b) + cdim * (c))]
-#define CH(a, b, c) ch[(a) + ido * ((b) + l1 * (c))]
-#define C1(a, b, c) cc[(a) + ido * ((b) + l1 * (c))]
-#define C2(a, b) cc[(a) + idl1 * (b)]
-#define CH2(a, b) ch[(a) + idl1 * (b)]
-
-static NOINLINE void radbg(size_t ido, size_t ip, size_t l1,
-                           double *restrict cc, double *restrict ch,
-                           const double *restrict wa,
-                           const double *restrict csarr) {
-  const size_t cdim = ip;
-  size_t ipph = (ip + 1) / 2;
-  size_t idl1 = ido * l1;
-
-  for (size_t k = 0; k < l1; ++k)    // 102
-    for (size_t i = 0; i < ido; ++i) // 101
-      CH(i, k, 0) = CC(i, 0, k);
-  for (size_t j = 1, jc = ip - 1; j < ipph; ++j, --jc) // 108
-  {
-    size_t j2 = 2 * j - 1;
-    for (size_t k = 0; k < l1; ++k) {
-      CH(0, k, j) = 2 * CC(ido - 1, j2, k);
-      CH(0, k, jc) = 2 * CC(0, j2 + 1, k);
-    }
-  }
-
-  if (ido != 1) {
-    for (size_t j = 1, jc = ip - 1; j < ipph; ++j, --jc) // 111
-    {
-      size_t j2 = 2 * j - 1;
-      for (size_t k = 0; k < l1; ++k)
-        for (size_t i = 1, ic = ido - i - 2; i <= ido - 2;
-             i += 2, ic -= 2) // 109
-        {
-          CH(i, k, j) = CC(i, j2 + 1, k) + CC(ic, j2, k);
-          CH(i, k, jc) = CC(i, j2 + 1, k) - CC(ic, j2, k);
-          CH(i + 1, k, j) = CC(i + 1, j2 + 1, k) - CC(ic + 1, j2, k);
-          CH(i + 1, k, jc) = CC(i + 1, j2 + 1, k) + CC(ic + 1, j2, k);
-        }
-    }
-  }
-  for (size_t l = 1, lc = ip - 1; l < ipph; ++l, --lc) {
-    for (size_t ik = 0; ik < idl1; ++ik) {
-      C2(ik, l) =
-          CH2(ik, 0) + csarr[2 * l] * CH2(ik, 1) + csarr[4 * l] * CH2(ik, 2);
-      C2(ik, lc) = csarr[2 * l + 1] * CH2(ik, ip - 1) +
-                   csarr[4 * l + 1] * CH2(ik, ip - 2);
-    }
-    size_t iang = 2 * l;
-    size_t j = 3, jc = ip - 3;
-    for (; j < ipph - 3; j += 4, jc -= 4) {
-      iang += l;
-      if (iang > ip)
-        iang -= ip;
-      double ar1 = csarr[2 * iang], ai1 = csarr[2 * iang + 1];
-      iang += l;
-      if (iang > ip)
-        iang -= ip;
-      double ar2 = csarr[2 * iang], ai2 = csarr[2 * iang + 1];
-      iang += l;
-      if (iang > ip)
-        iang -= ip;
-      double ar3 = csarr[2 * iang], ai3 = csarr[2 * iang + 1];
-      iang += l;
-      if (iang > ip)
-        iang -= ip;
-      double ar4 = csarr[2 * iang], ai4 = csarr[2 * iang + 1];
-      for (size_t ik = 0; ik < idl1; ++ik) {
-        C2(ik, l) += ar1 * CH2(ik, j) + ar2 * CH2(ik, j + 1) +
-                     ar3 * CH2(ik, j + 2) + ar4 * CH2(ik, j + 3);
-        C2(ik, lc) += ai1 * CH2(ik, jc) + ai2 * CH2(ik, jc - 1) +
-                      ai3 * CH2(ik, jc - 2) + ai4 * CH2(ik, jc - 3);
-      }
-    }
-    for (; j < ipph - 1; j += 2, jc -= 2) {
-      iang += l;
-      if (iang > ip)
-        iang -= ip;
-      double ar1 = csarr[2 * iang], ai1 = csarr[2 * iang + 1];
-      iang += l;
-      if (iang > ip)
-        iang -= ip;
-      double ar2 = csarr[2 * iang], ai2 = csarr[2 * iang + 1];
-      for (size_t ik = 0; ik < idl1; ++ik) {
-        C2(ik, l) += ar1 * CH2(ik, j) + ar2 * CH2(ik, j + 1);
-        C2(ik, lc) += ai1 * CH2(ik, jc) + ai2 * CH2(ik, jc - 1);
-      }
-    }
-    for (; j < ipph; ++j, --jc) {
-      iang += l;
-      if (iang > ip)
-        iang -= ip;
-      double war = csarr[2 * iang], wai = csarr[2 * iang + 1];
-      for (size_t ik = 0; ik < idl1; ++ik) {
-        C2(ik, l) += war * CH2(ik, j);
-        C2(ik, lc) += wai * CH2(ik, jc);
-      }
-    }
-  }
-  for (size_t j = 1; j < ipph; ++j)
-    for (size_t ik = 0; ik < idl1; ++ik)
-      CH2(ik, 0) += CH2(ik, j);
-  for (size_t j = 1, jc = ip - 1; j < ipph; ++j, --jc) // 124
-    for (size_t k = 0; k < l1; ++k) {
-      CH(0, k, j) = C1(0, k, j) - C1(0, k, jc);
-      CH(0, k, jc) = C1(0, k, j) + C1(0, k, jc);
-    }
-
-  if (ido == 1)
-    return;
-
-  for (size_t j = 1, jc = ip - 1; j < ipph; ++j, --jc) // 127
-    for (size_t k = 0; k < l1; ++k)
-      for (size_t i = 1; i <= ido - 2; i += 2) {
-        CH(i, k, j) = C1(i, k, j) - C1(i + 1, k, jc);
-        CH(i, k, jc) = C1(i, k, j) + C1(i + 1, k, jc);
-        CH(i + 1, k, j) = C1(i + 1, k, j) + C1(i, k, jc);
-        CH(i + 1, k, jc) = C1(i + 1, k, j) - C1(i, k, jc);
-      }
-
-  // All in CH
-
-  for (size_t j = 1; j < ip; ++j) {
-    size_t is = (j - 1) * (ido - 1);
-    for (size_t k = 0; k < l1; ++k) {
-      size_t idij = is;
-      for (size_t i = 1; i <= ido - 2; i += 2) {
-        double t1 = CH(i, k, j), t2 = CH(i + 1, k, j);
-        CH(i, k, j) = wa[idij] * t1 - wa[idij + 1] * t2;
-        CH(i + 1, k, j) = wa[idij] * t2 + wa[idij + 1] * t1;
-        idij += 2;
-      }
-    }
-  }
-}
-#undef C1
-#undef C2
-#undef CH2
-
-#undef CC
-#undef CH
-#undef PM
-#undef MULPM
-#undef WA
-
-static void copy_and_norm(double *c, double *p1, size_t n, double fct) {
-  if (p1 != c) {
-    if (fct != 1.)
-      for (size_t i = 0; i < n; ++i)
-        c[i] = fct * p1[i];
-    else
-      memcpy(c, p1, n * sizeof(double));
-  } else if (fct != 1.)
-    for (size_t i = 0; i < n; ++i)
-      c[i] *= fct;
-}
-
-WARN_UNUSED_RESULT
-static int rfftp_forward(rfftp_plan plan, double c[], double fct) {
-  if (plan->length == 1)
-    return 0;
-  size_t n = plan->length;
-  size_t l1 = n, nf = plan->nfct;
-  double *ch = RALLOC(double, n);
-  if (!ch)
-    return -1;
-  double *p1 = c, *p2 = ch;
-
-  for (size_t k1 = 0; k1 < nf; ++k1) {
-    size_t k = nf - k1 - 1;
-    size_t ip = plan->fct[k].fct;
-    size_t ido = n / l1;
-    l1 /= ip;
-    if (ip == 4)
-      radf4(ido, l1, p1, p2, plan->fct[k].tw);
-    else if (ip == 2)
-      radf2(ido, l1, p1, p2, plan->fct[k].tw);
-    else if (ip == 3)
-      radf3(ido, l1, p1, p2, plan->fct[k].tw);
-    else if (ip == 5)
-      radf5(ido, l1, p1, p2, plan->fct[k].tw);
-    else {
-      radfg(ido, ip, l1, p1, p2, plan->fct[k].tw, plan->fct[k].tws);
-      SWAP(p1, p2, double *);
-    }
-    SWAP(p1, p2, double *);
-  }
-  copy_and_norm(c, p1, n, fct);
-  DEALLOC(ch);
-  return 0;
-}
-
-WARN_UNUSED_RESULT
-static int rfftp_backward(rfftp_plan plan, double c[], double fct) {
-  if (plan->length == 1)
-    return 0;
-  size_t n = plan->length;
-  size_t l1 = 1, nf = plan->nfct;
-  double *ch = RALLOC(double, n);
-  if (!ch)
-    return -1;
-  double *p1 = c, *p2 = ch;
-
-  for (size_t k = 0; k < nf; k++) {
-    size_t ip = plan->fct[k].fct, ido = n / (ip * l1);
-    if (ip == 4)
-      radb4(ido, l1, p1, p2, plan->fct[k].tw);
-    else if (ip == 2)
-      radb2(ido, l1, p1, p2, plan->fct[k].tw);
-    else if (ip == 3)
-      radb3(ido, l1, p1, p2, plan->fct[k].tw);
-    else if (ip == 5)
-      radb5(ido, l1, p1, p2, plan->fct[k].tw);
-    else
-      radbg(ido, ip, l1, p1, p2, plan->fct[k].tw, plan->fct[k].tws);
-    SWAP(p1, p2, double *);
-    l1 *= ip;
-  }
-  copy_and_norm(c, p1, n, fct);
-  DEALLOC(ch);
-  return 0;
-}
-
-WARN_UNUSED_RESULT
-static int rfftp_factorize(rfftp_plan plan) {
-  size_t length = plan->length;
-  size_t nfct = 0;
-  while ((length % 4) == 0) {
-    if (nfct >= NFCT)
-      return -1;
-    plan->fct[nfct++].fct = 4;
-    length >>= 2;
-  }
-  if ((length % 2) == 0) {
-    length >>= 1;
-    // factor 2 should be at the front of the factor list
-    if (nfct >= NFCT)
-      return -1;
-    plan->fct[nfct++].fct = 2;
-    SWAP(plan->fct[0].fct, plan->fct[nfct - 1].fct, size_t);
-  }
-  size_t maxl = (size_t)(sqrt((double)length)) + 1;
-  for (size_t divisor = 3; (length > 1) && (divisor < maxl); divisor += 2)
-    if ((length % divisor) == 0) {
-      while ((length % divisor) == 0) {
-        if (nfct >= NFCT)
-          return -1;
-        plan->fct[nfct++].fct = divisor;
-        length /= divisor;
-      }
-      maxl = (size_t)(sqrt((double)length)) + 1;
-    }
-  if (length > 1)
-    plan->fct[nfct++].fct = length;
-  plan->nfct = nfct;
-  return 0;
-}
-
-static size_t rfftp_twsize(rfftp_plan plan) {
-  size_t twsize = 0, l1 = 1;
-  for (size_t k = 0; k < plan->nfct; ++k) {
-    size_t ip = plan->fct[k].fct, ido = plan->length / (l1 * ip);
-    twsize += (ip - 1) * (ido - 1);
-    if (ip > 5)
-      twsize += 2 * ip;
-    l1 *= ip;
-  }
-  return twsize;
-}
-
-WARN_UNUSED_RESULT static int rfftp_comp_twiddle(rfftp_plan plan) {
-  size_t length = plan->length;
-  double *twid = RALLOC(double, 2 * length);
-  if (!twid)
-    return -1;
-  sincos_2pibyn_half(length, twid);
-  size_t l1 = 1;
-  double *ptr = plan->mem;
-  for (size_t k = 0; k < plan->nfct; ++k) {
-    size_t ip = plan->fct[k].fct, ido = length / (l1 * ip);
-    if (k < plan->nfct - 1) // last factor doesn't need twiddles
-    {
-      plan->fct[k].tw = ptr;
-      ptr += (ip - 1) * (ido - 1);
-      for (size_t j = 1; j < ip; ++j)
-        for (size_t i = 1; i <= (ido - 1) / 2; ++i) {
-          plan->fct[k].tw[(j - 1) * (ido - 1) + 2 * i - 2] =
-              twid[2 * j * l1 * i];
-          plan->fct[k].tw[(j - 1) * (ido - 1) + 2 * i - 1] =
-              twid[2 * j * l1 * i + 1];
-        }
-    }
-    if (ip > 5) // special factors required by *g functions
-    {
-      plan->fct[k].tws = ptr;
-      ptr += 2 * ip;
-      plan->fct[k].tws[0] = 1.;
-      plan->fct[k].tws[1] = 0.;
-      for (size_t i = 1; i <= (ip >> 1); ++i) {
-        plan->fct[k].tws[2 * i] = twid[2 * i * (length / ip)];
-        plan->fct[k].tws[2 * i + 1] = twid[2 * i * (length / ip) + 1];
-        plan->fct[k].tws[2 * (ip - i)] = twid[2 * i * (length / ip)];
-        plan->fct[k].tws[2 * (ip - i) + 1] = -twid[2 * i * (length / ip) + 1];
-      }
-    }
-    l1 *= ip;
-  }
-  DEALLOC(twid);
-  return 0;
-}
-
-[[nodiscard]] static NOINLINE rfftp_plan make_rfftp_plan(size_t length) {
-  if (length == 0)
-    return nullptr;
-  rfftp_plan plan = RALLOC(rfftp_plan_i, 1);
-  if (!plan)
-    return nullptr;
-  plan->length = length;
-  plan->nfct = 0;
-  plan->mem = nullptr;
-  for (size_t i = 0; i < NFCT; ++i)
-    plan->fct[i] = (rfftp_fctdata){.fct = 0, .tw = nullptr, .tws = nullptr};
-  if (length == 1)
-    return plan;
-  if (rfftp_factorize(plan) != 0) {
-    DEALLOC(plan);
-    return nullptr;
-  }
-  size_t tws = rfftp_twsize(plan);
-  plan->mem = RALLOC(double, tws);
-  if (!plan->mem) {
-    DEALLOC(plan);
-    return nullptr;
-  }
-  if (rfftp_comp_twiddle(plan) != 0) {
-    DEALLOC(plan->mem);
-    DEALLOC(plan);
-    return nullptr;
-  }
-  return plan;
-}
-
-static NOINLINE void destroy_rfftp_plan(rfftp_plan plan) {
-  if (plan == nullptr)
-    return;
-  DEALLOC(plan->mem);
-  DEALLOC(plan);
+/* The packed real transform exists in double precision (the reference
+ * engine behind rfft_plan) and in single precision (rfftf_plan), which works
+ * on float buffers directly instead of widening every sample. */
+#define RFFTP_T double
+#define RFFTP_S double
+#define RFFTP_NAME(x) x
+#include "pocketfft-rfftp.h"
+
+/* Codelets for the production lengths: constant twiddle tables and fully
+ * specialized pass drivers, generated by tools/gen_fft_codelets.c (which
+ * builds this file with POCKETFFT_NO_CODELETS to dump the tables). */
+#ifndef POCKETFFT_NO_CODELETS
+#include "pocketfft-codelet-tables.h"
+#define RFFTP_CODELET_LANES 1
+#endif
+#define RFFTP_T float
+#define RFFTP_S float
+#define RFFTP_NAME(x) x##_f
+#include "pocketfft-rfftp.h"
+
+/* Whether the instantiation on the given lane count has a codelet for
+   length-point passes. */
+static bool rfftp_has_codelet([[maybe_unused]] size_t length,
+                              [[maybe_unused]] size_t lanes) {
+#ifndef POCKETFFT_NO_CODELETS
+  for (size_t i = 0; i < sizeof(rfftp_codelets) / sizeof(rfftp_codelets[0]);
+       ++i)
+    if (rfftp_codelets[i].length == length && rfftp_codelets[i].lanes == lanes)
+      return true;
+#endif
+  return false;
 }
 
 typedef struct fftblue_plan_i {
@@ -2203,6 +1389,17 @@ typedef struct rfft_plan_i {
   fftblue_plan blueplan;
 } rfft_plan_i;
 
+/* true if Bluestein's algorithm is expected to beat the packed real transform
+ * for this length (i.e. the length has a large prime factor) */
+static bool rfft_use_bluestein(size_t length) {
+  if ((length < 50) || (largest_prime_factor(length) <= sqrt(length)))
+    return false;
+  double comp1 = 0.5 * cost_guess(length);
+  double comp2 = 2 * cost_guess(good_size(2 * length - 1));
+  comp2 *= 1.5; /* fudge factor that appears to give good overall performance */
+  return comp2 < comp1;
+}
+
 [[nodiscard]] rfft_plan make_rfft_plan(size_t length) {
   if (length == 0)
     return nullptr;
@@ -2211,26 +1408,14 @@ typedef struct rfft_plan_i {
     return nullptr;
   plan->blueplan = nullptr;
   plan->packplan = nullptr;
-  if ((length < 50) || (largest_prime_factor(length) <= sqrt(length))) {
-    plan->packplan = make_rfftp_plan(length);
-    if (!plan->packplan) {
-      DEALLOC(plan);
-      return nullptr;
-    }
-    return plan;
-  }
-  double comp1 = 0.5 * cost_guess(length);
-  double comp2 = 2 * cost_guess(good_size(2 * length - 1));
-  comp2 *= 1.5; /* fudge factor that appears to give good overall performance */
-  if (comp2 < comp1) // use Bluestein
-  {
+  if (rfft_use_bluestein(length)) {
     plan->blueplan = make_fftblue_plan(length);
     if (!plan->blueplan) {
       DEALLOC(plan);
       return nullptr;
     }
   } else {
-    plan->packplan = make_rfftp_plan(length);
+    plan->packplan = make_rfftp_plan(length, POCKETFFT_ORDER_DEFAULT);
     if (!plan->packplan) {
       DEALLOC(plan);
       return nullptr;
@@ -2274,3 +1459,459 @@ WARN_UNUSED_RESULT int rfft_forward(rfft_plan plan, double c[], double fct) {
   else // if (plan->blueplan)
     return rfftblue_forward(plan->blueplan, c, fct);
 }
+
+/* Widest vector a single-precision real transform can use on this build
+ * target, and how to read it. The vector types may alias float buffers and
+ * only require float alignment, so the passes run on the caller's data. */
+#if defined(__x86_64__) || defined(__aarch64__)
+#define RFFTF_HAVE_SIMD
+typedef float pocketfft_v4sf
+    __attribute__((vector_size(16), aligned(4), may_alias));
+#endif
+#if defined(__x86_64__)
+typedef float pocketfft_v8sf
+    __attribute__((vector_size(32), aligned(4), may_alias));
+typedef float pocketfft_v16sf
+    __attribute__((vector_size(64), aligned(4), may_alias));
+#endif
+
+typedef struct rfftf_plan_i rfftf_plan_i;
+/* What a forward transform leaves in its buffer: the packed coefficients, or
+   |X_k|^2 respectively |X_k| for k = 0 .. length / 2. */
+typedef enum {
+  RFFTF_PACKED,
+  RFFTF_POWER,
+  RFFTF_MAGNITUDE,
+} rfftf_output;
+
+/* Kernels only read the plan and work in scratch, rfftf_scratch_size(plan)
+   floats for single transforms. */
+typedef void (*rfftf_kernel)(const rfftf_plan_i *plan, float c[], float fct,
+                             float *scratch);
+/* Power and magnitude outputs only cover bins [begin, end). */
+typedef void (*rfftf_forward_kernel)(const rfftf_plan_i *plan, float c[],
+                                     float fct, rfftf_output output,
+                                     size_t begin, size_t end, float *scratch);
+typedef void (*rfftf_batch_kernel)(const rfftf_plan_i *plan, float *c,
+                                   size_t stride, bool backward, float fct,
+                                   void *buf, void *ch);
+
+typedef struct rfftf_plan_i {
+  size_t length;
+  size_t nonzero; /* forward input from here on is taken as zero */
+  pocketfft_order order;
+  pocketfft_isa isa;
+  size_t lanes;          /* 1 for the scalar passes */
+  rfftp_plan_f packplan; /* length / lanes */
+  /* lanes > 1: per-lane twiddles of the length / lanes subtransforms,
+     followed by the sign and twiddle tables of the lane DFT stages */
+  float *tw;
+  size_t nstages;
+  unsigned char rev[16]; /* bit reversal of the lane index */
+  rfftf_forward_kernel forward;
+  rfftf_kernel backward;
+  /* batches put one frame per lane and need no divisibility, so they may use
+     a wider kernel than single transforms */
+  size_t batch_lanes;
+  rfftp_plan_f batchplan; /* length; aliases packplan when lanes == 1 */
+  rfftf_batch_kernel batch;
+} rfftf_plan_i;
+
+#ifdef RFFTF_HAVE_SIMD
+#define SIMD_V pocketfft_v4sf
+#define SIMD_W 4
+#define SIMD_NAME(x) x##_v4
+#define SIMD_ATTR
+#define SIMD_XOR1(v) __builtin_shufflevector(v, v, 1, 0, 3, 2)
+#define SIMD_XOR2(v) __builtin_shufflevector(v, v, 2, 3, 0, 1)
+#define SIMD_ZIPLO(a, b) __builtin_shufflevector(a, b, 0, 4, 1, 5)
+#define SIMD_ZIPHI(a, b) __builtin_shufflevector(a, b, 2, 6, 3, 7)
+#include "pocketfft-simd.h"
+#undef SIMD_ZIPHI
+#undef SIMD_ZIPLO
+#undef SIMD_XOR2
+#undef SIMD_XOR1
+#endif
+
+#if defined(__x86_64__)
+#define SIMD_V pocketfft_v8sf
+#define SIMD_W 8
+#define SIMD_NAME(x) x##_avx2
+#define SIMD_ATTR [[gnu::target("avx2,fma")]]
+#define SIMD_XOR1(v) __builtin_shufflevector(v, v, 1, 0, 3, 2, 5, 4, 7, 6)
+#define SIMD_XOR2(v) __builtin_shufflevector(v, v, 2, 3, 0, 1, 6, 7, 4, 5)
+#define SIMD_XOR4(v) __builtin_shufflevector(v, v, 4, 5, 6, 7, 0, 1, 2, 3)
+#define SIMD_ZIPLO(a, b) __builtin_shufflevector(a, b, 0, 8, 1, 9, 2, 10, 3, 11)
+#define SIMD_ZIPHI(a, b)                                                       \
+  __builtin_shufflevector(a, b, 4, 12, 5, 13, 6, 14, 7, 15)
+#include "pocketfft-simd.h"
+#undef SIMD_ZIPHI
+#undef SIMD_ZIPLO
+#undef SIMD_XOR4
+#undef SIMD_XOR2
+#undef SIMD_XOR1
+
+#define SIMD_V pocketfft_v16sf
+#define SIMD_W 16
+#define SIMD_NAME(x) x##_avx512
+#define SIMD_ATTR [[gnu::target("avx512f")]]
+#define SIMD_XOR1(v)                                                           \
+  __builtin_shufflevector(v, v, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12,  \
+                          15, 14)
+#define SIMD_XOR2(v)                                                           \
+  __builtin_shufflevector(v, v, 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15,  \
+                          12, 13)
+#define SIMD_XOR4(v)                                                           \
+  __builtin_shufflevector(v, v, 4, 5, 6, 7, 0, 1, 2, 3, 12, 13, 14, 15, 8, 9,  \
+                          10, 11)
+#define SIMD_XOR8(v)                                                           \
+  __builtin_shufflevector(v, v, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4,   \
+                          5, 6, 7)
+#define SIMD_ZIPLO(a, b)                                                       \
+  __builtin_shufflevector(a, b, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6,   \
+                          22, 7, 23)
+#define SIMD_ZIPHI(a, b)                                                       \
+  __builtin_shufflevector(a, b, 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29,  \
+                          14, 30, 15, 31)
+#include "pocketfft-simd.h"
+#undef SIMD_ZIPHI
+#undef SIMD_ZIPLO
+#undef SIMD_XOR8
+#undef SIMD_XOR4
+#undef SIMD_XOR2
+#undef SIMD_XOR1
+
+#include <cpuid.h>
+
+/* true if the OS saves every register state bit set in mask */
+static bool xgetbv_has(unsigned mask) {
+  unsigned eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (eax & mask) == mask;
+}
+#endif
+
+pocketfft_isa pocketfft_best_isa(void) {
+#if defined(__x86_64__)
+  unsigned eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    return POCKETFFT_ISA_SSE2;
+  bool fma = (ecx & bit_FMA) != 0;
+  if (!(ecx & bit_OSXSAVE) || !(ecx & bit_AVX) || !xgetbv_has(0x6))
+    return POCKETFFT_ISA_SSE2;
+  if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+    return POCKETFFT_ISA_SSE2;
+  /* opmask, upper ZMM and high ZMM state on top of XMM and YMM */
+  if ((ebx & bit_AVX512F) && xgetbv_has(0xe6))
+    return POCKETFFT_ISA_AVX512;
+  if ((ebx & bit_AVX2) && fma)
+    return POCKETFFT_ISA_AVX2;
+  return POCKETFFT_ISA_SSE2;
+#elif defined(__aarch64__)
+  return POCKETFFT_ISA_NEON;
+#else
+  return POCKETFFT_ISA_SCALAR;
+#endif
+}
+
+static const struct {
+  pocketfft_isa isa;
+  size_t lanes;
+  rfftf_forward_kernel forward;
+  rfftf_kernel backward;
+  rfftf_batch_kernel batch;
+} rfftf_kernels[] = {
+#if defined(__x86_64__)
+    {POCKETFFT_ISA_AVX512, 16, rfftf_forward_avx512, rfftf_backward_avx512,
+     rfftf_batch_avx512},
+    {POCKETFFT_ISA_AVX2, 8, rfftf_forward_avx2, rfftf_backward_avx2,
+     rfftf_batch_avx2},
+    {POCKETFFT_ISA_SSE2, 4, rfftf_forward_v4, rfftf_backward_v4,
+     rfftf_batch_v4},
+#elif defined(__aarch64__)
+    {POCKETFFT_ISA_NEON, 4, rfftf_forward_v4, rfftf_backward_v4,
+     rfftf_batch_v4},
+#endif
+    {POCKETFFT_ISA_SCALAR, 1, nullptr, nullptr, nullptr},
+};
+
+/* true if a kernel for `kernel` may run when the caller asked for `limit`,
+ * i.e. both belong to the same family and kernel is no wider */
+static bool rfftf_isa_within(pocketfft_isa kernel, pocketfft_isa limit) {
+  if (kernel == POCKETFFT_ISA_SCALAR)
+    return true;
+  if (kernel == POCKETFFT_ISA_NEON || limit == POCKETFFT_ISA_NEON)
+    return kernel == limit;
+  return kernel <= limit;
+}
+
+WARN_UNUSED_RESULT static int rfftf_comp_twiddle(rfftf_plan plan) {
+  size_t n = plan->length, w = plan->lanes, m = n / w;
+  plan->nstages = 0;
+  while (((size_t)1 << plan->nstages) < w)
+    ++plan->nstages;
+  for (size_t q = 0; q < w; ++q) {
+    size_t r = 0;
+    for (size_t b = 0; b < plan->nstages; ++b)
+      r |= ((q >> b) & 1) << (plan->nstages - 1 - b);
+    plan->rev[q] = (unsigned char)r;
+  }
+
+  plan->tw = RALLOC(float, 2 * m * w + 3 * w * plan->nstages);
+  double *twid = RALLOC(double, 2 * n);
+  if (!plan->tw || !twid) {
+    DEALLOC(twid);
+    return -1;
+  }
+  /* exp(-2 pi i l k / n) for every subtransform bin k and lane l */
+  sincos_2pibyn(n, twid);
+  for (size_t k = 0; k < m; ++k)
+    for (size_t l = 0; l < w; ++l) {
+      plan->tw[2 * k * w + l] = (float)twid[2 * ((l * k) % n)];
+      plan->tw[(2 * k + 1) * w + l] = (float)-twid[2 * ((l * k) % n) + 1];
+    }
+  /* lane DFT stage of half-size h: lanes with bit h set are the differences
+     and get multiplied by exp(-2 pi i (l mod h) / (2 h)) */
+  float *st = plan->tw + 2 * m * w;
+  for (size_t s = 0; s < plan->nstages; ++s, st += 3 * w) {
+    size_t h = w >> (s + 1);
+    for (size_t l = 0; l < w; ++l) {
+      bool high = (l & h) != 0;
+      size_t idx = high ? (l & (h - 1)) * (n / (2 * h)) : 0;
+      st[l] = high ? -1.f : 1.f;
+      st[w + l] = (float)twid[2 * idx];
+      st[2 * w + l] = (float)-twid[2 * idx + 1];
+    }
+  }
+  DEALLOC(twid);
+  return 0;
+}
+
+[[nodiscard]] rfftf_plan make_rfftf_plan_isa(size_t length,
+                                             pocketfft_isa isa) {
+  return make_rfftf_plan_order(length, length, isa, POCKETFFT_ORDER_DEFAULT);
+}
+
+[[nodiscard]] rfftf_plan make_rfftf_plan_order(size_t length, size_t nonzero,
+                                               pocketfft_isa isa,
+                                               pocketfft_order order) {
+  if (length == 0 || rfft_use_bluestein(length))
+    return nullptr;
+  rfftf_plan plan = RALLOC(rfftf_plan_i, 1);
+  if (!plan)
+    return nullptr;
+  pocketfft_isa best = pocketfft_best_isa();
+  size_t nkernels = sizeof(rfftf_kernels) / sizeof(rfftf_kernels[0]);
+  for (size_t i = 0; i < nkernels; ++i) {
+    size_t w = rfftf_kernels[i].lanes;
+    if (!rfftf_isa_within(rfftf_kernels[i].isa, isa) ||
+        !rfftf_isa_within(rfftf_kernels[i].isa, best))
+      continue;
+    /* batches take the widest kernel whose working set, two buffers of
+       length vectors, fits a 32 KiB L1 data cache, else the narrowest one */
+    if (plan->batch_lanes == 0 ||
+        (w > 1 && 2 * length * plan->batch_lanes * sizeof(float) > 32768)) {
+      plan->batch_lanes = w;
+      plan->batch = rfftf_kernels[i].batch;
+    }
+    /* single transforms take the widest kernel that gives every lane an even
+       subtransform of at least two points */
+    if (plan->lanes != 0 || (w > 1 && length % (2 * w) != 0))
+      continue;
+    plan->isa = rfftf_kernels[i].isa;
+    plan->lanes = w;
+    plan->forward = rfftf_kernels[i].forward;
+    plan->backward = rfftf_kernels[i].backward;
+  }
+  plan->length = length;
+  plan->nonzero = nonzero < length ? nonzero : length;
+  plan->order = order;
+  plan->packplan = make_rfftp_plan_f(length / plan->lanes, order);
+  if (!plan->packplan ||
+      (plan->lanes > 1 && rfftf_comp_twiddle(plan) != 0)) {
+    destroy_rfftf_plan(plan);
+    return nullptr;
+  }
+  plan->batchplan = plan->packplan;
+  if (plan->lanes > 1 && plan->batch_lanes > 1) {
+    plan->batchplan = make_rfftp_plan_f(length, order);
+    if (!plan->batchplan) {
+      destroy_rfftf_plan(plan);
+      return nullptr;
+    }
+  }
+  rfftf_set_codelets(plan, true);
+  return plan;
+}
+
+[[nodiscard]] rfftf_plan make_rfftf_plan(size_t length) {
+  return make_rfftf_plan_isa(length, pocketfft_best_isa());
+}
+
+[[nodiscard]] rfftf_plan make_rfftf_plan_pruned(size_t length, size_t nonzero,
+                                                pocketfft_isa isa) {
+  return make_rfftf_plan_order(length, nonzero, isa, POCKETFFT_ORDER_DEFAULT);
+}
+
+void destroy_rfftf_plan(rfftf_plan plan) {
+  if (plan == nullptr)
+    return;
+  if (plan->batchplan != plan->packplan)
+    destroy_rfftp_plan_f(plan->batchplan);
+  destroy_rfftp_plan_f(plan->packplan);
+  DEALLOC(plan->tw);
+  DEALLOC(plan);
+}
+
+[[nodiscard]] size_t rfftf_length(rfftf_plan plan) { return plan->length; }
+
+[[nodiscard]] pocketfft_isa rfftf_isa(rfftf_plan plan) { return plan->isa; }
+
+void rfftf_set_codelets(rfftf_plan plan, bool enabled) {
+  /* lengths without a codelet fall through to the generic driver; codelets
+     hard-code the default factor order */
+  enabled = enabled && plan->order == POCKETFFT_ORDER_DEFAULT;
+  plan->packplan->codelet = enabled;
+  plan->batchplan->codelet = enabled;
+}
+
+[[nodiscard]] bool rfftf_codelet(rfftf_plan plan) {
+  return plan->packplan->codelet &&
+         rfftp_has_codelet(plan->length / plan->lanes, plan->lanes);
+}
+
+[[nodiscard]] size_t rfftf_scratch_size(rfftf_plan plan) {
+  return plan->length;
+}
+
+[[nodiscard]] size_t rfftf_batch_scratch_size(rfftf_plan plan) {
+  /* the interleaved frames and the passes' second buffer */
+  if (plan->batch_lanes > 1)
+    return 2 * plan->length * plan->batch_lanes;
+  return plan->length;
+}
+
+WARN_UNUSED_RESULT int rfftf_backward(rfftf_plan plan, float c[], float fct,
+                                      float scratch[]) {
+  float *own = nullptr;
+  if (!scratch) {
+    scratch = own = RALLOC(float, rfftf_scratch_size(plan));
+    if (!own)
+      return -1;
+  }
+  if (plan->backward)
+    plan->backward(plan, c, fct, scratch);
+  else {
+    float *p1 = rfftp_backward_passes_f(plan->packplan, c, scratch);
+    copy_and_norm_f(c, p1, plan->length, fct);
+  }
+  DEALLOC(own);
+  return 0;
+}
+
+/* Writes the power (or magnitude) spectrum of the packed coefficients hc to
+   out[begin .. end - 1], bins up to n / 2; out may equal hc since bin k only
+   reads slots >= k. */
+static void rfftf_packed_to_power(float *out, const float *hc, size_t n,
+                                  float fct, rfftf_output output, size_t begin,
+                                  size_t end) {
+  float scale = fct * fct;
+  float nyquist = scale * hc[n - 1] * hc[n - 1];
+  size_t k = begin;
+  if (k == 0)
+    out[k++] = scale * hc[0] * hc[0];
+  for (; k < end && k < n / 2; ++k)
+    out[k] = scale * (hc[2 * k - 1] * hc[2 * k - 1] + hc[2 * k] * hc[2 * k]);
+  if (end > n / 2)
+    out[n / 2] = nyquist;
+  if (output == RFFTF_MAGNITUDE)
+    for (k = begin; k < end; ++k)
+      out[k] = sqrtf(out[k]);
+}
+
+WARN_UNUSED_RESULT static int rfftf_forward_output(rfftf_plan plan, float c[],
+                                                   float fct,
+                                                   rfftf_output output,
+                                                   size_t begin, size_t end,
+                                                   float *scratch) {
+  float *own = nullptr;
+  if (!scratch) {
+    scratch = own = RALLOC(float, rfftf_scratch_size(plan));
+    if (!own)
+      return -1;
+  }
+  if (plan->forward)
+    plan->forward(plan, c, fct, output, begin, end, scratch);
+  else {
+    float *p1 =
+        rfftp_forward_passes_f(plan->packplan, c, scratch, plan->nonzero);
+    /* square the last pass's output while it is still in cache instead of
+       normalizing it into c first */
+    if (output == RFFTF_PACKED)
+      copy_and_norm_f(c, p1, plan->length, fct);
+    else
+      rfftf_packed_to_power(c, p1, plan->length, fct, output, begin, end);
+  }
+  DEALLOC(own);
+  return 0;
+}
+
+WARN_UNUSED_RESULT int rfftf_forward(rfftf_plan plan, float c[], float fct,
+                                     float scratch[]) {
+  return rfftf_forward_output(plan, c, fct, RFFTF_PACKED, 0, plan->length,
+                              scratch);
+}
+
+WARN_UNUSED_RESULT int rfftf_forward_power(rfftf_plan plan, float c[],
+                                           float fct, bool magnitude,
+                                           float scratch[]) {
+  return rfftf_forward_power_range(plan, c, fct, magnitude, 0,
+                                   plan->length / 2 + 1, scratch);
+}
+
+WARN_UNUSED_RESULT int rfftf_forward_power_range(rfftf_plan plan, float c[],
+                                                 float fct, bool magnitude,
+                                                 size_t begin, size_t end,
+                                                 float scratch[]) {
+  if (plan->length % 2 != 0 || begin >= end || end > plan->length / 2 + 1)
+    return -1;
+  return rfftf_forward_output(plan, c, fct,
+                              magnitude ? RFFTF_MAGNITUDE : RFFTF_POWER, begin,
+                              end, scratch);
+}
+
+WARN_UNUSED_RESULT static int rfftf_batch(rfftf_plan plan, float c[],
+                                          size_t count, size_t stride,
+                                          bool backward, float fct,
+                                          float *scratch) {
+  size_t n = plan->length, w = plan->batch_lanes, done = 0;
+  float *own = nullptr;
+  if (!scratch) {
+    scratch = own = RALLOC(float, rfftf_batch_scratch_size(plan));
+    if (!own)
+      return -1;
+  }
+  if (w > 1 && n > 1)
+    for (; done + w <= count; done += w)
+      plan->batch(plan, c + done * stride, stride, backward, fct, scratch,
+                  scratch + n * w);
+  /* frames left over after the last full batch go one at a time */
+  int res = 0;
+  for (; done < count && res == 0; ++done)
+    res = backward ? rfftf_backward(plan, c + done * stride, fct, scratch)
+                   : rfftf_forward(plan, c + done * stride, fct, scratch);
+  DEALLOC(own);
+  return res;
+}
+
+WARN_UNUSED_RESULT int rfftf_backward_batch(rfftf_plan plan, float c[],
+                                            size_t count, size_t stride,
+                                            float fct, float scratch[]) {
+  return rfftf_batch(plan, c, count, stride, true, fct, scratch);
+}
+
+WARN_UNUSED_RESULT int rfftf_forward_batch(rfftf_plan plan, float c[],
+                                           size_t count, size_t stride,
+                                           float fct, float scratch[]) {
+  return rfftf_batch(plan, c, count, stride, false, fct, scratch);
+}
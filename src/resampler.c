@@ -0,0 +1,212 @@
+// Streaming polyphase resampler implementation in C23.
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "kaldi-native-fbank/kaldi-math.h"
+#include "kaldi-native-fbank/log.h"
+#include "kaldi-native-fbank/resampler.h"
+
+// Zero crossings of the sinc on each side of its centre.
+constexpr int32_t KNF_RESAMPLE_ZEROS = 6;
+// Cutoff as a fraction of the lower Nyquist frequency.
+constexpr double KNF_RESAMPLE_ROLLOFF = 0.99;
+// Lanes of the dot product; the taps are padded to a multiple of it.
+constexpr int32_t KNF_RESAMPLE_LANES = 8;
+// Largest filter bank, in floats, before rates are rejected as too far from
+// a simple ratio.
+constexpr int64_t KNF_RESAMPLE_MAX_FILTER = (int64_t)1 << 22;
+
+static int32_t knf_gcd(int32_t a, int32_t b) {
+  while (b != 0) {
+    int32_t t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+[[nodiscard]] bool knf_resampler_create(int32_t in_rate, int32_t out_rate,
+                                        knf_resampler *out) {
+  if (out == nullptr) {
+    return false;
+  }
+  memset(out, 0, sizeof(*out));
+  if (in_rate <= 0 || out_rate <= 0) {
+    return false;
+  }
+  int32_t g = knf_gcd(in_rate, out_rate);
+  int32_t up = out_rate / g;
+  int32_t down = in_rate / g;
+  double cutoff = KNF_RESAMPLE_ROLLOFF * 0.5 *
+                  (in_rate < out_rate ? in_rate : out_rate);
+  // Half the filter's support, in input samples.
+  double width = KNF_RESAMPLE_ZEROS * (double)in_rate / (2.0 * cutoff);
+  int32_t half = (int32_t)floor(width) + 1;
+  int32_t taps = (2 * half + KNF_RESAMPLE_LANES - 1) / KNF_RESAMPLE_LANES *
+                 KNF_RESAMPLE_LANES;
+  if ((int64_t)up * taps > KNF_RESAMPLE_MAX_FILTER) {
+    KNF_LOG_ERROR("Cannot resample from %d to %d Hz: filter too large",
+                  in_rate, out_rate);
+    return false;
+  }
+
+  out->filters = (float *)calloc((size_t)up * (size_t)taps, sizeof(float));
+  out->buffer_cap = 1024 + taps;
+  out->buffer = (float *)calloc((size_t)out->buffer_cap, sizeof(float));
+  if (out->filters == nullptr || out->buffer == nullptr) {
+    knf_resampler_destroy(out);
+    return false;
+  }
+  // Phase p produces the output at input time base + p / up from the taps
+  // base - half + 1 .. base + half.
+  double window_width = KNF_RESAMPLE_ZEROS / (2.0 * cutoff);
+  for (int32_t p = 0; p < up; ++p) {
+    float *w = out->filters + (size_t)p * (size_t)taps;
+    for (int32_t j = 0; j < 2 * half; ++j) {
+      double t = (j - half + 1 - (double)p / up) / in_rate;
+      if (fabs(t) >= window_width) continue;
+      double window =
+          0.5 * (1.0 + cos(2.0 * KNF_PI * cutoff / KNF_RESAMPLE_ZEROS * t));
+      double sinc = t == 0.0 ? 2.0 * cutoff
+                             : sin(2.0 * KNF_PI * cutoff * t) / (KNF_PI * t);
+      w[j] = (float)(window * sinc / in_rate);
+    }
+  }
+  out->in_rate = in_rate;
+  out->out_rate = out_rate;
+  out->up = up;
+  out->down = down;
+  out->half = half;
+  out->taps = taps;
+  // The first output reads half - 1 samples before the stream.
+  out->buffer_start = 1 - half;
+  out->buffer_size = half - 1;
+  return true;
+}
+
+void knf_resampler_destroy(knf_resampler *r) {
+  if (r == nullptr) return;
+  free(r->filters);
+  free(r->buffer);
+  memset(r, 0, sizeof(*r));
+}
+
+// Outputs of the whole stream once num_in samples have been accepted.
+static int64_t knf_resampler_total(const knf_resampler *r, int64_t num_in) {
+  return (num_in * r->up + r->down - 1) / r->down;
+}
+
+int32_t knf_resampler_max_output(const knf_resampler *r, int32_t n) {
+  if (r == nullptr || n < 0) {
+    return -1;
+  }
+  int64_t bound = knf_resampler_total(r, r->num_in + n) - r->num_out;
+  return bound > INT32_MAX ? -1 : (int32_t)(bound > 0 ? bound : 0);
+}
+
+static bool knf_resampler_reserve(knf_resampler *r, int64_t needed) {
+  if (needed > INT32_MAX) {
+    return false;
+  }
+  if (needed <= r->buffer_cap) {
+    return true;
+  }
+  int64_t next_cap = (int64_t)r->buffer_cap * 2;
+  if (next_cap < needed) next_cap = needed;
+  if (next_cap > INT32_MAX) next_cap = INT32_MAX;
+  auto buffer = (float *)realloc(r->buffer, sizeof(float) * (size_t)next_cap);
+  if (buffer == nullptr) {
+    return false;
+  }
+  r->buffer = buffer;
+  r->buffer_cap = (int32_t)next_cap;
+  return true;
+}
+
+// First input sample read by output n.
+static int64_t knf_resampler_first(const knf_resampler *r, int64_t n) {
+  return n * r->down / r->up - r->half + 1;
+}
+
+[[nodiscard]] bool knf_resampler_process(knf_resampler *r, const void *input,
+                                         knf_sample_format format, int32_t n,
+                                         bool flush, float *out,
+                                         int32_t *num_out) {
+  if (r == nullptr || r->filters == nullptr || num_out == nullptr || n < 0 ||
+      (n > 0 && input == nullptr) || r->flushed) {
+    return false;
+  }
+  *num_out = 0;
+  if (n > 0) {
+    if (!knf_resampler_reserve(r, (int64_t)r->buffer_size + n)) {
+      return false;
+    }
+    knf_convert_samples(input, format, 0, n, r->buffer + r->buffer_size);
+    r->buffer_size += n;
+    r->num_in += n;
+  }
+
+  int64_t end = r->num_out;  // one past the last output to produce now
+  if (flush) {
+    end = knf_resampler_total(r, r->num_in);
+    if (end > r->num_out) {
+      // Zeros after the stream for the last output's taps.
+      int64_t needed = knf_resampler_first(r, end - 1) + r->taps -
+                       r->buffer_start;
+      if (needed > r->buffer_size) {
+        if (!knf_resampler_reserve(r, needed)) {
+          return false;
+        }
+        memset(r->buffer + r->buffer_size, 0,
+               sizeof(float) * (size_t)(needed - r->buffer_size));
+        r->buffer_size = (int32_t)needed;
+      }
+    }
+    r->flushed = true;
+  } else {
+    // Output i is ready once first(i) + taps <= available, i.e. once
+    // floor(i down / up) <= last.
+    int64_t available = r->buffer_start + r->buffer_size;
+    int64_t last = available - r->taps + r->half - 1;
+    if (last >= 0) {
+      int64_t ready = ((last + 1) * r->up + r->down - 1) / r->down;
+      if (ready > end) end = ready;
+    }
+  }
+  if (end - r->num_out > INT32_MAX) {
+    return false;
+  }
+
+  int32_t count = 0;
+  for (int64_t i = r->num_out; i < end; ++i) {
+    int32_t phase = (int32_t)(i * r->down % r->up);
+    const float *w = r->filters + (size_t)phase * (size_t)r->taps;
+    const float *x =
+        r->buffer + (knf_resampler_first(r, i) - r->buffer_start);
+    float acc[KNF_RESAMPLE_LANES] = {};
+    for (int32_t j = 0; j < r->taps; j += KNF_RESAMPLE_LANES) {
+      for (int32_t l = 0; l < KNF_RESAMPLE_LANES; ++l) {
+        acc[l] += w[j + l] * x[j + l];
+      }
+    }
+    float sum = 0.0f;
+    for (int32_t l = 0; l < KNF_RESAMPLE_LANES; ++l) sum += acc[l];
+    out[count++] = sum;
+  }
+  r->num_out = end;
+  *num_out = count;
+
+  // Drop the samples no later output reads.
+  int64_t keep_from = knf_resampler_first(r, r->num_out);
+  int64_t discard = keep_from - r->buffer_start;
+  if (discard > r->buffer_size) discard = r->buffer_size;
+  if (discard > 0) {
+    memmove(r->buffer, r->buffer + discard,
+            sizeof(float) * (size_t)(r->buffer_size - discard));
+    r->buffer_size -= (int32_t)discard;
+    r->buffer_start += discard;
+  }
+  return true;
+}
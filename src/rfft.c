@@ -1,27 +1,496 @@
 // Real FFT wrapper implemented in C23 on top of pocketfft.
 
+#include <math.h>
+#include <stdatomic.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include "kaldi-native-fbank/log.h"
 #include "kaldi-native-fbank/rfft.h"
 #include "pocketfft/pocketfft.h"
+#include "spin-lock.h"
 
+// What a plan is built from; plans of equal variants are interchangeable and
+// the cache hands out one state for all of them.
+typedef struct {
+  int32_t n;
+  int32_t nonzero;                // n for KNF_RFFT_DOUBLE
+  knf_rfft_precision precision;   // as requested
+  pocketfft_isa isa;              // widest kernel the plan may use
+  bool codelets;
+  pocketfft_order order;
+} knf_rfft_variant;
+
+// Shared by every knf_rfft created from the same variant and read-only after
+// creation, except for refs, which the cache lock guards.
 struct knf_rfft_state {
-  rfft_plan plan;
-  double *buffer;
+  rfftf_plan fplan;  // KNF_RFFT_FLOAT
+  rfft_plan plan;    // KNF_RFFT_DOUBLE
+  knf_rfft_variant variant;
+  int32_t refs;  // knf_rfft objects using the state
+  bool cached;   // listed in knf_rfft_cache; freed with the last ref if not
 };
 
+// The fastest variant measured for a float transform.
+typedef struct {
+  int32_t n;
+  int32_t nonzero;
+  bool inverse;
+  pocketfft_isa isa;
+  bool codelets;
+  pocketfft_order order;
+} knf_rfft_wisdom;
+
+// Plans that stay around after their last knf_rfft is destroyed, so that
+// short-lived users such as knf_stft_compute do not rebuild the tables on
+// every call.
+constexpr int32_t KNF_RFFT_CACHE_SIZE = 16;
+
+static atomic_int knf_rfft_isa_cap = KNF_FFT_ISA_AUTO;
+static atomic_bool knf_rfft_codelets = true;
+static atomic_int knf_rfft_planning_mode = KNF_RFFT_ESTIMATE;
+
+// Guards knf_rfft_cache, knf_rfft_wisdoms and the refs of every state.
+static knf_spin_lock knf_rfft_lock = false;
+static struct knf_rfft_state *knf_rfft_cache[KNF_RFFT_CACHE_SIZE];
+static knf_rfft_wisdom *knf_rfft_wisdoms = nullptr;
+static int32_t knf_rfft_wisdom_count = 0;
+static int32_t knf_rfft_wisdom_capacity = 0;
+
+static void knf_rfft_lock_acquire(void) {
+  knf_spin_lock_acquire(&knf_rfft_lock);
+}
+
+static void knf_rfft_lock_release(void) {
+  knf_spin_lock_release(&knf_rfft_lock);
+}
+
+knf_fft_isa knf_fft_best_isa(void) {
+  return (knf_fft_isa)pocketfft_best_isa();
+}
+
+bool knf_fft_isa_supported(knf_fft_isa isa) {
+  const knf_fft_isa best = knf_fft_best_isa();
+  if (isa == KNF_FFT_ISA_SCALAR || isa == best) return true;
+  if (isa == KNF_FFT_ISA_NEON || best == KNF_FFT_ISA_NEON) return false;
+  // The x86 instruction sets are ordered by vector width.
+  return isa > KNF_FFT_ISA_SCALAR && isa < best;
+}
+
+bool knf_rfft_force_isa(knf_fft_isa isa) {
+  if (isa != KNF_FFT_ISA_AUTO && !knf_fft_isa_supported(isa)) {
+    return false;
+  }
+  atomic_store_explicit(&knf_rfft_isa_cap, (int)isa, memory_order_relaxed);
+  return true;
+}
+
+void knf_rfft_enable_codelets(bool enabled) {
+  atomic_store_explicit(&knf_rfft_codelets, enabled, memory_order_relaxed);
+}
+
+void knf_rfft_set_planning(knf_rfft_planning planning) {
+  atomic_store_explicit(&knf_rfft_planning_mode, (int)planning,
+                        memory_order_relaxed);
+}
+
+static bool knf_rfft_variant_equal(const knf_rfft_variant *a,
+                                   const knf_rfft_variant *b) {
+  return a->n == b->n && a->nonzero == b->nonzero &&
+         a->precision == b->precision && a->isa == b->isa &&
+         a->codelets == b->codelets && a->order == b->order;
+}
+
+static void knf_rfft_state_free(struct knf_rfft_state *state) {
+  if (state == nullptr) return;
+  if (state->fplan) destroy_rfftf_plan(state->fplan);
+  if (state->plan) destroy_rfft_plan(state->plan);
+  free(state);
+}
+
+// Builds the plans of a variant; a float request whose length needs
+// Bluestein's algorithm gets a double plan instead.
+static struct knf_rfft_state *knf_rfft_state_create(
+    const knf_rfft_variant *variant) {
+  auto state =
+      (struct knf_rfft_state *)calloc(1, sizeof(struct knf_rfft_state));
+  if (state == nullptr) return nullptr;
+  state->variant = *variant;
+  if (variant->precision == KNF_RFFT_FLOAT) {
+    state->fplan = make_rfftf_plan_order((size_t)variant->n,
+                                         (size_t)variant->nonzero,
+                                         variant->isa, variant->order);
+    if (state->fplan != nullptr) {
+      rfftf_set_codelets(state->fplan, variant->codelets);
+      return state;
+    }
+  }
+  state->plan = make_rfft_plan((size_t)variant->n);
+  if (state->plan == nullptr) {
+    knf_rfft_state_free(state);
+    return nullptr;
+  }
+  return state;
+}
+
+// Returns a state for variant with one more ref, from the cache if possible.
+static struct knf_rfft_state *knf_rfft_state_acquire(
+    const knf_rfft_variant *variant) {
+  knf_rfft_lock_acquire();
+  for (int32_t i = 0; i < KNF_RFFT_CACHE_SIZE; ++i) {
+    struct knf_rfft_state *s = knf_rfft_cache[i];
+    if (s != nullptr && knf_rfft_variant_equal(&s->variant, variant)) {
+      ++s->refs;
+      knf_rfft_lock_release();
+      return s;
+    }
+  }
+  knf_rfft_lock_release();
+
+  // Build outside the lock; another thread may race us to the same variant.
+  struct knf_rfft_state *state = knf_rfft_state_create(variant);
+  if (state == nullptr) return nullptr;
+
+  struct knf_rfft_state *evicted = nullptr;
+  int32_t slot = -1;
+  knf_rfft_lock_acquire();
+  for (int32_t i = 0; i < KNF_RFFT_CACHE_SIZE; ++i) {
+    struct knf_rfft_state *s = knf_rfft_cache[i];
+    if (s != nullptr && knf_rfft_variant_equal(&s->variant, variant)) {
+      ++s->refs;
+      knf_rfft_lock_release();
+      knf_rfft_state_free(state);
+      return s;
+    }
+    if (slot < 0 && (s == nullptr || s->refs == 0)) slot = i;
+  }
+  state->refs = 1;
+  if (slot >= 0) {
+    evicted = knf_rfft_cache[slot];
+    knf_rfft_cache[slot] = state;
+    state->cached = true;
+  }
+  knf_rfft_lock_release();
+  knf_rfft_state_free(evicted);
+  return state;
+}
+
+static void knf_rfft_state_release(struct knf_rfft_state *state) {
+  knf_rfft_lock_acquire();
+  const bool drop = --state->refs == 0 && !state->cached;
+  knf_rfft_lock_release();
+  if (drop) knf_rfft_state_free(state);
+}
+
+void knf_rfft_clear_plan_cache(void) {
+  struct knf_rfft_state *unused[KNF_RFFT_CACHE_SIZE] = {};
+  knf_rfft_lock_acquire();
+  for (int32_t i = 0; i < KNF_RFFT_CACHE_SIZE; ++i) {
+    struct knf_rfft_state *s = knf_rfft_cache[i];
+    if (s == nullptr) continue;
+    if (s->refs == 0) {
+      unused[i] = s;
+    } else {
+      s->cached = false;  // freed by its last knf_rfft_destroy
+    }
+    knf_rfft_cache[i] = nullptr;
+  }
+  knf_rfft_lock_release();
+  for (int32_t i = 0; i < KNF_RFFT_CACHE_SIZE; ++i) {
+    knf_rfft_state_free(unused[i]);
+  }
+}
+
+// Records w, replacing any wisdom for the same transform. Takes the lock;
+// a bigger table is allocated outside it, and the lookup retried if another
+// thread changed the table meanwhile.
+static bool knf_rfft_wisdom_put(const knf_rfft_wisdom *w) {
+  knf_rfft_wisdom *spare = nullptr;
+  int32_t spare_capacity = 0;
+  for (;;) {
+    knf_rfft_wisdom *old = nullptr;
+    bool done = false;
+    knf_rfft_lock_acquire();
+    for (int32_t i = 0; i < knf_rfft_wisdom_count && !done; ++i) {
+      knf_rfft_wisdom *e = &knf_rfft_wisdoms[i];
+      if (e->n == w->n && e->nonzero == w->nonzero &&
+          e->inverse == w->inverse) {
+        *e = *w;
+        done = true;
+      }
+    }
+    if (!done && knf_rfft_wisdom_count == knf_rfft_wisdom_capacity &&
+        spare_capacity > knf_rfft_wisdom_capacity) {
+      if (knf_rfft_wisdom_count > 0) {
+        memcpy(spare, knf_rfft_wisdoms,
+               (size_t)knf_rfft_wisdom_count * sizeof(knf_rfft_wisdom));
+      }
+      old = knf_rfft_wisdoms;
+      knf_rfft_wisdoms = spare;
+      knf_rfft_wisdom_capacity = spare_capacity;
+      spare = nullptr;
+    }
+    if (!done && knf_rfft_wisdom_count < knf_rfft_wisdom_capacity) {
+      knf_rfft_wisdoms[knf_rfft_wisdom_count++] = *w;
+      done = true;
+    }
+    int32_t capacity =
+        knf_rfft_wisdom_capacity > 0 ? 2 * knf_rfft_wisdom_capacity : 8;
+    knf_rfft_lock_release();
+    free(old);
+    if (done) {
+      free(spare);
+      return true;
+    }
+    free(spare);
+    spare = (knf_rfft_wisdom *)malloc((size_t)capacity *
+                                      sizeof(knf_rfft_wisdom));
+    if (spare == nullptr) return false;
+    spare_capacity = capacity;
+  }
+}
+
+static bool knf_rfft_wisdom_get(int32_t n, int32_t nonzero, bool inverse,
+                                knf_rfft_wisdom *out) {
+  bool found = false;
+  knf_rfft_lock_acquire();
+  for (int32_t i = 0; i < knf_rfft_wisdom_count && !found; ++i) {
+    const knf_rfft_wisdom *e = &knf_rfft_wisdoms[i];
+    if (e->n == n && e->nonzero == nonzero && e->inverse == inverse) {
+      *out = *e;
+      found = true;
+    }
+  }
+  knf_rfft_lock_release();
+  return found;
+}
+
+void knf_rfft_forget_wisdom(void) {
+  knf_rfft_lock_acquire();
+  knf_rfft_wisdom *unused = knf_rfft_wisdoms;
+  knf_rfft_wisdoms = nullptr;
+  knf_rfft_wisdom_count = 0;
+  knf_rfft_wisdom_capacity = 0;
+  knf_rfft_lock_release();
+  free(unused);
+}
+
+// Copies the wisdom table into *out, which the caller frees, allocating
+// outside the lock and retrying if the table grew meanwhile.
+static bool knf_rfft_wisdom_snapshot(knf_rfft_wisdom **out, int32_t *count) {
+  knf_rfft_wisdom *copy = nullptr;
+  int32_t room = 0;
+  for (;;) {
+    knf_rfft_lock_acquire();
+    int32_t n = knf_rfft_wisdom_count;
+    if (n <= room) {
+      if (n > 0) memcpy(copy, knf_rfft_wisdoms, (size_t)n * sizeof(*copy));
+      knf_rfft_lock_release();
+      *out = copy;
+      *count = n;
+      return true;
+    }
+    knf_rfft_lock_release();
+    free(copy);
+    copy = (knf_rfft_wisdom *)malloc((size_t)n * sizeof(*copy));
+    if (copy == nullptr) return false;
+    room = n;
+  }
+}
+
+bool knf_rfft_export_wisdom(const char *path) {
+  if (path == nullptr) return false;
+  // The file is written from a snapshot, so that no I/O runs under the lock.
+  knf_rfft_wisdom *wisdoms = nullptr;
+  int32_t count = 0;
+  if (!knf_rfft_wisdom_snapshot(&wisdoms, &count)) return false;
+  FILE *f = fopen(path, "w");
+  if (f == nullptr) {
+    KNF_LOG_ERROR("Cannot open %s for writing", path);
+    free(wisdoms);
+    return false;
+  }
+  bool ok = fprintf(f, "# kaldi-native-fbank FFT wisdom\n"
+                       "# n nonzero inverse isa codelets order\n") > 0;
+  for (int32_t i = 0; i < count && ok; ++i) {
+    const knf_rfft_wisdom *e = &wisdoms[i];
+    ok = fprintf(f, "%d %d %d %d %d %d\n", e->n, e->nonzero, e->inverse ? 1 : 0,
+                 (int)e->isa, e->codelets ? 1 : 0, (int)e->order) > 0;
+  }
+  free(wisdoms);
+  if (fclose(f) != 0) ok = false;
+  return ok;
+}
+
+bool knf_rfft_import_wisdom(const char *path) {
+  if (path == nullptr) return false;
+  FILE *f = fopen(path, "r");
+  if (f == nullptr) {
+    KNF_LOG_ERROR("Cannot open %s for reading", path);
+    return false;
+  }
+  bool ok = true;
+  char line[128];
+  while (ok && fgets(line, sizeof(line), f) != nullptr) {
+    if (line[0] == '#' || line[0] == '\n') continue;
+    int n = 0, nonzero = 0, inverse = 0, isa = 0, codelets = 0, order = 0;
+    if (sscanf(line, "%d %d %d %d %d %d", &n, &nonzero, &inverse, &isa,
+               &codelets, &order) != 6 ||
+        n <= 0 || (n & 1) != 0 || nonzero <= 0 || nonzero > n ||
+        (inverse != 0 && inverse != 1) || isa < KNF_FFT_ISA_SCALAR ||
+        isa > KNF_FFT_ISA_NEON || (codelets != 0 && codelets != 1) ||
+        order < POCKETFFT_ORDER_DEFAULT || order > POCKETFFT_ORDER_TWO_LAST) {
+      KNF_LOG_ERROR("Malformed FFT wisdom in %s: %s", path, line);
+      ok = false;
+      break;
+    }
+    const knf_rfft_wisdom w = {n, nonzero, inverse == 1, (pocketfft_isa)isa,
+                               codelets == 1, (pocketfft_order)order};
+    ok = knf_rfft_wisdom_put(&w);
+  }
+  fclose(f);
+  return ok;
+}
+
+static double knf_rfft_now(void) {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+// Best time of a few rounds of transforms of input, or a negative value if
+// the plan fails. data and scratch are scratch space of the plan's size.
+static double knf_rfft_time(rfftf_plan plan, bool inverse, const float *input,
+                            float *data, float *scratch, int32_t n) {
+  const int32_t reps = 1 + 16384 / n;
+  double best = -1.0;
+  for (int32_t round = 0; round < 5; ++round) {
+    int failed = 0;
+    const double start = knf_rfft_now();
+    for (int32_t r = 0; r < reps; ++r) {
+      memcpy(data, input, (size_t)n * sizeof(float));
+      failed |= inverse ? rfftf_backward(plan, data, 1.0f, scratch)
+                        : rfftf_forward(plan, data, 1.0f, scratch);
+    }
+    const double elapsed = knf_rfft_now() - start;
+    if (failed != 0) return -1.0;
+    if (best < 0.0 || elapsed < best) best = elapsed;
+  }
+  return best;
+}
+
+// Times every instruction set, codelet setting and pass order for the
+// transform and returns the fastest in best.
+static bool knf_rfft_measure(int32_t n, int32_t nonzero, bool inverse,
+                             knf_rfft_wisdom *best) {
+  float *input = (float *)malloc(3 * (size_t)n * sizeof(float));
+  if (input == nullptr) return false;
+  float *data = input + n, *scratch = input + 2 * n;
+  // A fixed LCG keeps the caller's rand() sequence untouched.
+  uint32_t seed = 1;
+  for (int32_t i = 0; i < n; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    input[i] = i < nonzero ? (float)(seed >> 8) / 8388608.0f - 1.0f : 0.0f;
+  }
+
+  const knf_fft_isa isas[] = {KNF_FFT_ISA_SCALAR, KNF_FFT_ISA_SSE2,
+                              KNF_FFT_ISA_AVX2, KNF_FFT_ISA_AVX512,
+                              KNF_FFT_ISA_NEON};
+  const pocketfft_order orders[] = {POCKETFFT_ORDER_DEFAULT,
+                                    POCKETFFT_ORDER_REVERSED,
+                                    POCKETFFT_ORDER_TWO_LAST};
+  double best_time = -1.0;
+  for (size_t i = 0; i < sizeof(isas) / sizeof(isas[0]); ++i) {
+    if (!knf_fft_isa_supported(isas[i])) continue;
+    for (size_t o = 0; o < sizeof(orders) / sizeof(orders[0]); ++o) {
+      for (int c = 1; c >= 0; --c) {
+        rfftf_plan plan = make_rfftf_plan_order(
+            (size_t)n, (size_t)nonzero, (pocketfft_isa)isas[i], orders[o]);
+        if (plan == nullptr) continue;
+        rfftf_set_codelets(plan, c == 1);
+        // Skip variants that fall back to one measured already.
+        const bool duplicate = rfftf_isa(plan) != (pocketfft_isa)isas[i] ||
+                               (c == 1 && !rfftf_codelet(plan));
+        double t = duplicate ? -1.0
+                             : knf_rfft_time(plan, inverse, input, data,
+                                             scratch, n);
+        destroy_rfftf_plan(plan);
+        if (t >= 0.0 && (best_time < 0.0 || t < best_time)) {
+          best_time = t;
+          *best = (knf_rfft_wisdom){n,
+                                    nonzero,
+                                    inverse,
+                                    (pocketfft_isa)isas[i],
+                                    c == 1,
+                                    orders[o]};
+        }
+      }
+    }
+  }
+  free(input);
+  return best_time >= 0.0;
+}
+
+// Fills in the float variant: the wisdom for the transform if there is any,
+// else a fresh measurement in KNF_RFFT_MEASURE mode, else the defaults.
+// Forced instruction sets and disabled codelets bypass the wisdom.
+static void knf_rfft_plan_variant(bool inverse, knf_rfft_variant *variant) {
+  const int cap =
+      atomic_load_explicit(&knf_rfft_isa_cap, memory_order_relaxed);
+  variant->isa =
+      cap == KNF_FFT_ISA_AUTO ? pocketfft_best_isa() : (pocketfft_isa)cap;
+  variant->codelets =
+      atomic_load_explicit(&knf_rfft_codelets, memory_order_relaxed);
+  variant->order = POCKETFFT_ORDER_DEFAULT;
+  if (cap != KNF_FFT_ISA_AUTO || !variant->codelets) return;
+
+  knf_rfft_wisdom w;
+  bool known = knf_rfft_wisdom_get(variant->n, variant->nonzero, inverse, &w) &&
+               knf_fft_isa_supported((knf_fft_isa)w.isa);
+  if (!known &&
+      atomic_load_explicit(&knf_rfft_planning_mode, memory_order_relaxed) ==
+          KNF_RFFT_MEASURE &&
+      knf_rfft_measure(variant->n, variant->nonzero, inverse, &w)) {
+    known = knf_rfft_wisdom_put(&w);
+  }
+  if (known) {
+    variant->isa = w.isa;
+    variant->codelets = w.codelets;
+    variant->order = w.order;
+  }
+}
+
 [[nodiscard]] knf_rfft *knf_rfft_create(int32_t n, bool inverse) {
-  if ((n & 1) != 0 || n <= 0) {
+  return knf_rfft_create_with_precision(n, inverse, KNF_RFFT_FLOAT);
+}
+
+static knf_rfft *knf_rfft_create_impl(int32_t n, bool inverse,
+                                      knf_rfft_precision precision,
+                                      int32_t nonzero) {
+  if ((n & 1) != 0 || n <= 0 || nonzero <= 0 || nonzero > n) {
+    return nullptr;
+  }
+  if (precision != KNF_RFFT_FLOAT && precision != KNF_RFFT_DOUBLE) {
     return nullptr;
   }
 
+  knf_rfft_variant variant = {
+      .n = n,
+      .nonzero = precision == KNF_RFFT_FLOAT ? nonzero : n,
+      .precision = precision,
+      .isa = POCKETFFT_ISA_SCALAR,
+      .codelets = false,
+      .order = POCKETFFT_ORDER_DEFAULT,
+  };
+  if (precision == KNF_RFFT_FLOAT) {
+    knf_rfft_plan_variant(inverse, &variant);
+  }
+
   auto fft = (knf_rfft *)calloc(1, sizeof(knf_rfft));
   if (fft == nullptr) return nullptr;
-
-  auto state =
-      (struct knf_rfft_state *)calloc(1, sizeof(struct knf_rfft_state));
+  struct knf_rfft_state *state = knf_rfft_state_acquire(&variant);
   if (state == nullptr) {
     free(fft);
     return nullptr;
@@ -31,68 +500,304 @@ struct knf_rfft_state {
   fft->inverse = inverse;
   fft->scale = inverse ? 1.0f : 1.0f;
   fft->plan = state;
-  state->plan = make_rfft_plan((size_t)n);
-  state->buffer = (double *)calloc((size_t)n, sizeof(double));
-
-  if (state->plan == nullptr || state->buffer == nullptr) {
-    knf_rfft_destroy(fft);
-    return nullptr;
+  fft->isa = KNF_FFT_ISA_SCALAR;
+  fft->nonzero = nonzero;
+  fft->precision = state->fplan != nullptr ? KNF_RFFT_FLOAT : KNF_RFFT_DOUBLE;
+  if (state->fplan != nullptr) {
+    fft->isa = (knf_fft_isa)rfftf_isa(state->fplan);
+    fft->codelet = rfftf_codelet(state->fplan);
   }
-
   return fft;
 }
 
+[[nodiscard]] knf_rfft *knf_rfft_create_with_precision(
+    int32_t n, bool inverse, knf_rfft_precision precision) {
+  return knf_rfft_create_impl(n, inverse, precision, n);
+}
+
+[[nodiscard]] knf_rfft *knf_rfft_create_pruned(int32_t n, int32_t nonzero) {
+  return knf_rfft_create_impl(n, false, KNF_RFFT_FLOAT, nonzero);
+}
+
 void knf_rfft_destroy(knf_rfft *fft) {
   if (!fft) return;
-  struct knf_rfft_state *state = (struct knf_rfft_state *)fft->plan;
-  if (state) {
-    if (state->plan) destroy_rfft_plan(state->plan);
-    free(state->buffer);
-    free(state);
-  }
+  if (fft->plan) knf_rfft_state_release((struct knf_rfft_state *)fft->plan);
   free(fft);
 }
 
-[[nodiscard]] bool knf_rfft_compute(knf_rfft *fft, float *in_out) {
-  if (fft == nullptr || in_out == nullptr || fft->plan == nullptr ||
-      fft->n <= 0) {
+// pocketfft stores the spectrum as [r0, r1, i1, ..., r(n/2)]; Kaldi moves the
+// Nyquist term next to DC. Both helpers shift the payload by one slot.
+static void knf_rfft_pocketfft_to_kaldi(float *data, int32_t n) {
+  float nyquist = data[n - 1];
+  memmove(data + 2, data + 1, sizeof(float) * (size_t)(n - 2));
+  data[1] = nyquist;
+}
+
+static void knf_rfft_kaldi_to_pocketfft(float *data, int32_t n) {
+  float nyquist = data[1];
+  memmove(data + 1, data + 2, sizeof(float) * (size_t)(n - 2));
+  data[n - 1] = nyquist;
+}
+
+size_t knf_rfft_scratch_size(const knf_rfft *fft) {
+  if (fft == nullptr || fft->plan == nullptr) return 0;
+  const struct knf_rfft_state *state = (const struct knf_rfft_state *)fft->plan;
+  if (fft->precision == KNF_RFFT_FLOAT) {
+    return rfftf_scratch_size(state->fplan) * sizeof(float);
+  }
+  return (size_t)fft->n * sizeof(double);
+}
+
+size_t knf_rfft_batch_scratch_size(const knf_rfft *fft) {
+  if (fft == nullptr || fft->plan == nullptr) return 0;
+  const struct knf_rfft_state *state = (const struct knf_rfft_state *)fft->plan;
+  if (fft->precision == KNF_RFFT_FLOAT) {
+    return rfftf_batch_scratch_size(state->fplan) * sizeof(float);
+  }
+  return knf_rfft_scratch_size(fft);
+}
+
+// Copies forward input into the double buffer, zeroing the pruned tail.
+static void knf_rfft_widen(const knf_rfft *fft, double *buffer,
+                           const float *in) {
+  int32_t i = 0;
+  for (; i < fft->nonzero; ++i) buffer[i] = (double)in[i];
+  for (; i < fft->n; ++i) buffer[i] = 0.0;
+}
+
+static bool knf_rfft_compute_float(const knf_rfft *fft,
+                                   const struct knf_rfft_state *state,
+                                   float *in_out, float *scratch) {
+  if (state->fplan == nullptr) {
     return false;
   }
+  if (!fft->inverse) {
+    const int status = rfftf_forward(state->fplan, in_out, 1.0f, scratch);
+    if (status != 0) {
+      KNF_LOG_ERROR("rfftf_forward failed with status %d", status);
+      return false;
+    }
+    knf_rfft_pocketfft_to_kaldi(in_out, fft->n);
+  } else {
+    knf_rfft_kaldi_to_pocketfft(in_out, fft->n);
+    const int status = rfftf_backward(state->fplan, in_out, 1.0f, scratch);
+    if (status != 0) {
+      KNF_LOG_ERROR("rfftf_backward failed with status %d", status);
+      return false;
+    }
+  }
+  return true;
+}
 
-  struct knf_rfft_state *state = (struct knf_rfft_state *)fft->plan;
-  if (state->plan == nullptr || state->buffer == nullptr) {
+// buffer holds n doubles.
+static bool knf_rfft_compute_double(const knf_rfft *fft,
+                                    const struct knf_rfft_state *state,
+                                    float *in_out, double *buffer) {
+  if (state->plan == nullptr) {
     return false;
   }
+  int32_t n = fft->n;
   if (!fft->inverse) {
-    for (int32_t i = 0; i < fft->n; ++i) state->buffer[i] = (double)in_out[i];
-    const int status = rfft_forward(state->plan, state->buffer, 1.0);
+    knf_rfft_widen(fft, buffer, in_out);
+    const int status = rfft_forward(state->plan, buffer, 1.0);
     if (status != 0) {
       KNF_LOG_ERROR("rfft_forward failed with status %d", status);
       return false;
     }
 
-    in_out[0] = (float)state->buffer[0];
-    in_out[1] = (float)state->buffer[1];
-    for (int32_t i = 1; i < fft->n / 2; ++i) {
-      in_out[2 * i] = (float)state->buffer[2 * i];
-      in_out[2 * i + 1] = (float)state->buffer[2 * i + 1];
+    in_out[0] = (float)buffer[0];
+    in_out[1] = (float)buffer[n - 1];
+    for (int32_t i = 1; i < n / 2; ++i) {
+      in_out[2 * i] = (float)buffer[2 * i - 1];
+      in_out[2 * i + 1] = (float)buffer[2 * i];
     }
   } else {
-    state->buffer[0] = (double)in_out[0];
-    state->buffer[1] = (double)in_out[1];
+    buffer[0] = (double)in_out[0];
+    buffer[n - 1] = (double)in_out[1];
 
-    for (int32_t i = 1; i < fft->n / 2; ++i) {
-      state->buffer[2 * i] = (double)in_out[2 * i];
-      state->buffer[2 * i + 1] = (double)in_out[2 * i + 1];
+    for (int32_t i = 1; i < n / 2; ++i) {
+      buffer[2 * i - 1] = (double)in_out[2 * i];
+      buffer[2 * i] = (double)in_out[2 * i + 1];
     }
 
-    const int status = rfft_backward(state->plan, state->buffer, 1.0);
+    const int status = rfft_backward(state->plan, buffer, 1.0);
     if (status != 0) {
       KNF_LOG_ERROR("rfft_backward failed with status %d", status);
       return false;
     }
 
-    for (int32_t i = 0; i < fft->n; ++i) in_out[i] = (float)state->buffer[i];
+    for (int32_t i = 0; i < n; ++i) in_out[i] = (float)buffer[i];
+  }
+  return true;
+}
+
+// The double path needs its buffer up front; the float engine allocates its
+// own scratch when given none.
+static double *knf_rfft_double_scratch(const knf_rfft *fft, void *scratch,
+                                       double **owned) {
+  *owned = nullptr;
+  if (scratch != nullptr) return (double *)scratch;
+  *owned = (double *)calloc((size_t)fft->n, sizeof(double));
+  return *owned;
+}
+
+[[nodiscard]] bool knf_rfft_compute(const knf_rfft *fft, float *in_out) {
+  return knf_rfft_compute_with_scratch(fft, in_out, nullptr);
+}
+
+[[nodiscard]] bool knf_rfft_compute_with_scratch(const knf_rfft *fft,
+                                                 float *in_out, void *scratch) {
+  if (fft == nullptr || in_out == nullptr || fft->plan == nullptr ||
+      fft->n <= 0) {
+    return false;
+  }
+
+  const struct knf_rfft_state *state = (const struct knf_rfft_state *)fft->plan;
+  if (fft->precision == KNF_RFFT_FLOAT) {
+    return knf_rfft_compute_float(fft, state, in_out, (float *)scratch);
+  }
+  double *owned = nullptr;
+  double *buffer = knf_rfft_double_scratch(fft, scratch, &owned);
+  const bool ok =
+      buffer != nullptr && knf_rfft_compute_double(fft, state, in_out, buffer);
+  free(owned);
+  return ok;
+}
+
+[[nodiscard]] bool knf_rfft_compute_power(const knf_rfft *fft, float *in_out,
+                                          bool magnitude) {
+  if (fft == nullptr) {
+    return false;
+  }
+  return knf_rfft_compute_power_range_with_scratch(fft, in_out, magnitude, 0,
+                                                   fft->n / 2 + 1, nullptr);
+}
+
+[[nodiscard]] bool knf_rfft_compute_power_range(const knf_rfft *fft,
+                                                float *in_out, bool magnitude,
+                                                int32_t begin, int32_t end) {
+  return knf_rfft_compute_power_range_with_scratch(fft, in_out, magnitude,
+                                                   begin, end, nullptr);
+}
+
+// Power spectrum of the double transform, from the halfcomplex buffer.
+static bool knf_rfft_power_double(const knf_rfft *fft,
+                                  const struct knf_rfft_state *state,
+                                  float *in_out, bool magnitude, int32_t begin,
+                                  int32_t end, double *buffer) {
+  if (state->plan == nullptr) {
+    return false;
+  }
+  int32_t n = fft->n;
+  knf_rfft_widen(fft, buffer, in_out);
+  const int status = rfft_forward(state->plan, buffer, 1.0);
+  if (status != 0) {
+    KNF_LOG_ERROR("rfft_forward failed with status %d", status);
+    return false;
+  }
+  const double *hc = buffer;
+  for (int32_t i = begin; i < end; ++i) {
+    double p = 0.0;
+    if (i == 0) {
+      p = hc[0] * hc[0];
+    } else if (i == n / 2) {
+      p = hc[n - 1] * hc[n - 1];
+    } else {
+      p = hc[2 * i - 1] * hc[2 * i - 1] + hc[2 * i] * hc[2 * i];
+    }
+    in_out[i] = magnitude ? sqrtf((float)p) : (float)p;
+  }
+  return true;
+}
+
+[[nodiscard]] bool knf_rfft_compute_power_range_with_scratch(
+    const knf_rfft *fft, float *in_out, bool magnitude, int32_t begin,
+    int32_t end, void *scratch) {
+  if (fft == nullptr || in_out == nullptr || fft->plan == nullptr ||
+      fft->n <= 0 || fft->inverse || begin < 0 || begin >= end ||
+      end > fft->n / 2 + 1) {
+    return false;
+  }
+
+  const struct knf_rfft_state *state = (const struct knf_rfft_state *)fft->plan;
+  if (fft->precision == KNF_RFFT_FLOAT) {
+    if (state->fplan == nullptr) {
+      return false;
+    }
+    const int status =
+        rfftf_forward_power_range(state->fplan, in_out, 1.0f, magnitude,
+                                  (size_t)begin, (size_t)end, (float *)scratch);
+    if (status != 0) {
+      KNF_LOG_ERROR("rfftf_forward_power_range failed with status %d",
+                    status);
+      return false;
+    }
+    return true;
+  }
+
+  double *owned = nullptr;
+  double *buffer = knf_rfft_double_scratch(fft, scratch, &owned);
+  const bool ok = buffer != nullptr &&
+                  knf_rfft_power_double(fft, state, in_out, magnitude, begin,
+                                        end, buffer);
+  free(owned);
+  return ok;
+}
+
+[[nodiscard]] bool knf_rfft_compute_batch(const knf_rfft *fft, float *frames,
+                                          int32_t count, int32_t stride) {
+  return knf_rfft_compute_batch_with_scratch(fft, frames, count, stride,
+                                             nullptr);
+}
+
+[[nodiscard]] bool knf_rfft_compute_batch_with_scratch(const knf_rfft *fft,
+                                                       float *frames,
+                                                       int32_t count,
+                                                       int32_t stride,
+                                                       void *scratch) {
+  if (fft == nullptr || frames == nullptr || fft->plan == nullptr ||
+      fft->n <= 0 || count < 0 || stride < fft->n) {
+    return false;
+  }
+
+  const struct knf_rfft_state *state = (const struct knf_rfft_state *)fft->plan;
+  if (fft->precision != KNF_RFFT_FLOAT) {
+    double *owned = nullptr;
+    double *buffer = knf_rfft_double_scratch(fft, scratch, &owned);
+    bool ok = buffer != nullptr;
+    for (int32_t i = 0; i < count && ok; ++i) {
+      ok = knf_rfft_compute_double(fft, state, frames + (size_t)i * stride,
+                                   buffer);
+    }
+    free(owned);
+    return ok;
+  }
+  if (state->fplan == nullptr) {
+    return false;
+  }
+
+  if (!fft->inverse) {
+    const int status = rfftf_forward_batch(state->fplan, frames, (size_t)count,
+                                           (size_t)stride, 1.0f,
+                                           (float *)scratch);
+    if (status != 0) {
+      KNF_LOG_ERROR("rfftf_forward_batch failed with status %d", status);
+      return false;
+    }
+    for (int32_t i = 0; i < count; ++i) {
+      knf_rfft_pocketfft_to_kaldi(frames + (size_t)i * stride, fft->n);
+    }
+  } else {
+    for (int32_t i = 0; i < count; ++i) {
+      knf_rfft_kaldi_to_pocketfft(frames + (size_t)i * stride, fft->n);
+    }
+    const int status = rfftf_backward_batch(state->fplan, frames, (size_t)count,
+                                            (size_t)stride, 1.0f,
+                                            (float *)scratch);
+    if (status != 0) {
+      KNF_LOG_ERROR("rfftf_backward_batch failed with status %d", status);
+      return false;
+    }
   }
   return true;
 }
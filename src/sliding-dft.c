@@ -0,0 +1,326 @@
+// Sliding-DFT spectrum engine in C23.
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "kaldi-native-fbank/kaldi-math.h"
+#include "kaldi-native-fbank/log.h"
+#include "kaldi-native-fbank/sliding-dft.h"
+
+// Samples slid before the state is recomputed with FFTs. The recursion runs
+// in double, so this only bounds drift that is far below float resolution.
+constexpr int32_t KNF_SLIDING_DFT_ANCHOR = 4096;
+// Time of one tracker update in units of n log2 n for the float FFT, fitted on
+// x86-64 with AVX-512 so that it also covers the per-frame overhead. Only the
+// default of KNF_SPECTRUM_AUTO; other targets may want spectrum_engine set.
+constexpr double KNF_SLIDING_DFT_UPDATE_COST = 3.0;
+
+static bool knf_sliding_type_is(const knf_frame_opts *opts, const char *name) {
+  return strncmp(opts->window_type, name, sizeof(opts->window_type)) == 0;
+}
+
+// Cosine coefficients and period of the window, or 0 terms if it is not a
+// sum of cosines.
+static int32_t knf_sliding_window_terms(const knf_frame_opts *opts,
+                                        double coeffs[3], double *period) {
+  int32_t size = knf_window_size(opts);
+  if (size < 2) {
+    return 0;
+  }
+  *period = size - 1;
+  coeffs[1] = 0.0;
+  coeffs[2] = 0.0;
+  if (knf_sliding_type_is(opts, "rectangular")) {
+    coeffs[0] = 1.0;
+    return 1;
+  }
+  if (knf_sliding_type_is(opts, "hanning")) {
+    coeffs[0] = 0.5;
+    coeffs[1] = -0.5;
+    return 2;
+  }
+  if (knf_sliding_type_is(opts, "hann")) {
+    *period = size;
+    coeffs[0] = 0.5;
+    coeffs[1] = -0.5;
+    return 2;
+  }
+  if (knf_sliding_type_is(opts, "hamming")) {
+    coeffs[0] = 0.54;
+    coeffs[1] = -0.46;
+    return 2;
+  }
+  if (knf_sliding_type_is(opts, "blackman")) {
+    coeffs[0] = opts->blackman_coeff;
+    coeffs[1] = -0.5;
+    coeffs[2] = 0.5 - opts->blackman_coeff;
+    return 3;
+  }
+  return 0;
+}
+
+bool knf_sliding_dft_supported(const knf_frame_opts *opts) {
+  if (opts == nullptr || opts->dither != 0.0f || opts->preemph_coeff != 0.0f ||
+      knf_window_shift(opts) <= 0) {
+    return false;
+  }
+  double coeffs[3];
+  double period = 0.0;
+  return knf_sliding_window_terms(opts, coeffs, &period) > 0;
+}
+
+bool knf_sliding_dft_cheaper(const knf_frame_opts *opts, int32_t bin_begin,
+                             int32_t bin_end) {
+  if (!knf_sliding_dft_supported(opts) || bin_begin < 0 ||
+      bin_end <= bin_begin) {
+    return false;
+  }
+  double coeffs[3];
+  double period = 0.0;
+  int32_t terms = knf_sliding_window_terms(opts, coeffs, &period);
+  int32_t shift = knf_window_shift(opts);
+  int32_t size = knf_window_size(opts);
+  int32_t padded = knf_padded_window_size(opts);
+  if (shift >= size) {
+    return false;
+  }
+  double trackers = (double)(2 * terms - 1) * (bin_end - bin_begin);
+  // One update per slid sample, plus about one to combine the trackers and
+  // copy the frame.
+  double sliding = KNF_SLIDING_DFT_UPDATE_COST * (shift + 1) * trackers;
+  double fft = padded * log2((double)padded);
+  return sliding < fft;
+}
+
+void knf_sliding_dft_destroy(knf_sliding_dft *s) {
+  if (s == nullptr) return;
+  free(s->re);
+  free(s->im);
+  free(s->step_re);
+  free(s->step_im);
+  free(s->tail_re);
+  free(s->tail_im);
+  free(s->window_re);
+  free(s->window_im);
+  free(s->frame);
+  free(s->buffer);
+  knf_rfft_destroy(s->fft);
+  memset(s, 0, sizeof(*s));
+}
+
+void knf_sliding_dft_reset(knf_sliding_dft *s) {
+  if (s == nullptr) return;
+  s->frame_start = -1;
+  s->slid = 0;
+}
+
+// Bin k of a packed forward transform.
+static void knf_sliding_packed_bin(const float *packed, int32_t n, int32_t k,
+                                   double *re, double *im) {
+  if (k == 0) {
+    *re = packed[0];
+    *im = 0.0;
+  } else if (2 * k == n) {
+    *re = packed[1];
+    *im = 0.0;
+  } else {
+    *re = packed[2 * k];
+    *im = packed[2 * k + 1];
+  }
+}
+
+[[nodiscard]] bool knf_sliding_dft_create(const knf_frame_opts *opts,
+                                          int32_t bin_begin, int32_t bin_end,
+                                          bool magnitude,
+                                          knf_sliding_dft *out) {
+  if (out == nullptr) {
+    return false;
+  }
+  memset(out, 0, sizeof(*out));
+  if (!knf_sliding_dft_supported(opts)) {
+    return false;
+  }
+  int32_t padded = knf_padded_window_size(opts);
+  if (bin_begin < 0 || bin_end <= bin_begin || bin_end > padded / 2 + 1) {
+    return false;
+  }
+  out->size = knf_window_size(opts);
+  out->padded = padded;
+  out->shift = knf_window_shift(opts);
+  out->bin_begin = bin_begin;
+  out->bin_end = bin_end;
+  out->num_terms = knf_sliding_window_terms(opts, out->coeffs, &out->period);
+  out->remove_dc_offset = opts->remove_dc_offset;
+  out->magnitude = magnitude;
+  out->frame_start = -1;
+
+  size_t bins = (size_t)(bin_end - bin_begin);
+  size_t trackers = (size_t)(2 * out->num_terms - 1) * bins;
+  out->re = (double *)calloc(trackers, sizeof(double));
+  out->im = (double *)calloc(trackers, sizeof(double));
+  out->step_re = (double *)calloc(trackers, sizeof(double));
+  out->step_im = (double *)calloc(trackers, sizeof(double));
+  out->tail_re = (double *)calloc(trackers, sizeof(double));
+  out->tail_im = (double *)calloc(trackers, sizeof(double));
+  out->window_re = (double *)calloc(bins, sizeof(double));
+  out->window_im = (double *)calloc(bins, sizeof(double));
+  out->frame = (float *)calloc((size_t)out->size, sizeof(float));
+  out->buffer = (float *)calloc((size_t)padded, sizeof(float));
+  out->fft = knf_rfft_create_with_precision(padded, false, KNF_RFFT_DOUBLE);
+  if (out->re == nullptr || out->im == nullptr || out->step_re == nullptr ||
+      out->step_im == nullptr || out->tail_re == nullptr ||
+      out->tail_im == nullptr || out->window_re == nullptr ||
+      out->window_im == nullptr || out->frame == nullptr ||
+      out->buffer == nullptr || out->fft == nullptr) {
+    knf_sliding_dft_destroy(out);
+    return false;
+  }
+
+  // Tracker t runs at bin k shifted by +-((t + 1) / 2) / period, plus first.
+  for (int32_t t = 0; t < 2 * out->num_terms - 1; ++t) {
+    double offset = ((t + 1) / 2) / out->period * (t % 2 == 1 ? 1.0 : -1.0);
+    for (size_t b = 0; b < bins; ++b) {
+      double f = (double)(bin_begin + (int32_t)b) / padded + offset;
+      size_t i = (size_t)t * bins + b;
+      out->step_re[i] = cos(2.0 * KNF_PI * f);
+      out->step_im[i] = sin(2.0 * KNF_PI * f);
+      out->tail_re[i] = cos(2.0 * KNF_PI * f * out->size);
+      out->tail_im[i] = -sin(2.0 * KNF_PI * f * out->size);
+    }
+  }
+
+  if (out->remove_dc_offset) {
+    knf_window window;
+    if (!knf_make_window_from_opts(opts, &window)) {
+      knf_sliding_dft_destroy(out);
+      return false;
+    }
+    memcpy(out->buffer, window.data, sizeof(float) * (size_t)out->size);
+    knf_free_window(&window);
+    if (!knf_rfft_compute(out->fft, out->buffer)) {
+      knf_sliding_dft_destroy(out);
+      return false;
+    }
+    for (size_t b = 0; b < bins; ++b) {
+      knf_sliding_packed_bin(out->buffer, padded, bin_begin + (int32_t)b,
+                             &out->window_re[b], &out->window_im[b]);
+    }
+  }
+  return true;
+}
+
+// Recomputes every tracker from the frame with 2 * num_terms - 1 FFTs: the
+// frame times cos and sin of each window harmonic, A and B, give the DFT at
+// k + m and k - m as A - iB and A + iB.
+static bool knf_sliding_dft_anchor(knf_sliding_dft *s, const float *frame) {
+  size_t bins = (size_t)(s->bin_end - s->bin_begin);
+  double sum = 0.0;
+  for (int32_t t = 0; t < s->size; ++t) sum += frame[t];
+  s->sum = sum;
+
+  memset(s->buffer, 0, sizeof(float) * (size_t)s->padded);
+  memcpy(s->buffer, frame, sizeof(float) * (size_t)s->size);
+  if (!knf_rfft_compute(s->fft, s->buffer)) {
+    return false;
+  }
+  for (size_t b = 0; b < bins; ++b) {
+    knf_sliding_packed_bin(s->buffer, s->padded, s->bin_begin + (int32_t)b,
+                           &s->re[b], &s->im[b]);
+  }
+  for (int32_t m = 1; m < s->num_terms; ++m) {
+    double w = 2.0 * KNF_PI * m / s->period;
+    for (int32_t part = 0; part < 2; ++part) {
+      memset(s->buffer, 0, sizeof(float) * (size_t)s->padded);
+      for (int32_t t = 0; t < s->size; ++t) {
+        double harmonic = part == 0 ? cos(w * t) : sin(w * t);
+        s->buffer[t] = (float)(frame[t] * harmonic);
+      }
+      if (!knf_rfft_compute(s->fft, s->buffer)) {
+        return false;
+      }
+      double *plus_re = s->re + (size_t)(2 * m - 1) * bins;
+      double *plus_im = s->im + (size_t)(2 * m - 1) * bins;
+      double *minus_re = s->re + (size_t)(2 * m) * bins;
+      double *minus_im = s->im + (size_t)(2 * m) * bins;
+      for (size_t b = 0; b < bins; ++b) {
+        double re = 0.0;
+        double im = 0.0;
+        knf_sliding_packed_bin(s->buffer, s->padded, s->bin_begin + (int32_t)b,
+                               &re, &im);
+        if (part == 0) {
+          plus_re[b] = minus_re[b] = re;
+          plus_im[b] = minus_im[b] = im;
+        } else {
+          plus_re[b] += im;
+          plus_im[b] -= re;
+          minus_re[b] -= im;
+          minus_im[b] += re;
+        }
+      }
+    }
+  }
+  s->slid = 0;
+  return true;
+}
+
+// Moves every tracker one sample on: drop x_out, append x_in.
+static void knf_sliding_dft_step(knf_sliding_dft *s, size_t trackers,
+                                 double x_out, double x_in) {
+  double *restrict re = s->re;
+  double *restrict im = s->im;
+  const double *restrict step_re = s->step_re;
+  const double *restrict step_im = s->step_im;
+  const double *restrict tail_re = s->tail_re;
+  const double *restrict tail_im = s->tail_im;
+  for (size_t i = 0; i < trackers; ++i) {
+    double r = re[i] - x_out + x_in * tail_re[i];
+    double j = im[i] + x_in * tail_im[i];
+    re[i] = r * step_re[i] - j * step_im[i];
+    im[i] = r * step_im[i] + j * step_re[i];
+  }
+  s->sum += x_in - x_out;
+}
+
+[[nodiscard]] bool knf_sliding_dft_compute(knf_sliding_dft *s,
+                                           int64_t frame_start,
+                                           const float *frame,
+                                           float *spectrum) {
+  if (s == nullptr || s->re == nullptr || frame == nullptr ||
+      spectrum == nullptr) {
+    return false;
+  }
+  size_t bins = (size_t)(s->bin_end - s->bin_begin);
+  size_t trackers = (size_t)(2 * s->num_terms - 1) * bins;
+  bool consecutive = s->frame_start >= 0 && s->shift < s->size &&
+                     frame_start == s->frame_start + s->shift;
+  if (consecutive && s->slid + s->shift <= KNF_SLIDING_DFT_ANCHOR) {
+    for (int32_t j = 0; j < s->shift; ++j) {
+      knf_sliding_dft_step(s, trackers, s->frame[j],
+                           frame[s->size - s->shift + j]);
+    }
+    s->slid += s->shift;
+  } else if (!knf_sliding_dft_anchor(s, frame)) {
+    KNF_LOG_ERROR("sliding DFT anchoring failed");
+    knf_sliding_dft_reset(s);
+    return false;
+  }
+  memcpy(s->frame, frame, sizeof(float) * (size_t)s->size);
+  s->frame_start = frame_start;
+
+  double mean = s->remove_dc_offset ? s->sum / s->size : 0.0;
+  for (size_t b = 0; b < bins; ++b) {
+    double re = s->coeffs[0] * s->re[b] - mean * s->window_re[b];
+    double im = s->coeffs[0] * s->im[b] - mean * s->window_im[b];
+    for (int32_t m = 1; m < s->num_terms; ++m) {
+      size_t plus = (size_t)(2 * m - 1) * bins + b;
+      size_t minus = (size_t)(2 * m) * bins + b;
+      re += 0.5 * s->coeffs[m] * (s->re[plus] + s->re[minus]);
+      im += 0.5 * s->coeffs[m] * (s->im[plus] + s->im[minus]);
+    }
+    double p = re * re + im * im;
+    spectrum[s->bin_begin + (int32_t)b] =
+        s->magnitude ? (float)sqrt(p) : (float)p;
+  }
+  return true;
+}
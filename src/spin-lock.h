@@ -0,0 +1,54 @@
+// Lock for the process-wide caches (FFT plans and wisdom, warped mel banks).
+// Critical sections are a few loads and stores, so a waiter spins on a plain
+// load with a pause hint and exponential backoff. Past the backoff bound it
+// yields its time slice, so that a holder that was preempted gets the CPU
+// back instead of the waiters burning it.
+#pragma once
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sched.h>
+#endif
+
+typedef atomic_bool knf_spin_lock;
+
+// Pause hints per round at most; rounds after that yield instead.
+constexpr int32_t KNF_SPIN_LOCK_MAX_BACKOFF = 64;
+
+static inline void knf_spin_lock_pause(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  __asm__ volatile("yield");
+#endif
+}
+
+static inline void knf_spin_lock_yield(void) {
+#if defined(_WIN32)
+  SwitchToThread();
+#else
+  sched_yield();
+#endif
+}
+
+static inline void knf_spin_lock_acquire(knf_spin_lock *lock) {
+  int32_t backoff = 1;
+  while (atomic_exchange_explicit(lock, true, memory_order_acquire)) {
+    while (atomic_load_explicit(lock, memory_order_relaxed)) {
+      if (backoff <= KNF_SPIN_LOCK_MAX_BACKOFF) {
+        for (int32_t i = 0; i < backoff; ++i) knf_spin_lock_pause();
+        backoff *= 2;
+      } else {
+        knf_spin_lock_yield();
+      }
+    }
+  }
+}
+
+static inline void knf_spin_lock_release(knf_spin_lock *lock) {
+  atomic_store_explicit(lock, false, memory_order_release);
+}
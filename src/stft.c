@@ -9,6 +9,9 @@
 #include "kaldi-native-fbank/rfft.h"
 #include "kaldi-native-fbank/stft.h"
 
+// Frames handed to knf_rfft_compute_batch at a time.
+constexpr int32_t KNF_STFT_BATCH = 16;
+
 static bool knf_fixed_cstr_eq(const char *text, size_t text_cap,
                               const char *literal) {
   if (text == nullptr || literal == nullptr || text_cap == 0) {
@@ -41,19 +44,16 @@ void knf_stft_config_default(knf_stft_config *cfg) {
   memcpy(cfg->window_type, "povey", sizeof("povey"));
 }
 
-static void knf_pad_reflect(const float *data, int32_t n, int32_t pad,
-                            float *out) {
-  if (n <= 0) {
-    memset(out, 0, sizeof(float) * (size_t)(2 * pad));
-    return;
-  }
+// The pad helpers fill the edges of out around the n samples already
+// converted into out + pad.
+static void knf_pad_reflect(int32_t n, int32_t pad, float *out) {
+  const float *data = out + pad;
   // left pad
   for (int32_t i = 0; i < pad; ++i) {
     int32_t src = pad - i;
     if (src >= n) src = n - 1;
     out[i] = data[src];
   }
-  memcpy(out + pad, data, sizeof(float) * n);
   for (int32_t i = 0; i < pad; ++i) {
     int32_t src = n - 2 - i;
     if (src < 0) src = 0;
@@ -61,39 +61,41 @@ static void knf_pad_reflect(const float *data, int32_t n, int32_t pad,
   }
 }
 
-static void knf_pad_replicate(const float *data, int32_t n, int32_t pad,
-                              float *out) {
-  if (n <= 0) {
-    memset(out, 0, sizeof(float) * (size_t)(2 * pad));
-    return;
-  }
+static void knf_pad_replicate(int32_t n, int32_t pad, float *out) {
+  const float *data = out + pad;
   for (int32_t i = 0; i < pad; ++i) out[i] = data[0];
-  memcpy(out + pad, data, sizeof(float) * n);
   for (int32_t i = 0; i < pad; ++i) out[pad + n + i] = data[n - 1];
 }
 
-static void knf_pad_constant(const float *data, int32_t n, int32_t pad,
-                             float *out) {
-  memset(out, 0, sizeof(float) * (size_t)(n + 2 * pad));
-  memcpy(out + pad, data, sizeof(float) * n);
+static void knf_pad_constant(int32_t n, int32_t pad, float *out) {
+  memset(out, 0, sizeof(float) * (size_t)pad);
+  memset(out + pad + n, 0, sizeof(float) * (size_t)pad);
 }
 
 [[nodiscard]] bool knf_stft_compute(const knf_stft_config *cfg,
                                     const float *data, int32_t n,
                                     knf_stft_result *out) {
+  return knf_stft_compute_typed(cfg, data, KNF_SAMPLE_FLOAT32, n, out);
+}
+
+[[nodiscard]] bool knf_stft_compute_typed(const knf_stft_config *cfg,
+                                          const void *samples,
+                                          knf_sample_format format, int32_t n,
+                                          knf_stft_result *out) {
   if (out == nullptr) {
     return false;
   }
   memset(out, 0, sizeof(*out));
 
   bool ok = false;
-  knf_window window = {nullptr, 0};
+  knf_window window = {};
   bool owns_window = false;
   knf_rfft *fft = nullptr;
   float *padded = nullptr;
   float *frame = nullptr;
+  void *scratch = nullptr;
 
-  if (cfg == nullptr || data == nullptr || n <= 0 || cfg->n_fft <= 0 ||
+  if (cfg == nullptr || samples == nullptr || n <= 0 || cfg->n_fft <= 0 ||
       cfg->hop_length <= 0 || cfg->win_length <= 0 ||
       cfg->win_length > cfg->n_fft || (cfg->n_fft & 1) != 0) {
     goto cleanup;
@@ -126,20 +128,20 @@ static void knf_pad_constant(const float *data, int32_t n, int32_t pad,
     goto cleanup;
   }
 
+  // The samples are converted once, straight into the padded signal.
+  knf_convert_samples(samples, format, 0, n, padded + pad);
   if (cfg->center) {
     if (knf_fixed_cstr_eq(cfg->pad_mode, sizeof(cfg->pad_mode), "reflect")) {
-      knf_pad_reflect(data, n, pad, padded);
+      knf_pad_reflect(n, pad, padded);
     } else if (knf_fixed_cstr_eq(cfg->pad_mode, sizeof(cfg->pad_mode),
                                  "replicate")) {
-      knf_pad_replicate(data, n, pad, padded);
+      knf_pad_replicate(n, pad, padded);
     } else {
-      knf_pad_constant(data, n, pad, padded);
+      knf_pad_constant(n, pad, padded);
     }
-    data = padded;
     n = padded_len;
-  } else {
-    memcpy(padded, data, sizeof(float) * n);
   }
+  const float *data = padded;
 
   auto num_frames = (int64_t)1 + ((int64_t)n - cfg->n_fft) / cfg->hop_length;
   if (num_frames <= 0 || num_frames > INT32_MAX) {
@@ -165,25 +167,39 @@ static void knf_pad_constant(const float *data, int32_t n, int32_t pad,
     goto cleanup;
   }
 
-  frame = (float *)calloc((size_t)cfg->n_fft, sizeof(float));
-  if (frame == nullptr) {
+  frame = (float *)calloc((size_t)KNF_STFT_BATCH * (size_t)cfg->n_fft,
+                         sizeof(float));
+  // One scratch buffer serves every batch of this call.
+  scratch = malloc(knf_rfft_batch_scratch_size(fft));
+  if (frame == nullptr || scratch == nullptr) {
     goto cleanup;
   }
-  for (int32_t i = 0; i < out->num_frames; ++i) {
-    memcpy(frame, data + i * cfg->hop_length, sizeof(float) * cfg->n_fft);
-    if (window.size > 0) {
-      knf_apply_window(&window, frame);
+  for (int32_t i0 = 0; i0 < out->num_frames; i0 += KNF_STFT_BATCH) {
+    auto count = out->num_frames - i0 < KNF_STFT_BATCH ? out->num_frames - i0
+                                                       : KNF_STFT_BATCH;
+    for (int32_t b = 0; b < count; ++b) {
+      float *f = frame + (size_t)b * cfg->n_fft;
+      memcpy(f, data + (i0 + b) * cfg->hop_length,
+             sizeof(float) * cfg->n_fft);
+      if (window.size > 0) {
+        knf_apply_window(&window, f);
+      }
     }
-    if (!knf_rfft_compute(fft, frame)) {
+    if (!knf_rfft_compute_batch_with_scratch(fft, frame, count, cfg->n_fft,
+                                             scratch)) {
       goto cleanup;
     }
-    for (int32_t k = 0; k < cfg->n_fft / 2; ++k) {
-      if (k == 0) {
-        out->real[i * bins] = frame[0];
-        out->real[i * bins + cfg->n_fft / 2] = frame[1];
-      } else {
-        out->real[i * bins + k] = frame[2 * k];
-        out->imag[i * bins + k] = frame[2 * k + 1];
+    for (int32_t b = 0; b < count; ++b) {
+      const float *f = frame + (size_t)b * cfg->n_fft;
+      auto i = i0 + b;
+      for (int32_t k = 0; k < cfg->n_fft / 2; ++k) {
+        if (k == 0) {
+          out->real[i * bins] = f[0];
+          out->real[i * bins + cfg->n_fft / 2] = f[1];
+        } else {
+          out->real[i * bins + k] = f[2 * k];
+          out->imag[i * bins + k] = f[2 * k + 1];
+        }
       }
     }
   }
@@ -200,6 +216,7 @@ static void knf_pad_constant(const float *data, int32_t n, int32_t pad,
 
 cleanup:
   free(frame);
+  free(scratch);
   free(padded);
   knf_rfft_destroy(fft);
   if (owns_window) {
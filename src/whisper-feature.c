@@ -1,6 +1,6 @@
+#include <stdlib.h>
 #include <string.h>
 
-#include "kaldi-native-fbank/feature-functions.h"
 #include "kaldi-native-fbank/whisper-feature.h"
 
 void knf_whisper_opts_default(knf_whisper_opts *opts) {
@@ -37,11 +37,15 @@ void knf_whisper_opts_default(knf_whisper_opts *opts) {
   mel_opts.use_slaney_mel_scale = true;
   memcpy(mel_opts.norm, "slaney", sizeof("slaney"));
 
-  out->rfft = knf_rfft_create(knf_window_size(&opts->frame_opts), false);
+  if (!knf_frame_geometry_init(&opts->frame_opts, nullptr, &out->geometry)) {
+    return false;
+  }
+  out->rfft = knf_rfft_create(out->geometry.size, false);
   if (!out->rfft) return false;
+  out->rfft_scratch = malloc(knf_rfft_scratch_size(out->rfft));
   out->mel_banks = knf_mel_banks_create(&mel_opts, &opts->frame_opts, 1.0f);
-  if (!out->mel_banks) {
-    knf_rfft_destroy(out->rfft);
+  if (!out->rfft_scratch || !out->mel_banks) {
+    knf_whisper_computer_destroy(out);
     return false;
   }
   return true;
@@ -50,6 +54,7 @@ void knf_whisper_opts_default(knf_whisper_opts *opts) {
 void knf_whisper_computer_destroy(knf_whisper_computer *c) {
   if (!c) return;
   knf_rfft_destroy(c->rfft);
+  free(c->rfft_scratch);
   knf_mel_banks_destroy(c->mel_banks);
 }
 
@@ -79,15 +84,34 @@ void knf_whisper_compute(knf_whisper_computer *c,
       c->rfft == nullptr || c->mel_banks == nullptr) {
     return;
   }
-  int32_t n_fft = knf_window_size(&c->opts.frame_opts);
   int32_t dim = knf_whisper_dim(c);
-  if (n_fft <= 0 || dim <= 0) {
-    return;
-  }
-  if (!knf_rfft_compute(c->rfft, signal_frame)) {
+  // Only the bins some mel filter reads are computed.
+  if (!knf_rfft_compute_power_range_with_scratch(
+          c->rfft, signal_frame, false, c->mel_banks->bin_begin,
+          c->mel_banks->bin_end, c->rfft_scratch)) {
     memset(feature, 0, sizeof(float) * (size_t)dim);
     return;
   }
-  knf_compute_power_spectrum(signal_frame, n_fft);
   knf_mel_compute(c->mel_banks, signal_frame, feature);
 }
+
+void knf_whisper_compute_batch(knf_whisper_computer *c,
+                               [[maybe_unused]] float vtln_warp,
+                               knf_frame_matrix *frames, float *features) {
+  if (c == nullptr || frames == nullptr || frames->data == nullptr ||
+      features == nullptr || c->rfft == nullptr || c->mel_banks == nullptr) {
+    return;
+  }
+  int32_t dim = knf_whisper_dim(c);
+  for (int32_t i = 0; i < frames->rows; ++i) {
+    if (!knf_rfft_compute_power_range_with_scratch(
+            c->rfft, frames->data + (size_t)i * (size_t)frames->stride, false,
+            c->mel_banks->bin_begin, c->mel_banks->bin_end,
+            c->rfft_scratch)) {
+      memset(features, 0, sizeof(float) * (size_t)dim * (size_t)frames->rows);
+      return;
+    }
+  }
+  knf_mel_compute_batch(c->mel_banks, frames->data, frames->rows,
+                        frames->stride, features, dim);
+}
@@ -2,12 +2,172 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "kaldi-native-fbank/feature-fbank.h"
 #include "kaldi-native-fbank/feature-window.h"
 
 constexpr float KNF_PI = 3.14159265358979323846f;
 
+// The batched path gives the per-frame features of every row, at a warp of 1
+// or through the warped banks the computer holds.
+static void check_batch(const knf_fbank_opts *opts, float warp) {
+  knf_fbank_computer comp;
+  assert(knf_fbank_computer_create(opts, &comp));
+  knf_window win;
+  assert(knf_make_window_from_opts(&opts->frame_opts, &win));
+  knf_frame_geometry g;
+  assert(knf_frame_geometry_init(&opts->frame_opts, &win, &g));
+  int32_t n = 4000;
+  float *wave = (float *)calloc((size_t)n, sizeof(float));
+  assert(wave != nullptr);
+  for (int32_t i = 0; i < n; ++i) {
+    wave[i] = sinf(0.07f * (float)i) + 0.3f * sinf(0.9f * (float)i);
+  }
+  int32_t count = knf_frame_geometry_num_frames(&g, n, true);
+  knf_frame_matrix frames = {};
+  assert(knf_extract_windows(&g, 0, wave, KNF_SAMPLE_FLOAT32, 1, false, n, 0,
+                             count, &frames));
+  int32_t dim = knf_fbank_dim(&comp);
+  float *expected = (float *)calloc((size_t)count * (size_t)dim, sizeof(float));
+  float *actual = (float *)calloc((size_t)count * (size_t)dim, sizeof(float));
+  float *row = (float *)calloc((size_t)g.padded, sizeof(float));
+  assert(expected != nullptr && actual != nullptr && row != nullptr);
+  for (int32_t i = 0; i < count; ++i) {
+    memcpy(row, frames.data + (size_t)i * frames.stride,
+           sizeof(float) * (size_t)g.padded);
+    knf_fbank_compute(&comp, frames.log_energies[i], warp, row,
+                      expected + (size_t)i * dim);
+  }
+  knf_fbank_compute_batch(&comp, warp, &frames, actual);
+  for (int32_t i = 0; i < count * dim; ++i) {
+    assert(fabsf(actual[i] - expected[i]) <=
+           1e-5f * (1.0f + fabsf(expected[i])));
+  }
+
+  free(expected);
+  free(actual);
+  free(row);
+  free(wave);
+  knf_frame_matrix_free(&frames);
+  knf_free_window(&win);
+  knf_fbank_computer_destroy(&comp);
+}
+
+// fast_log changes each log by at most its relative error bound.
+static void check_fast_log(const knf_fbank_opts *opts, const float *frame) {
+  knf_fbank_opts fast_opts = *opts;
+  fast_opts.fast_log = true;
+  fast_opts.raw_energy = false;
+  knf_fbank_opts exact_opts = fast_opts;
+  exact_opts.fast_log = false;
+  knf_fbank_computer fast;
+  knf_fbank_computer exact;
+  assert(knf_fbank_computer_create(&fast_opts, &fast));
+  assert(knf_fbank_computer_create(&exact_opts, &exact));
+  int32_t padded = knf_padded_window_size(&opts->frame_opts);
+  int32_t dim = knf_fbank_dim(&exact);
+  float *a = (float *)calloc((size_t)padded, sizeof(float));
+  float *b = (float *)calloc((size_t)padded, sizeof(float));
+  float *fa = (float *)calloc((size_t)dim, sizeof(float));
+  float *fb = (float *)calloc((size_t)dim, sizeof(float));
+  assert(a != nullptr && b != nullptr && fa != nullptr && fb != nullptr);
+  memcpy(a, frame, sizeof(float) * (size_t)padded);
+  memcpy(b, frame, sizeof(float) * (size_t)padded);
+  knf_fbank_compute(&fast, 0.0f, 1.0f, a, fa);
+  knf_fbank_compute(&exact, 0.0f, 1.0f, b, fb);
+  for (int32_t i = 0; i < dim; ++i) {
+    assert(fabsf(fa[i] - fb[i]) <= 5e-7f * fabsf(fb[i]) + 1e-6f);
+  }
+  free(a);
+  free(b);
+  free(fa);
+  free(fb);
+  knf_fbank_computer_destroy(&fast);
+  knf_fbank_computer_destroy(&exact);
+}
+
+// Features at several warps from one spectrum per frame match computing
+// each warp on its own.
+static void check_warps(const knf_fbank_opts *opts) {
+  knf_fbank_computer comp;
+  assert(knf_fbank_computer_create(opts, &comp));
+  knf_window win;
+  assert(knf_make_window_from_opts(&opts->frame_opts, &win));
+  knf_frame_geometry g;
+  assert(knf_frame_geometry_init(&opts->frame_opts, &win, &g));
+  int32_t n = 3000;
+  float *wave = (float *)calloc((size_t)n, sizeof(float));
+  assert(wave != nullptr);
+  for (int32_t i = 0; i < n; ++i) {
+    wave[i] = sinf(0.05f * (float)i * (1.0f + 0.001f * (float)i));
+  }
+  int32_t count = knf_frame_geometry_num_frames(&g, n, true);
+  knf_frame_matrix frames = {};
+  assert(knf_extract_windows(&g, 0, wave, KNF_SAMPLE_FLOAT32, 1, false, n, 0,
+                             count, &frames));
+  const float warps[3] = {0.88f, 1.0f, 1.12f};
+  int32_t dim = knf_fbank_dim(&comp);
+  size_t block = (size_t)count * (size_t)dim;
+  float *expected = (float *)calloc(3 * block, sizeof(float));
+  float *actual = (float *)calloc(3 * block, sizeof(float));
+  float *rows = (float *)calloc((size_t)count * frames.stride, sizeof(float));
+  float *energies = (float *)calloc((size_t)count, sizeof(float));
+  float *row = (float *)calloc((size_t)g.padded, sizeof(float));
+  assert(expected != nullptr && actual != nullptr && rows != nullptr &&
+         energies != nullptr && row != nullptr);
+  memcpy(rows, frames.data, sizeof(float) * (size_t)count * frames.stride);
+  memcpy(energies, frames.log_energies, sizeof(float) * (size_t)count);
+  for (int32_t k = 0; k < 3; ++k) {
+    for (int32_t i = 0; i < count; ++i) {
+      memcpy(row, rows + (size_t)i * frames.stride,
+             sizeof(float) * (size_t)g.padded);
+      knf_fbank_compute(&comp, energies[i], warps[k], row,
+                        expected + k * block + (size_t)i * dim);
+    }
+  }
+  knf_fbank_compute_warps(&comp, warps, 3, &frames, actual);
+  for (size_t i = 0; i < 3 * block; ++i) {
+    assert(fabsf(actual[i] - expected[i]) <=
+           1e-5f * (1.0f + fabsf(expected[i])));
+  }
+  assert(memcmp(actual, actual + 2 * block, sizeof(float) * block) != 0);
+
+  free(expected);
+  free(actual);
+  free(rows);
+  free(energies);
+  free(row);
+  free(wave);
+  knf_frame_matrix_free(&frames);
+  knf_free_window(&win);
+  knf_fbank_computer_destroy(&comp);
+}
+
+// Per-call warps switch between shared warped banks; coming back to a warp
+// gives the same features.
+static void check_warp(const knf_fbank_opts *opts, const float *frame) {
+  knf_fbank_computer comp;
+  assert(knf_fbank_computer_create(opts, &comp));
+  int32_t padded = knf_padded_window_size(&opts->frame_opts);
+  int32_t dim = knf_fbank_dim(&comp);
+  const float warps[4] = {0.9f, 1.0f, 1.1f, 0.9f};
+  float *features = (float *)calloc((size_t)4 * dim, sizeof(float));
+  float *row = (float *)calloc((size_t)padded, sizeof(float));
+  assert(features != nullptr && row != nullptr);
+  for (int32_t w = 0; w < 4; ++w) {
+    memcpy(row, frame, sizeof(float) * (size_t)padded);
+    knf_fbank_compute(&comp, 0.0f, warps[w], row, features + w * dim);
+  }
+  assert(memcmp(features, features + 3 * dim, sizeof(float) * dim) == 0);
+  assert(memcmp(features, features + dim, sizeof(float) * dim) != 0);
+  assert(memcmp(features + dim, features + 2 * dim, sizeof(float) * dim) != 0);
+  for (int32_t i = 0; i < 4 * dim; ++i) assert(isfinite(features[i]));
+  free(features);
+  free(row);
+  knf_fbank_computer_destroy(&comp);
+}
+
 int main() {
   knf_fbank_opts opts;
   knf_fbank_opts_default(&opts);
@@ -28,10 +188,12 @@ int main() {
   knf_window win;
   assert(knf_make_window_from_opts(&opts.frame_opts, &win));
   float raw_log_energy = 0.0f;
-  knf_process_window(&opts.frame_opts, &win, wave, &raw_log_energy);
+  assert(knf_process_window(&opts.frame_opts, &win, wave, &raw_log_energy));
 
   float *feat = (float *)calloc(knf_fbank_dim(&comp), sizeof(float));
   assert(feat != nullptr);
+  check_fast_log(&opts, wave);
+  check_warp(&opts, wave);
   knf_fbank_compute(&comp, raw_log_energy, 1.0f, wave, feat);
   for (int i = 0; i < knf_fbank_dim(&comp); ++i) {
     assert(isfinite(feat[i]));
@@ -41,6 +203,18 @@ int main() {
   free(wave);
   knf_free_window(&win);
   knf_fbank_computer_destroy(&comp);
+
+  check_batch(&opts, 1.0f);
+  check_batch(&opts, 0.9f);
+  check_warps(&opts);
+  opts.fast_log = true;
+  check_batch(&opts, 1.0f);
+  opts.fast_log = false;
+  opts.htk_compat = true;
+  opts.use_power = false;
+  opts.raw_energy = false;
+  opts.mel_opts.num_bins = 80;
+  check_batch(&opts, 1.0f);
   printf("test_fbank passed\n");
   return 0;
 }
@@ -1,15 +1,215 @@
 #include <assert.h>
+#include <math.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "kaldi-native-fbank/feature-window.h"
 
+// Frame processing as separate passes, the way it was before the fused
+// kernel: DC removal, pre-emphasis, energy, window.
+static float reference_process(const knf_frame_opts *opts,
+                               const knf_window *win, float *x) {
+  int32_t n = knf_window_size(opts);
+  if (opts->remove_dc_offset) {
+    double sum = 0.0;
+    for (int32_t i = 0; i < n; ++i) sum += x[i];
+    float mean = (float)(sum / n);
+    for (int32_t i = 0; i < n; ++i) x[i] -= mean;
+  }
+  if (opts->preemph_coeff != 0.0f) {
+    for (int32_t i = n - 1; i > 0; --i) x[i] -= opts->preemph_coeff * x[i - 1];
+    x[0] -= opts->preemph_coeff * x[0];
+  }
+  float energy = 0.0f;
+  for (int32_t i = 0; i < n; ++i) energy += x[i] * x[i];
+  for (int32_t i = 0; i < n; ++i) x[i] *= win->data[i];
+  return logf(energy < 1e-10f ? 1e-10f : energy);
+}
+
+static void check_fused(const char *window_type, float preemph_coeff,
+                        bool remove_dc_offset, float frame_length_ms) {
+  knf_frame_opts opts;
+  knf_frame_opts_default(&opts);
+  opts.dither = 0.0f;
+  opts.preemph_coeff = preemph_coeff;
+  opts.remove_dc_offset = remove_dc_offset;
+  opts.frame_length_ms = frame_length_ms;
+  memcpy(opts.window_type, window_type, strlen(window_type) + 1);
+  knf_window win;
+  assert(knf_make_window_from_opts(&opts, &win));
+  int32_t n = knf_window_size(&opts);
+  int32_t padded = knf_padded_window_size(&opts);
+
+  float wave[2048];
+  for (int32_t i = 0; i < 2048; ++i) {
+    wave[i] = 0.25f + sinf(0.05f * (float)i) + 0.01f * (float)(i % 7);
+  }
+  float expected[2048];
+  float actual[2048];
+  for (int32_t frame = 0; frame < 4; ++frame) {
+    memcpy(expected, wave + frame * knf_window_shift(&opts),
+           sizeof(float) * (size_t)n);
+    float expected_energy = reference_process(&opts, &win, expected);
+    memset(actual, 0x7f, sizeof(actual));
+    float actual_energy = 0.0f;
+    assert(knf_extract_window(0, wave, 2048, frame, &opts, &win, actual,
+                              &actual_energy));
+    assert(fabsf(actual_energy - expected_energy) < 1e-5f);
+    for (int32_t i = 0; i < n; ++i) {
+      assert(fabsf(actual[i] - expected[i]) < 1e-5f);
+    }
+    for (int32_t i = n; i < padded; ++i) assert(actual[i] == 0.0f);
+  }
+  knf_free_window(&win);
+}
+
+// Frames of int16, int32, float64 and G.711 samples match those of the same
+// samples converted to float first, including frames reflected at the edges.
+static void check_typed(bool snip_edges) {
+  knf_frame_opts opts;
+  knf_frame_opts_default(&opts);
+  opts.snip_edges = snip_edges;
+  opts.dither = 1.0f;
+  knf_frame_geometry g;
+  assert(knf_frame_geometry_init(&opts, nullptr, &g));
+  enum { N = 1200 };
+  static int16_t s16[N];
+  static int32_t s32[N];
+  static double f64[N];
+  static uint8_t g711[N];
+  static float f16[N], f32[N], f32d[N], fmu[N], fa[N];
+  for (int32_t i = 0; i < N; ++i) {
+    g711[i] = (uint8_t)(i * 37 + (i >> 3));
+    s16[i] = (int16_t)(12000.0f * sinf(0.013f * (float)i) + (float)(i % 7));
+    s32[i] = (int32_t)s16[i] * 65536 + (i % 5) * 4096;
+    f64[i] = 0.25 * sin(0.021 * i);
+    f16[i] = (float)s16[i];
+    f32[i] = (float)s32[i] / 65536.0f;
+    f32d[i] = (float)f64[i];
+  }
+  knf_convert_samples(g711, KNF_SAMPLE_MULAW, 0, N, fmu);
+  knf_convert_samples(g711, KNF_SAMPLE_ALAW, 0, N, fa);
+  const void *typed[] = {s16, s32, f64, g711, g711};
+  const float *floats[] = {f16, f32, f32d, fmu, fa};
+  knf_sample_format formats[] = {KNF_SAMPLE_INT16, KNF_SAMPLE_INT32,
+                                 KNF_SAMPLE_FLOAT64, KNF_SAMPLE_MULAW,
+                                 KNF_SAMPLE_ALAW};
+  float expected[512];
+  float actual[512];
+  int32_t frames = knf_frame_geometry_num_frames(&g, N, true);
+  for (int32_t k = 0; k < 5; ++k) {
+    for (int32_t frame = 0; frame < frames; ++frame) {
+      float e = 0.0f;
+      float a = 0.0f;
+      assert(knf_frame_geometry_extract(&g, 0, floats[k], N, frame, expected,
+                                        &e));
+      assert(knf_frame_geometry_extract_typed(&g, 0, typed[k], formats[k], N,
+                                              frame, actual, &a));
+      assert(memcmp(expected, actual, sizeof(expected)) == 0 && e == a);
+    }
+  }
+}
+
+// Reference G.711 decoders.
+static float mulaw_decode(uint8_t b) {
+  int32_t u = (uint8_t)~b;
+  int32_t t = (((u & 0x0F) << 3) + 0x84) << ((u & 0x70) >> 4);
+  return (float)((u & 0x80) ? 0x84 - t : t - 0x84);
+}
+
+static float alaw_decode(uint8_t b) {
+  int32_t a = b ^ 0x55;
+  int32_t seg = (a & 0x70) >> 4;
+  int32_t t = (a & 0x0F) << 4;
+  t += seg == 0 ? 8 : 0x108;
+  if (seg > 1) t <<= seg - 1;
+  return (float)((a & 0x80) ? t : -t);
+}
+
+static void check_g711() {
+  uint8_t bytes[256];
+  float mu[256];
+  float a[256];
+  for (int32_t i = 0; i < 256; ++i) bytes[i] = (uint8_t)i;
+  knf_convert_samples(bytes, KNF_SAMPLE_MULAW, 0, 256, mu);
+  knf_convert_samples(bytes, KNF_SAMPLE_ALAW, 0, 256, a);
+  for (int32_t i = 0; i < 256; ++i) {
+    assert(mu[i] == mulaw_decode((uint8_t)i));
+    assert(a[i] == alaw_decode((uint8_t)i));
+  }
+  assert(mu[0x00] == -32124.0f && mu[0xFF] == 0.0f && mu[0x80] == 32124.0f);
+  assert(a[0xD5] == 8.0f && a[0x55] == -8.0f && a[0x2A] == -32256.0f);
+  assert(knf_sample_size(KNF_SAMPLE_MULAW) == 1);
+}
+
+// Without snip_edges, frames past either edge of waves long and short match a
+// sample-by-sample reflection of the source.
+static void check_reflect() {
+  knf_frame_opts opts;
+  knf_frame_opts_default(&opts);
+  opts.snip_edges = false;
+  opts.dither = 0.0f;
+  opts.remove_dc_offset = false;
+  opts.preemph_coeff = 0.0f;
+  memcpy(opts.window_type, "rectangular", sizeof("rectangular"));
+  knf_frame_geometry g;
+  assert(knf_frame_geometry_init(&opts, nullptr, &g));
+  float wave[1000];
+  for (int32_t i = 0; i < 1000; ++i) wave[i] = (float)i;
+  float window[512];
+  int32_t sizes[] = {1000, 300, 150, 90};
+  for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k) {
+    int32_t n = sizes[k];
+    int32_t frames = knf_frame_geometry_num_frames(&g, n, true);
+    assert(frames > 0);
+    for (int32_t frame = 0; frame < frames; ++frame) {
+      assert(knf_frame_geometry_extract(&g, 0, wave, n, frame, window,
+                                        nullptr));
+      int64_t start = knf_frame_geometry_first_sample(&g, frame);
+      for (int32_t s = 0; s < g.size; ++s) {
+        int64_t i = start + s;
+        while (i < 0 || i >= n) i = i < 0 ? -i - 1 : 2 * (int64_t)n - 1 - i;
+        assert(window[s] == wave[i]);
+      }
+    }
+  }
+}
+
+// Standard windows are bound to the built-in tables and others computed;
+// both follow the window formulas.
+static void check_tables() {
+  const struct {
+    const char *type;
+    int32_t size;
+    bool embedded;
+  } cases[] = {
+      {"povey", 400, true},  {"povey", 200, true}, {"hann", 400, true},
+      {"povey", 401, false}, {"hann", 256, false},
+  };
+  for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+    knf_window w;
+    assert(knf_make_window(cases[c].type, cases[c].size, 0.42f, &w));
+    assert(w.size == cases[c].size && w.embedded == cases[c].embedded);
+    bool povey = strcmp(cases[c].type, "povey") == 0;
+    double a = 2.0 * 3.14159265358979323846 / (povey ? w.size - 1 : w.size);
+    for (int32_t i = 0; i < w.size; ++i) {
+      double hann = 0.5 - 0.5 * cos(a * i);
+      double expected = povey ? pow(hann, 0.85) : hann;
+      assert(fabs(w.data[i] - expected) <= 1e-6);
+    }
+    knf_free_window(&w);
+    assert(w.data == nullptr && !w.embedded);
+    knf_free_window(&w);
+  }
+}
+
 int main() {
   knf_frame_opts opts;
   knf_frame_opts_default(&opts);
   assert(knf_window_size(&opts) == 400);
   assert(knf_padded_window_size(&opts) == 512);
 
-  knf_window window = {nullptr, 0};
+  knf_window window = {};
   assert(knf_make_window_from_opts(&opts, &window));
   assert(window.size == 400);
 
@@ -27,6 +227,93 @@ int main() {
                                &log_energy);
   assert(ok);
 
+  knf_frame_geometry geometry;
+  assert(knf_frame_geometry_init(&opts, nullptr, &geometry));
+  assert(geometry.shift == 160 && geometry.size == 400 &&
+         geometry.padded == 512);
+  for (int32_t frame = 0; frame < 8; ++frame) {
+    assert(knf_frame_geometry_first_sample(&geometry, frame) ==
+           knf_first_sample_of_frame(frame, &opts));
+  }
+  for (int64_t n = 0; n < 2000; n += 37) {
+    assert(knf_frame_geometry_num_frames(&geometry, n, false) ==
+           knf_num_frames(n, &opts, false));
+  }
+  knf_window short_window = {};
+  assert(knf_make_window("hann", 200, 0.42f, &short_window));
+  assert(!knf_frame_geometry_init(&opts, &short_window, &geometry));
+  knf_free_window(&short_window);
+
+  // Dither depends only on the seed and the frame index.
+  float a[512];
+  float b[512];
+  opts.dither = 1.0f;
+  assert(knf_extract_window(0, wave, 512, 0, &opts, nullptr, a, nullptr));
+  assert(knf_extract_window(0, wave, 512, 0, &opts, nullptr, b, nullptr));
+  assert(memcmp(a, b, sizeof(a)) == 0);
+  opts.dither_seed = 1;
+  assert(knf_extract_window(0, wave, 512, 0, &opts, nullptr, b, nullptr));
+  assert(memcmp(a, b, sizeof(a)) != 0);
+  // Channels holding the same samples get different noise.
+  float stereo[1024];
+  for (int32_t i = 0; i < 1024; ++i) stereo[i] = wave[i / 2];
+  knf_frame_geometry dithered;
+  assert(knf_frame_geometry_init(&opts, nullptr, &dithered));
+  knf_frame_matrix rows = {};
+  assert(knf_extract_windows(&dithered, 0, stereo, KNF_SAMPLE_FLOAT32, 2,
+                             false, 512, 0, 1, &rows));
+  assert(rows.rows == 2);
+  assert(memcmp(rows.data, rows.data + rows.stride,
+                sizeof(float) * (size_t)rows.cols) != 0);
+  knf_frame_matrix_free(&rows);
+  // knf_process_window_at dithers as frame extraction does; without a frame
+  // index knf_process_window refuses to.
+  memcpy(a, wave, sizeof(float) * 400);
+  assert(knf_process_window_at(&opts, nullptr, 0, a, nullptr));
+  assert(knf_extract_window(0, wave, 512, 0, &opts, nullptr, b, nullptr));
+  assert(memcmp(a, b, sizeof(float) * 400) == 0);
+  memcpy(a, wave, sizeof(float) * 400);
+  assert(!knf_process_window(&opts, nullptr, a, nullptr));
+  assert(memcmp(a, wave, sizeof(float) * 400) == 0);
+  opts.dither = 0.0f;
+  assert(knf_process_window(&opts, nullptr, a, nullptr));
+
+  // A batch of frames matches extracting them one at a time.
+  assert(knf_frame_geometry_init(&opts, nullptr, &geometry));
+  knf_frame_matrix frames = {};
+  assert(knf_extract_windows(&geometry, 0, wave, KNF_SAMPLE_FLOAT32, 1, false,
+                             512, 0, 1, &frames));
+  assert(!knf_extract_windows(&geometry, 0, wave, KNF_SAMPLE_FLOAT32, 1,
+                              false, 512, 0, 3, &frames));
+  assert(frames.rows == 0);
+  float long_wave[1600];
+  for (int32_t i = 0; i < 1600; ++i) long_wave[i] = sinf(0.01f * (float)i);
+  assert(knf_extract_windows(&geometry, 0, long_wave, KNF_SAMPLE_FLOAT32, 1,
+                             false, 1600, 2, 5, &frames));
+  assert(frames.rows == 5 && frames.cols == 512 && frames.stride % 16 == 0);
+  for (int32_t r = 0; r < frames.rows; ++r) {
+    const float *row = frames.data + r * frames.stride;
+    assert((uintptr_t)row % 64 == 0);
+    float energy = 0.0f;
+    assert(knf_frame_geometry_extract(&geometry, 0, long_wave, 1600, 2 + r,
+                                      window_buf, &energy));
+    assert(memcmp(row, window_buf, sizeof(float) * 512) == 0);
+    assert(energy == frames.log_energies[r]);
+  }
+  knf_frame_matrix_free(&frames);
+
+  // Odd lengths leave a partial block for the scalar tail.
+  check_g711();
+  check_tables();
+  check_reflect();
+  check_typed(true);
+  check_typed(false);
+  check_fused("povey", 0.97f, true, 25.0f);
+  check_fused("hamming", 0.0f, true, 25.0f);
+  check_fused("hann", 0.97f, false, 25.0f);
+  check_fused("rectangular", 0.5f, true, 25.3125f);
+  check_fused("povey", 0.97f, true, 0.5625f);
+
   printf("test_feature_window passed\n");
   return 0;
 }
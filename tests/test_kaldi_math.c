@@ -0,0 +1,76 @@
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "kaldi-native-fbank/kaldi-math.h"
+
+int main() {
+  // Known-answer vector of Philox4x32-10 from the Random123 distribution.
+  knf_random_state state;
+  knf_random_state_seed(&state, 0);
+  uint32_t block[4];
+  knf_rand_block(&state, 0, block);
+  assert(block[0] == 0x6627e8d5u && block[1] == 0xe169c58du &&
+         block[2] == 0xbc57ac4cu && block[3] == 0x9b00dbd8u);
+
+  // Blocks match single draws, whatever the chunking.
+  float whole[100];
+  float parts[100];
+  knf_random_state_seed(&state, 42);
+  knf_rand_uniform_block(&state, whole, 100);
+  assert(state.counter == 25);
+  knf_random_state_seed(&state, 42);
+  knf_rand_uniform_block(&state, parts, 36);
+  knf_rand_uniform_block(&state, parts + 36, 64);
+  for (int i = 0; i < 100; ++i) {
+    assert(whole[i] == parts[i]);
+    assert(whole[i] > 0.0f && whole[i] < 1.0f);
+  }
+  knf_random_state_seed(&state, 42);
+  for (int i = 0; i < 100; i += 4) {
+    assert(knf_rand_uniform(&state) == whole[i]);
+  }
+
+  float gauss[10001];
+  knf_random_state_seed(&state, 7);
+  knf_rand_gauss_block(&state, gauss, 10001);
+  double mean = 0.0;
+  double var = 0.0;
+  for (int i = 0; i < 10001; ++i) mean += gauss[i];
+  mean /= 10001;
+  for (int i = 0; i < 10001; ++i) var += (gauss[i] - mean) * (gauss[i] - mean);
+  var /= 10001;
+  assert(fabs(mean) < 0.05 && fabs(var - 1.0) < 0.05);
+
+  // The fast log stays within its bound of the exact log over the whole
+  // normal range, and both apply the floor.
+  float x[4096];
+  float exact[4096];
+  float fast[4096];
+  for (uint32_t bits = 0x00800000u; bits < 0x7f800000u;) {
+    int32_t n = 0;
+    for (; n < 4096 && bits < 0x7f800000u; ++n, bits += 4099u) {
+      memcpy(&x[n], &bits, sizeof(float));
+      exact[n] = x[n];
+      fast[n] = x[n];
+    }
+    knf_log_floor(exact, n, 1e-20f);
+    knf_log_floor_fast(fast, n, 1e-20f);
+    for (int32_t i = 0; i < n; ++i) {
+      double y = log(x[i] < 1e-20f ? 1e-20 : (double)x[i]);
+      assert(fabs(fast[i] - y) <= KNF_FAST_LOG_MAX_REL_ERROR * fabs(y));
+      assert(fabsf(fast[i] - exact[i]) <=
+             2.0f * KNF_FAST_LOG_MAX_REL_ERROR * fabsf(exact[i]));
+    }
+  }
+  float tiny[3] = {0.0f, -1.0f, 1e-30f};
+  knf_log_floor_fast(tiny, 3, 1e-20f);
+  for (int i = 0; i < 3; ++i) {
+    assert(fabsf(tiny[i] - logf(1e-20f)) <= 1e-5f);
+  }
+
+  printf("test_kaldi_math passed\n");
+  return 0;
+}
@@ -2,10 +2,102 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "kaldi-native-fbank/feature-window.h"
 #include "kaldi-native-fbank/mel-computations.h"
 
+// The built-in 80-bin banks of the 16 kHz fbank follow the triangular
+// filters of the mel scale.
+static void check_table() {
+  knf_frame_opts fopts;
+  knf_frame_opts_default(&fopts);
+  knf_mel_opts mopts;
+  knf_mel_opts_default(&mopts);
+  mopts.num_bins = 80;
+  knf_mel_banks *banks = knf_mel_banks_create(&mopts, &fopts, 1.0f);
+  assert(banks != nullptr && banks->embedded);
+  assert(knf_mel_banks_create(&mopts, &fopts, 1.0f) == banks);
+  knf_mel_banks *warped = knf_mel_banks_create(&mopts, &fopts, 0.9f);
+  assert(warped != nullptr && !warped->embedded);
+  knf_mel_banks_destroy(warped);
+
+  assert(banks->num_bins == 80 && banks->num_fft_bins == 256);
+  double mel_low = 1127.0 * log(1.0 + 20.0 / 700.0);
+  double mel_high = 1127.0 * log(1.0 + 8000.0 / 700.0);
+  double delta = (mel_high - mel_low) / 81;
+  for (int32_t r = 0; r < 80; ++r) {
+    double left = mel_low + r * delta;
+    double center = left + delta;
+    double right = center + delta;
+    for (int32_t i = 0; i < 256; ++i) {
+      double mel = 1127.0 * log(1.0 + 31.25 * i / 700.0);
+      double expected = 0.0;
+      if (mel > left && mel < right) {
+        expected = mel <= center ? (mel - left) / delta : (right - mel) / delta;
+      }
+      int32_t k = i - banks->first_bin[r];
+      float w = k >= 0 && k < banks->length[r]
+                    ? banks->weights[banks->start[r] + k]
+                    : 0.0f;
+      assert(fabs(w - expected) <= 1e-4);
+    }
+  }
+  knf_mel_banks_destroy(banks);
+  assert(banks->weights != nullptr);
+}
+
+// Warped banks come from the shared cache: equal to freshly built ones,
+// shared between nearby warps, and evicted least recently used first.
+static void check_cache() {
+  knf_frame_opts fopts;
+  knf_frame_opts_default(&fopts);
+  knf_mel_opts mopts;
+  knf_mel_opts_default(&mopts);
+  mopts.num_bins = 40;
+
+  knf_mel_banks *a = knf_mel_banks_acquire(&mopts, &fopts, 0.9f);
+  knf_mel_banks *fresh = knf_mel_banks_create(&mopts, &fopts, 0.9f);
+  assert(a != nullptr && fresh != nullptr && !a->embedded);
+  assert(a->bin_begin == fresh->bin_begin && a->bin_end == fresh->bin_end);
+  for (int32_t r = 0; r < 40; ++r) {
+    assert(a->first_bin[r] == fresh->first_bin[r]);
+    assert(a->length[r] == fresh->length[r]);
+    assert(memcmp(a->weights + a->start[r], fresh->weights + fresh->start[r],
+                  sizeof(float) * (size_t)a->length[r]) == 0);
+  }
+  knf_mel_banks_destroy(fresh);
+  assert(knf_mel_banks_acquire(&mopts, &fopts, 0.90002f) == a);
+  knf_mel_banks_release(a);
+  knf_mel_banks_release(a);
+  assert(knf_mel_banks_acquire(&mopts, &fopts, 0.0f) == nullptr);
+
+  // a plus 15 more warps fill the cache; after a is used again, the next
+  // warp evicts the oldest of the others instead.
+  knf_mel_banks *b = knf_mel_banks_acquire(&mopts, &fopts, 1.01f);
+  assert(b != nullptr && b != a);
+  knf_mel_banks_release(b);
+  for (int32_t i = 2; i <= 15; ++i) {
+    knf_mel_banks *other =
+        knf_mel_banks_acquire(&mopts, &fopts, 1.0f + 0.01f * (float)i);
+    assert(other != nullptr);
+    knf_mel_banks_release(other);
+  }
+  assert(knf_mel_banks_acquire(&mopts, &fopts, 0.9f) == a);
+  knf_mel_banks_release(a);
+  knf_mel_banks *c = knf_mel_banks_acquire(&mopts, &fopts, 0.85f);
+  assert(c != nullptr);
+  assert(knf_mel_banks_acquire(&mopts, &fopts, 0.9f) == a);
+  knf_mel_banks_release(a);
+  knf_mel_banks_release(c);
+
+  // Held banks survive clearing the cache.
+  a = knf_mel_banks_acquire(&mopts, &fopts, 0.9f);
+  knf_mel_clear_cache();
+  assert(a->num_bins == 40);
+  knf_mel_banks_release(a);
+}
+
 int main() {
   knf_frame_opts fopts;
   knf_frame_opts_default(&fopts);
@@ -29,9 +121,78 @@ int main() {
   for (int i = 0; i < mopts.num_bins; ++i) {
     assert(isfinite(out[i]));
   }
+
+  // Every band lies in [bin_begin, bin_end), and the range is tight.
+  assert(banks->bin_begin >= 0 && banks->bin_begin < banks->bin_end &&
+         banks->bin_end <= cols);
+  bool first_used = false, last_used = false;
+  int32_t total = 0;
+  for (int r = 0; r < mopts.num_bins; ++r) {
+    int32_t first = banks->first_bin[r];
+    int32_t last = first + banks->length[r] - 1;
+    assert(banks->length[r] > 0 && banks->start[r] == total);
+    assert(first >= banks->bin_begin && last < banks->bin_end);
+    assert(banks->weights[banks->start[r]] != 0.0f);
+    assert(banks->weights[banks->start[r] + banks->length[r] - 1] != 0.0f);
+    if (first == banks->bin_begin) first_used = true;
+    if (last == banks->bin_end - 1) last_used = true;
+    // The kernel matches a plain sum over the band.
+    double expected = 0.0;
+    for (int32_t i = 0; i < banks->length[r]; ++i) {
+      expected += (double)banks->weights[banks->start[r] + i] * fft[first + i];
+    }
+    assert(fabs(out[r] - expected) <= 1e-5 * expected);
+    total += banks->length[r];
+  }
+  assert(first_used && last_used);
+  // Far fewer weights than the dense matrix.
+  assert(total * 4 < mopts.num_bins * cols);
+  // The batched kernel agrees with one spectrum at a time, including the
+  // frames past the last full block.
+  {
+    int32_t count = 11;
+    int32_t stride = cols + 3;
+    float *spectra = (float *)calloc((size_t)count * stride, sizeof(float));
+    float *batch = (float *)calloc((size_t)count * 16, sizeof(float));
+    float *single = (float *)calloc((size_t)mopts.num_bins, sizeof(float));
+    assert(spectra != nullptr && batch != nullptr && single != nullptr);
+    for (int32_t i = 0; i < count * stride; ++i) {
+      spectra[i] = (float)((i * 7919) % 101) * 0.01f;
+    }
+    knf_mel_compute_batch(banks, spectra, count, stride, batch, 16);
+    for (int32_t f = 0; f < count; ++f) {
+      knf_mel_compute(banks, spectra + f * stride, single);
+      for (int r = 0; r < mopts.num_bins; ++r) {
+        assert(fabsf(batch[f * 16 + r] - single[r]) <= 1e-5f * single[r]);
+      }
+    }
+    free(spectra);
+    free(batch);
+    free(single);
+  }
+
+  // Band-limited banks skip the top of the spectrum; the bins there are
+  // never read.
+  knf_mel_opts narrow = mopts;
+  narrow.low_freq = 300.0f;
+  narrow.high_freq = 3400.0f;
+  knf_mel_banks *band = knf_mel_banks_create(&narrow, &fopts, 1.0f);
+  assert(band != nullptr);
+  assert(band->bin_begin > 0 && band->bin_end < cols / 2 + 1);
+  for (int i = 0; i < cols; ++i) {
+    if (i < band->bin_begin || i >= band->bin_end) fft[i] = NAN;
+  }
+  knf_mel_compute(band, fft, out);
+  for (int i = 0; i < narrow.num_bins; ++i) {
+    assert(isfinite(out[i]) && out[i] > 0.0f);
+  }
+  knf_mel_banks_destroy(band);
+
   knf_mel_banks_destroy(banks);
   free(fft);
   free(out);
+  check_table();
+  check_cache();
   printf("test_mel_banks passed\n");
   return 0;
 }
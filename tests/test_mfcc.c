@@ -2,11 +2,66 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "kaldi-native-fbank/feature-mfcc.h"
 #include "kaldi-native-fbank/feature-window.h"
 
 constexpr float KNF_PI = 3.14159265358979323846f;
+// knf_mfcc_compute_warps matches knf_mfcc_compute at each warp.
+static void check_warps(const knf_mfcc_opts *opts) {
+  knf_mfcc_computer comp;
+  assert(knf_mfcc_computer_create(opts, &comp));
+  knf_window win;
+  assert(knf_make_window_from_opts(&opts->frame_opts, &win));
+  knf_frame_geometry g;
+  assert(knf_frame_geometry_init(&opts->frame_opts, &win, &g));
+  int32_t n = 2000;
+  float *wave = (float *)calloc((size_t)n, sizeof(float));
+  assert(wave != nullptr);
+  for (int32_t i = 0; i < n; ++i) {
+    wave[i] = cosf(0.11f * (float)i) + 0.5f * sinf(0.013f * (float)i);
+  }
+  int32_t count = knf_frame_geometry_num_frames(&g, n, true);
+  knf_frame_matrix frames = {};
+  assert(knf_extract_windows(&g, 0, wave, KNF_SAMPLE_FLOAT32, 1, false, n, 0,
+                             count, &frames));
+  const float warps[2] = {0.93f, 1.07f};
+  int32_t dim = knf_mfcc_dim(&comp);
+  float *row = (float *)calloc((size_t)g.padded, sizeof(float));
+  float *expected = (float *)calloc((size_t)dim, sizeof(float));
+  float *rows = (float *)calloc((size_t)count * frames.stride, sizeof(float));
+  float *energies = (float *)calloc((size_t)count, sizeof(float));
+  float *actual = (float *)calloc((size_t)2 * count * dim, sizeof(float));
+  assert(row != nullptr && expected != nullptr && rows != nullptr &&
+         energies != nullptr && actual != nullptr);
+  memcpy(rows, frames.data, sizeof(float) * (size_t)count * frames.stride);
+  memcpy(energies, frames.log_energies, sizeof(float) * (size_t)count);
+  knf_mfcc_compute_warps(&comp, warps, 2, &frames, actual);
+  for (int32_t k = 0; k < 2; ++k) {
+    for (int32_t i = 0; i < count; ++i) {
+      memcpy(row, rows + (size_t)i * frames.stride,
+             sizeof(float) * (size_t)g.padded);
+      knf_mfcc_compute(&comp, energies[i], warps[k], row, expected);
+      const float *got = actual + ((size_t)k * count + i) * dim;
+      for (int32_t d = 0; d < dim; ++d) {
+        assert(fabsf(got[d] - expected[d]) <=
+               1e-4f * (1.0f + fabsf(expected[d])));
+      }
+    }
+  }
+
+  free(row);
+  free(expected);
+  free(rows);
+  free(energies);
+  free(actual);
+  free(wave);
+  knf_frame_matrix_free(&frames);
+  knf_free_window(&win);
+  knf_mfcc_computer_destroy(&comp);
+}
+
 int main() {
   knf_mfcc_opts opts;
   knf_mfcc_opts_default(&opts);
@@ -27,7 +82,7 @@ int main() {
   knf_window win;
   assert(knf_make_window_from_opts(&opts.frame_opts, &win));
   float raw_log_energy = 0.0f;
-  knf_process_window(&opts.frame_opts, &win, wave, &raw_log_energy);
+  assert(knf_process_window(&opts.frame_opts, &win, wave, &raw_log_energy));
 
   float *feat = (float *)calloc(knf_mfcc_dim(&comp), sizeof(float));
   assert(feat != nullptr);
@@ -40,6 +95,7 @@ int main() {
   free(wave);
   knf_free_window(&win);
   knf_mfcc_computer_destroy(&comp);
+  check_warps(&opts);
   printf("test_mfcc passed\n");
   return 0;
 }
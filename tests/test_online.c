@@ -2,6 +2,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "kaldi-native-fbank/online-feature.h"
 
@@ -12,6 +13,206 @@ static void fill_wave(float *wave, int n, float freq, float samp_freq) {
   }
 }
 
+// Fed in chunks of chunk samples, the online extractor gives the features
+// of knf_extract_window and knf_fbank_compute on the whole wave, to within tol
+// relative to each value's magnitude or 1, whichever is larger.
+static void check_online_matches_offline(const knf_fbank_opts *fopts,
+                                         const float *wave, int n, int chunk,
+                                         float tol) {
+  knf_online_feature feat;
+  assert(knf_online_fbank_create(fopts, &feat));
+  for (int i = 0; i < n; i += chunk) {
+    int m = n - i < chunk ? n - i : chunk;
+    assert(knf_online_accept_waveform(&feat, fopts->frame_opts.samp_freq,
+                                      wave + i, m));
+  }
+  assert(knf_online_input_finished(&feat));
+
+  knf_fbank_computer comp;
+  assert(knf_fbank_computer_create(fopts, &comp));
+  knf_window win;
+  assert(knf_make_window_from_opts(&fopts->frame_opts, &win));
+  int32_t padded = knf_padded_window_size(&fopts->frame_opts);
+  int32_t dim = knf_fbank_dim(&comp);
+  float *window = (float *)calloc((size_t)padded, sizeof(float));
+  float *expected = (float *)calloc((size_t)dim, sizeof(float));
+  assert(window != nullptr && expected != nullptr);
+  int32_t ready = knf_online_num_frames_ready(&feat);
+  assert(ready == knf_num_frames(n, &fopts->frame_opts, true));
+  for (int32_t i = 0; i < ready; ++i) {
+    float raw_log_energy = 0.0f;
+    assert(knf_extract_window(0, wave, n, i, &fopts->frame_opts, &win, window,
+                              &raw_log_energy));
+    knf_fbank_compute(&comp, raw_log_energy, 1.0f, window, expected);
+    const float *frame = knf_online_get_frame(&feat, i);
+    for (int32_t d = 0; d < dim; ++d) {
+      assert(fabsf(frame[d] - expected[d]) <
+             tol * fmaxf(1.0f, fabsf(expected[d])));
+    }
+  }
+
+  free(window);
+  free(expected);
+  knf_free_window(&win);
+  knf_fbank_computer_destroy(&comp);
+  knf_online_feature_destroy(&feat);
+}
+
+// A one-sample shift with a rectangular window runs on the sliding DFT, and
+// so does a hann window at a 2.5 ms shift when forced; the features must match
+// the FFT path frame by frame. Bins far below a pure tone are only resolved
+// to a relative error by the float FFT of the reference.
+static void check_sliding(const float *wave, int n, const char *window_type,
+                          float shift_ms, knf_spectrum_engine engine) {
+  knf_fbank_opts fopts;
+  knf_fbank_opts_default(&fopts);
+  fopts.frame_opts.dither = 0.0f;
+  fopts.frame_opts.preemph_coeff = 0.0f;
+  fopts.frame_opts.frame_shift_ms = shift_ms;
+  memset(fopts.frame_opts.window_type, 0,
+         sizeof(fopts.frame_opts.window_type));
+  memcpy(fopts.frame_opts.window_type, window_type, strlen(window_type));
+  fopts.spectrum_engine = engine;
+
+  knf_online_feature feat;
+  assert(knf_online_fbank_create(&fopts, &feat));
+  assert(feat.sliding != nullptr);
+  knf_online_feature_destroy(&feat);
+  check_online_matches_offline(&fopts, wave, n, 333, 2e-3f);
+}
+
+// n samples of the given format, fed in chunks alone or followed by float
+// chunks that force the buffer to float, give the features of the same
+// samples accepted as float; alone they stay in their format in the buffer.
+static void check_typed(const knf_fbank_opts *fopts, knf_sample_format format,
+                        const void *samples, int n, bool mixed) {
+  const char *bytes = (const char *)samples;
+  size_t sample_size = knf_sample_size(format);
+  float *wave = (float *)calloc((size_t)n, sizeof(float));
+  assert(wave != nullptr);
+  knf_convert_samples(samples, format, 0, n, wave);
+  float rate = fopts->frame_opts.samp_freq;
+  knf_online_feature a;
+  knf_online_feature b;
+  assert(knf_online_fbank_create(fopts, &a));
+  assert(knf_online_fbank_create(fopts, &b));
+  assert(knf_online_accept_waveform(&a, rate, wave, n));
+  for (int i = 0; i < n; i += 500) {
+    int m = n - i < 500 ? n - i : 500;
+    if (mixed && i >= n / 2) {
+      assert(knf_online_accept_waveform(&b, rate, wave + i, m));
+    } else {
+      assert(knf_online_accept_waveform_typed(
+          &b, rate, bytes + (size_t)i * sample_size, format, m));
+    }
+  }
+  assert(b.format == (mixed ? KNF_SAMPLE_FLOAT32 : format));
+  // Typed chunks after float ones are converted as they come, without
+  // reallocating the float buffer while it has room.
+  knf_online_feature c;
+  assert(knf_online_fbank_create(fopts, &c));
+  assert(knf_online_accept_waveform(&c, rate, wave, 500));
+  const void *buffer = c.waveform;
+  for (int i = 500; i < 1000; i += 100) {
+    assert(knf_online_accept_waveform_typed(
+        &c, rate, bytes + (size_t)i * sample_size, format, 100));
+    assert(c.waveform == buffer && c.format == KNF_SAMPLE_FLOAT32);
+  }
+  assert(knf_online_input_finished(&a));
+  assert(knf_online_input_finished(&b));
+  int32_t ready = knf_online_num_frames_ready(&a);
+  assert(ready > 0 && ready == knf_online_num_frames_ready(&b));
+  int32_t dim = knf_fbank_dim((knf_fbank_computer *)a.computer);
+  for (int32_t i = 0; i < ready; ++i) {
+    const float *fa = knf_online_get_frame(&a, i);
+    const float *fb = knf_online_get_frame(&b, i);
+    for (int32_t d = 0; d < dim; ++d) {
+      assert(fabsf(fa[d] - fb[d]) < 1e-4f);
+    }
+  }
+  for (int32_t i = 0; i < knf_online_num_frames_ready(&c); ++i) {
+    const float *fa = knf_online_get_frame(&a, i);
+    const float *fc = knf_online_get_frame(&c, i);
+    for (int32_t d = 0; d < dim; ++d) {
+      assert(fabsf(fa[d] - fc[d]) < 1e-4f);
+    }
+  }
+  knf_online_feature_destroy(&a);
+  knf_online_feature_destroy(&b);
+  knf_online_feature_destroy(&c);
+  free(wave);
+}
+
+// Interleaved stereo gives each channel's own features, and with downmix
+// the features of the channels' mean.
+static void check_channels(const knf_fbank_opts *fopts) {
+  int n = 4000;
+  int16_t *stereo = (int16_t *)calloc((size_t)n * 2, sizeof(int16_t));
+  float *left = (float *)calloc((size_t)n, sizeof(float));
+  float *right = (float *)calloc((size_t)n, sizeof(float));
+  float *mean = (float *)calloc((size_t)n, sizeof(float));
+  assert(stereo != nullptr && left != nullptr && right != nullptr &&
+         mean != nullptr);
+  for (int i = 0; i < n; ++i) {
+    stereo[2 * i] = (int16_t)(7000.0f * sinf(0.03f * (float)i));
+    stereo[2 * i + 1] = (int16_t)(3000.0f * sinf(0.2f * (float)i) + 5.0f);
+    left[i] = stereo[2 * i];
+    right[i] = stereo[2 * i + 1];
+    mean[i] = (left[i] + right[i]) * 0.5f;
+  }
+  float rate = fopts->frame_opts.samp_freq;
+  const float *mono[] = {left, right, mean};
+  knf_online_feature ref[3];
+  for (int k = 0; k < 3; ++k) {
+    assert(knf_online_fbank_create(fopts, &ref[k]));
+    assert(knf_online_accept_waveform(&ref[k], rate, mono[k], n));
+    assert(knf_online_input_finished(&ref[k]));
+  }
+  int32_t dim = knf_fbank_dim((knf_fbank_computer *)ref[0].computer);
+  int32_t ready = knf_online_num_frames_ready(&ref[0]);
+  assert(ready > 0);
+
+  for (int downmix = 0; downmix < 2; ++downmix) {
+    knf_online_feature feat;
+    assert(knf_online_fbank_create(fopts, &feat));
+    assert(knf_online_set_channels(&feat, 2, downmix));
+    assert(!knf_online_set_input_rate(&feat, 8000.0f));
+    for (int i = 0; i < n; i += 700) {
+      int chunk = n - i < 700 ? n - i : 700;
+      assert(knf_online_accept_waveform_typed(
+          &feat, rate, stereo + 2 * i, KNF_SAMPLE_INT16, chunk));
+    }
+    assert(knf_online_input_finished(&feat));
+    assert(knf_online_num_frames_ready(&feat) == ready);
+    for (int32_t i = 0; i < ready; ++i) {
+      const float *frame = knf_online_get_frame(&feat, i);
+      for (int c = 0; c < (downmix ? 1 : 2); ++c) {
+        const float *expected = knf_online_get_frame(&ref[downmix ? 2 : c], i);
+        for (int32_t d = 0; d < dim; ++d) {
+          assert(fabsf(frame[c * dim + d] - expected[d]) < 1e-4f);
+        }
+      }
+    }
+    knf_online_feature_destroy(&feat);
+  }
+
+  for (int k = 0; k < 3; ++k) knf_online_feature_destroy(&ref[k]);
+  free(stereo);
+  free(left);
+  free(right);
+  free(mean);
+}
+
+// Without snip_edges the first frames reflect the start of the stream; fed in
+// chunks, they still match extraction from the whole wave.
+static void check_no_snip(const float *wave, int n) {
+  knf_fbank_opts fopts;
+  knf_fbank_opts_default(&fopts);
+  fopts.frame_opts.dither = 0.0f;
+  fopts.frame_opts.snip_edges = false;
+  check_online_matches_offline(&fopts, wave, n, 250, 1e-4f);
+}
+
 int main() {
   knf_fbank_opts fopts;
   knf_fbank_opts_default(&fopts);
@@ -46,6 +247,36 @@ int main() {
 
   knf_online_feature_destroy(&feat);
   knf_online_feature_destroy(&feat);
+  assert(feat.sliding == nullptr);
+  check_sliding(wave, n, "rectangular", 0.0625f, KNF_SPECTRUM_AUTO);
+  check_sliding(wave, n, "hann", 2.5f, KNF_SPECTRUM_SLIDING);
+  knf_fbank_opts engine_opts = fopts;
+  engine_opts.spectrum_engine = KNF_SPECTRUM_SLIDING;
+  assert(!knf_online_fbank_create(&engine_opts, &feat));  // povey
+  engine_opts.frame_opts.dither = 0.0f;
+  engine_opts.frame_opts.preemph_coeff = 0.0f;
+  engine_opts.frame_opts.frame_shift_ms = 0.0625f;
+  memcpy(engine_opts.frame_opts.window_type, "hamming", sizeof("hamming"));
+  engine_opts.spectrum_engine = KNF_SPECTRUM_FFT;
+  assert(knf_online_fbank_create(&engine_opts, &feat));
+  assert(feat.sliding == nullptr);
+  knf_online_feature_destroy(&feat);
+  check_no_snip(wave, n);
+  enum { TYPED_N = 4000 };
+  static int16_t pcm[TYPED_N];
+  static uint8_t mulaw[TYPED_N];
+  for (int i = 0; i < TYPED_N; ++i) {
+    pcm[i] = (int16_t)(8000.0f * sinf(0.05f * (float)i) + (float)(i % 11));
+    mulaw[i] = (uint8_t)(i * 29 + (i >> 4));
+  }
+  check_typed(&fopts, KNF_SAMPLE_INT16, pcm, TYPED_N, false);
+  check_typed(&fopts, KNF_SAMPLE_INT16, pcm, TYPED_N, true);
+  check_typed(&fopts, KNF_SAMPLE_MULAW, mulaw, TYPED_N, false);
+  check_channels(&fopts);
+  fopts.frame_opts.preemph_coeff = 0.0f;
+  fopts.frame_opts.frame_shift_ms = 0.0625f;
+  memcpy(fopts.frame_opts.window_type, "rectangular", sizeof("rectangular"));
+  check_typed(&fopts, KNF_SAMPLE_INT16, pcm, TYPED_N, false);
   free(wave);
   printf("test_online passed\n");
   return 0;
@@ -0,0 +1,134 @@
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "kaldi-native-fbank/online-feature.h"
+#include "kaldi-native-fbank/resampler.h"
+
+constexpr double KNF_PI = 3.14159265358979323846;
+
+// Resamples a tone in one go and in uneven chunks: the chunks must give the
+// same samples, their count must be ceil(n * out / in), and away from the
+// edges they must follow the tone.
+static void check_tone(int32_t in_rate, int32_t out_rate, double freq) {
+  int32_t n = in_rate / 2;
+  float *wave = (float *)calloc((size_t)n, sizeof(float));
+  assert(wave != nullptr);
+  for (int32_t i = 0; i < n; ++i) {
+    wave[i] = (float)sin(2.0 * KNF_PI * freq * i / in_rate);
+  }
+
+  knf_resampler whole;
+  knf_resampler chunked;
+  assert(knf_resampler_create(in_rate, out_rate, &whole));
+  assert(knf_resampler_create(in_rate, out_rate, &chunked));
+  int32_t bound = knf_resampler_max_output(&whole, n);
+  int64_t total = ((int64_t)n * out_rate + in_rate - 1) / in_rate;
+  assert(bound == total);
+  float *a = (float *)calloc((size_t)bound, sizeof(float));
+  float *b = (float *)calloc((size_t)bound, sizeof(float));
+  assert(a != nullptr && b != nullptr);
+  int32_t num_a = 0;
+  assert(knf_resampler_process(&whole, wave, KNF_SAMPLE_FLOAT32, n, true, a,
+                               &num_a));
+  assert(num_a == total);
+
+  int32_t num_b = 0;
+  for (int32_t i = 0, chunk = 1; i < n; i += chunk, chunk = chunk * 3 + 7) {
+    int32_t m = n - i < chunk ? n - i : chunk;
+    int32_t produced = 0;
+    assert(knf_resampler_process(&chunked, wave + i, KNF_SAMPLE_FLOAT32, m,
+                                 false, b + num_b, &produced));
+    num_b += produced;
+  }
+  int32_t produced = 0;
+  assert(knf_resampler_process(&chunked, nullptr, KNF_SAMPLE_FLOAT32, 0, true,
+                               b + num_b, &produced));
+  num_b += produced;
+  assert(num_b == num_a);
+  assert(memcmp(a, b, sizeof(float) * (size_t)num_a) == 0);
+  assert(!knf_resampler_process(&chunked, nullptr, KNF_SAMPLE_FLOAT32, 0, true,
+                                b, &produced));
+
+  double max_err = 0.0;
+  for (int32_t i = out_rate / 100; i < num_a - out_rate / 100; ++i) {
+    double expected = sin(2.0 * KNF_PI * freq * i / out_rate);
+    double err = fabs(a[i] - expected);
+    if (err > max_err) max_err = err;
+  }
+  assert(max_err < 5e-3);
+
+  free(a);
+  free(b);
+  free(wave);
+  knf_resampler_destroy(&whole);
+  knf_resampler_destroy(&chunked);
+}
+
+// An 8 kHz stream fed to a 16 kHz extractor gives the features of the same
+// stream resampled up front.
+static void check_online() {
+  int32_t n = 8000;
+  int16_t *pcm = (int16_t *)calloc((size_t)n, sizeof(int16_t));
+  assert(pcm != nullptr);
+  for (int32_t i = 0; i < n; ++i) {
+    pcm[i] = (int16_t)(6000.0 * sin(2.0 * KNF_PI * 440.0 * i / 8000.0));
+  }
+  knf_resampler r;
+  assert(knf_resampler_create(8000, 16000, &r));
+  float *wave = (float *)calloc((size_t)knf_resampler_max_output(&r, n),
+                                sizeof(float));
+  assert(wave != nullptr);
+  int32_t num = 0;
+  assert(knf_resampler_process(&r, pcm, KNF_SAMPLE_INT16, n, true, wave, &num));
+
+  knf_fbank_opts fopts;
+  knf_fbank_opts_default(&fopts);
+  fopts.frame_opts.dither = 0.0f;
+  knf_online_feature a;
+  knf_online_feature b;
+  assert(knf_online_fbank_create(&fopts, &a));
+  assert(knf_online_fbank_create(&fopts, &b));
+  assert(knf_online_accept_waveform(&a, 16000.0f, wave, num));
+  assert(knf_online_input_finished(&a));
+  assert(knf_online_set_input_rate(&b, 8000.0f));
+  assert(!knf_online_set_input_rate(&b, 8000.0f));
+  assert(!knf_online_accept_waveform_typed(&b, 16000.0f, pcm,
+                                           KNF_SAMPLE_INT16, 100));
+  for (int32_t i = 0; i < n; i += 1000) {
+    assert(knf_online_accept_waveform_typed(&b, 8000.0f, pcm + i,
+                                            KNF_SAMPLE_INT16, 1000));
+  }
+  assert(knf_online_input_finished(&b));
+
+  int32_t ready = knf_online_num_frames_ready(&a);
+  assert(ready > 0 && ready == knf_online_num_frames_ready(&b));
+  int32_t dim = knf_fbank_dim((knf_fbank_computer *)a.computer);
+  for (int32_t i = 0; i < ready; ++i) {
+    const float *fa = knf_online_get_frame(&a, i);
+    const float *fb = knf_online_get_frame(&b, i);
+    for (int32_t d = 0; d < dim; ++d) assert(fabsf(fa[d] - fb[d]) < 1e-4f);
+  }
+
+  knf_online_feature_destroy(&a);
+  knf_online_feature_destroy(&b);
+  knf_resampler_destroy(&r);
+  free(wave);
+  free(pcm);
+}
+
+int main() {
+  check_tone(8000, 16000, 440.0);
+  check_tone(48000, 16000, 1000.0);
+  check_tone(44100, 16000, 3000.0);
+  check_tone(22050, 16000, 250.0);
+
+  knf_resampler r;
+  assert(!knf_resampler_create(0, 16000, &r));
+  assert(!knf_resampler_create(1000003, 999983, &r));  // too many phases
+  check_online();
+  printf("test_resampler passed\n");
+  return 0;
+}
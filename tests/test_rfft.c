@@ -1,9 +1,307 @@
 #include <assert.h>
+#include <float.h>
 #include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
+#include "kaldi-native-fbank/feature-functions.h"
 #include "kaldi-native-fbank/rfft.h"
 
+constexpr float KNF_PI = 3.14159265358979323846f;
+
+// Largest |float - double| over the spectrum, relative to the largest
+// magnitude of the double-precision reference.
+static float float_vs_double_error(int32_t n, bool inverse) {
+  float *a = (float *)calloc((size_t)n, sizeof(float));
+  float *b = (float *)calloc((size_t)n, sizeof(float));
+  assert(a != nullptr && b != nullptr);
+  for (int32_t i = 0; i < n; ++i) {
+    a[i] = b[i] = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+  }
+
+  knf_rfft *f = knf_rfft_create_with_precision(n, inverse, KNF_RFFT_FLOAT);
+  knf_rfft *d = knf_rfft_create_with_precision(n, inverse, KNF_RFFT_DOUBLE);
+  assert(f != nullptr && d != nullptr);
+  assert(f->precision == KNF_RFFT_FLOAT);
+  assert(d->precision == KNF_RFFT_DOUBLE);
+  assert(knf_rfft_compute(f, a));
+  assert(knf_rfft_compute(d, b));
+
+  float max_diff = 0.0f;
+  float max_ref = 0.0f;
+  for (int32_t i = 0; i < n; ++i) {
+    max_diff = fmaxf(max_diff, fabsf(a[i] - b[i]));
+    max_ref = fmaxf(max_ref, fabsf(b[i]));
+  }
+  knf_rfft_destroy(f);
+  knf_rfft_destroy(d);
+  free(a);
+  free(b);
+  return max_diff / max_ref;
+}
+
+// Largest |simd - scalar| relative to the largest scalar magnitude, with the
+// plan capped at isa. Stores the instruction set the plan picked in used.
+static float simd_vs_scalar_error(int32_t n, bool inverse, knf_fft_isa isa,
+                                  knf_fft_isa *used) {
+  float *a = (float *)calloc((size_t)n, sizeof(float));
+  float *b = (float *)calloc((size_t)n, sizeof(float));
+  assert(a != nullptr && b != nullptr);
+  for (int32_t i = 0; i < n; ++i) {
+    a[i] = b[i] = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+  }
+
+  assert(knf_rfft_force_isa(KNF_FFT_ISA_SCALAR));
+  knf_rfft *s = knf_rfft_create(n, inverse);
+  assert(knf_rfft_force_isa(isa));
+  knf_rfft *v = knf_rfft_create(n, inverse);
+  assert(s != nullptr && v != nullptr);
+  assert(s->isa == KNF_FFT_ISA_SCALAR);
+  *used = v->isa;
+  assert(knf_rfft_compute(v, a));
+  assert(knf_rfft_compute(s, b));
+
+  float max_diff = 0.0f;
+  float max_ref = 0.0f;
+  for (int32_t i = 0; i < n; ++i) {
+    max_diff = fmaxf(max_diff, fabsf(a[i] - b[i]));
+    max_ref = fmaxf(max_ref, fabsf(b[i]));
+  }
+  knf_rfft_destroy(s);
+  knf_rfft_destroy(v);
+  free(a);
+  free(b);
+  return max_diff / max_ref;
+}
+
+// Largest |batch - single| relative to the largest single-frame magnitude for
+// count frames laid out stride floats apart. The gaps between frames must
+// come back untouched.
+static float batch_vs_single_error(int32_t n, bool inverse, int32_t count,
+                                   int32_t stride) {
+  const size_t total = (size_t)count * (size_t)stride;
+  float *a = (float *)calloc(total, sizeof(float));
+  float *b = (float *)calloc(total, sizeof(float));
+  assert(a != nullptr && b != nullptr);
+  for (size_t i = 0; i < total; ++i) {
+    a[i] = b[i] = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+  }
+
+  knf_rfft *fft = knf_rfft_create(n, inverse);
+  assert(fft != nullptr);
+  assert(knf_rfft_compute_batch(fft, a, count, stride));
+  for (int32_t i = 0; i < count; ++i) {
+    assert(knf_rfft_compute(fft, b + (size_t)i * stride));
+  }
+  knf_rfft_destroy(fft);
+
+  float max_diff = 0.0f;
+  float max_ref = 0.0f;
+  for (size_t i = 0; i < total; ++i) {
+    if ((int32_t)(i % (size_t)stride) >= n) {
+      assert(a[i] == b[i]);
+      continue;
+    }
+    max_diff = fmaxf(max_diff, fabsf(a[i] - b[i]));
+    max_ref = fmaxf(max_ref, fabsf(b[i]));
+  }
+  free(a);
+  free(b);
+  return max_diff / max_ref;
+}
+
+// Largest |fused - unfused| relative to the largest unfused value, where the
+// unfused spectrum is knf_rfft_compute followed by knf_compute_power_spectrum
+// (and a square root for magnitudes).
+static float fused_power_error(int32_t n, knf_rfft_precision precision,
+                               bool magnitude) {
+  float *a = (float *)calloc((size_t)n, sizeof(float));
+  float *b = (float *)calloc((size_t)n, sizeof(float));
+  assert(a != nullptr && b != nullptr);
+  for (int32_t i = 0; i < n; ++i) {
+    a[i] = b[i] = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+  }
+
+  knf_rfft *fft = knf_rfft_create_with_precision(n, false, precision);
+  assert(fft != nullptr);
+  assert(knf_rfft_compute_power(fft, a, magnitude));
+  assert(knf_rfft_compute(fft, b));
+  knf_rfft_destroy(fft);
+  knf_compute_power_spectrum(b, n);
+
+  float max_diff = 0.0f;
+  float max_ref = 0.0f;
+  for (int32_t i = 0; i <= n / 2; ++i) {
+    float ref = magnitude ? sqrtf(b[i]) : b[i];
+    max_diff = fmaxf(max_diff, fabsf(a[i] - ref));
+    max_ref = fmaxf(max_ref, fabsf(ref));
+  }
+  free(a);
+  free(b);
+  return max_diff / max_ref;
+}
+
+// Largest |range - full| over bins [begin, end) relative to the largest full
+// value, where range comes from knf_rfft_compute_power_range and full from
+// knf_rfft_compute_power.
+static float power_range_error(int32_t n, knf_rfft_precision precision,
+                               bool magnitude, int32_t begin, int32_t end) {
+  float *a = (float *)calloc((size_t)n, sizeof(float));
+  float *b = (float *)calloc((size_t)n, sizeof(float));
+  assert(a != nullptr && b != nullptr);
+  for (int32_t i = 0; i < n; ++i) {
+    a[i] = b[i] = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+  }
+
+  knf_rfft *fft = knf_rfft_create_with_precision(n, false, precision);
+  assert(fft != nullptr);
+  assert(knf_rfft_compute_power_range(fft, a, magnitude, begin, end));
+  assert(knf_rfft_compute_power(fft, b, magnitude));
+  knf_rfft_destroy(fft);
+
+  float max_diff = 0.0f;
+  float max_ref = 0.0f;
+  for (int32_t i = begin; i < end; ++i) {
+    max_diff = fmaxf(max_diff, fabsf(a[i] - b[i]));
+    max_ref = fmaxf(max_ref, fabsf(b[i]));
+  }
+  free(a);
+  free(b);
+  return max_diff / max_ref;
+}
+
+// Largest |pruned - full| relative to the largest full value when the first
+// nonzero of n samples are live: the pruned plan gets NaN in the tail, which
+// it must never read, and the full plan gets zeros. Covers single, batched
+// and fused power transforms.
+static float pruned_vs_full_error(int32_t n, int32_t nonzero) {
+  const int32_t count = 19;
+  const size_t total = (size_t)count * (size_t)n;
+  float *a = (float *)calloc(total, sizeof(float));
+  float *b = (float *)calloc(total, sizeof(float));
+  assert(a != nullptr && b != nullptr);
+  for (size_t i = 0; i < total; ++i) {
+    bool live = (int32_t)(i % (size_t)n) < nonzero;
+    b[i] = live ? (float)rand() / (float)RAND_MAX * 2.0f - 1.0f : 0.0f;
+    a[i] = live ? b[i] : NAN;
+  }
+
+  knf_rfft *pruned = knf_rfft_create_pruned(n, nonzero);
+  knf_rfft *full = knf_rfft_create(n, false);
+  assert(pruned != nullptr && full != nullptr);
+  assert(pruned->nonzero == nonzero && full->nonzero == n);
+  assert(knf_rfft_compute(pruned, a));
+  assert(knf_rfft_compute(full, b));
+  assert(knf_rfft_compute_power(pruned, a + n, false));
+  assert(knf_rfft_compute_power(full, b + n, false));
+  assert(knf_rfft_compute_batch(pruned, a + 2 * n, count - 2, n));
+  assert(knf_rfft_compute_batch(full, b + 2 * n, count - 2, n));
+  knf_rfft_destroy(pruned);
+  knf_rfft_destroy(full);
+
+  float max_diff = 0.0f;
+  float max_ref = 0.0f;
+  for (size_t i = 0; i < total; ++i) {
+    // Frame 1 holds the power spectrum in its first n/2 + 1 slots.
+    bool power = i >= (size_t)n && i < 2 * (size_t)n;
+    if (power && i >= (size_t)n + (size_t)n / 2 + 1) continue;
+    float diff = power ? fabsf(sqrtf(a[i]) - sqrtf(b[i])) : fabsf(a[i] - b[i]);
+    max_diff = isnan(diff) ? INFINITY : fmaxf(max_diff, diff);
+    if (!power) max_ref = fmaxf(max_ref, fabsf(b[i]));
+  }
+  free(a);
+  free(b);
+  return max_diff / max_ref;
+}
+
+// Whether codelet and generic plans give the same single, batched and pruned
+// transforms; nonzero < n exercises the pruned first pass. They are
+// bit-identical unless the compiler contracts multiply-adds, which rounds
+// the two differently, so a few ulps of the largest output are allowed.
+static bool codelet_matches_generic(int32_t n, bool inverse, int32_t nonzero) {
+  const int32_t count = 21;
+  const size_t total = (size_t)count * (size_t)n;
+  float *a = (float *)calloc(total, sizeof(float));
+  float *b = (float *)calloc(total, sizeof(float));
+  assert(a != nullptr && b != nullptr);
+  for (size_t i = 0; i < total; ++i) {
+    a[i] = b[i] = (int32_t)(i % (size_t)n) < nonzero
+                      ? (float)rand() / (float)RAND_MAX * 2.0f - 1.0f
+                      : 0.0f;
+  }
+
+  knf_rfft_enable_codelets(false);
+  knf_rfft *g = inverse ? knf_rfft_create(n, true)
+                        : knf_rfft_create_pruned(n, nonzero);
+  knf_rfft_enable_codelets(true);
+  knf_rfft *c = inverse ? knf_rfft_create(n, true)
+                        : knf_rfft_create_pruned(n, nonzero);
+  assert(g != nullptr && c != nullptr);
+  assert(!g->codelet && c->codelet && g->isa == c->isa);
+  assert(knf_rfft_compute(g, a));
+  assert(knf_rfft_compute(c, b));
+  assert(knf_rfft_compute_batch(g, a + n, count - 1, n));
+  assert(knf_rfft_compute_batch(c, b + n, count - 1, n));
+  knf_rfft_destroy(g);
+  knf_rfft_destroy(c);
+
+  float max_diff = 0.0f;
+  float max_ref = 0.0f;
+  for (size_t i = 0; i < total; ++i) {
+    float diff = fabsf(a[i] - b[i]);
+    max_diff = isnan(diff) ? INFINITY : fmaxf(max_diff, diff);
+    max_ref = fmaxf(max_ref, fabsf(a[i]));
+  }
+  bool same = max_diff <= 8.0f * FLT_EPSILON * max_ref;
+  free(a);
+  free(b);
+  return same;
+}
+
+// Whether transforms in caller-provided scratch of exactly the advertised
+// size match the self-allocating calls bit for bit; the sanitizers catch any
+// access past the scratch.
+static bool scratch_matches_owned(int32_t n, bool inverse,
+                                  knf_rfft_precision precision) {
+  const int32_t count = 19;
+  const size_t total = (size_t)count * (size_t)n;
+  float *a = (float *)calloc(total, sizeof(float));
+  float *b = (float *)calloc(total, sizeof(float));
+  assert(a != nullptr && b != nullptr);
+  for (size_t i = 0; i < total; ++i) {
+    a[i] = b[i] = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+  }
+
+  knf_rfft *fft = knf_rfft_create_with_precision(n, inverse, precision);
+  assert(fft != nullptr);
+  void *scratch = malloc(knf_rfft_scratch_size(fft));
+  void *batch_scratch = malloc(knf_rfft_batch_scratch_size(fft));
+  assert(scratch != nullptr && batch_scratch != nullptr);
+  assert(knf_rfft_batch_scratch_size(fft) >= knf_rfft_scratch_size(fft));
+  assert(knf_rfft_compute(fft, a));
+  assert(knf_rfft_compute_with_scratch(fft, b, scratch));
+  assert(knf_rfft_compute_batch(fft, a + n, count - 2, n));
+  assert(knf_rfft_compute_batch_with_scratch(fft, b + n, count - 2, n,
+                                             batch_scratch));
+  if (!inverse) {
+    float *la = a + (size_t)(count - 1) * n, *lb = b + (size_t)(count - 1) * n;
+    assert(knf_rfft_compute_power_range(fft, la, false, 1, n / 2 + 1));
+    assert(knf_rfft_compute_power_range_with_scratch(fft, lb, false, 1,
+                                                     n / 2 + 1, scratch));
+    la[0] = lb[0] = 0.0f;
+    for (int32_t i = n / 2 + 1; i < n; ++i) la[i] = lb[i] = 0.0f;
+  }
+  free(scratch);
+  free(batch_scratch);
+  knf_rfft_destroy(fft);
+
+  bool same = memcmp(a, b, total * sizeof(float)) == 0;
+  free(a);
+  free(b);
+  return same;
+}
+
 int main() {
   float signal[8] = {0, 1, 2, 3, 4, 5, 6, 7};
   float original[8];
@@ -26,6 +324,271 @@ int main() {
     assert(fabsf(signal[i] - expected) < 1e-3f);
   }
 
+  // Kaldi layout: [Re X0, Re X(n/2), Re X1, Im X1, ...].
+  float tone[8];
+  for (int i = 0; i < 8; ++i) {
+    tone[i] = cosf(2.0f * KNF_PI * (float)i / 8.0f) + (i % 2 ? -0.5f : 0.5f);
+  }
+  knf_rfft *layout = knf_rfft_create(8, false);
+  assert(layout != nullptr);
+  assert(knf_rfft_compute(layout, tone));
+  knf_rfft_destroy(layout);
+  assert(fabsf(tone[0]) < 1e-5f);
+  assert(fabsf(tone[1] - 4.0f) < 1e-5f);
+  assert(fabsf(tone[2] - 4.0f) < 1e-5f);
+  for (int i = 3; i < 8; ++i) assert(fabsf(tone[i]) < 1e-5f);
+
+  // Lengths with a large prime factor fall back to double precision.
+  knf_rfft *prime = knf_rfft_create(2 * 1009, false);
+  assert(prime != nullptr);
+  assert(prime->precision == KNF_RFFT_DOUBLE);
+  knf_rfft_destroy(prime);
+
+  srand(20240611);
+  const int32_t sizes[] = {256, 320, 400, 512, 1024, 2 * 3 * 5 * 7 * 11};
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+    float fwd = float_vs_double_error(sizes[i], false);
+    float inv = float_vs_double_error(sizes[i], true);
+    printf("n=%d float vs double: forward %.3g, inverse %.3g\n", sizes[i], fwd,
+           inv);
+    assert(fwd < 2e-6f);
+    assert(inv < 2e-6f);
+  }
+
+  // Every vector kernel the CPU can run must agree with the scalar passes,
+  // including lengths it has to hand back to a narrower kernel.
+  const knf_fft_isa isas[] = {KNF_FFT_ISA_SSE2, KNF_FFT_ISA_AVX2,
+                              KNF_FFT_ISA_AVX512, KNF_FFT_ISA_NEON};
+  const int32_t simd_sizes[] = {8, 24, 64, 200, 256, 320, 400, 512, 1024, 2310};
+  for (size_t k = 0; k < sizeof(isas) / sizeof(isas[0]); ++k) {
+    if (!knf_fft_isa_supported(isas[k])) {
+      assert(!knf_rfft_force_isa(isas[k]));
+      continue;
+    }
+    for (size_t i = 0; i < sizeof(simd_sizes) / sizeof(simd_sizes[0]); ++i) {
+      const int32_t n = simd_sizes[i];
+      knf_fft_isa used_fwd, used_inv;
+      float fwd = simd_vs_scalar_error(n, false, isas[k], &used_fwd);
+      float inv = simd_vs_scalar_error(n, true, isas[k], &used_inv);
+      printf("n=%d isa %d (ran %d) vs scalar: forward %.3g, inverse %.3g\n",
+             n, isas[k], used_fwd, fwd, inv);
+      assert(used_fwd == used_inv);
+      assert(used_fwd <= isas[k]);
+      assert(fwd < 2e-6f);
+      assert(inv < 2e-6f);
+      if (n == 512) assert(used_fwd == isas[k]);
+    }
+  }
+
+  // Codelets cover the production sizes on every kernel and match the
+  // generic passes exactly; other sizes keep the generic passes.
+  const knf_fft_isa codelet_isas[] = {KNF_FFT_ISA_SCALAR, KNF_FFT_ISA_SSE2,
+                                      KNF_FFT_ISA_AVX2, KNF_FFT_ISA_AVX512,
+                                      KNF_FFT_ISA_NEON};
+  const int32_t codelet_sizes[][2] = {
+      {256, 200}, {320, 240}, {400, 400}, {512, 400}};
+  for (size_t k = 0; k < sizeof(codelet_isas) / sizeof(codelet_isas[0]); ++k) {
+    if (!knf_rfft_force_isa(codelet_isas[k])) continue;
+    for (size_t i = 0; i < sizeof(codelet_sizes) / sizeof(codelet_sizes[0]);
+         ++i) {
+      const int32_t n = codelet_sizes[i][0];
+      assert(codelet_matches_generic(n, false, n));
+      assert(codelet_matches_generic(n, false, codelet_sizes[i][1]));
+      assert(codelet_matches_generic(n, true, n));
+    }
+  }
+  assert(knf_rfft_force_isa(KNF_FFT_ISA_AUTO));
+  knf_rfft *generic = knf_rfft_create(1024, false);
+  assert(generic != nullptr && !generic->codelet);
+  knf_rfft_destroy(generic);
+
+  // Batches interleave one frame per lane, whatever the length.
+  const knf_fft_isa batch_isas[] = {KNF_FFT_ISA_SCALAR, KNF_FFT_ISA_AUTO};
+  const int32_t batch_sizes[] = {8, 400, 512, 2310};
+  for (size_t k = 0; k < sizeof(batch_isas) / sizeof(batch_isas[0]); ++k) {
+    assert(knf_rfft_force_isa(batch_isas[k]));
+    for (size_t i = 0; i < sizeof(batch_sizes) / sizeof(batch_sizes[0]); ++i) {
+      const int32_t n = batch_sizes[i];
+      float fwd = batch_vs_single_error(n, false, 37, n + 3);
+      float inv = batch_vs_single_error(n, true, 37, n + 3);
+      printf("n=%d isa cap %d batch vs single: forward %.3g, inverse %.3g\n",
+             n, batch_isas[k], fwd, inv);
+      assert(fwd < 2e-6f);
+      assert(inv < 2e-6f);
+      assert(batch_vs_single_error(n, false, 1, n) < 2e-6f);
+    }
+  }
+  float dummy = 0.0f;
+  knf_rfft *small = knf_rfft_create(8, false);
+  assert(small != nullptr);
+  assert(knf_rfft_compute_batch(small, &dummy, 0, 8));
+  assert(!knf_rfft_compute_batch(small, &dummy, 1, 7));
+  knf_rfft_destroy(small);
+
+  // The fused power spectrum matches the two-pass one on every kernel.
+  const knf_fft_isa power_isas[] = {KNF_FFT_ISA_SCALAR, KNF_FFT_ISA_AUTO};
+  const int32_t power_sizes[] = {8, 256, 400, 512, 2310};
+  for (size_t k = 0; k < sizeof(power_isas) / sizeof(power_isas[0]); ++k) {
+    assert(knf_rfft_force_isa(power_isas[k]));
+    for (size_t i = 0; i < sizeof(power_sizes) / sizeof(power_sizes[0]); ++i) {
+      const int32_t n = power_sizes[i];
+      for (int m = 0; m < 2; ++m) {
+        float f = fused_power_error(n, KNF_RFFT_FLOAT, m == 1);
+        float d = fused_power_error(n, KNF_RFFT_DOUBLE, m == 1);
+        printf("n=%d isa cap %d fused %s: float %.3g, double %.3g\n", n,
+               power_isas[k], m == 1 ? "magnitude" : "power", f, d);
+        assert(f < 2e-6f);
+        assert(d < 2e-6f);
+      }
+    }
+  }
+  // Pruned plans ignore the zero-padded tail on every kernel, whether the
+  // first pass is radix 2 or 4 or has to clear the tail itself.
+  const int32_t pruned_sizes[][2] = {
+      {512, 400}, {256, 200}, {512, 512},   {400, 300},      {320, 317},
+      {24, 1},    {8, 5},     {2310, 2000}, {2 * 1009, 1500}};
+  for (size_t k = 0; k < sizeof(power_isas) / sizeof(power_isas[0]); ++k) {
+    assert(knf_rfft_force_isa(power_isas[k]));
+    for (size_t i = 0; i < sizeof(pruned_sizes) / sizeof(pruned_sizes[0]);
+         ++i) {
+      float e = pruned_vs_full_error(pruned_sizes[i][0], pruned_sizes[i][1]);
+      printf("n=%d nonzero=%d isa cap %d pruned vs full: %.3g\n",
+             pruned_sizes[i][0], pruned_sizes[i][1], power_isas[k], e);
+      assert(e < 2e-6f);
+    }
+  }
+  assert(knf_rfft_create_pruned(512, 0) == nullptr);
+  assert(knf_rfft_create_pruned(512, 513) == nullptr);
+
+  // Band-limited power spectra agree with the full one inside the band,
+  // including bands that touch DC or Nyquist.
+  const int32_t range_sizes[] = {8, 256, 400, 512};
+  for (size_t k = 0; k < sizeof(power_isas) / sizeof(power_isas[0]); ++k) {
+    assert(knf_rfft_force_isa(power_isas[k]));
+    for (size_t i = 0; i < sizeof(range_sizes) / sizeof(range_sizes[0]); ++i) {
+      const int32_t n = range_sizes[i];
+      const int32_t bands[][2] = {
+          {0, n / 2 + 1}, {1, n / 4}, {n / 8, n / 2 + 1}, {n / 2, n / 2 + 1},
+          {3, 4}};
+      for (size_t j = 0; j < sizeof(bands) / sizeof(bands[0]); ++j) {
+        for (int m = 0; m < 2; ++m) {
+          float f = power_range_error(n, KNF_RFFT_FLOAT, m == 1, bands[j][0],
+                                      bands[j][1]);
+          float d = power_range_error(n, KNF_RFFT_DOUBLE, m == 1, bands[j][0],
+                                      bands[j][1]);
+          assert(f < 2e-6f);
+          assert(d < 2e-6f);
+        }
+      }
+    }
+  }
+  knf_rfft *fwd = knf_rfft_create(8, false);
+  assert(fwd != nullptr);
+  assert(!knf_rfft_compute_power_range(fwd, signal, false, 2, 2));
+  assert(!knf_rfft_compute_power_range(fwd, signal, false, 0, 6));
+  knf_rfft_destroy(fwd);
+
+  knf_rfft *inv = knf_rfft_create(8, true);
+  assert(inv != nullptr);
+  assert(!knf_rfft_compute_power(inv, signal, false));
+  knf_rfft_destroy(inv);
+
+  // Plans are shared read-only; each call may bring its own scratch.
+  const int32_t scratch_sizes[] = {8, 400, 512, 1000};
+  for (size_t k = 0; k < sizeof(power_isas) / sizeof(power_isas[0]); ++k) {
+    assert(knf_rfft_force_isa(power_isas[k]));
+    for (size_t i = 0; i < sizeof(scratch_sizes) / sizeof(scratch_sizes[0]);
+         ++i) {
+      for (int inv = 0; inv < 2; ++inv) {
+        assert(scratch_matches_owned(scratch_sizes[i], inv == 1,
+                                     KNF_RFFT_FLOAT));
+        assert(scratch_matches_owned(scratch_sizes[i], inv == 1,
+                                     KNF_RFFT_DOUBLE));
+      }
+    }
+  }
+
+  assert(knf_rfft_force_isa(KNF_FFT_ISA_AUTO));
+
+  // Equal variants share one cached plan, across directions too.
+  knf_rfft *p1 = knf_rfft_create(512, false);
+  knf_rfft *p2 = knf_rfft_create(512, true);
+  knf_rfft *p3 = knf_rfft_create_pruned(512, 400);
+  assert(p1 != nullptr && p2 != nullptr && p3 != nullptr);
+  assert(p1->plan == p2->plan && p1->plan != p3->plan);
+  knf_rfft_destroy(p1);
+  knf_rfft_clear_plan_cache();
+  float *survivor = (float *)calloc(512, sizeof(float));
+  assert(survivor != nullptr && knf_rfft_compute(p2, survivor));
+  free(survivor);
+  knf_rfft_destroy(p2);
+  knf_rfft_destroy(p3);
+
+  // Wisdom selects the variant; every pass order gives the same spectrum.
+  const char *wisdom_path = "test_rfft_wisdom.txt";
+  const knf_fft_isa wisdom_isas[] = {KNF_FFT_ISA_SCALAR, knf_fft_best_isa()};
+  const int32_t wisdom_sizes[] = {320, 400, 512, 1000};
+  for (size_t k = 0; k < sizeof(wisdom_isas) / sizeof(wisdom_isas[0]); ++k) {
+    for (int order = 0; order < 3; ++order) {
+      for (int c = 0; c < 2; ++c) {
+        FILE *f = fopen(wisdom_path, "w");
+        assert(f != nullptr);
+        fprintf(f, "# n nonzero inverse isa codelets order\n");
+        for (size_t i = 0; i < sizeof(wisdom_sizes) / sizeof(wisdom_sizes[0]);
+             ++i) {
+          for (int inv = 0; inv < 2; ++inv) {
+            fprintf(f, "%d %d %d %d %d %d\n", wisdom_sizes[i], wisdom_sizes[i],
+                    inv, (int)wisdom_isas[k], c, order);
+          }
+        }
+        fprintf(f, "512 400 0 %d %d %d\n", (int)wisdom_isas[k], c, order);
+        assert(fclose(f) == 0);
+        assert(knf_rfft_import_wisdom(wisdom_path));
+
+        knf_rfft *w = knf_rfft_create(512, false);
+        assert(w != nullptr && w->isa == wisdom_isas[k]);
+        assert(w->codelet == (c == 1 && order == 0));
+        knf_rfft_destroy(w);
+        for (size_t i = 0; i < sizeof(wisdom_sizes) / sizeof(wisdom_sizes[0]);
+             ++i) {
+          assert(float_vs_double_error(wisdom_sizes[i], false) < 2e-6f);
+          assert(float_vs_double_error(wisdom_sizes[i], true) < 2e-6f);
+        }
+        assert(pruned_vs_full_error(512, 400) < 2e-6f);
+      }
+    }
+  }
+
+  // Measured wisdom survives an export/import round trip.
+  knf_rfft_forget_wisdom();
+  knf_rfft_set_planning(KNF_RFFT_MEASURE);
+  knf_rfft *measured = knf_rfft_create(400, false);
+  assert(measured != nullptr);
+  knf_rfft_set_planning(KNF_RFFT_ESTIMATE);
+  assert(knf_rfft_export_wisdom(wisdom_path));
+  knf_rfft_forget_wisdom();
+  assert(knf_rfft_import_wisdom(wisdom_path));
+  knf_rfft *reloaded = knf_rfft_create(400, false);
+  assert(reloaded != nullptr && reloaded->plan == measured->plan);
+  printf("n=400 measured isa %d codelet %d\n", (int)measured->isa,
+         (int)measured->codelet);
+  knf_rfft_destroy(measured);
+  knf_rfft_destroy(reloaded);
+
+  FILE *bad = fopen(wisdom_path, "w");
+  assert(bad != nullptr);
+  fprintf(bad, "512 600 0 0 1 0\n");
+  assert(fclose(bad) == 0);
+  assert(!knf_rfft_import_wisdom(wisdom_path));
+  assert(remove(wisdom_path) == 0);
+  assert(!knf_rfft_import_wisdom(wisdom_path));
+  knf_rfft_forget_wisdom();
+  knf_rfft_clear_plan_cache();
+
+  knf_rfft *best = knf_rfft_create(512, false);
+  assert(best != nullptr && best->isa == knf_fft_best_isa());
+  knf_rfft_destroy(best);
+
   printf("test_rfft passed\n");
   return 0;
 }
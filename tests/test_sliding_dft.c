@@ -0,0 +1,102 @@
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "kaldi-native-fbank/feature-window.h"
+#include "kaldi-native-fbank/rfft.h"
+#include "kaldi-native-fbank/sliding-dft.h"
+
+constexpr float KNF_PI = 3.14159265358979323846f;
+
+// Slides over num_samples of wave with the given window and compares every
+// frame with an FFT of the processed frame, skipping frame 100 to force an
+// anchor in the middle.
+static void check_window(const char *window_type, bool remove_dc_offset,
+                         bool magnitude, const float *wave,
+                         int32_t num_samples) {
+  knf_frame_opts opts;
+  knf_frame_opts_default(&opts);
+  opts.dither = 0.0f;
+  opts.preemph_coeff = 0.0f;
+  opts.frame_shift_ms = 0.25f;
+  opts.remove_dc_offset = remove_dc_offset;
+  memcpy(opts.window_type, window_type, strlen(window_type) + 1);
+  assert(knf_sliding_dft_supported(&opts));
+
+  int32_t size = knf_window_size(&opts);
+  int32_t shift = knf_window_shift(&opts);
+  int32_t padded = knf_padded_window_size(&opts);
+  int32_t begin = 3;
+  int32_t end = padded / 2 + 1;
+  knf_sliding_dft s;
+  assert(knf_sliding_dft_create(&opts, begin, end, magnitude, &s));
+  knf_rfft *fft = knf_rfft_create(padded, false);
+  knf_window win;
+  assert(fft != nullptr && knf_make_window_from_opts(&opts, &win));
+  float *expected = (float *)calloc((size_t)padded, sizeof(float));
+  float *spectrum = (float *)calloc((size_t)padded, sizeof(float));
+  assert(expected != nullptr && spectrum != nullptr);
+
+  double max_err = 0.0;
+  for (int32_t i = 0; (int64_t)i * shift + size <= num_samples; ++i) {
+    if (i == 100) continue;
+    const float *raw = wave + (int64_t)i * shift;
+    assert(knf_sliding_dft_compute(&s, (int64_t)i * shift, raw, spectrum));
+
+    memset(expected, 0, sizeof(float) * (size_t)padded);
+    memcpy(expected, raw, sizeof(float) * (size_t)size);
+    assert(knf_process_window(&opts, &win, expected, nullptr));
+    assert(knf_rfft_compute_power_range(fft, expected, magnitude, begin, end));
+    double peak = 0.0;
+    for (int32_t k = begin; k < end; ++k) {
+      if (expected[k] > peak) peak = expected[k];
+    }
+    for (int32_t k = begin; k < end; ++k) {
+      double err = fabs((double)spectrum[k] - expected[k]) / peak;
+      if (err > max_err) max_err = err;
+    }
+  }
+  assert(max_err < 1e-4);
+
+  free(expected);
+  free(spectrum);
+  knf_free_window(&win);
+  knf_rfft_destroy(fft);
+  knf_sliding_dft_destroy(&s);
+}
+
+int main() {
+  int32_t n = 16000;
+  float *wave = (float *)calloc((size_t)n, sizeof(float));
+  assert(wave != nullptr);
+  uint32_t state = 1;
+  for (int32_t i = 0; i < n; ++i) {
+    state = state * 1664525u + 1013904223u;
+    wave[i] = 0.3f + 0.5f * sinf(2.0f * KNF_PI * 440.0f * i / 16000.0f) +
+              0.1f * ((float)(state >> 8) / (float)(1u << 24) - 0.5f);
+  }
+
+  const char *windows[] = {"rectangular", "hanning", "hann", "hamming",
+                           "blackman"};
+  for (size_t w = 0; w < sizeof(windows) / sizeof(windows[0]); ++w) {
+    check_window(windows[w], true, false, wave, n);
+    check_window(windows[w], false, true, wave, n);
+  }
+
+  knf_frame_opts opts;
+  knf_frame_opts_default(&opts);
+  assert(!knf_sliding_dft_supported(&opts));
+  opts.dither = 0.0f;
+  opts.preemph_coeff = 0.0f;
+  assert(!knf_sliding_dft_supported(&opts));  // povey
+  memcpy(opts.window_type, "rectangular", sizeof("rectangular"));
+  assert(!knf_sliding_dft_cheaper(&opts, 0, 257));
+  opts.frame_shift_ms = 0.0625f;
+  assert(knf_sliding_dft_cheaper(&opts, 0, 257));
+
+  free(wave);
+  printf("test_sliding_dft passed\n");
+  return 0;
+}
@@ -43,6 +43,20 @@ int main() {
   printf("max reconstruction error: %f\n", max_err);
   assert(max_err < 1e-2f);
 
+  // float64 input is converted while padding and gives the same spectrum.
+  double *wave64 = (double *)calloc((size_t)n, sizeof(double));
+  assert(wave64 != nullptr);
+  for (int i = 0; i < n; ++i) wave64[i] = wave[i];
+  knf_stft_result res64 = {0};
+  assert(knf_stft_compute_typed(&stft_cfg, wave64, KNF_SAMPLE_FLOAT64, n,
+                                &res64));
+  assert(res64.num_frames == res.num_frames);
+  for (int i = 0; i < res.num_frames * (res.n_fft / 2 + 1); ++i) {
+    assert(res64.real[i] == res.real[i] && res64.imag[i] == res.imag[i]);
+  }
+  knf_stft_result_free(&res64);
+  free(wave64);
+
   float dummy = 0.0f;
   knf_stft_result empty = {
       .real = &dummy, .imag = &dummy, .num_frames = 7, .n_fft = 9};
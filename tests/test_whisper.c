@@ -2,6 +2,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "kaldi-native-fbank/feature-window.h"
 #include "kaldi-native-fbank/whisper-feature.h"
@@ -27,6 +28,36 @@ int main() {
     assert(isfinite(feat[i]));
   }
 
+  // A batch of frames gives the features of each frame on its own.
+  knf_frame_geometry g;
+  assert(knf_frame_geometry_init(&opts.frame_opts, nullptr, &g));
+  knf_frame_matrix frames = {};
+  assert(knf_extract_windows(&g, 0, wave, KNF_SAMPLE_FLOAT32, 1, false, n, 0,
+                             7, &frames));
+  float *row = (float *)calloc((size_t)g.padded, sizeof(float));
+  float *batch = (float *)calloc((size_t)7 * opts.dim, sizeof(float));
+  assert(row != nullptr && batch != nullptr);
+  knf_frame_matrix copy = frames;
+  copy.data = (float *)calloc((size_t)frames.rows * frames.stride,
+                              sizeof(float));
+  assert(copy.data != nullptr);
+  memcpy(copy.data, frames.data,
+         sizeof(float) * (size_t)frames.rows * frames.stride);
+  knf_whisper_compute_batch(&comp, 1.0f, &frames, batch);
+  for (int32_t i = 0; i < 7; ++i) {
+    memcpy(row, copy.data + (size_t)i * copy.stride,
+           sizeof(float) * (size_t)g.padded);
+    knf_whisper_compute(&comp, 0.0f, 1.0f, row, feat);
+    for (int32_t d = 0; d < opts.dim; ++d) {
+      float e = feat[d];
+      assert(fabsf(batch[i * opts.dim + d] - e) <= 1e-5f * (1e-6f + fabsf(e)));
+    }
+  }
+  free(copy.data);
+  free(row);
+  free(batch);
+  knf_frame_matrix_free(&frames);
+
   free(feat);
   free(wave);
   knf_whisper_computer_destroy(&comp);
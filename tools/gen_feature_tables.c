@@ -0,0 +1,201 @@
+// Generates src/feature-window-tables.h and src/mel-tables.h: the windows and
+// mel filter banks of the standard feature configurations as constant tables,
+// which knf_make_window and knf_mel_banks_create bind instead of computing
+// them.
+//
+// Run through `zig build tables` whenever the configurations or the window
+// and mel code change. The generator links the library sources built with
+// KNF_NO_EMBEDDED_TABLES, so the tables are dumped from the run-time code and
+// binding them is bit-identical to computing them.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "kaldi-native-fbank/feature-window.h"
+#include "kaldi-native-fbank/mel-computations.h"
+
+#ifndef KNF_NO_EMBEDDED_TABLES
+#error "build with -DKNF_NO_EMBEDDED_TABLES"
+#endif
+
+typedef struct {
+  const char *type;
+  float samp_freq;
+} knf_window_config;
+
+typedef struct {
+  const char *name;
+  int32_t num_bins;
+  float low_freq;
+  float samp_freq;
+  const char *window_type;
+  bool round_to_power_of_two;
+} knf_mel_config;
+
+// 25 ms frames: povey at 16 kHz (Kaldi fbank and MFCC) and 8 kHz
+// (telephony), hann at 16 kHz (whisper and the Kaldi demo).
+static const knf_window_config knf_window_configs[] = {
+    {"povey", 16000.0f},
+    {"povey", 8000.0f},
+    {"hann", 16000.0f},
+};
+
+static const knf_mel_config knf_mel_configs[] = {
+    {"16 kHz 80-bin fbank", 80, 20.0f, 16000.0f, "povey", true},
+    {"Kaldi demo, 23 bins", 23, 20.0f, 16000.0f, "povey", true},
+    {"whisper, 80 bins", 80, 0.0f, 16000.0f, "hann", false},
+    {"8 kHz telephony, 23 bins", 23, 20.0f, 8000.0f, "povey", true},
+};
+
+constexpr size_t KNF_NUM_WINDOWS =
+    sizeof(knf_window_configs) / sizeof(knf_window_configs[0]);
+constexpr size_t KNF_NUM_MELS =
+    sizeof(knf_mel_configs) / sizeof(knf_mel_configs[0]);
+
+static void knf_frame_opts_for(float samp_freq, const char *window_type,
+                               bool round_to_power_of_two,
+                               knf_frame_opts *out) {
+  knf_frame_opts_default(out);
+  out->samp_freq = samp_freq;
+  memset(out->window_type, 0, sizeof(out->window_type));
+  memcpy(out->window_type, window_type, strlen(window_type));
+  out->round_to_power_of_two = round_to_power_of_two;
+}
+
+static void knf_print_floats(FILE *f, const float *x, int32_t n) {
+  for (int32_t i = 0; i < n; ++i) {
+    fprintf(f, "%s%af,", i % 4 == 0 ? "\n    " : " ", (double)x[i]);
+  }
+  fprintf(f, "\n");
+}
+
+static void knf_print_ints(FILE *f, const int32_t *x, int32_t n) {
+  for (int32_t i = 0; i < n; ++i) {
+    fprintf(f, "%s%d,", i % 8 == 0 ? "\n    " : " ", x[i]);
+  }
+  fprintf(f, "\n");
+}
+
+static bool knf_write_windows(FILE *f) {
+  fprintf(f,
+          "// Windows of the standard frame configurations, dumped from "
+          "knf_make_window.\n"
+          "// Generated by tools/gen_feature_tables.c (zig build tables); "
+          "do not edit.\n");
+  for (size_t i = 0; i < KNF_NUM_WINDOWS; ++i) {
+    knf_frame_opts opts;
+    knf_frame_opts_for(knf_window_configs[i].samp_freq,
+                       knf_window_configs[i].type, true, &opts);
+    knf_window w;
+    if (!knf_make_window_from_opts(&opts, &w)) return false;
+    fprintf(f,
+            "\n// %s, %d samples\n"
+            "static const float knf_window_table_%zu[%d] = {",
+            knf_window_configs[i].type, w.size, i, w.size);
+    knf_print_floats(f, w.data, w.size);
+    fprintf(f, "};\n");
+    knf_free_window(&w);
+  }
+  fprintf(f, "\nstatic const knf_window_table knf_window_tables[] = {\n");
+  for (size_t i = 0; i < KNF_NUM_WINDOWS; ++i) {
+    knf_frame_opts opts;
+    knf_frame_opts_for(knf_window_configs[i].samp_freq,
+                       knf_window_configs[i].type, true, &opts);
+    fprintf(f, "    {\"%s\", %d, knf_window_table_%zu},\n",
+            knf_window_configs[i].type, knf_window_size(&opts), i);
+  }
+  fprintf(f, "};\n");
+  return true;
+}
+
+static bool knf_write_mels(FILE *f) {
+  fprintf(f,
+          "// Mel filter banks of the standard configurations, dumped from\n"
+          "// knf_mel_banks_create without VTLN warping. Generated by\n"
+          "// tools/gen_feature_tables.c (zig build tables); do not edit.\n");
+  knf_mel_banks *banks[KNF_NUM_MELS] = {};
+  knf_mel_opts mel_opts[KNF_NUM_MELS];
+  knf_frame_opts frame_opts[KNF_NUM_MELS];
+  bool ok = true;
+  for (size_t i = 0; i < KNF_NUM_MELS && ok; ++i) {
+    const knf_mel_config *c = &knf_mel_configs[i];
+    knf_mel_opts_default(&mel_opts[i]);
+    mel_opts[i].num_bins = c->num_bins;
+    mel_opts[i].low_freq = c->low_freq;
+    knf_frame_opts_for(c->samp_freq, c->window_type, c->round_to_power_of_two,
+                       &frame_opts[i]);
+    banks[i] = knf_mel_banks_create(&mel_opts[i], &frame_opts[i], 1.0f);
+    if (banks[i] == nullptr) {
+      ok = false;
+      break;
+    }
+    const knf_mel_banks *b = banks[i];
+    int32_t num_weights =
+        b->start[b->num_bins - 1] + b->length[b->num_bins - 1];
+    fprintf(f, "\n// %s\nstatic const float knf_mel_weights_%zu[%d] = {",
+            c->name, i, num_weights);
+    knf_print_floats(f, b->weights, num_weights);
+    fprintf(f, "};\nstatic const int32_t knf_mel_first_bin_%zu[%d] = {", i,
+            b->num_bins);
+    knf_print_ints(f, b->first_bin, b->num_bins);
+    fprintf(f, "};\nstatic const int32_t knf_mel_length_%zu[%d] = {", i,
+            b->num_bins);
+    knf_print_ints(f, b->length, b->num_bins);
+    fprintf(f, "};\nstatic const int32_t knf_mel_start_%zu[%d] = {", i,
+            b->num_bins);
+    knf_print_ints(f, b->start, b->num_bins);
+    fprintf(f, "};\n");
+  }
+  if (ok) {
+    fprintf(f, "\nstatic const knf_mel_table knf_mel_tables[] = {\n");
+    for (size_t i = 0; i < KNF_NUM_MELS; ++i) {
+      const knf_mel_banks *b = banks[i];
+      fprintf(f,
+              "    {%d, %af, %af, %af, %d,\n"
+              "     {.num_bins = %d,\n"
+              "      .num_fft_bins = %d,\n"
+              "      .weights = (float *)knf_mel_weights_%zu,\n"
+              "      .first_bin = (int32_t *)knf_mel_first_bin_%zu,\n"
+              "      .length = (int32_t *)knf_mel_length_%zu,\n"
+              "      .start = (int32_t *)knf_mel_start_%zu,\n"
+              "      .bin_begin = %d,\n"
+              "      .bin_end = %d,\n"
+              "      .embedded = true}},\n",
+              mel_opts[i].num_bins, (double)mel_opts[i].low_freq,
+              (double)mel_opts[i].high_freq, (double)frame_opts[i].samp_freq,
+              knf_padded_window_size(&frame_opts[i]), b->num_bins,
+              b->num_fft_bins, i, i, i, i, b->bin_begin, b->bin_end);
+    }
+    fprintf(f, "};\n");
+  }
+  for (size_t i = 0; i < KNF_NUM_MELS; ++i) knf_mel_banks_destroy(banks[i]);
+  return ok;
+}
+
+static bool knf_write(const char *dir, const char *name,
+                      bool (*write)(FILE *)) {
+  char path[4096];
+  if (snprintf(path, sizeof(path), "%s/%s", dir, name) >= (int)sizeof(path)) {
+    return false;
+  }
+  FILE *f = fopen(path, "w");
+  if (f == nullptr) {
+    fprintf(stderr, "Cannot write %s\n", path);
+    return false;
+  }
+  bool ok = write(f);
+  if (fclose(f) != 0) ok = false;
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  if (argc != 2) {
+    fprintf(stderr, "Usage: %s <src dir>\n", argv[0]);
+    return 1;
+  }
+  if (!knf_write(argv[1], "feature-window-tables.h", knf_write_windows) ||
+      !knf_write(argv[1], "mel-tables.h", knf_write_mels)) {
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,315 @@
+// Generates src/pocketfft-codelet-tables.h and src/pocketfft-codelets.h: the
+// twiddle factors of the production FFT sizes as constant tables, and pass
+// drivers whose factorization, strides and twiddle offsets are spelled out
+// so that the compiler can specialize every radix pass.
+//
+// Run through `zig build codelets` whenever the sizes or the packed passes
+// change. The tables are dumped from the plans pocketfft computes at run time,
+// so codelets and generic passes produce bit-identical results.
+
+#define POCKETFFT_NO_CODELETS
+#include "pocketfft.c"
+
+#include <stdio.h>
+#include <string.h>
+
+// Transform sizes with codelets: Kaldi fbank (512), whisper (400) and 8 kHz
+// telephony (256, 320).
+static const size_t knf_codelet_sizes[] = {256, 320, 400, 512};
+// Lane counts of the float instantiations: the scalar passes, SSE2/NEON, AVX2
+// and AVX-512.
+static const size_t knf_codelet_lanes[] = {1, 4, 8, 16};
+
+constexpr size_t KNF_MAX_CODELETS = 32;
+
+typedef struct {
+  size_t length;
+  bool lanes[sizeof(knf_codelet_lanes) / sizeof(knf_codelet_lanes[0])];
+} knf_codelet;
+
+static size_t knf_codelet_count = 0;
+static knf_codelet knf_codelets[KNF_MAX_CODELETS];
+
+// Records that the instantiation with lanes[w] runs length-point passes.
+static void knf_codelet_add(size_t length, size_t w) {
+  for (size_t i = 0; i < knf_codelet_count; ++i) {
+    if (knf_codelets[i].length == length) {
+      knf_codelets[i].lanes[w] = true;
+      return;
+    }
+  }
+  knf_codelets[knf_codelet_count].length = length;
+  knf_codelets[knf_codelet_count].lanes[w] = true;
+  ++knf_codelet_count;
+}
+
+// Mirrors make_rfftf_plan_isa: a single transform on W lanes runs passes of
+// n / W points when W * 2 divides n, and a batch runs n-point passes on W
+// lanes when its two buffers of n vectors fit in 32 KiB.
+static void knf_codelet_collect(void) {
+  const size_t nsizes = sizeof(knf_codelet_sizes) / sizeof(size_t);
+  const size_t nlanes = sizeof(knf_codelet_lanes) / sizeof(size_t);
+  for (size_t i = 0; i < nsizes; ++i) {
+    const size_t n = knf_codelet_sizes[i];
+    for (size_t w = 0; w < nlanes; ++w) {
+      const size_t lanes = knf_codelet_lanes[w];
+      if (lanes == 1 || n % (2 * lanes) == 0) knf_codelet_add(n / lanes, w);
+      if (lanes > 1 && 2 * n * lanes * sizeof(float) <= 32768) {
+        knf_codelet_add(n, w);
+      }
+    }
+  }
+  for (size_t i = 1; i < knf_codelet_count; ++i) {
+    knf_codelet c = knf_codelets[i];
+    size_t j = i;
+    for (; j > 0 && knf_codelets[j - 1].length > c.length; --j) {
+      knf_codelets[j] = knf_codelets[j - 1];
+    }
+    knf_codelets[j] = c;
+  }
+}
+
+// Opens an #if for the instantiations that have codelet c; returns false,
+// printing nothing, if all of them do.
+static bool knf_print_guard(FILE *f, const knf_codelet *c) {
+  const size_t nlanes = sizeof(knf_codelet_lanes) / sizeof(size_t);
+  size_t used = 0;
+  for (size_t w = 0; w < nlanes; ++w) used += c->lanes[w] ? 1 : 0;
+  if (used == nlanes) return false;
+  int column = fprintf(f, "#if");
+  bool first = true;
+  for (size_t w = 0; w < nlanes; ++w) {
+    if (!c->lanes[w]) continue;
+    char term[64];
+    int len = snprintf(term, sizeof(term), "RFFTP_CODELET_LANES == %zu",
+                       knf_codelet_lanes[w]);
+    if (first) {
+      column += fprintf(f, " %s", term);
+    } else if (column + 4 + len > 78) {
+      fprintf(f, " || \\\n");
+      column = fprintf(f, "    %s", term);
+    } else {
+      column += fprintf(f, " || %s", term);
+    }
+    first = false;
+  }
+  fprintf(f, "\n");
+  return true;
+}
+
+static void knf_print_factors(FILE *f, rfftp_plan_f plan) {
+  fprintf(f, "/* %zu =", plan->length);
+  for (size_t k = 0; k < plan->nfct; ++k) {
+    fprintf(f, "%s%zu", k == 0 ? " " : " * ", plan->fct[k].fct);
+  }
+  fprintf(f, " */\n");
+}
+
+static void knf_print_twiddle(FILE *f, rfftp_plan_f plan, size_t k) {
+  if (plan->fct[k].tw == nullptr) {
+    fprintf(f, "nullptr");
+  } else {
+    fprintf(f, "tw + %td", plan->fct[k].tw - plan->mem);
+  }
+}
+
+static bool knf_write_tables(FILE *f) {
+  fprintf(f,
+          "/*\n"
+          " * This file is part of pocketfft.\n"
+          " * Licensed under a 3-clause BSD style license - see LICENSE.md\n"
+          " */\n\n"
+          "/*\n"
+          " *  Twiddle factors of the codelet lengths, dumped from\n"
+          " *  rfftp_comp_twiddle_f. Generated by tools/gen_fft_codelets.c "
+          "(zig build\n"
+          " *  codelets); do not edit.\n"
+          " */\n\n");
+  for (size_t i = 0; i < knf_codelet_count; ++i) {
+    rfftp_plan_f plan =
+        make_rfftp_plan_f(knf_codelets[i].length, POCKETFFT_ORDER_DEFAULT);
+    if (plan == nullptr) return false;
+    size_t twsize = rfftp_twsize_f(plan);
+    knf_print_factors(f, plan);
+    fprintf(f, "static const float rfftp_codelet_tw_%zu[%zu] = {",
+            plan->length, twsize);
+    for (size_t j = 0; j < twsize; ++j) {
+      fprintf(f, "%s%af,", j % 4 == 0 ? "\n    " : " ",
+              (double)plan->mem[j]);
+    }
+    fprintf(f, "\n};\n\n");
+    destroy_rfftp_plan_f(plan);
+  }
+
+  const size_t nlanes = sizeof(knf_codelet_lanes) / sizeof(size_t);
+  fprintf(f,
+          "/* Pass lengths with a codelet in the instantiation of the given "
+          "lane\n   count. */\n"
+          "static const struct {\n"
+          "  size_t length, lanes;\n"
+          "} rfftp_codelets[] = {\n");
+  for (size_t i = 0; i < knf_codelet_count; ++i) {
+    for (size_t w = 0; w < nlanes; ++w) {
+      if (knf_codelets[i].lanes[w]) {
+        fprintf(f, "    {%zu, %zu},\n", knf_codelets[i].length,
+                knf_codelet_lanes[w]);
+      }
+    }
+  }
+  fprintf(f, "};\n");
+  return true;
+}
+
+static bool knf_write_drivers(FILE *f) {
+  fprintf(f,
+          "/*\n"
+          " * This file is part of pocketfft.\n"
+          " * Licensed under a 3-clause BSD style license - see LICENSE.md\n"
+          " */\n\n"
+          "/*\n"
+          " *  Codelets: rfftp_forward_passes and rfftp_backward_passes "
+          "unrolled for\n"
+          " *  the lengths in pocketfft-codelet-tables.h, with constant "
+          "strides and\n"
+          " *  twiddle tables so that every pass is specialized in place.\n"
+          " *  Generated by tools/gen_fft_codelets.c (zig build codelets); do "
+          "not edit.\n"
+          " *\n"
+          " *  Included by pocketfft-rfftp.h for every instantiation that "
+          "defines\n"
+          " *  RFFTP_CODELET_LANES, the lane count of its element type.\n"
+          " */\n");
+  for (size_t i = 0; i < knf_codelet_count; ++i) {
+    rfftp_plan_f plan =
+        make_rfftp_plan_f(knf_codelets[i].length, POCKETFFT_ORDER_DEFAULT);
+    if (plan == nullptr) return false;
+    const size_t n = plan->length, nf = plan->nfct;
+    for (size_t k = 0; k < nf; ++k) {
+      if (plan->fct[k].fct < 2 || plan->fct[k].fct > 5) {
+        fprintf(stderr, "length %zu needs the generic radix\n", n);
+        destroy_rfftp_plan_f(plan);
+        return false;
+      }
+    }
+
+    fprintf(f, "\n");
+    bool guarded = knf_print_guard(f, &knf_codelets[i]);
+    knf_print_factors(f, plan);
+    int indent = fprintf(f,
+                         "RFFTP_ATTR [[gnu::flatten]]\n"
+                         "static RFFTP_T *RFFTP_NAME(rfftp_forward_%zu)(",
+                         n) -
+                 (int)strlen("RFFTP_ATTR [[gnu::flatten]]\n");
+    fprintf(f,
+            "RFFTP_T *c, RFFTP_T *ch,\n"
+            "%*ssize_t nonzero) {\n"
+            "  [[maybe_unused]] const float *tw = rfftp_codelet_tw_%zu;\n",
+            indent, "", n);
+    size_t l1 = n;
+    bool in_c = true;
+    for (size_t k1 = 0; k1 < nf; ++k1) {
+      const size_t k = nf - k1 - 1, ip = plan->fct[k].fct, ido = n / l1;
+      l1 /= ip;
+      const char *src = in_c ? "c" : "ch", *dst = in_c ? "ch" : "c";
+      if (k1 == 0 && (ip == 2 || ip == 4)) {
+        fprintf(f,
+                "  if (nonzero < %zu)\n"
+                "    RFFTP_NAME(radf%zu_pruned)(%zu, c, ch, nonzero);\n"
+                "  else\n"
+                "    RFFTP_NAME(radf%zu)(1, %zu, c, ch, nullptr);\n",
+                n, ip, l1, ip, l1);
+      } else {
+        if (k1 == 0) {
+          fprintf(f,
+                  "  if (nonzero < %zu)\n"
+                  "    memset(c + nonzero, 0, (%zu - nonzero) * "
+                  "sizeof(RFFTP_T));\n",
+                  n, n);
+        }
+        fprintf(f, "  RFFTP_NAME(radf%zu)(%zu, %zu, %s, %s, ", ip, ido, l1,
+                src, dst);
+        knf_print_twiddle(f, plan, k);
+        fprintf(f, ");\n");
+      }
+      in_c = !in_c;
+    }
+    fprintf(f, "  return %s;\n}\n\n", in_c ? "c" : "ch");
+
+    fprintf(f,
+            "RFFTP_ATTR [[gnu::flatten]]\n"
+            "static RFFTP_T *RFFTP_NAME(rfftp_backward_%zu)(RFFTP_T *c, "
+            "RFFTP_T *ch) {\n"
+            "  [[maybe_unused]] const float *tw = rfftp_codelet_tw_%zu;\n",
+            n, n);
+    l1 = 1;
+    in_c = true;
+    for (size_t k = 0; k < nf; ++k) {
+      const size_t ip = plan->fct[k].fct, ido = n / (ip * l1);
+      fprintf(f, "  RFFTP_NAME(radb%zu)(%zu, %zu, %s, %s, ", ip, ido, l1,
+              in_c ? "c" : "ch", in_c ? "ch" : "c");
+      knf_print_twiddle(f, plan, k);
+      fprintf(f, ");\n");
+      in_c = !in_c;
+      l1 *= ip;
+    }
+    fprintf(f, "  return %s;\n}\n%s", in_c ? "c" : "ch",
+            guarded ? "#endif\n" : "");
+    destroy_rfftp_plan_f(plan);
+  }
+
+  const char *dirs[] = {"forward", "backward"};
+  for (size_t d = 0; d < 2; ++d) {
+    fprintf(f,
+            "\n/* Runs the %s codelet of the given length; nullptr if this\n"
+            "   instantiation has none. */\n"
+            "RFFTP_ATTR\n"
+            "static RFFTP_T *RFFTP_NAME(rfftp_codelet_%s)(size_t length, "
+            "RFFTP_T *c,\n"
+            "                                             RFFTP_T *ch%s) {\n"
+            "  switch (length) {\n",
+            dirs[d], dirs[d], d == 0 ? ", size_t nonzero" : "");
+    for (size_t i = 0; i < knf_codelet_count; ++i) {
+      bool guarded = knf_print_guard(f, &knf_codelets[i]);
+      fprintf(f,
+              "  case %zu:\n"
+              "    return RFFTP_NAME(rfftp_%s_%zu)(c, ch%s);\n%s",
+              knf_codelets[i].length, dirs[d], knf_codelets[i].length,
+              d == 0 ? ", nonzero" : "", guarded ? "#endif\n" : "");
+    }
+    fprintf(f,
+            "  default:\n"
+            "    return nullptr;\n"
+            "  }\n"
+            "}\n");
+  }
+  return true;
+}
+
+static bool knf_write(const char *dir, const char *name,
+                      bool (*write)(FILE *)) {
+  char path[4096];
+  if (snprintf(path, sizeof(path), "%s/%s", dir, name) >= (int)sizeof(path)) {
+    return false;
+  }
+  FILE *f = fopen(path, "w");
+  if (f == nullptr) {
+    fprintf(stderr, "Cannot write %s\n", path);
+    return false;
+  }
+  bool ok = write(f);
+  if (fclose(f) != 0) ok = false;
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  if (argc != 2) {
+    fprintf(stderr, "Usage: %s <src dir>\n", argv[0]);
+    return 1;
+  }
+  knf_codelet_collect();
+  if (!knf_write(argv[1], "pocketfft-codelet-tables.h", knf_write_tables) ||
+      !knf_write(argv[1], "pocketfft-codelets.h", knf_write_drivers)) {
+    return 1;
+  }
+  return 0;
+}